@@ -239,6 +239,15 @@ static void cpuid_info(uint32_t info[4], const uint32_t infotype)
 #endif
 }
 
+static void cpuid_info_count(uint32_t info[4], const uint32_t infotype, const uint32_t subleaf)
+{
+#if defined(QSC_SYSTEM_COMPILER_MSC)
+    __cpuidex((int*)info, infotype, subleaf);
+#elif defined(QSC_SYSTEM_COMPILER_GCC)
+    __get_cpuid_count(infotype, subleaf, &info[0], &info[1], &info[2], &info[3]);
+#endif
+}
+
 static uint32_t read_bits(uint32_t value, int index, int length)
 {
     int mask = ((1L << length) - 1) << index;
@@ -328,6 +337,20 @@ static void cpu_topology(qsc_cpuidex_cpu_features* features)
     features->rdrand = ((info[2] & CPUID_ECX_RDRAND) != 0x00000000UL);
     features->rdtcsp = ((info[3] & CPUID_EDX_RDTCSP) != 0x00000000UL);
 
+    /* sha-ni also requires the ssse3 shuffles and sse4.1 blends */
+    if ((info[2] & (CPUID_ECX_SSSE3 | CPUID_ECX_SSE41)) == (CPUID_ECX_SSSE3 | CPUID_ECX_SSE41))
+    {
+        uint32_t linfo[4] = { 0 };
+
+        cpuid_info(linfo, 0x00000000UL);
+
+        if (linfo[0] >= 0x00000007UL)
+        {
+            cpuid_info_count(linfo, 0x00000007UL, 0x00000000UL);
+            features->shani = ((linfo[1] & CPUID_EBX_SHA) != 0x00000000UL);
+        }
+    }
+
 #if defined(QSC_SYSTEM_HAS_AVX)
     bool havx;
 
@@ -454,6 +477,7 @@ bool qsc_cpuidex_features_set(qsc_cpuidex_cpu_features* features)
     features->pcmul = false;
     features->rdrand = false;
     features->rdtcsp = false;
+    features->shani = false;
     features->cacheline = 0;
     features->cores = 0;
     features->cpus = 1;
@@ -525,6 +549,9 @@ void qsc_cpuidex_print_stats()
 		qsc_consoleutils_print_safe("RDTCSP: ");
 		qsc_consoleutils_print_line(cfeat.rdtcsp == true ? st : sf);
 
+		qsc_consoleutils_print_safe("SHA-NI: ");
+		qsc_consoleutils_print_line(cfeat.shani == true ? st : sf);
+
 		qsc_consoleutils_print_safe("Cacheline size: ");
 		qsc_stringutils_int_to_string((int32_t)cfeat.cacheline, vstr, sizeof(vstr));
 		qsc_consoleutils_print_line(vstr);
@@ -70,6 +70,7 @@ QSC_EXPORT_API typedef struct
     bool pcmul;                             	/*!< The PCLMULQDQ flag */
     bool rdrand;                            	/*!< The RDRAND flag */
     bool rdtcsp;                            	/*!< The RDTCSP flag */
+    bool shani;                             	/*!< The SHA-NI flag */
     uint32_t cacheline;                     	/*!< The number of cache lines */
     uint32_t cores;                         	/*!< The number of cores */
     uint32_t cpus;                          	/*!< The number of CPUs */
@@ -1,4 +1,10 @@
+/* declares syscall when compiling in a strict ISO C mode */
+#if !defined(_DEFAULT_SOURCE)
+#	define _DEFAULT_SOURCE
+#endif
+
 #include "csp.h"
+#include "memutils.h"
 
 #if defined(QSC_SYSTEM_OS_WINDOWS)
 #	include <Windows.h>
@@ -11,24 +17,99 @@
 #	include <errno.h>
 #	include <fcntl.h>
 #	include <limits.h>
+#	include <pthread.h>
 #	include <stdlib.h>
 #	include <stdio.h>
-#	include <sys/types.h>
 #	include <unistd.h>
+#	if defined(QSC_SYSTEM_OS_LINUX)
+#		include <sys/syscall.h>
+#	endif
 #	if !defined(O_NOCTTY)
 #		define O_NOCTTY 0
 #	endif
+#	if !defined(O_CLOEXEC)
+#		define O_CLOEXEC 0
+#	endif
 #endif
 
 #if defined(__OpenBSD__) || defined(__CloudABI__) || defined(__wasi__)
 #	define HAVE_SAFE_ARC4RANDOM
 #endif
 
-bool qsc_csp_generate(uint8_t* output, size_t length)
+#if defined(QSC_SYSTEM_OS_LINUX) && defined(SYS_getrandom)
+#	define CSP_HAVE_GETRANDOM
+#endif
+
+/* arc4random is already buffered in user space and reseeded after a fork */
+#if !defined(HAVE_SAFE_ARC4RANDOM)
+#	if defined(QSC_SYSTEM_COMPILER_MSC)
+#		define CSP_THREAD_LOCAL __declspec(thread)
+#	elif defined(QSC_SYSTEM_COMPILER_GCC) || defined(QSC_SYSTEM_COMPILER_CLANG)
+#		define CSP_THREAD_LOCAL __thread
+#	endif
+#	if defined(CSP_THREAD_LOCAL)
+#		define CSP_POOL_ENABLED
+#	endif
+#endif
+
+/*!
+* \def CSP_POOL_SIZE
+* \brief The size in bytes of the per-thread random pool
+*/
+#define CSP_POOL_SIZE 1024
+
+/*!
+* \def CSP_POOL_REQUEST_MAX
+* \brief Requests up to this length are served from the pool, longer requests read the provider directly
+*/
+#define CSP_POOL_REQUEST_MAX 256
+
+#if !defined(QSC_SYSTEM_OS_WINDOWS) && !defined(HAVE_SAFE_ARC4RANDOM)
+
+static bool csp_urandom_generate(uint8_t* output, size_t length)
 {
-	assert(output != 0);
-	assert(length <= QSC_CSP_SEED_MAX);
+	int32_t fd;
+	bool res;
 
+	res = true;
+	fd = open("/dev/urandom", O_RDONLY | O_NOCTTY | O_CLOEXEC);
+
+	if (fd < 0)
+	{
+		res = false;
+	}
+	else
+	{
+		while (length != 0)
+		{
+			ssize_t r = read(fd, output, length);
+
+			if (r > 0)
+			{
+				output += (size_t)r;
+				length -= (size_t)r;
+			}
+			else if (r < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			else
+			{
+				res = false;
+				break;
+			}
+		}
+
+		close(fd);
+	}
+
+	return res;
+}
+
+#endif
+
+static bool csp_system_generate(uint8_t* output, size_t length)
+{
 	bool res;
 
 	res = true;
@@ -37,11 +118,23 @@ bool qsc_csp_generate(uint8_t* output, size_t length)
 
 	HCRYPTPROV hprov;
 
+	hprov = 0;
+
 	if (CryptAcquireContextW(&hprov, 0, 0, PROV_RSA_FULL, (CRYPT_VERIFYCONTEXT | CRYPT_SILENT)) == true)
 	{
-		if (CryptGenRandom(hprov, (DWORD)length, output) == false)
+		/* the length argument is 32 bits wide */
+		while (length != 0)
 		{
-			res = false;
+			const DWORD RMDLEN = (DWORD)((length > 0x40000000UL) ? 0x40000000UL : length);
+
+			if (CryptGenRandom(hprov, RMDLEN, output) == false)
+			{
+				res = false;
+				break;
+			}
+
+			output += RMDLEN;
+			length -= RMDLEN;
 		}
 	}
 	else
@@ -58,26 +151,196 @@ bool qsc_csp_generate(uint8_t* output, size_t length)
 
 	arc4random_buf(output, length);
 
+#elif defined(CSP_HAVE_GETRANDOM)
+
+	/* getrandom blocks only until the kernel pool is first seeded, and needs no file descriptor */
+	while (length != 0)
+	{
+		long r = syscall(SYS_getrandom, output, length, 0);
+
+		if (r > 0)
+		{
+			output += (size_t)r;
+			length -= (size_t)r;
+		}
+		else if (r < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		else
+		{
+			/* kernels older than 3.17 do not have the call */
+			res = (r < 0 && errno == ENOSYS) ? csp_urandom_generate(output, length) : false;
+			break;
+		}
+	}
+
 #else
 
-	int32_t fd = open("/dev/urandom", O_RDONLY);
+	res = csp_urandom_generate(output, length);
+
+#endif
+
+	return res;
+}
+
+#if defined(CSP_POOL_ENABLED)
 
-	if (fd <= 0)
+typedef struct
+{
+	uint8_t buffer[CSP_POOL_SIZE];
+	size_t remaining;
+	bool registered;
+} csp_pool_state;
+
+static CSP_THREAD_LOCAL csp_pool_state csp_pool;
+static bool csp_pool_safe = false;
+
+static void csp_pool_clear(csp_pool_state* pool)
+{
+	qsc_memutils_clear(pool->buffer, sizeof(pool->buffer));
+	pool->remaining = 0;
+}
+
+#	if defined(QSC_SYSTEM_OS_WINDOWS)
+
+static INIT_ONCE csp_pool_once = INIT_ONCE_STATIC_INIT;
+static DWORD csp_pool_key = FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI csp_thread_exit(PVOID pool)
+{
+	/* the fiber local storage callback runs when the thread exits, erase its unserved bytes */
+	if (pool != NULL)
 	{
-		res = false;
+		csp_pool_clear((csp_pool_state*)pool);
+		((csp_pool_state*)pool)->registered = false;
 	}
-	else
+}
+
+static BOOL CALLBACK csp_pool_register(PINIT_ONCE once, PVOID param, PVOID* context)
+{
+	(void)once;
+	(void)param;
+	(void)context;
+
+	csp_pool_key = FlsAlloc(&csp_thread_exit);
+	csp_pool_safe = (csp_pool_key != FLS_OUT_OF_INDEXES);
+
+	return TRUE;
+}
+
+#	else
+
+static pthread_once_t csp_pool_once = PTHREAD_ONCE_INIT;
+static pthread_key_t csp_pool_key;
+
+static void csp_thread_exit(void* pool)
+{
+	/* the key destructor runs when the thread exits, erase its unserved bytes */
+	if (pool != NULL)
 	{
-		int32_t r = read(fd, output, length);
+		csp_pool_clear((csp_pool_state*)pool);
+		((csp_pool_state*)pool)->registered = false;
+	}
+}
 
-		if (r != length)
-		{
-			res = false;
-		}
+static void csp_fork_child(void)
+{
+	/* the child runs in a copy of the forking thread, erase its copy of the parent pool */
+	csp_pool_clear(&csp_pool);
+}
 
-		close(fd);
+static void csp_pool_register(void)
+{
+	/* a pool copied into a forked child would repeat the parent output, so it is used only with the fork handler */
+	csp_pool_safe = (pthread_key_create(&csp_pool_key, &csp_thread_exit) == 0 &&
+		pthread_atfork(NULL, NULL, &csp_fork_child) == 0);
+}
+
+#	endif
+
+static bool csp_pool_available(void)
+{
+	bool res;
+
+#	if defined(QSC_SYSTEM_OS_WINDOWS)
+	res = (InitOnceExecuteOnce(&csp_pool_once, &csp_pool_register, NULL, NULL) == TRUE && csp_pool_safe == true);
+#	else
+	res = (pthread_once(&csp_pool_once, &csp_pool_register) == 0 && csp_pool_safe == true);
+#	endif
+
+	/* the thread exit handler is armed on the first use of the pool in each thread */
+	if (res == true && csp_pool.registered == false)
+	{
+#	if defined(QSC_SYSTEM_OS_WINDOWS)
+		csp_pool.registered = (FlsSetValue(csp_pool_key, &csp_pool) == TRUE);
+#	else
+		csp_pool.registered = (pthread_setspecific(csp_pool_key, &csp_pool) == 0);
+#	endif
+		res = csp_pool.registered;
+	}
+
+	return res;
+}
+
+static bool csp_pool_generate(uint8_t* output, size_t length)
+{
+	size_t pos;
+	bool res;
+
+	res = true;
+
+	if (csp_pool.remaining < length)
+	{
+		/* discard the unused bytes and refill the pool */
+		res = csp_system_generate(csp_pool.buffer, sizeof(csp_pool.buffer));
+		csp_pool.remaining = (res == true) ? sizeof(csp_pool.buffer) : 0;
+	}
+
+	if (res == true)
+	{
+		/* served bytes are erased, so the pool never holds an output that was already returned */
+		pos = sizeof(csp_pool.buffer) - csp_pool.remaining;
+		qsc_memutils_copy(output, csp_pool.buffer + pos, length);
+		qsc_memutils_clear(csp_pool.buffer + pos, length);
+		csp_pool.remaining -= length;
+	}
+
+	return res;
+}
+
+#endif
+
+bool qsc_csp_generate(uint8_t* output, size_t length)
+{
+	assert(output != 0);
+
+	bool res;
+
+#if defined(CSP_POOL_ENABLED)
+
+	bool pool;
+
+	pool = (length <= CSP_POOL_REQUEST_MAX);
+
+	if (pool == true)
+	{
+		pool = csp_pool_available();
 	}
 
+	if (pool == true)
+	{
+		res = csp_pool_generate(output, length);
+	}
+	else
+	{
+		res = csp_system_generate(output, length);
+	}
+
+#else
+
+	res = csp_system_generate(output, length);
+
 #endif
 
 	return res;
@@ -23,8 +23,13 @@
 /**
 * \file csp.h
 * \brief Cryptographic System entropy Provider
-* Provides access to either the Windows CryptGenRandom provider or
-* the /dev/urandom pool on Posix systems.
+* Provides access to either the Windows CryptGenRandom provider, the getrandom system call on Linux,
+* or the /dev/urandom pool on other Posix systems.
+* Requests of up to 256 bytes are served from a per-thread pool refilled 1024 bytes at a time,
+* so short outputs such as nonces are a memory copy rather than a system call.
+* Bytes are erased from the pool as they are served, and the pool of a forked child process is discarded.
+* The unserved bytes of a thread pool are erased when the thread exits, the pool of the thread that ends the process
+* is released with the process memory.
 * This provider is not recommended for stand-alone use, but should be combined
 * with another entropy provider to seed a MAC or DRBG function to provide quality
 * random output.
@@ -41,7 +46,8 @@ QSC_SYSTEM_CONDITION_IGNORE(5105)
 
 /*!
 * \def QSC_CSP_SEED_MAX
-* \brief The maximum seed size that can be extracted from a single generate call
+* \brief The maximum seed size that can be extracted from a single generate call.
+* Retained for compatibility; the generate function no longer limits the request length.
 */
 #define QSC_CSP_SEED_MAX 1024000
 
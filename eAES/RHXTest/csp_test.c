@@ -0,0 +1,252 @@
+#include "csp_test.h"
+#include "testutils.h"
+#include "intutils.h"
+#include "csp.h"
+#include <stdlib.h>
+#if !defined(QSC_SYSTEM_OS_WINDOWS)
+#	include <pthread.h>
+#	include <sys/types.h>
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
+
+#define CSP_DRAW_LENGTH 200
+#define CSP_DRAW_COUNT 12
+#define CSP_DRAW_ZEROS_MAX 16
+#define CSP_LONG_LENGTH (QSC_CSP_SEED_MAX + 1000)
+#define CSP_TAIL_LENGTH 64
+
+static size_t csp_zero_count(const uint8_t* input, size_t length)
+{
+	size_t ctr;
+	size_t i;
+
+	ctr = 0;
+
+	for (i = 0; i < length; ++i)
+	{
+		ctr += (input[i] == 0) ? 1 : 0;
+	}
+
+	return ctr;
+}
+
+#if !defined(QSC_SYSTEM_OS_WINDOWS)
+
+static void* csp_fork_worker(void* result)
+{
+	uint8_t cbuf[CSP_DRAW_LENGTH] = { 0 };
+	uint8_t pbuf[CSP_DRAW_LENGTH] = { 0 };
+	uint8_t seed[16] = { 0 };
+	int fds[2];
+	size_t pos;
+	pid_t pid;
+	bool status;
+
+	status = false;
+
+	/* a new thread starts with an empty pool, this call fills it and leaves 1008 bytes unserved */
+	if (qsc_csp_generate(seed, sizeof(seed)) == true && pipe(fds) == 0)
+	{
+		pid = fork();
+
+		if (pid == 0)
+		{
+			/* the child draws from its copy of the pool and returns the output to the parent */
+			close(fds[0]);
+
+			if (qsc_csp_generate(cbuf, sizeof(cbuf)) == true)
+			{
+				pos = 0;
+
+				while (pos < sizeof(cbuf))
+				{
+					ssize_t w = write(fds[1], cbuf + pos, sizeof(cbuf) - pos);
+
+					if (w <= 0)
+					{
+						break;
+					}
+
+					pos += (size_t)w;
+				}
+			}
+
+			close(fds[1]);
+			_exit(0);
+		}
+		else if (pid > 0)
+		{
+			int wstatus;
+
+			close(fds[1]);
+			status = qsc_csp_generate(pbuf, sizeof(pbuf));
+			pos = 0;
+
+			while (pos < sizeof(cbuf))
+			{
+				ssize_t r = read(fds[0], cbuf + pos, sizeof(cbuf) - pos);
+
+				if (r <= 0)
+				{
+					break;
+				}
+
+				pos += (size_t)r;
+			}
+
+			close(fds[0]);
+			waitpid(pid, &wstatus, 0);
+
+			if (pos != sizeof(cbuf))
+			{
+				qsctest_print_safe("Failure! qsctest_csp_fork_distinct: the child output is incomplete -CF1 \n");
+				status = false;
+			}
+
+			if (qsc_intutils_are_equal8(cbuf, pbuf, sizeof(pbuf)) == true)
+			{
+				qsctest_print_safe("Failure! qsctest_csp_fork_distinct: the child repeated the parent output -CF2 \n");
+				status = false;
+			}
+		}
+		else
+		{
+			close(fds[0]);
+			close(fds[1]);
+		}
+	}
+
+	*(bool*)result = status;
+
+	return NULL;
+}
+
+bool qsctest_csp_fork_distinct()
+{
+	pthread_t thd;
+	bool status;
+
+	status = false;
+
+	/* the test runs in a new thread so the parent pool state is known */
+	if (pthread_create(&thd, NULL, &csp_fork_worker, &status) == 0)
+	{
+		pthread_join(thd, NULL);
+	}
+	else
+	{
+		qsctest_print_safe("Failure! qsctest_csp_fork_distinct: the test thread could not be created -CF3 \n");
+	}
+
+	return status;
+}
+
+#endif
+
+bool qsctest_csp_long_request()
+{
+	uint8_t* otp;
+	bool status;
+
+	status = true;
+	otp = (uint8_t*)calloc(CSP_LONG_LENGTH, sizeof(uint8_t));
+
+	if (otp != NULL)
+	{
+		if (qsc_csp_generate(otp, CSP_LONG_LENGTH) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_csp_long_request: the generate call failed -CL1 \n");
+			status = false;
+		}
+
+		/* the expected count is one zero byte in 256, a short read leaves the tail zeroed */
+		if (csp_zero_count(otp, CSP_LONG_LENGTH) > CSP_LONG_LENGTH / 128 ||
+			csp_zero_count(otp + CSP_LONG_LENGTH - CSP_TAIL_LENGTH, CSP_TAIL_LENGTH) == CSP_TAIL_LENGTH)
+		{
+			qsctest_print_safe("Failure! qsctest_csp_long_request: the output was not filled -CL2 \n");
+			status = false;
+		}
+
+		free(otp);
+	}
+	else
+	{
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_csp_pool_refill()
+{
+	uint8_t otp[CSP_DRAW_COUNT][CSP_DRAW_LENGTH] = { 0 };
+	size_t i;
+	size_t j;
+	bool status;
+
+	status = true;
+
+	/* 12 draws of 200 bytes cross the 1024 byte pool boundary twice */
+	for (i = 0; i < CSP_DRAW_COUNT; ++i)
+	{
+		if (qsc_csp_generate(otp[i], CSP_DRAW_LENGTH) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_csp_pool_refill: the generate call failed -CP1 \n");
+			status = false;
+			break;
+		}
+
+		/* served bytes are erased from the pool, serving them twice would return zeroes */
+		if (csp_zero_count(otp[i], CSP_DRAW_LENGTH) > CSP_DRAW_ZEROS_MAX)
+		{
+			qsctest_print_safe("Failure! qsctest_csp_pool_refill: the output was not filled -CP2 \n");
+			status = false;
+			break;
+		}
+
+		for (j = 0; j < i; ++j)
+		{
+			if (qsc_intutils_are_equal8(otp[i], otp[j], CSP_DRAW_LENGTH) == true)
+			{
+				qsctest_print_safe("Failure! qsctest_csp_pool_refill: an output was repeated -CP3 \n");
+				status = false;
+				break;
+			}
+		}
+	}
+
+	return status;
+}
+
+void qsctest_csp_run()
+{
+#if !defined(QSC_SYSTEM_OS_WINDOWS)
+	if (qsctest_csp_fork_distinct() == true)
+	{
+		qsctest_print_safe("Success! Passed the CSP forked child pool test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CSP forked child pool test. \n");
+	}
+#endif
+
+	if (qsctest_csp_long_request() == true)
+	{
+		qsctest_print_safe("Success! Passed the CSP long request test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CSP long request test. \n");
+	}
+
+	if (qsctest_csp_pool_refill() == true)
+	{
+		qsctest_print_safe("Success! Passed the CSP pool refill test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CSP pool refill test. \n");
+	}
+}
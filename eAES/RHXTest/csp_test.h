@@ -0,0 +1,46 @@
+/**
+* \file csp_test.h
+* \brief <b>CSP Functional Tests</b> \n
+* Tests the system entropy provider request paths; long requests read from the provider,
+* short requests served from the per-thread pool across refills, and the pool of a forked child process.
+* \author John Underhill
+* \date October 18, 2026
+*/
+
+#ifndef QSCTEST_CSP_TEST_H
+#define QSCTEST_CSP_TEST_H
+
+#include "common.h"
+
+#if !defined(QSC_SYSTEM_OS_WINDOWS)
+/**
+* \brief Tests that a child process forked after the parent filled its pool
+* does not return the bytes the parent pool serves next.
+*
+* \return Returns true for success
+*/
+bool qsctest_csp_fork_distinct(void);
+#endif
+
+/**
+* \brief Tests a single request longer than QSC_CSP_SEED_MAX,
+* the request must succeed and the output must be filled to the last byte.
+*
+* \return Returns true for success
+*/
+bool qsctest_csp_long_request(void);
+
+/**
+* \brief Tests a series of 200 byte requests that cross the 1024 byte pool refill boundary,
+* each output must be filled and differ from every other output.
+*
+* \return Returns true for success
+*/
+bool qsctest_csp_pool_refill(void);
+
+/**
+* \brief Run all tests.
+*/
+void qsctest_csp_run(void);
+
+#endif
@@ -93,6 +93,24 @@
 */
 #define HBA_INFO_LENGTH 16
 
+/*!
+\def HBA_INFO_MAX_LENGTH
+* The maximum number of info bytes used by the MAC ratchet; longer info arrays are truncated, as in the original fixed-size state
+*/
+#define HBA_INFO_MAX_LENGTH 256
+
+/*!
+\def HBA_AAD_MAX_LENGTH
+* The maximum total associated data length between transforms; the length is encoded in the MAC as a 32-bit integer
+*/
+#define HBA_AAD_MAX_LENGTH 0xFFFFFFFFULL
+
+/*!
+\def HBA_AAD_REJECTED
+* The associated data length recorded after a segment was rejected; the next transform fails
+*/
+#define HBA_AAD_REJECTED 0xFFFFFFFFFFFFFFFFULL
+
 /*!
 \def HBA256_MKEY_LENGTH
 * The size of the hba-rhx256 mac key array
@@ -128,6 +146,53 @@ static const uint8_t RHX_HKDF256_INFO[7] = { 82, 72, 88, 72, 50, 53, 54 };
 static const uint8_t RHX_HKDF512_INFO[7] = { 82, 72, 88, 72, 53, 49, 50 };
 #endif
 
+/* common key-schedule helpers */
+
+static size_t rhx_secure_info(uint8_t* tmpi, size_t tmplen, const qsc_rhx_keyparams* keyparams)
+{
+	uint16_t kblen;
+	size_t inlen;
+
+	qsc_memutils_clear(tmpi, tmplen);
+
+	/* add the ciphers string literal name */
+	if (keyparams->keylen == QSC_RHX256_KEY_SIZE)
+	{
+#if defined(QSC_RHX_SHAKE_EXTENSION)
+		/* RHXS256 */
+		qsc_memutils_copy(tmpi, RHX_CSHAKE256_INFO, sizeof(RHX_CSHAKE256_INFO));
+#else
+		/* RHXH256 */
+		qsc_memutils_copy(tmpi, RHX_HKDF256_INFO, sizeof(RHX_HKDF256_INFO));
+#endif
+	}
+	else
+	{
+#if defined(QSC_RHX_SHAKE_EXTENSION)
+		/* RHXS512 */
+		qsc_memutils_copy(tmpi, RHX_CSHAKE512_INFO, sizeof(RHX_CSHAKE512_INFO));
+#else
+		/* RHXH512 */
+		qsc_memutils_copy(tmpi, RHX_HKDF512_INFO, sizeof(RHX_HKDF512_INFO));
+#endif
+	}
+
+	/* add the key size in bits to info array as a little endian ordered 16-bit integer */
+	kblen = (uint16_t)(keyparams->keylen * 8);
+	tmpi[7] = (uint8_t)kblen;
+	tmpi[8] = (uint8_t)(kblen >> 8);
+	inlen = 0;
+
+	/* copy user-defined tweak to the info array */
+	if (keyparams->infolen != 0)
+	{
+		inlen = qsc_intutils_min(keyparams->infolen, tmplen - RHX_INFO_DEFLEN);
+		qsc_memutils_copy((uint8_t*)(tmpi + RHX_INFO_DEFLEN), keyparams->info, inlen);
+	}
+
+	return RHX_INFO_DEFLEN + inlen;
+}
+
 /* aes-ni and table-based fallback functions */
 
 #if defined(QSC_SYSTEM_AESNI_ENABLED)
@@ -176,6 +241,38 @@ static void rhx_encrypt_block(qsc_rhx_state* state, __m128i* output, const __m12
 	*output = _mm_aesenclast_si128(*output, state->roundkeys[keyctr]);
 }
 
+static void rhx_encrypt_blocks8(qsc_rhx_state* state, __m128i blocks[8])
+{
+	const size_t RNDCNT = state->roundkeylen - 2;
+	size_t i;
+	size_t keyctr;
+
+	/* interleave eight independent blocks to fill the aesenc pipeline */
+	keyctr = 0;
+
+	for (i = 0; i < 8; ++i)
+	{
+		blocks[i] = _mm_xor_si128(blocks[i], state->roundkeys[keyctr]);
+	}
+
+	while (keyctr != RNDCNT)
+	{
+		++keyctr;
+
+		for (i = 0; i < 8; ++i)
+		{
+			blocks[i] = _mm_aesenc_si128(blocks[i], state->roundkeys[keyctr]);
+		}
+	}
+
+	++keyctr;
+
+	for (i = 0; i < 8; ++i)
+	{
+		blocks[i] = _mm_aesenclast_si128(blocks[i], state->roundkeys[keyctr]);
+	}
+}
+
 static void rhx_le128to8(uint8_t* input, size_t inplen, __m128i* output, size_t outlen)
 {
 	size_t i;
@@ -247,6 +344,38 @@ static void rhx_encrypt_blockw(qsc_rhx_state* state, __m512i* output, const __m5
 	++keyctr;
 	*output = _mm512_aesenclast_epi128(*output, state->roundkeysw[keyctr]);
 }
+
+static void rhx_encrypt_blocksw4(qsc_rhx_state* state, __m512i blocks[4])
+{
+	const size_t RNDCNT = state->roundkeylen - 2;
+	size_t i;
+	size_t keyctr;
+
+	/* interleave four wide registers, sixteen blocks per round */
+	keyctr = 0;
+
+	for (i = 0; i < 4; ++i)
+	{
+		blocks[i] = _mm512_xor_si512(blocks[i], state->roundkeysw[keyctr]);
+	}
+
+	while (keyctr != RNDCNT)
+	{
+		++keyctr;
+
+		for (i = 0; i < 4; ++i)
+		{
+			blocks[i] = _mm512_aesenc_epi128(blocks[i], state->roundkeysw[keyctr]);
+		}
+	}
+
+	++keyctr;
+
+	for (i = 0; i < 4; ++i)
+	{
+		blocks[i] = _mm512_aesenclast_epi128(blocks[i], state->roundkeysw[keyctr]);
+	}
+}
 #endif
 
 static void rhx_expand_rot(__m128i* Key, size_t Index, size_t Offset)
@@ -276,44 +405,9 @@ static void rhx_expand_sub(__m128i* Key, size_t Index, size_t Offset)
 static void rhx_secure_expand(qsc_rhx_state* state, const qsc_rhx_keyparams* keyparams)
 {
 	uint8_t tmpi[256] = { 0 };
-	uint16_t kblen;
-	size_t inlen;
-
-	qsc_memutils_clear(tmpi, RHX_INFO_DEFLEN + keyparams->infolen);
-
-	/* add the ciphers string literal name */
-	if (keyparams->keylen == QSC_RHX256_KEY_SIZE)
-	{
-#if defined(QSC_RHX_SHAKE_EXTENSION)
-		/* RHXS256 */
-		qsc_memutils_copy(tmpi, RHX_CSHAKE256_INFO, sizeof(RHX_CSHAKE256_INFO));
-#else
-		/* RHXH256 */
-		qsc_memutils_copy(tmpi, RHX_HKDF256_INFO, sizeof(RHX_HKDF256_INFO));
-#endif
-	}
-	else
-	{
-#if defined(QSC_RHX_SHAKE_EXTENSION)
-		/* RHXS512 */
-		qsc_memutils_copy(tmpi, RHX_CSHAKE512_INFO, sizeof(RHX_CSHAKE512_INFO));
-#else
-		/* RHXH512 */
-		qsc_memutils_copy(tmpi, RHX_HKDF512_INFO, sizeof(RHX_HKDF512_INFO));
-#endif
-	}
-
-	/* add the key size in bits to info array as a little endian ordered 16-bit integer */
-	kblen = (uint16_t)(keyparams->keylen * 8);
-	tmpi[7] = (uint8_t)kblen;
-	tmpi[8] = (uint8_t)(kblen >> 8);
+	size_t tmplen;
 
-	/* copy user-defined tweak to the info array */
-	if (keyparams->infolen != 0)
-	{
-		inlen = qsc_intutils_min(keyparams->infolen, sizeof(tmpi) - RHX_INFO_DEFLEN);
-		qsc_memutils_copy((uint8_t*)(tmpi + RHX_INFO_DEFLEN), keyparams->info, inlen);
-	}
+	tmplen = rhx_secure_info(tmpi, sizeof(tmpi), keyparams);
 
 #if defined(QSC_RHX_SHAKE_EXTENSION)
 	if (keyparams->keylen == QSC_RHX256_KEY_SIZE)
@@ -321,7 +415,7 @@ static void rhx_secure_expand(qsc_rhx_state* state, const qsc_rhx_keyparams* key
 		uint8_t rk[(RHX256_ROUNDKEY_SIZE * ROUNDKEY_ELEMENT_SIZE)] = { 0 };
 
 		/* generate the round-key buffer with cSHAKE-256 */
-		qsc_cshake256_compute(rk, sizeof(rk), keyparams->key, keyparams->keylen, tmpi, RHX_INFO_DEFLEN + keyparams->infolen, NULL, 0);
+		qsc_cshake256_compute(rk, sizeof(rk), keyparams->key, keyparams->keylen, tmpi, tmplen, NULL, 0);
 		/* convert the bytes to little endian encoded 128-bit integers */
 		rhx_le128to8(rk, sizeof(rk), state->roundkeys, state->roundkeylen);
 	}
@@ -330,7 +424,7 @@ static void rhx_secure_expand(qsc_rhx_state* state, const qsc_rhx_keyparams* key
 		uint8_t rk[(RHX512_ROUNDKEY_SIZE * ROUNDKEY_ELEMENT_SIZE)] = { 0 };
 
 		/* generate the round-key buffer with cSHAKE-512 */
-		qsc_cshake512_compute(rk, sizeof(rk), keyparams->key, keyparams->keylen, tmpi, RHX_INFO_DEFLEN + keyparams->infolen, NULL, 0);
+		qsc_cshake512_compute(rk, sizeof(rk), keyparams->key, keyparams->keylen, tmpi, tmplen, NULL, 0);
 		/* convert the bytes to little endian encoded 128-bit integers */
 		rhx_le128to8(rk, sizeof(rk), state->roundkeys, state->roundkeylen);
 	}
@@ -340,7 +434,7 @@ static void rhx_secure_expand(qsc_rhx_state* state, const qsc_rhx_keyparams* key
 		uint8_t rk[RHX256_ROUNDKEY_SIZE * ROUNDKEY_ELEMENT_SIZE] = { 0 };
 
 		/* generate the round-key buffer with HKDF(HMAC(SHA2-256)) */
-		qsc_hkdf256_expand(rk, sizeof(rk), keyparams->key, keyparams->keylen, tmpi, RHX_INFO_DEFLEN + keyparams->infolen);
+		qsc_hkdf256_expand(rk, sizeof(rk), keyparams->key, keyparams->keylen, tmpi, tmplen);
 		/* convert the bytes to little endian encoded 128-bit integers */
 		rhx_le128to8(rk, sizeof(rk), state->roundkeys, state->roundkeylen);
 	}
@@ -349,7 +443,7 @@ static void rhx_secure_expand(qsc_rhx_state* state, const qsc_rhx_keyparams* key
 		uint8_t rk[(RHX512_ROUNDKEY_SIZE * ROUNDKEY_ELEMENT_SIZE)] = { 0 };
 
 		/* generate the round-key buffer with HKDF(HMAC(SHA2-512)) */
-		qsc_hkdf512_expand(rk, sizeof(rk), keyparams->key, keyparams->keylen, tmpi, RHX_INFO_DEFLEN + keyparams->infolen);
+		qsc_hkdf512_expand(rk, sizeof(rk), keyparams->key, keyparams->keylen, tmpi, tmplen);
 		/* convert the bytes to little endian encoded 128-bit integers */
 		rhx_le128to8(rk, sizeof(rk), state->roundkeys, state->roundkeylen);
 	}
@@ -415,6 +509,41 @@ static void rhx_standard_expand(qsc_rhx_state* state, const qsc_rhx_keyparams* k
 	}
 }
 
+static void rhx_schedule_finalize(qsc_rhx_state* state, bool encryption)
+{
+	/* inverse cipher */
+	if (encryption == false)
+	{
+		__m128i tmp;
+		size_t i;
+		size_t j;
+
+		tmp = state->roundkeys[0];
+		state->roundkeys[0] = state->roundkeys[state->roundkeylen - 1];
+		state->roundkeys[state->roundkeylen - 1] = tmp;
+
+		for (i = 1, j = state->roundkeylen - 2; i < j; ++i, --j)
+		{
+			tmp = _mm_aesimc_si128(state->roundkeys[i]);
+			state->roundkeys[i] = _mm_aesimc_si128(state->roundkeys[j]);
+			state->roundkeys[j] = tmp;
+		}
+
+		state->roundkeys[i] = _mm_aesimc_si128(state->roundkeys[i]);
+	}
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	size_t i;
+
+	qsc_memutils_clear((uint8_t*)state->roundkeysw, sizeof(state->roundkeysw));
+
+	for (i = 0; i < state->rounds + 1; ++i)
+	{
+		rhx_load128to512(&state->roundkeys[i], &state->roundkeysw[i]);
+	}
+#endif
+}
+
 void qsc_rhx_initialize(qsc_rhx_state* state, const qsc_rhx_keyparams* keyparams, bool encryption, qsc_rhx_cipher_type ctype)
 {
 	assert(state != NULL);
@@ -456,38 +585,7 @@ void qsc_rhx_initialize(qsc_rhx_state* state, const qsc_rhx_keyparams* keyparams
 		state->roundkeylen = 0;
 	}
 
-	/* inverse cipher */
-	if (encryption == false)
-	{
-		__m128i tmp;
-		size_t i;
-		size_t j;
-
-		tmp = state->roundkeys[0];
-		state->roundkeys[0] = state->roundkeys[state->roundkeylen - 1];
-		state->roundkeys[state->roundkeylen - 1] = tmp;
-
-		for (i = 1, j = state->roundkeylen - 2; i < j; ++i, --j)
-		{
-			tmp = _mm_aesimc_si128(state->roundkeys[i]);
-			state->roundkeys[i] = _mm_aesimc_si128(state->roundkeys[j]);
-			state->roundkeys[j] = tmp;
-		}
-
-		state->roundkeys[i] = _mm_aesimc_si128(state->roundkeys[i]);
-	}
-
-#if defined(QSC_SYSTEM_HAS_AVX512)
-	size_t i;
-
-	qsc_memutils_clear((uint8_t*)state->roundkeysw, sizeof(state->roundkeysw));
-
-	for (i = 0; i < state->rounds + 1; ++i)
-	{
-		rhx_load128to512(&state->roundkeys[i], &state->roundkeysw[i]);
-	}
-#endif
-
+	rhx_schedule_finalize(state, encryption);
 }
 
 /* cbc mode */
@@ -1273,63 +1371,30 @@ static void rhx_prefetch_sbox(bool encryption)
 static void rhx_secure_expand(qsc_rhx_state* state, const qsc_rhx_keyparams* keyparams)
 {
 	uint8_t tmpi[256] = { 0 };
-	uint16_t kblen;
-	size_t inlen;
-
-	/* add the ciphers string literal name */
-	if (keyparams->keylen == QSC_RHX256_KEY_SIZE)
-	{
-#if defined(QSC_RHX_SHAKE_EXTENSION)
-		/* RHXS256 */
-		qsc_memutils_copy(tmpi, RHX_CSHAKE256_INFO, sizeof(RHX_CSHAKE256_INFO));
-#else
-		/* RHXH256 */
-		qsc_memutils_copy(tmpi, RHX_HKDF256_INFO, sizeof(RHX_HKDF256_INFO));
-#endif
-	}
-	else
-	{
-#if defined(QSC_RHX_SHAKE_EXTENSION)
-		/* RHXS512 */
-		qsc_memutils_copy(tmpi, RHX_CSHAKE512_INFO, sizeof(RHX_CSHAKE512_INFO));
-#else
-		/* RHXH512 */
-		qsc_memutils_copy(tmpi, RHX_HKDF512_INFO, sizeof(RHX_HKDF512_INFO));
-#endif
-	}
-
-	/* add the key size in bits to info array as a little endian ordered 16-bit integer */
-	kblen = (uint16_t)(keyparams->keylen * 8);
-	tmpi[7] = (uint8_t)kblen;
-	tmpi[8] = (uint8_t)(kblen >> 8);
+	size_t tmplen;
 
-	/* copy in user supplied tweak to info array */
-	if (keyparams->infolen != 0)
-	{
-		inlen = qsc_intutils_min(keyparams->infolen, sizeof(tmpi) - RHX_INFO_DEFLEN);
-		qsc_memutils_copy(tmpi + RHX_INFO_DEFLEN, keyparams->info, inlen);
-	}
+	tmplen = rhx_secure_info(tmpi, sizeof(tmpi), keyparams);
 
 	/* seed the rng and generate the round key array */
 #if defined(QSC_RHX_SHAKE_EXTENSION)
 	if (keyparams->keylen == QSC_RHX256_KEY_SIZE)
 	{
 		/* info is used as cSHAKE name parameter */
-		qsc_cshake256_compute((uint8_t*)state->roundkeys, state->roundkeylen * sizeof(uint32_t), keyparams->key, keyparams->keylen, tmpi, RHX_INFO_DEFLEN + keyparams->infolen, NULL, 0);
+		qsc_cshake256_compute((uint8_t*)state->roundkeys, state->roundkeylen * sizeof(uint32_t), keyparams->key, keyparams->keylen, tmpi, tmplen, NULL, 0);
 	}
 	else
 	{
-		qsc_cshake512_compute((uint8_t*)state->roundkeys, state->roundkeylen * sizeof(uint32_t), keyparams->key, keyparams->keylen, tmpi, RHX_INFO_DEFLEN + keyparams->infolen, NULL, 0);
+		qsc_cshake512_compute((uint8_t*)state->roundkeys, state->roundkeylen * sizeof(uint32_t), keyparams->key, keyparams->keylen, tmpi, tmplen, NULL, 0);
 	}
 #else
 	if (keyparams->keylen == QSC_RHX256_KEY_SIZE)
 	{
 		/* info is HKDF Expand info parameter */
-		qsc_hkdf256_expand((uint8_t*)state->roundkeys, state->roundkeylen * sizeof(uint32_t), keyparams->key, keyparams->keylen, tmpi, RHX_INFO_DEFLEN + keyparams->infolen);
+		qsc_hkdf256_expand((uint8_t*)state->roundkeys, state->roundkeylen * sizeof(uint32_t), keyparams->key, keyparams->keylen, tmpi, tmplen);
 	}
 	else
 	{
-		qsc_hkdf512_expand((uint8_t*)state->roundkeys, state->roundkeylen * sizeof(uint32_t), keyparams->key, keyparams->keylen, tmpi, RHX_INFO_DEFLEN + keyparams->infolen);
+		qsc_hkdf512_expand((uint8_t*)state->roundkeys, state->roundkeylen * sizeof(uint32_t), keyparams->key, keyparams->keylen, tmpi, tmplen);
 	}
 #endif
 }
@@ -1650,30 +1715,477 @@ void qsc_rhx_dispose(qsc_rhx_state* state)
 
 #endif
 
-/* pkcs7 padding */
+/* batched key schedule */
 
-void qsc_pkcs7_add_padding(uint8_t* input, size_t length)
+#if defined(QSC_RHX_SHAKE_EXTENSION)
+static bool rhx_batch_compatible(const qsc_rhx_keyparams* keyparams, size_t count)
 {
-	assert(input != NULL);
-
-	const size_t PADOFT = QSC_RHX_BLOCK_SIZE - length;
-	uint8_t code;
-	uint8_t cond;
 	size_t i;
+	bool res;
 
-	code = (uint8_t)length;
+	res = true;
 
-	for (i = 0; i < QSC_RHX_BLOCK_SIZE; ++i)
+	/* lanes share the cSHAKE name string, so key size and info tweak must match */
+	for (i = 1; i < count; ++i)
 	{
-		cond = i >= PADOFT ? 0xFF : 0x00;
-		input[i] ^= cond & code;
+		if (keyparams[i].keylen != keyparams[0].keylen || keyparams[i].infolen != keyparams[0].infolen)
+		{
+			res = false;
+			break;
+		}
+
+		if (keyparams[0].infolen != 0 && qsc_intutils_verify(keyparams[i].info, keyparams[0].info, keyparams[0].infolen) != 0)
+		{
+			res = false;
+			break;
+		}
 	}
+
+	return res;
 }
 
-size_t qsc_pkcs7_padding_length(const uint8_t* input)
+static void rhx_batch_prepare(qsc_rhx_state* state, const qsc_rhx_keyparams* keyparams, qsc_rhx_cipher_type ctype)
 {
-	assert(input != NULL);
-
+	if (keyparams->nonce != NULL)
+	{
+		state->nonce = keyparams->nonce;
+	}
+
+	qsc_memutils_clear((uint8_t*)state->roundkeys, sizeof(state->roundkeys));
+
+	if (ctype == RHX256)
+	{
+		state->roundkeylen = RHX256_ROUNDKEY_SIZE;
+		state->rounds = 22;
+	}
+	else
+	{
+		state->roundkeylen = RHX512_ROUNDKEY_SIZE;
+		state->rounds = 30;
+	}
+}
+#endif
+
+void qsc_rhx_initialize_batch(qsc_rhx_state* states, const qsc_rhx_keyparams* keyparams, size_t count, bool encryption, qsc_rhx_cipher_type ctype)
+{
+	assert(states != NULL);
+	assert(keyparams != NULL);
+
+	size_t i;
+
+	i = 0;
+
+#if defined(QSC_RHX_SHAKE_EXTENSION)
+	if (ctype == RHX256 || ctype == RHX512)
+	{
+		uint8_t rk[8][RHX512_ROUNDKEY_SIZE * ROUNDKEY_ELEMENT_SIZE];
+		uint8_t tmpi[256] = { 0 };
+		size_t j;
+		size_t lanes;
+		size_t rklen;
+		size_t tmplen;
+
+		while (i < count)
+		{
+			if (count - i >= 8 && rhx_batch_compatible(&keyparams[i], 8) == true)
+			{
+				lanes = 8;
+			}
+			else if (count - i >= 4 && rhx_batch_compatible(&keyparams[i], 4) == true)
+			{
+				lanes = 4;
+			}
+			else
+			{
+				lanes = 1;
+			}
+
+			if (lanes == 1)
+			{
+				qsc_rhx_initialize(&states[i], &keyparams[i], encryption, ctype);
+			}
+			else
+			{
+				for (j = 0; j < lanes; ++j)
+				{
+					rhx_batch_prepare(&states[i + j], &keyparams[i + j], ctype);
+				}
+
+				/* the info array is the cSHAKE name parameter, common to every lane */
+				tmplen = rhx_secure_info(tmpi, sizeof(tmpi), &keyparams[i]);
+				rklen = states[i].roundkeylen * ROUNDKEY_ELEMENT_SIZE;
+
+				if (lanes == 8)
+				{
+					if (keyparams[i].keylen == QSC_RHX256_KEY_SIZE)
+					{
+						cshake256x8(rk[0], rk[1], rk[2], rk[3], rk[4], rk[5], rk[6], rk[7], rklen,
+							keyparams[i].key, keyparams[i + 1].key, keyparams[i + 2].key, keyparams[i + 3].key,
+							keyparams[i + 4].key, keyparams[i + 5].key, keyparams[i + 6].key, keyparams[i + 7].key, keyparams[i].keylen,
+							tmpi, tmplen, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0);
+					}
+					else
+					{
+						cshake512x8(rk[0], rk[1], rk[2], rk[3], rk[4], rk[5], rk[6], rk[7], rklen,
+							keyparams[i].key, keyparams[i + 1].key, keyparams[i + 2].key, keyparams[i + 3].key,
+							keyparams[i + 4].key, keyparams[i + 5].key, keyparams[i + 6].key, keyparams[i + 7].key, keyparams[i].keylen,
+							tmpi, tmplen, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0);
+					}
+				}
+				else
+				{
+					if (keyparams[i].keylen == QSC_RHX256_KEY_SIZE)
+					{
+						cshake256x4(rk[0], rk[1], rk[2], rk[3], rklen,
+							keyparams[i].key, keyparams[i + 1].key, keyparams[i + 2].key, keyparams[i + 3].key, keyparams[i].keylen,
+							tmpi, tmplen, NULL, NULL, NULL, NULL, 0);
+					}
+					else
+					{
+						cshake512x4(rk[0], rk[1], rk[2], rk[3], rklen,
+							keyparams[i].key, keyparams[i + 1].key, keyparams[i + 2].key, keyparams[i + 3].key, keyparams[i].keylen,
+							tmpi, tmplen, NULL, NULL, NULL, NULL, 0);
+					}
+				}
+
+				for (j = 0; j < lanes; ++j)
+				{
+#if defined(QSC_SYSTEM_AESNI_ENABLED)
+					/* convert the bytes to little endian encoded 128-bit integers */
+					rhx_le128to8(rk[j], rklen, states[i + j].roundkeys, states[i + j].roundkeylen);
+					rhx_schedule_finalize(&states[i + j], encryption);
+#else
+					qsc_memutils_copy((uint8_t*)states[i + j].roundkeys, rk[j], rklen);
+#endif
+				}
+
+				qsc_memutils_clear((uint8_t*)rk, sizeof(rk));
+			}
+
+			i += lanes;
+		}
+	}
+#endif
+
+	/* aes and the hkdf extension are expanded sequentially */
+	while (i < count)
+	{
+		qsc_rhx_initialize(&states[i], &keyparams[i], encryption, ctype);
+		++i;
+	}
+}
+
+/* pmac */
+
+static size_t rhx_pmac_ntz(uint64_t x)
+{
+	size_t n;
+
+	n = 0;
+
+	while ((x & 1) == 0)
+	{
+		x >>= 1;
+		++n;
+	}
+
+	return n;
+}
+
+static void rhx_pmac_double(uint8_t* output, const uint8_t* input)
+{
+	uint8_t mask;
+	size_t i;
+
+	/* multiply by x in GF(2^128), the block is big endian */
+	mask = (uint8_t)(0 - (input[0] >> 7));
+
+	for (i = 0; i < QSC_RHX_BLOCK_SIZE - 1; ++i)
+	{
+		output[i] = (uint8_t)((input[i] << 1) | (input[i + 1] >> 7));
+	}
+
+	output[QSC_RHX_BLOCK_SIZE - 1] = (uint8_t)((input[QSC_RHX_BLOCK_SIZE - 1] << 1) ^ (0x87 & mask));
+}
+
+static void rhx_pmac_halve(uint8_t* output, const uint8_t* input)
+{
+	uint8_t mask;
+	size_t i;
+
+	/* multiply by x^-1 in GF(2^128) */
+	mask = (uint8_t)(0 - (input[QSC_RHX_BLOCK_SIZE - 1] & 1));
+
+	for (i = QSC_RHX_BLOCK_SIZE - 1; i > 0; --i)
+	{
+		output[i] = (uint8_t)((input[i] >> 1) | (input[i - 1] << 7));
+	}
+
+	output[0] = (uint8_t)((input[0] >> 1) ^ (0x80 & mask));
+	output[QSC_RHX_BLOCK_SIZE - 1] ^= (uint8_t)(0x43 & mask);
+}
+
+#if defined(QSC_SYSTEM_AESNI_ENABLED)
+static void rhx_pmac_process(qsc_rhx_pmac_state* ctx, const uint8_t* input, size_t blocks)
+{
+	__m128i blk[8];
+	__m128i off;
+	__m128i sum;
+	size_t i;
+	size_t oft;
+
+	off = _mm_loadu_si128((const __m128i*)ctx->offset);
+	sum = _mm_loadu_si128((const __m128i*)ctx->sum);
+	oft = 0;
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	if (blocks >= 16)
+	{
+		__m512i blkw[4];
+		__m512i sumw;
+		uint8_t offb[16 * QSC_RHX_BLOCK_SIZE];
+
+		sumw = _mm512_setzero_si512();
+
+		while (blocks >= 16)
+		{
+			/* the offsets are serial, the block encryptions are not */
+			for (i = 0; i < 16; ++i)
+			{
+				++ctx->counter;
+				off = _mm_xor_si128(off, _mm_loadu_si128((const __m128i*)ctx->ltable[rhx_pmac_ntz(ctx->counter)]));
+				_mm_storeu_si128((__m128i*)(offb + (i * QSC_RHX_BLOCK_SIZE)), off);
+			}
+
+			for (i = 0; i < 4; ++i)
+			{
+				blkw[i] = _mm512_xor_si512(_mm512_loadu_si512((const __m512i*)(input + oft + (i * AVX512_BLOCK_SIZE))),
+					_mm512_loadu_si512((const __m512i*)(offb + (i * AVX512_BLOCK_SIZE))));
+			}
+
+			rhx_encrypt_blocksw4(&ctx->cstate, blkw);
+			sumw = _mm512_xor_si512(sumw, _mm512_xor_si512(_mm512_xor_si512(blkw[0], blkw[1]), _mm512_xor_si512(blkw[2], blkw[3])));
+
+			blocks -= 16;
+			oft += 16 * QSC_RHX_BLOCK_SIZE;
+		}
+
+		/* fold the four lanes into the checksum */
+		sum = _mm_xor_si128(sum, _mm_xor_si128(_mm512_extracti32x4_epi32(sumw, 0), _mm512_extracti32x4_epi32(sumw, 1)));
+		sum = _mm_xor_si128(sum, _mm_xor_si128(_mm512_extracti32x4_epi32(sumw, 2), _mm512_extracti32x4_epi32(sumw, 3)));
+	}
+#endif
+
+	while (blocks >= 8)
+	{
+		for (i = 0; i < 8; ++i)
+		{
+			++ctx->counter;
+			off = _mm_xor_si128(off, _mm_loadu_si128((const __m128i*)ctx->ltable[rhx_pmac_ntz(ctx->counter)]));
+			blk[i] = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(input + oft + (i * QSC_RHX_BLOCK_SIZE))), off);
+		}
+
+		rhx_encrypt_blocks8(&ctx->cstate, blk);
+
+		for (i = 0; i < 8; ++i)
+		{
+			sum = _mm_xor_si128(sum, blk[i]);
+		}
+
+		blocks -= 8;
+		oft += 8 * QSC_RHX_BLOCK_SIZE;
+	}
+
+	while (blocks != 0)
+	{
+		++ctx->counter;
+		off = _mm_xor_si128(off, _mm_loadu_si128((const __m128i*)ctx->ltable[rhx_pmac_ntz(ctx->counter)]));
+		blk[0] = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(input + oft)), off);
+		rhx_encrypt_block(&ctx->cstate, &blk[1], &blk[0]);
+		sum = _mm_xor_si128(sum, blk[1]);
+
+		--blocks;
+		oft += QSC_RHX_BLOCK_SIZE;
+	}
+
+	_mm_storeu_si128((__m128i*)ctx->offset, off);
+	_mm_storeu_si128((__m128i*)ctx->sum, sum);
+}
+#else
+static void rhx_pmac_process(qsc_rhx_pmac_state* ctx, const uint8_t* input, size_t blocks)
+{
+	uint8_t blk[QSC_RHX_BLOCK_SIZE];
+	uint8_t enc[QSC_RHX_BLOCK_SIZE];
+	size_t oft;
+
+	oft = 0;
+
+	while (blocks != 0)
+	{
+		++ctx->counter;
+		qsc_memutils_xor(ctx->offset, ctx->ltable[rhx_pmac_ntz(ctx->counter)], QSC_RHX_BLOCK_SIZE);
+		qsc_memutils_copy(blk, (uint8_t*)(input + oft), QSC_RHX_BLOCK_SIZE);
+		qsc_memutils_xor(blk, ctx->offset, QSC_RHX_BLOCK_SIZE);
+		qsc_rhx_ecb_encrypt_block(&ctx->cstate, enc, blk);
+		qsc_memutils_xor(ctx->sum, enc, QSC_RHX_BLOCK_SIZE);
+
+		--blocks;
+		oft += QSC_RHX_BLOCK_SIZE;
+	}
+}
+#endif
+
+void qsc_rhx_pmac_compute(uint8_t* output, const uint8_t* message, size_t msglen, const qsc_rhx_keyparams* keyparams, qsc_rhx_cipher_type ctype)
+{
+	assert(output != NULL);
+	assert(message != NULL || msglen == 0);
+	assert(keyparams != NULL);
+
+	qsc_rhx_pmac_state ctx;
+
+	qsc_rhx_pmac_initialize(&ctx, keyparams, ctype);
+	qsc_rhx_pmac_update(&ctx, message, msglen);
+	qsc_rhx_pmac_finalize(&ctx, output);
+	qsc_rhx_pmac_dispose(&ctx);
+}
+
+void qsc_rhx_pmac_dispose(qsc_rhx_pmac_state* ctx)
+{
+	if (ctx != NULL)
+	{
+		qsc_rhx_dispose(&ctx->cstate);
+		qsc_memutils_clear((uint8_t*)ctx->ltable, sizeof(ctx->ltable));
+		qsc_memutils_clear(ctx->linv, sizeof(ctx->linv));
+		qsc_memutils_clear(ctx->offset, sizeof(ctx->offset));
+		qsc_memutils_clear(ctx->sum, sizeof(ctx->sum));
+		qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
+		ctx->position = 0;
+		ctx->counter = 0;
+	}
+}
+
+void qsc_rhx_pmac_finalize(qsc_rhx_pmac_state* ctx, uint8_t* output)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+
+	if (ctx->position == QSC_RHX_BLOCK_SIZE)
+	{
+		/* a complete final block is offset by L(-1) */
+		qsc_memutils_xor(ctx->sum, ctx->buffer, QSC_RHX_BLOCK_SIZE);
+		qsc_memutils_xor(ctx->sum, ctx->linv, QSC_RHX_BLOCK_SIZE);
+	}
+	else
+	{
+		/* a partial final block is padded with 10* */
+		qsc_memutils_clear((uint8_t*)(ctx->buffer + ctx->position), QSC_RHX_BLOCK_SIZE - ctx->position);
+		ctx->buffer[ctx->position] = 0x80;
+		qsc_memutils_xor(ctx->sum, ctx->buffer, QSC_RHX_BLOCK_SIZE);
+	}
+
+	qsc_rhx_ecb_encrypt_block(&ctx->cstate, output, ctx->sum);
+
+	/* reset the message state, the key is retained */
+	qsc_memutils_clear(ctx->offset, sizeof(ctx->offset));
+	qsc_memutils_clear(ctx->sum, sizeof(ctx->sum));
+	qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
+	ctx->position = 0;
+	ctx->counter = 0;
+}
+
+void qsc_rhx_pmac_initialize(qsc_rhx_pmac_state* ctx, const qsc_rhx_keyparams* keyparams, qsc_rhx_cipher_type ctype)
+{
+	assert(ctx != NULL);
+	assert(keyparams != NULL);
+
+	const uint8_t zero[QSC_RHX_BLOCK_SIZE] = { 0 };
+	size_t i;
+
+	qsc_rhx_initialize(&ctx->cstate, keyparams, true, ctype);
+
+	/* L = E(0), precompute L(i) = L * x^i and L(-1) = L * x^-1 */
+	qsc_rhx_ecb_encrypt_block(&ctx->cstate, ctx->ltable[0], zero);
+
+	for (i = 1; i < QSC_RHX_PMAC_LTABLE_SIZE; ++i)
+	{
+		rhx_pmac_double(ctx->ltable[i], ctx->ltable[i - 1]);
+	}
+
+	rhx_pmac_halve(ctx->linv, ctx->ltable[0]);
+
+	qsc_memutils_clear(ctx->offset, sizeof(ctx->offset));
+	qsc_memutils_clear(ctx->sum, sizeof(ctx->sum));
+	qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
+	ctx->position = 0;
+	ctx->counter = 0;
+}
+
+void qsc_rhx_pmac_update(qsc_rhx_pmac_state* ctx, const uint8_t* message, size_t msglen)
+{
+	assert(ctx != NULL);
+	assert(message != NULL || msglen == 0);
+
+	size_t blocks;
+	size_t oft;
+	size_t rmd;
+
+	oft = 0;
+
+	/* the last block is always held in the buffer for finalize */
+	if (ctx->position != 0 && ctx->position + msglen > QSC_RHX_BLOCK_SIZE)
+	{
+		rmd = QSC_RHX_BLOCK_SIZE - ctx->position;
+
+		if (rmd != 0)
+		{
+			qsc_memutils_copy((uint8_t*)(ctx->buffer + ctx->position), message, rmd);
+		}
+
+		rhx_pmac_process(ctx, ctx->buffer, 1);
+		ctx->position = 0;
+		oft = rmd;
+		msglen -= rmd;
+	}
+
+	if (ctx->position == 0 && msglen > QSC_RHX_BLOCK_SIZE)
+	{
+		blocks = (msglen - 1) / QSC_RHX_BLOCK_SIZE;
+		rhx_pmac_process(ctx, (uint8_t*)(message + oft), blocks);
+		oft += blocks * QSC_RHX_BLOCK_SIZE;
+		msglen -= blocks * QSC_RHX_BLOCK_SIZE;
+	}
+
+	if (msglen != 0)
+	{
+		qsc_memutils_copy((uint8_t*)(ctx->buffer + ctx->position), (uint8_t*)(message + oft), msglen);
+		ctx->position += msglen;
+	}
+}
+
+/* pkcs7 padding */
+
+void qsc_pkcs7_add_padding(uint8_t* input, size_t length)
+{
+	assert(input != NULL);
+
+	const size_t PADOFT = QSC_RHX_BLOCK_SIZE - length;
+	uint8_t code;
+	uint8_t cond;
+	size_t i;
+
+	code = (uint8_t)length;
+
+	for (i = 0; i < QSC_RHX_BLOCK_SIZE; ++i)
+	{
+		cond = i >= PADOFT ? 0xFF : 0x00;
+		input[i] ^= cond & code;
+	}
+}
+
+size_t qsc_pkcs7_padding_length(const uint8_t* input)
+{
+	assert(input != NULL);
+
 	uint8_t code;
 	int32_t i;
 	size_t len;
@@ -1760,6 +2272,25 @@ static void rhx_hba256_finalize(qsc_rhx_hba256_state* state, uint8_t* output)
 #endif
 }
 
+static bool rhx_hba256_associated_finalize(qsc_rhx_hba256_state* state)
+{
+	bool res;
+
+	res = (state->aadlen <= HBA_AAD_MAX_LENGTH);
+
+	if (res == true && state->aadlen != 0)
+	{
+		uint8_t actr[sizeof(uint32_t)] = { 0 };
+
+		/* 1.1a encode with the ad size */
+		qsc_intutils_le32to8(actr, (uint32_t)state->aadlen);
+		rhx_hba256_update(state, actr, sizeof(actr));
+		state->aadlen = 0;
+	}
+
+	return res;
+}
+
 static void rhx_hba256_genkeys(const qsc_rhx_keyparams* keyparams, uint8_t* cprk, uint8_t* mack)
 {
 #if defined(QSC_RHX_SHAKE_EXTENSION)
@@ -1821,7 +2352,9 @@ void qsc_rhx_hba256_dispose(qsc_rhx_hba256_state* state)
 
 		if (state->cust != NULL)
 		{
-			qsc_memutils_clear(state->cust, sizeof(state->cust));
+			qsc_memutils_clear(state->cust, state->custlen);
+			qsc_memutils_alloc_free(state->cust);
+			state->cust = NULL;
 		}
 
 		if (state->mkey != NULL)
@@ -1831,43 +2364,70 @@ void qsc_rhx_hba256_dispose(qsc_rhx_hba256_state* state)
 
 		state->counter = 0;
 		state->custlen = 0;
+		state->aadlen = 0;
 		state->encrypt = false;
 	}
 }
 
-void qsc_rhx_hba256_initialize(qsc_rhx_hba256_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt)
+bool qsc_rhx_hba256_initialize(qsc_rhx_hba256_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt)
 {
 	uint8_t cprk[QSC_RHX256_KEY_SIZE] = { 0 };
+	size_t clen;
+	bool res;
+
+	res = true;
 
-	state->custlen = qsc_intutils_min(keyparams->infolen, sizeof(state->cust));
+	state->cust = NULL;
+	state->custlen = 0;
+	state->aadlen = 0;
+	state->counter = 0;
+	state->encrypt = false;
 
-	if (state->custlen != 0)
+	/* the customization string is stored out of line, the ratchet uses at most the first 256 bytes of info */
+	clen = qsc_intutils_min(keyparams->infolen, (size_t)HBA_INFO_MAX_LENGTH);
+
+	if (clen != 0)
 	{
-		qsc_memutils_clear(state->cust, sizeof(state->cust));
-		qsc_memutils_copy(state->cust, keyparams->info, state->custlen);
+		state->cust = (uint8_t*)qsc_memutils_malloc(clen);
+
+		if (state->cust != NULL)
+		{
+			qsc_memutils_copy(state->cust, keyparams->info, clen);
+			state->custlen = clen;
+		}
+		else
+		{
+			/* the state is not keyed without the info, a mac generated without it would not be bound to the info */
+			res = false;
+		}
 	}
 
-	qsc_intutils_clear8(state->mkey, sizeof(state->mkey));
+	if (res == true)
+	{
+		qsc_intutils_clear8(state->mkey, sizeof(state->mkey));
 
-	/* generate the cipher and mac keys */
-	rhx_hba256_genkeys(keyparams, cprk, state->mkey);
+		/* generate the cipher and mac keys */
+		rhx_hba256_genkeys(keyparams, cprk, state->mkey);
 
-	/* initialize the mac state */
+		/* initialize the mac state */
 #if defined(QSC_RHX_SHAKE_EXTENSION)
-	qsc_kmac_initialize(&state->kstate, QSC_KECCAK_256_RATE, state->mkey, HBA256_MKEY_LENGTH, NULL, 0);
+		qsc_kmac_initialize(&state->kstate, QSC_KECCAK_256_RATE, state->mkey, HBA256_MKEY_LENGTH, NULL, 0);
 #else
-	qsc_hmac256_initialize(&state->kstate, state->mkey, HBA256_MKEY_LENGTH);
+		qsc_hmac256_initialize(&state->kstate, state->mkey, HBA256_MKEY_LENGTH);
 #endif
 
-	/* initialize the key parameters struct, info is optional */
-	qsc_rhx_keyparams kp = { cprk, QSC_RHX256_KEY_SIZE, keyparams->nonce, keyparams->info, keyparams->infolen };
-	/* initialize the cipher state */
-	qsc_rhx_initialize(&state->cstate, &kp, true, RHX256);
+		/* initialize the key parameters struct, info is optional */
+		qsc_rhx_keyparams kp = { cprk, QSC_RHX256_KEY_SIZE, keyparams->nonce, keyparams->info, keyparams->infolen };
+		/* initialize the cipher state */
+		qsc_rhx_initialize(&state->cstate, &kp, true, RHX256);
+
+		/* populate the hba state structure with mac-key and counter */
+		/* the state counter always initializes at 1 */
+		state->counter = 1;
+		state->encrypt = encrypt;
+	}
 
-	/* populate the hba state structure with mac-key and counter */
-	/* the state counter always initializes at 1 */
-	state->counter = 1;
-	state->encrypt = encrypt;
+	return res;
 }
 
 void qsc_rhx_hba256_set_associated(qsc_rhx_hba256_state* state, const uint8_t* data, size_t datalen)
@@ -1876,57 +2436,84 @@ void qsc_rhx_hba256_set_associated(qsc_rhx_hba256_state* state, const uint8_t* d
 	assert(data != NULL);
 
 	/* process the additional data */
-	if (datalen != 0)
-	{
-		uint8_t actr[sizeof(uint32_t)] = { 0 };
-
-		/* add the additional data to the mac */
-		rhx_hba256_update(state, data, datalen);
-		/* 1.1a encode with the ad size */
-		qsc_intutils_le32to8(actr, (uint32_t)datalen);
-		rhx_hba256_update(state, actr, sizeof(actr));
-	}
+	qsc_rhx_hba256_update_associated(state, data, datalen);
+	rhx_hba256_associated_finalize(state);
 }
 
-bool qsc_rhx_hba256_transform(qsc_rhx_hba256_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
+bool qsc_rhx_hba256_update_associated(qsc_rhx_hba256_state* state, const uint8_t* data, size_t datalen)
 {
+	assert(state != NULL);
+	assert(data != NULL || datalen == 0);
+	assert(state->aadlen <= HBA_AAD_MAX_LENGTH && (uint64_t)datalen <= HBA_AAD_MAX_LENGTH - state->aadlen);
+
 	bool res;
 
 	res = false;
 
-	/* update the processed bytes counter */
-	state->counter += inputlen;
-
-	if (state->encrypt)
+	/* the length is encoded in 32 bits, a longer string would share the encoding of a shorter one */
+	if (state->aadlen <= HBA_AAD_MAX_LENGTH && (uint64_t)datalen <= HBA_AAD_MAX_LENGTH - state->aadlen)
 	{
-		/* update the mac with the nonce */
-		rhx_hba256_update(state, state->cstate.nonce, QSC_RHX_BLOCK_SIZE);
-		/* use rhx counter-mode to encrypt the array */
-		qsc_rhx_ctrle_transform(&state->cstate, output, input, inputlen);
-		/* update the mac with the cipher-text */
-		rhx_hba256_update(state, output, inputlen);
-		/* mac the cipher-text appending the code to the end of the array */
-		rhx_hba256_finalize(state, (uint8_t*)(output + inputlen));
+		if (datalen != 0)
+		{
+			/* add the additional data to the mac */
+			rhx_hba256_update(state, data, datalen);
+			state->aadlen += datalen;
+		}
+
 		res = true;
 	}
 	else
 	{
-		uint8_t code[QSC_HBA256_MAC_LENGTH] = { 0 };
+		/* the segment is not absorbed, and the next transform fails */
+		state->aadlen = HBA_AAD_REJECTED;
+	}
 
-		/* update the mac with the nonce */
-		rhx_hba256_update(state, state->cstate.nonce, QSC_RHX_BLOCK_SIZE);
-		/* update the mac with the cipher-text */
-		rhx_hba256_update(state, input, inputlen);
-		/* mac the cipher-text to the mac */
-		rhx_hba256_finalize(state, code);
+	return res;
+}
 
-		/* test the mac for equality, bypassing the transform if the mac check fails */
-		if (qsc_intutils_verify(code, (uint8_t*)(input + inputlen), QSC_HBA256_MAC_LENGTH) == 0)
+bool qsc_rhx_hba256_transform(qsc_rhx_hba256_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
+{
+	bool res;
+
+	res = false;
+
+	/* encode the length of any streamed associated data, a rejected associated data string fails the transform */
+	if (rhx_hba256_associated_finalize(state) == true)
+	{
+		/* update the processed bytes counter */
+		state->counter += inputlen;
+
+		if (state->encrypt)
 		{
-			/* use rhx counter-mode to decrypt the array */
+			/* update the mac with the nonce */
+			rhx_hba256_update(state, state->cstate.nonce, QSC_RHX_BLOCK_SIZE);
+			/* use rhx counter-mode to encrypt the array */
 			qsc_rhx_ctrle_transform(&state->cstate, output, input, inputlen);
+			/* update the mac with the cipher-text */
+			rhx_hba256_update(state, output, inputlen);
+			/* mac the cipher-text appending the code to the end of the array */
+			rhx_hba256_finalize(state, (uint8_t*)(output + inputlen));
 			res = true;
 		}
+		else
+		{
+			uint8_t code[QSC_HBA256_MAC_LENGTH] = { 0 };
+
+			/* update the mac with the nonce */
+			rhx_hba256_update(state, state->cstate.nonce, QSC_RHX_BLOCK_SIZE);
+			/* update the mac with the cipher-text */
+			rhx_hba256_update(state, input, inputlen);
+			/* mac the cipher-text to the mac */
+			rhx_hba256_finalize(state, code);
+
+			/* test the mac for equality, bypassing the transform if the mac check fails */
+			if (qsc_intutils_verify(code, (uint8_t*)(input + inputlen), QSC_HBA256_MAC_LENGTH) == 0)
+			{
+				/* use rhx counter-mode to decrypt the array */
+				qsc_rhx_ctrle_transform(&state->cstate, output, input, inputlen);
+				res = true;
+			}
+		}
 	}
 
 	return res;
@@ -1997,6 +2584,25 @@ static void rhx_hba512_finalize(qsc_rhx_hba512_state* state, uint8_t* output)
 #endif
 }
 
+static bool rhx_hba512_associated_finalize(qsc_rhx_hba512_state* state)
+{
+	bool res;
+
+	res = (state->aadlen <= HBA_AAD_MAX_LENGTH);
+
+	if (res == true && state->aadlen != 0)
+	{
+		uint8_t actr[sizeof(uint32_t)] = { 0 };
+
+		/* 1.1a encode with the ad size */
+		qsc_intutils_le32to8(actr, (uint32_t)state->aadlen);
+		rhx_hba512_update(state, actr, sizeof(actr));
+		state->aadlen = 0;
+	}
+
+	return res;
+}
+
 static void rhx_hba512_genkeys(const qsc_rhx_keyparams* keyparams, uint8_t* cprk, uint8_t* mack)
 {
 #if defined(QSC_RHX_SHAKE_EXTENSION)
@@ -2059,7 +2665,9 @@ void qsc_rhx_hba512_dispose(qsc_rhx_hba512_state* state)
 
 		if (state->cust != NULL)
 		{
-			qsc_memutils_clear(state->cust, sizeof(state->cust));
+			qsc_memutils_clear(state->cust, state->custlen);
+			qsc_memutils_alloc_free(state->cust);
+			state->cust = NULL;
 		}
 
 		if (state->mkey != NULL)
@@ -2069,43 +2677,70 @@ void qsc_rhx_hba512_dispose(qsc_rhx_hba512_state* state)
 
 		state->counter = 0;
 		state->custlen = 0;
+		state->aadlen = 0;
 		state->encrypt = false;
 	}
 }
 
-void qsc_rhx_hba512_initialize(qsc_rhx_hba512_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt)
+bool qsc_rhx_hba512_initialize(qsc_rhx_hba512_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt)
 {
 	uint8_t cprk[QSC_RHX512_KEY_SIZE] = { 0 };
+	size_t clen;
+	bool res;
+
+	res = true;
 
-	state->custlen = qsc_intutils_min(keyparams->infolen, sizeof(state->cust));
+	state->cust = NULL;
+	state->custlen = 0;
+	state->aadlen = 0;
+	state->counter = 0;
+	state->encrypt = false;
 
-	if (state->custlen != 0)
+	/* the customization string is stored out of line, the ratchet uses at most the first 256 bytes of info */
+	clen = qsc_intutils_min(keyparams->infolen, (size_t)HBA_INFO_MAX_LENGTH);
+
+	if (clen != 0)
 	{
-		qsc_memutils_clear(state->cust, sizeof(state->cust));
-		qsc_memutils_copy(state->cust, keyparams->info, state->custlen);
+		state->cust = (uint8_t*)qsc_memutils_malloc(clen);
+
+		if (state->cust != NULL)
+		{
+			qsc_memutils_copy(state->cust, keyparams->info, clen);
+			state->custlen = clen;
+		}
+		else
+		{
+			/* the state is not keyed without the info, a mac generated without it would not be bound to the info */
+			res = false;
+		}
 	}
 
-	qsc_intutils_clear8(state->mkey, sizeof(state->mkey));
+	if (res == true)
+	{
+		qsc_intutils_clear8(state->mkey, sizeof(state->mkey));
 
-	/* generate the cipher and mac keys */
-	rhx_hba512_genkeys(keyparams, cprk, state->mkey);
+		/* generate the cipher and mac keys */
+		rhx_hba512_genkeys(keyparams, cprk, state->mkey);
 
-	/* initialize the mac state */
+		/* initialize the mac state */
 #if defined(QSC_RHX_SHAKE_EXTENSION)
-	qsc_kmac_initialize(&state->kstate, QSC_KECCAK_512_RATE, state->mkey, HBA512_MKEY_LENGTH, NULL, 0);
+		qsc_kmac_initialize(&state->kstate, QSC_KECCAK_512_RATE, state->mkey, HBA512_MKEY_LENGTH, NULL, 0);
 #else
-	qsc_hmac512_initialize(&state->kstate, state->mkey, HBA512_MKEY_LENGTH);
+		qsc_hmac512_initialize(&state->kstate, state->mkey, HBA512_MKEY_LENGTH);
 #endif
 
-	/* initialize the key parameters struct, info is optional */
-	qsc_rhx_keyparams kp = { cprk, QSC_RHX512_KEY_SIZE, keyparams->nonce, keyparams->info, keyparams->infolen };
-	/* initialize the cipher state */
-	qsc_rhx_initialize(&state->cstate, &kp, true, RHX512);
+		/* initialize the key parameters struct, info is optional */
+		qsc_rhx_keyparams kp = { cprk, QSC_RHX512_KEY_SIZE, keyparams->nonce, keyparams->info, keyparams->infolen };
+		/* initialize the cipher state */
+		qsc_rhx_initialize(&state->cstate, &kp, true, RHX512);
+
+		/* populate the hba state structure with mac-key and counter */
+		/* the state counter always initializes at 1 */
+		state->counter = 1;
+		state->encrypt = encrypt;
+	}
 
-	/* populate the hba state structure with mac-key and counter */
-	/* the state counter always initializes at 1 */
-	state->counter = 1;
-	state->encrypt = encrypt;
+	return res;
 }
 
 void qsc_rhx_hba512_set_associated(qsc_rhx_hba512_state* state, const uint8_t* data, size_t datalen)
@@ -2114,16 +2749,39 @@ void qsc_rhx_hba512_set_associated(qsc_rhx_hba512_state* state, const uint8_t* d
 	assert(data != NULL);
 
 	/* process the additional data */
-	if (datalen != 0)
+	qsc_rhx_hba512_update_associated(state, data, datalen);
+	rhx_hba512_associated_finalize(state);
+}
+
+bool qsc_rhx_hba512_update_associated(qsc_rhx_hba512_state* state, const uint8_t* data, size_t datalen)
+{
+	assert(state != NULL);
+	assert(data != NULL || datalen == 0);
+	assert(state->aadlen <= HBA_AAD_MAX_LENGTH && (uint64_t)datalen <= HBA_AAD_MAX_LENGTH - state->aadlen);
+
+	bool res;
+
+	res = false;
+
+	/* the length is encoded in 32 bits, a longer string would share the encoding of a shorter one */
+	if (state->aadlen <= HBA_AAD_MAX_LENGTH && (uint64_t)datalen <= HBA_AAD_MAX_LENGTH - state->aadlen)
 	{
-		uint8_t actr[sizeof(uint32_t)] = { 0 };
+		if (datalen != 0)
+		{
+			/* add the additional data to the mac */
+			rhx_hba512_update(state, data, datalen);
+			state->aadlen += datalen;
+		}
 
-		/* add the additional data to the mac */
-		rhx_hba512_update(state, data, datalen);
-		/* 1.1a encode with the ad size */
-		qsc_intutils_le32to8(actr, (uint32_t)datalen);
-		rhx_hba512_update(state, actr, sizeof(actr));
+		res = true;
 	}
+	else
+	{
+		/* the segment is not absorbed, and the next transform fails */
+		state->aadlen = HBA_AAD_REJECTED;
+	}
+
+	return res;
 }
 
 bool qsc_rhx_hba512_transform(qsc_rhx_hba512_state* state, uint8_t* output, const uint8_t* input, size_t inputlen)
@@ -2132,40 +2790,332 @@ bool qsc_rhx_hba512_transform(qsc_rhx_hba512_state* state, uint8_t* output, cons
 
 	res = false;
 
-	/* update the processed bytes counter */
-	state->counter += inputlen;
+	/* encode the length of any streamed associated data, a rejected associated data string fails the transform */
+	if (rhx_hba512_associated_finalize(state) == true)
+	{
+		/* update the processed bytes counter */
+		state->counter += inputlen;
+
+		if (state->encrypt)
+		{
+			/* update the mac with the nonce */
+			rhx_hba512_update(state, state->cstate.nonce, QSC_RHX_BLOCK_SIZE);
+			/* use rhx counter-mode to encrypt the array */
+			qsc_rhx_ctrle_transform(&state->cstate, output, input, inputlen);
+			/* update the mac with the cipher-text */
+			rhx_hba512_update(state, output, inputlen);
+			/* mac the cipher-text appending the code to the end of the array */
+			rhx_hba512_finalize(state, (uint8_t*)(output + inputlen));
+			res = true;
+		}
+		else
+		{
+			uint8_t code[QSC_HBA512_MAC_LENGTH] = { 0 };
+
+			/* update the mac with the nonce */
+			rhx_hba512_update(state, state->cstate.nonce, QSC_RHX_BLOCK_SIZE);
+			/* update the mac with the cipher-text */
+			rhx_hba512_update(state, (uint8_t*)input, inputlen);
+			/* mac the cipher-text to the mac */
+			rhx_hba512_finalize(state, code);
+
+			/* test the mac for equality, bypassing the transform if the mac check fails */
+			if (qsc_intutils_verify(code, (uint8_t*)(input + inputlen), QSC_HBA512_MAC_LENGTH) == 0)
+			{
+				/* use rhx counter-mode to decrypt the array */
+				qsc_rhx_ctrle_transform(&state->cstate, output, input, inputlen);
+				res = true;
+			}
+		}
+	}
 
-	if (state->encrypt)
+	return res;
+}
+
+/* hba record layer */
+
+static void rhx_hba_record_nonce(uint8_t* nonce, const uint8_t* iv, uint64_t sequence)
+{
+	uint8_t seq[sizeof(uint64_t)] = { 0 };
+
+	/* the sequence occupies the high 64 bits, the ctr mode block counter increments the low 64 bits */
+	qsc_memutils_copy(nonce, iv, QSC_RHX_BLOCK_SIZE);
+	qsc_intutils_le64to8(seq, sequence);
+	qsc_memutils_xor((uint8_t*)(nonce + sizeof(uint64_t)), seq, sizeof(seq));
+}
+
+void qsc_rhx_hba_header_deserialize(qsc_rhx_hba_record_header* header, const uint8_t* input)
+{
+	assert(header != NULL);
+	assert(input != NULL);
+
+	header->sequence = qsc_intutils_le8to64(input);
+	header->length = qsc_intutils_le8to32((uint8_t*)(input + sizeof(uint64_t)));
+}
+
+void qsc_rhx_hba_header_serialize(uint8_t* output, const qsc_rhx_hba_record_header* header)
+{
+	assert(output != NULL);
+	assert(header != NULL);
+
+	qsc_intutils_le64to8(output, header->sequence);
+	qsc_intutils_le32to8((uint8_t*)(output + sizeof(uint64_t)), header->length);
+}
+
+/* hba-256 record layer */
+
+void qsc_rhx_hba256_session_dispose(qsc_rhx_hba256_session* session)
+{
+	if (session != NULL)
 	{
-		/* update the mac with the nonce */
-		rhx_hba512_update(state, state->cstate.nonce, QSC_RHX_BLOCK_SIZE);
-		/* use rhx counter-mode to encrypt the array */
-		qsc_rhx_ctrle_transform(&state->cstate, output, input, inputlen);
-		/* update the mac with the cipher-text */
-		rhx_hba512_update(state, output, inputlen);
-		/* mac the cipher-text appending the code to the end of the array */
-		rhx_hba512_finalize(state, (uint8_t*)(output + inputlen));
-		res = true;
+		qsc_rhx_hba256_dispose(&session->hba);
+		qsc_memutils_clear(session->iv, sizeof(session->iv));
+		qsc_memutils_clear(session->nonce, sizeof(session->nonce));
+		session->sequence = 0;
 	}
-	else
+}
+
+bool qsc_rhx_hba256_session_initialize(qsc_rhx_hba256_session* session, const qsc_rhx_keyparams* keyparams, bool encrypt)
+{
+	assert(session != NULL);
+	assert(keyparams != NULL);
+
+	qsc_memutils_clear(session->iv, sizeof(session->iv));
+
+	if (keyparams->nonce != NULL)
 	{
-		uint8_t code[QSC_HBA512_MAC_LENGTH] = { 0 };
+		qsc_memutils_copy(session->iv, keyparams->nonce, QSC_RHX_BLOCK_SIZE);
+	}
 
-		/* update the mac with the nonce */
-		rhx_hba512_update(state, state->cstate.nonce, QSC_RHX_BLOCK_SIZE);
-		/* update the mac with the cipher-text */
-		rhx_hba512_update(state, (uint8_t*)input, inputlen);
-		/* mac the cipher-text to the mac */
-		rhx_hba512_finalize(state, code);
+	rhx_hba_record_nonce(session->nonce, session->iv, 0);
+	session->sequence = 0;
+
+	/* the cipher state references the session owned nonce */
+	qsc_rhx_keyparams kp = { keyparams->key, keyparams->keylen, session->nonce, keyparams->info, keyparams->infolen };
+
+	return qsc_rhx_hba256_initialize(&session->hba, &kp, encrypt);
+}
 
-		/* test the mac for equality, bypassing the transform if the mac check fails */
-		if (qsc_intutils_verify(code, (uint8_t*)(input + inputlen), QSC_HBA512_MAC_LENGTH) == 0)
+bool qsc_rhx_hba256_record_open(qsc_rhx_hba256_session* session, uint8_t* output, size_t* outputlen, const uint8_t* input, size_t inputlen)
+{
+	assert(session != NULL);
+	assert(output != NULL);
+	assert(outputlen != NULL);
+	assert(input != NULL);
+
+	qsc_rhx_hba_record_header hdr;
+	bool res;
+
+	res = false;
+	*outputlen = 0;
+
+	if (session->hba.encrypt == false && inputlen >= QSC_HBA256_RECORD_OVERHEAD)
+	{
+		qsc_rhx_hba_header_deserialize(&hdr, input);
+
+		if (hdr.sequence == session->sequence && (size_t)hdr.length == inputlen - QSC_HBA256_RECORD_OVERHEAD)
 		{
-			/* use rhx counter-mode to decrypt the array */
-			qsc_rhx_ctrle_transform(&state->cstate, output, input, inputlen);
-			res = true;
+			rhx_hba_record_nonce(session->nonce, session->iv, session->sequence);
+			session->hba.cstate.nonce = session->nonce;
+			/* the header is authenticated as associated data */
+			qsc_rhx_hba256_set_associated(&session->hba, input, QSC_HBA_RECORD_HEADER_SIZE);
+			res = qsc_rhx_hba256_transform(&session->hba, output, (uint8_t*)(input + QSC_HBA_RECORD_HEADER_SIZE), hdr.length);
+			++session->sequence;
+
+			if (res == true)
+			{
+				*outputlen = hdr.length;
+			}
 		}
 	}
 
 	return res;
 }
+
+bool qsc_rhx_hba256_record_seal(qsc_rhx_hba256_session* session, uint8_t* output, const uint8_t* input, size_t inputlen)
+{
+	assert(session != NULL);
+	assert(output != NULL);
+	assert(input != NULL || inputlen == 0);
+
+	qsc_rhx_hba_record_header hdr;
+	bool res;
+
+	res = false;
+
+	if (session->hba.encrypt == true && inputlen <= UINT32_MAX)
+	{
+		hdr.sequence = session->sequence;
+		hdr.length = (uint32_t)inputlen;
+		qsc_rhx_hba_header_serialize(output, &hdr);
+
+		rhx_hba_record_nonce(session->nonce, session->iv, session->sequence);
+		session->hba.cstate.nonce = session->nonce;
+		/* the header is authenticated as associated data */
+		qsc_rhx_hba256_set_associated(&session->hba, output, QSC_HBA_RECORD_HEADER_SIZE);
+		res = qsc_rhx_hba256_transform(&session->hba, (uint8_t*)(output + QSC_HBA_RECORD_HEADER_SIZE), input, inputlen);
+		++session->sequence;
+	}
+
+	return res;
+}
+
+size_t qsc_rhx_hba256_record_seal_batch(qsc_rhx_hba256_session* session, uint8_t* output, const qsc_rhx_hba_record* records, size_t count)
+{
+	assert(session != NULL);
+	assert(output != NULL);
+	assert(records != NULL);
+
+	size_t i;
+	size_t oft;
+	bool res;
+
+	oft = 0;
+	res = session->hba.encrypt;
+
+	/* validate the queue before sealing so a rejected batch does not consume sequence numbers */
+	for (i = 0; i < count && res == true; ++i)
+	{
+		res = (records[i].msglen <= UINT32_MAX && (records[i].message != NULL || records[i].msglen == 0));
+	}
+
+	if (res == true)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			qsc_rhx_hba256_record_seal(session, (uint8_t*)(output + oft), records[i].message, records[i].msglen);
+			oft += records[i].msglen + QSC_HBA256_RECORD_OVERHEAD;
+		}
+	}
+
+	return oft;
+}
+
+/* hba-512 record layer */
+
+void qsc_rhx_hba512_session_dispose(qsc_rhx_hba512_session* session)
+{
+	if (session != NULL)
+	{
+		qsc_rhx_hba512_dispose(&session->hba);
+		qsc_memutils_clear(session->iv, sizeof(session->iv));
+		qsc_memutils_clear(session->nonce, sizeof(session->nonce));
+		session->sequence = 0;
+	}
+}
+
+bool qsc_rhx_hba512_session_initialize(qsc_rhx_hba512_session* session, const qsc_rhx_keyparams* keyparams, bool encrypt)
+{
+	assert(session != NULL);
+	assert(keyparams != NULL);
+
+	qsc_memutils_clear(session->iv, sizeof(session->iv));
+
+	if (keyparams->nonce != NULL)
+	{
+		qsc_memutils_copy(session->iv, keyparams->nonce, QSC_RHX_BLOCK_SIZE);
+	}
+
+	rhx_hba_record_nonce(session->nonce, session->iv, 0);
+	session->sequence = 0;
+
+	/* the cipher state references the session owned nonce */
+	qsc_rhx_keyparams kp = { keyparams->key, keyparams->keylen, session->nonce, keyparams->info, keyparams->infolen };
+
+	return qsc_rhx_hba512_initialize(&session->hba, &kp, encrypt);
+}
+
+bool qsc_rhx_hba512_record_open(qsc_rhx_hba512_session* session, uint8_t* output, size_t* outputlen, const uint8_t* input, size_t inputlen)
+{
+	assert(session != NULL);
+	assert(output != NULL);
+	assert(outputlen != NULL);
+	assert(input != NULL);
+
+	qsc_rhx_hba_record_header hdr;
+	bool res;
+
+	res = false;
+	*outputlen = 0;
+
+	if (session->hba.encrypt == false && inputlen >= QSC_HBA512_RECORD_OVERHEAD)
+	{
+		qsc_rhx_hba_header_deserialize(&hdr, input);
+
+		if (hdr.sequence == session->sequence && (size_t)hdr.length == inputlen - QSC_HBA512_RECORD_OVERHEAD)
+		{
+			rhx_hba_record_nonce(session->nonce, session->iv, session->sequence);
+			session->hba.cstate.nonce = session->nonce;
+			/* the header is authenticated as associated data */
+			qsc_rhx_hba512_set_associated(&session->hba, input, QSC_HBA_RECORD_HEADER_SIZE);
+			res = qsc_rhx_hba512_transform(&session->hba, output, (uint8_t*)(input + QSC_HBA_RECORD_HEADER_SIZE), hdr.length);
+			++session->sequence;
+
+			if (res == true)
+			{
+				*outputlen = hdr.length;
+			}
+		}
+	}
+
+	return res;
+}
+
+bool qsc_rhx_hba512_record_seal(qsc_rhx_hba512_session* session, uint8_t* output, const uint8_t* input, size_t inputlen)
+{
+	assert(session != NULL);
+	assert(output != NULL);
+	assert(input != NULL || inputlen == 0);
+
+	qsc_rhx_hba_record_header hdr;
+	bool res;
+
+	res = false;
+
+	if (session->hba.encrypt == true && inputlen <= UINT32_MAX)
+	{
+		hdr.sequence = session->sequence;
+		hdr.length = (uint32_t)inputlen;
+		qsc_rhx_hba_header_serialize(output, &hdr);
+
+		rhx_hba_record_nonce(session->nonce, session->iv, session->sequence);
+		session->hba.cstate.nonce = session->nonce;
+		/* the header is authenticated as associated data */
+		qsc_rhx_hba512_set_associated(&session->hba, output, QSC_HBA_RECORD_HEADER_SIZE);
+		res = qsc_rhx_hba512_transform(&session->hba, (uint8_t*)(output + QSC_HBA_RECORD_HEADER_SIZE), input, inputlen);
+		++session->sequence;
+	}
+
+	return res;
+}
+
+size_t qsc_rhx_hba512_record_seal_batch(qsc_rhx_hba512_session* session, uint8_t* output, const qsc_rhx_hba_record* records, size_t count)
+{
+	assert(session != NULL);
+	assert(output != NULL);
+	assert(records != NULL);
+
+	size_t i;
+	size_t oft;
+	bool res;
+
+	oft = 0;
+	res = session->hba.encrypt;
+
+	/* validate the queue before sealing so a rejected batch does not consume sequence numbers */
+	for (i = 0; i < count && res == true; ++i)
+	{
+		res = (records[i].msglen <= UINT32_MAX && (records[i].message != NULL || records[i].msglen == 0));
+	}
+
+	if (res == true)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			qsc_rhx_hba512_record_seal(session, (uint8_t*)(output + oft), records[i].message, records[i].msglen);
+			oft += records[i].msglen + QSC_HBA512_RECORD_OVERHEAD;
+		}
+	}
+
+	return oft;
+}
@@ -317,18 +317,6 @@ QSC_EXPORT_API typedef enum
 */
 #define QSC_RHX512_KEY_SIZE 64
 
-/*!
-\def QSC_HBA_MAXAAD_SIZE
-* The maximum allowed AAD size.
-*/
-#define QSC_HBA_MAXAAD_SIZE 256
-
-/*!
-\def QSC_HBA_MAXINFO_SIZE
-* The maximum allowed key info size.
-*/
-#define QSC_HBA_MAXINFO_SIZE 256
-
 /*! \struct qsc_rhx_keyparams
 * The key parameters structure containing key and info arrays and lengths.
 * Use this structure to load an input cipher-key and optional info tweak, using the qsc_rhx_initialize function.
@@ -381,6 +369,21 @@ QSC_EXPORT_API void qsc_rhx_dispose(qsc_rhx_state* state);
 */
 QSC_EXPORT_API void qsc_rhx_initialize(qsc_rhx_state* state, const qsc_rhx_keyparams* keyparams, bool encryption, qsc_rhx_cipher_type ctype);
 
+/**
+* \brief Initialize an array of states from an array of input cipher-keys.
+* The RHX-256 and RHX-512 key schedules are generated 8 or 4 at a time using the parallel cSHAKE functions,
+* the round-key arrays are identical to those produced by qsc_rhx_initialize.
+* Keys are grouped in lanes only when adjacent keys share the same key size and info tweak,
+* remaining keys, the AES modes, and the HKDF extension are expanded sequentially.
+*
+* \param states: [struct] The array of qsc_rhx_state structures
+* \param keyparams: [const] The array of input cipher-keys, one for each state
+* \param count: The number of states and key parameter structures
+* \param encryption: Initialize the ciphers for encryption, false for decryption mode
+* \param ctype: The cipher type, shared by every state
+*/
+QSC_EXPORT_API void qsc_rhx_initialize_batch(qsc_rhx_state* states, const qsc_rhx_keyparams* keyparams, size_t count, bool encryption, qsc_rhx_cipher_type ctype);
+
 /* cbc mode */
 
 /**
@@ -501,6 +504,85 @@ QSC_EXPORT_API void qsc_rhx_ecb_decrypt_block(qsc_rhx_state* state, uint8_t* out
 */
 QSC_EXPORT_API void qsc_rhx_ecb_encrypt_block(qsc_rhx_state* state, uint8_t* output, const uint8_t* input);
 
+/* PMAC */
+
+/*!
+\def QSC_RHX_PMAC_LTABLE_SIZE
+* The number of precomputed L(i) offset multiples; one for each bit of the 64-bit block counter.
+*/
+#define QSC_RHX_PMAC_LTABLE_SIZE 64
+
+/*!
+\def QSC_RHX_PMAC_TAG_SIZE
+* The size in bytes of the PMAC authentication tag.
+*/
+#define QSC_RHX_PMAC_TAG_SIZE 16
+
+/*! \struct qsc_rhx_pmac_state
+* The PMAC state structure; the keyed cipher state, the precomputed offset multiples, the running offset and checksum, 
+* and the buffer holding the final message block.
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_rhx_state cstate;											/*!< the encryption cipher state */
+	uint8_t ltable[QSC_RHX_PMAC_LTABLE_SIZE][QSC_RHX_BLOCK_SIZE];	/*!< the L(i) offset multiples */
+	uint8_t linv[QSC_RHX_BLOCK_SIZE];								/*!< the L(-1) final block offset */
+	uint8_t offset[QSC_RHX_BLOCK_SIZE];								/*!< the running block offset */
+	uint8_t sum[QSC_RHX_BLOCK_SIZE];								/*!< the running checksum */
+	uint8_t buffer[QSC_RHX_BLOCK_SIZE];								/*!< the message buffer */
+	size_t position;												/*!< the number of bytes in the message buffer */
+	uint64_t counter;												/*!< the number of processed message blocks */
+} qsc_rhx_pmac_state;
+
+/**
+* \brief Compute a PMAC authentication tag with a single call.
+* Short form api: initializes the state, processes the message, and generates the tag.
+*
+* \param output: The output byte array; receives the QSC_RHX_PMAC_TAG_SIZE byte tag
+* \param message: [const] The input message array
+* \param msglen: The number of message bytes to process
+* \param keyparams: [const][struct] The key parameters, the nonce is not used
+* \param ctype: The cipher type; AES128, AES256, RHX256, or RHX512
+*/
+QSC_EXPORT_API void qsc_rhx_pmac_compute(uint8_t* output, const uint8_t* message, size_t msglen, const qsc_rhx_keyparams* keyparams, qsc_rhx_cipher_type ctype);
+
+/**
+* \brief Dispose of the PMAC state.
+*
+* \param ctx: [struct] The PMAC state structure
+*/
+QSC_EXPORT_API void qsc_rhx_pmac_dispose(qsc_rhx_pmac_state* ctx);
+
+/**
+* \brief Finalize the message and generate the PMAC authentication tag.
+* The message state is reset after the tag is generated, the key is retained so the state can authenticate another message.
+*
+* \param ctx: [struct] The PMAC state structure
+* \param output: The output byte array; receives the QSC_RHX_PMAC_TAG_SIZE byte tag
+*/
+QSC_EXPORT_API void qsc_rhx_pmac_finalize(qsc_rhx_pmac_state* ctx, uint8_t* output);
+
+/**
+* \brief Initialize the PMAC state with the cipher key.
+* Long form api: must be used in conjunction with the update and finalize functions.
+*
+* \param ctx: [struct] The PMAC state structure
+* \param keyparams: [const][struct] The key parameters, the nonce is not used
+* \param ctype: The cipher type; AES128, AES256, RHX256, or RHX512
+*/
+QSC_EXPORT_API void qsc_rhx_pmac_initialize(qsc_rhx_pmac_state* ctx, const qsc_rhx_keyparams* keyparams, qsc_rhx_cipher_type ctype);
+
+/**
+* \brief Update the PMAC with a segment of the message.
+* The message can be added in any number of segments of any size, 
+* complete blocks are encrypted in parallel batches on the AES-NI and AVX-512 code paths.
+*
+* \param ctx: [struct] The PMAC state structure
+* \param message: [const] The input message segment
+* \param msglen: The number of message bytes to process
+*/
+QSC_EXPORT_API void qsc_rhx_pmac_update(qsc_rhx_pmac_state* ctx, const uint8_t* message, size_t msglen);
+
 /* HBA-256 */
 
 /*! \struct qsc_rhx_hba256_state
@@ -517,8 +599,9 @@ QSC_EXPORT_API typedef struct
 	qsc_rhx_state cstate;				/*!< the underlying block-ciphers state structure */
 	uint64_t counter;					/*!< the processed bytes counter */
 	uint8_t mkey[32];					/*!< the mac generators key array */
-	uint8_t cust[QSC_HBA_MAXINFO_SIZE];	/*!< the ciphers custom key */
+	uint8_t* cust;						/*!< the ciphers custom key, the first 256 bytes of info allocated on the heap */
 	size_t custlen;						/*!< the custom key array length */
+	uint64_t aadlen;					/*!< the associated data length absorbed since the last transform */
 	bool encrypt;						/*!< the transformation mode; true for encryption */
 } qsc_rhx_hba256_state;
 
@@ -538,18 +621,22 @@ QSC_EXPORT_API void qsc_rhx_hba256_dispose(qsc_rhx_hba256_state* state);
 * Initializes the cipher state to an RHX-256 instance.
 *
 * \warning The initialize function must be called before either the associated data or transform functions are called.
+* The info array is copied to the heap, a state initialized with an info array must be disposed before it is re-initialized.
+* The MAC ratchet uses at most the first 256 bytes of the info array.
 *
 * \param state: [struct] The HBA state structure; contains internal state information
 * \param keyparams: [struct] The HBA key parameters, includes the key, and optional AAD and user info arrays
 * \param encrypt: The cipher encryption mode; true for encryption, false for decryption
+* \return: Returns false if the info array could not be copied, the state is not keyed
 */
-QSC_EXPORT_API void qsc_rhx_hba256_initialize(qsc_rhx_hba256_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt);
+QSC_EXPORT_API bool qsc_rhx_hba256_initialize(qsc_rhx_hba256_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt);
 
 /**
 * \brief Set the associated data string used in authenticating the message.
 * The associated data may be packet header information, domain specific data, or a secret shared by a group.
 * The associated data must be set after initialization, and before each transformation call.
 * The data is erased after each call to the transform.
+* The associated data length is limited to 2^32-1 bytes, a longer string causes the next transform to fail.
 *
 * \param state: [struct] The HBA-256 state structure; contains internal state information
 * \param data: [const] The associated data array
@@ -557,6 +644,22 @@ QSC_EXPORT_API void qsc_rhx_hba256_initialize(qsc_rhx_hba256_state* state, const
 */
 QSC_EXPORT_API void qsc_rhx_hba256_set_associated(qsc_rhx_hba256_state* state, const uint8_t* data, size_t datalen);
 
+/**
+* \brief Absorb a segment of the associated data string into the MAC.
+* The associated data can be added in any number of segments of any size, the segments are authenticated
+* as a single contiguous string, equivalent to a single call to the set associated function.
+* The associated data length is encoded by the next call to the transform function as a 32-bit integer,
+* so the total length of the segments between transforms is limited to 2^32-1 bytes.
+* A segment that would exceed the limit is rejected and the next transform fails;
+* the state must then be disposed and re-initialized.
+*
+* \param state: [struct] The HBA-256 state structure; contains internal state information
+* \param data: [const] The associated data segment
+* \param datalen: The associated data segment length
+* \return: Returns false if the segment was rejected
+*/
+QSC_EXPORT_API bool qsc_rhx_hba256_update_associated(qsc_rhx_hba256_state* state, const uint8_t* data, size_t datalen);
+
 /**
 * \brief Transform an array of bytes using an instance of RHX-256.
 * In encryption mode, the input plain-text is encrypted and then an authentication MAC code is appended to the ciphertext.
@@ -589,8 +692,9 @@ QSC_EXPORT_API typedef struct
 	qsc_rhx_state cstate;				/*!< the underlying block-ciphers state structure */
 	uint64_t counter;					/*!< the processed bytes counter */
 	uint8_t mkey[64];					/*!< the mac generators key array */
-	uint8_t cust[QSC_HBA_MAXINFO_SIZE];	/*!< the ciphers custom key */
+	uint8_t* cust;						/*!< the ciphers custom key, the first 256 bytes of info allocated on the heap */
 	size_t custlen;						/*!< the custom key array length */
+	uint64_t aadlen;					/*!< the associated data length absorbed since the last transform */
 	bool encrypt;						/*!< the transformation mode; true for encryption */
 } qsc_rhx_hba512_state;
 
@@ -610,18 +714,22 @@ QSC_EXPORT_API void qsc_rhx_hba512_dispose(qsc_rhx_hba512_state* state);
 * Initializes the cipher state to an RHX-512 instance.
 *
 * \warning The initialize function must be called before either the associated data or transform functions are called.
+* The info array is copied to the heap, a state initialized with an info array must be disposed before it is re-initialized.
+* The MAC ratchet uses at most the first 256 bytes of the info array.
 *
 * \param state: [struct] The HBA state structure; contains internal state information
 * \param keyparams: [struct] The HBA key parameters, includes the key, and optional AAD and user info arrays
 * \param encrypt: The cipher encryption mode; true for encryption, false for decryption
+* \return: Returns false if the info array could not be copied, the state is not keyed
 */
-QSC_EXPORT_API void qsc_rhx_hba512_initialize(qsc_rhx_hba512_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt);
+QSC_EXPORT_API bool qsc_rhx_hba512_initialize(qsc_rhx_hba512_state* state, const qsc_rhx_keyparams* keyparams, bool encrypt);
 
 /**
 * \brief Set the associated data string used in authenticating the message.
 * The associated data may be packet header information, domain specific data, or a secret shared by a group.
 * The associated data must be set after initialization, and before each transformation call.
 * The data is erased after each call to the transform.
+* The associated data length is limited to 2^32-1 bytes, a longer string causes the next transform to fail.
 *
 * \param state: [struct] The HBA-512 state structure; contains internal state information
 * \param data: [const] The associated data array
@@ -629,6 +737,22 @@ QSC_EXPORT_API void qsc_rhx_hba512_initialize(qsc_rhx_hba512_state* state, const
 */
 QSC_EXPORT_API void qsc_rhx_hba512_set_associated(qsc_rhx_hba512_state* state, const uint8_t* data, size_t datalen);
 
+/**
+* \brief Absorb a segment of the associated data string into the MAC.
+* The associated data can be added in any number of segments of any size, the segments are authenticated
+* as a single contiguous string, equivalent to a single call to the set associated function.
+* The associated data length is encoded by the next call to the transform function as a 32-bit integer,
+* so the total length of the segments between transforms is limited to 2^32-1 bytes.
+* A segment that would exceed the limit is rejected and the next transform fails;
+* the state must then be disposed and re-initialized.
+*
+* \param state: [struct] The HBA-512 state structure; contains internal state information
+* \param data: [const] The associated data segment
+* \param datalen: The associated data segment length
+* \return: Returns false if the segment was rejected
+*/
+QSC_EXPORT_API bool qsc_rhx_hba512_update_associated(qsc_rhx_hba512_state* state, const uint8_t* data, size_t datalen);
+
 /**
 * \brief Transform an array of bytes using an instance of RHX-512.
 * In encryption mode, the input plain-text is encrypted and then an authentication MAC code is appended to the ciphertext.
@@ -645,4 +769,208 @@ QSC_EXPORT_API void qsc_rhx_hba512_set_associated(qsc_rhx_hba512_state* state, c
 */
 QSC_EXPORT_API bool qsc_rhx_hba512_transform(qsc_rhx_hba512_state* state, uint8_t* output, const uint8_t* input, size_t inputlen);
 
+/* HBA record layer */
+
+/*!
+\def QSC_HBA_RECORD_HEADER_SIZE
+* The size in bytes of a serialized HBA record header; the 64-bit sequence number and 32-bit message length.
+*/
+#define QSC_HBA_RECORD_HEADER_SIZE 12
+
+/*!
+\def QSC_HBA256_RECORD_OVERHEAD
+* The number of bytes an HBA-256 record adds to a message; the record header and the MAC code.
+*/
+#define QSC_HBA256_RECORD_OVERHEAD (QSC_HBA_RECORD_HEADER_SIZE + QSC_HBA256_MAC_LENGTH)
+
+/*!
+\def QSC_HBA512_RECORD_OVERHEAD
+* The number of bytes an HBA-512 record adds to a message; the record header and the MAC code.
+*/
+#define QSC_HBA512_RECORD_OVERHEAD (QSC_HBA_RECORD_HEADER_SIZE + QSC_HBA512_MAC_LENGTH)
+
+/*! \struct qsc_rhx_hba_record_header
+* The HBA record header. 
+* The header is serialized as a little endian sequence number followed by the little endian message length,
+* and is authenticated as associated data by the record functions.
+*/
+QSC_EXPORT_API typedef struct
+{
+	uint64_t sequence;					/*!< the record sequence number */
+	uint32_t length;					/*!< the message length in bytes, excluding the header and MAC code */
+} qsc_rhx_hba_record_header;
+
+/*! \struct qsc_rhx_hba_record
+* A message queued for the batch seal functions.
+*/
+QSC_EXPORT_API typedef struct
+{
+	const uint8_t* message;				/*!< the plain-text message */
+	size_t msglen;						/*!< the message length in bytes */
+} qsc_rhx_hba_record;
+
+/*! \struct qsc_rhx_hba256_session
+* The HBA-256 record layer session.
+* The session owns the working nonce, each record nonce is the base nonce with the sequence number
+* xored into the high 64 bits, the low 64 bits are used as the records block counter.
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_rhx_hba256_state hba;			/*!< the HBA-256 cipher state */
+	uint8_t iv[QSC_RHX_BLOCK_SIZE];		/*!< the base nonce */
+	uint8_t nonce[QSC_RHX_BLOCK_SIZE];	/*!< the working nonce of the current record */
+	uint64_t sequence;					/*!< the sequence number of the next record */
+} qsc_rhx_hba256_session;
+
+/*! \struct qsc_rhx_hba512_session
+* The HBA-512 record layer session.
+* The session owns the working nonce, each record nonce is the base nonce with the sequence number
+* xored into the high 64 bits, the low 64 bits are used as the records block counter.
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_rhx_hba512_state hba;			/*!< the HBA-512 cipher state */
+	uint8_t iv[QSC_RHX_BLOCK_SIZE];		/*!< the base nonce */
+	uint8_t nonce[QSC_RHX_BLOCK_SIZE];	/*!< the working nonce of the current record */
+	uint64_t sequence;					/*!< the sequence number of the next record */
+} qsc_rhx_hba512_session;
+
+/**
+* \brief Deserialize a record header from the first QSC_HBA_RECORD_HEADER_SIZE bytes of a record.
+*
+* \param header: [struct] The record header structure; receives the header values
+* \param input: [const] The serialized record header
+*/
+QSC_EXPORT_API void qsc_rhx_hba_header_deserialize(qsc_rhx_hba_record_header* header, const uint8_t* input);
+
+/**
+* \brief Serialize a record header to a QSC_HBA_RECORD_HEADER_SIZE byte array.
+*
+* \param output: The output array; receives the serialized header
+* \param header: [const][struct] The record header structure
+*/
+QSC_EXPORT_API void qsc_rhx_hba_header_serialize(uint8_t* output, const qsc_rhx_hba_record_header* header);
+
+/**
+* \brief Dispose of the HBA-256 session
+*
+* \param session: [struct] The HBA-256 session structure
+*/
+QSC_EXPORT_API void qsc_rhx_hba256_session_dispose(qsc_rhx_hba256_session* session);
+
+/**
+* \brief Initialize an HBA-256 session and load the keying material.
+* The keyparams nonce is copied to the session as the base nonce, if the nonce is NULL, the base nonce is zero.
+* The sequence number starts at zero.
+*
+* \param session: [struct] The HBA-256 session structure
+* \param keyparams: [const][struct] The key parameters, includes the key, nonce, and optional info array
+* \param encrypt: The session mode; true to seal records, false to open records
+* \return: Returns false if the session state could not be keyed
+*/
+QSC_EXPORT_API bool qsc_rhx_hba256_session_initialize(qsc_rhx_hba256_session* session, const qsc_rhx_keyparams* keyparams, bool encrypt);
+
+/**
+* \brief Open an HBA-256 record.
+* The record header must carry the expected sequence number and a length consistent with the record size,
+* the header is authenticated with the cipher-text before the message is decrypted.
+*
+* \warning The record sequence is consumed whether or not the authentication check succeeds; an authentication failure should be treated as fatal to the session.
+*
+* \param session: [struct] The HBA-256 session structure initialized for decryption
+* \param output: The output array; receives the plain-text message, must be at least inputlen - QSC_HBA256_RECORD_OVERHEAD in length
+* \param outputlen: Receives the length of the plain-text message
+* \param input: [const] The record; the header, cipher-text and MAC code
+* \param inputlen: The length of the record in bytes
+*
+* \return: Returns true if the record was authenticated and decrypted
+*/
+QSC_EXPORT_API bool qsc_rhx_hba256_record_open(qsc_rhx_hba256_session* session, uint8_t* output, size_t* outputlen, const uint8_t* input, size_t inputlen);
+
+/**
+* \brief Seal a message as an HBA-256 record.
+* The output record is the serialized header, the cipher-text, and the MAC code.
+*
+* \param session: [struct] The HBA-256 session structure initialized for encryption
+* \param output: The output array; must be at least inputlen + QSC_HBA256_RECORD_OVERHEAD in length
+* \param input: [const] The plain-text message
+* \param inputlen: The length of the message in bytes
+*
+* \return: Returns true if the record was sealed
+*/
+QSC_EXPORT_API bool qsc_rhx_hba256_record_seal(qsc_rhx_hba256_session* session, uint8_t* output, const uint8_t* input, size_t inputlen);
+
+/**
+* \brief Seal a queue of messages as consecutive HBA-256 records in one contiguous output array.
+*
+* \param session: [struct] The HBA-256 session structure initialized for encryption
+* \param output: The output array; must be the sum of the message lengths plus count * QSC_HBA256_RECORD_OVERHEAD in length
+* \param records: [const][struct] The array of queued messages
+* \param count: The number of queued messages
+*
+* \return: Returns the number of bytes written to the output array, or zero on failure
+*/
+QSC_EXPORT_API size_t qsc_rhx_hba256_record_seal_batch(qsc_rhx_hba256_session* session, uint8_t* output, const qsc_rhx_hba_record* records, size_t count);
+
+/**
+* \brief Dispose of the HBA-512 session
+*
+* \param session: [struct] The HBA-512 session structure
+*/
+QSC_EXPORT_API void qsc_rhx_hba512_session_dispose(qsc_rhx_hba512_session* session);
+
+/**
+* \brief Initialize an HBA-512 session and load the keying material.
+* The keyparams nonce is copied to the session as the base nonce, if the nonce is NULL, the base nonce is zero.
+* The sequence number starts at zero.
+*
+* \param session: [struct] The HBA-512 session structure
+* \param keyparams: [const][struct] The key parameters, includes the key, nonce, and optional info array
+* \param encrypt: The session mode; true to seal records, false to open records
+* \return: Returns false if the session state could not be keyed
+*/
+QSC_EXPORT_API bool qsc_rhx_hba512_session_initialize(qsc_rhx_hba512_session* session, const qsc_rhx_keyparams* keyparams, bool encrypt);
+
+/**
+* \brief Open an HBA-512 record.
+* The record header must carry the expected sequence number and a length consistent with the record size,
+* the header is authenticated with the cipher-text before the message is decrypted.
+*
+* \warning The record sequence is consumed whether or not the authentication check succeeds; an authentication failure should be treated as fatal to the session.
+*
+* \param session: [struct] The HBA-512 session structure initialized for decryption
+* \param output: The output array; receives the plain-text message, must be at least inputlen - QSC_HBA512_RECORD_OVERHEAD in length
+* \param outputlen: Receives the length of the plain-text message
+* \param input: [const] The record; the header, cipher-text and MAC code
+* \param inputlen: The length of the record in bytes
+*
+* \return: Returns true if the record was authenticated and decrypted
+*/
+QSC_EXPORT_API bool qsc_rhx_hba512_record_open(qsc_rhx_hba512_session* session, uint8_t* output, size_t* outputlen, const uint8_t* input, size_t inputlen);
+
+/**
+* \brief Seal a message as an HBA-512 record.
+* The output record is the serialized header, the cipher-text, and the MAC code.
+*
+* \param session: [struct] The HBA-512 session structure initialized for encryption
+* \param output: The output array; must be at least inputlen + QSC_HBA512_RECORD_OVERHEAD in length
+* \param input: [const] The plain-text message
+* \param inputlen: The length of the message in bytes
+*
+* \return: Returns true if the record was sealed
+*/
+QSC_EXPORT_API bool qsc_rhx_hba512_record_seal(qsc_rhx_hba512_session* session, uint8_t* output, const uint8_t* input, size_t inputlen);
+
+/**
+* \brief Seal a queue of messages as consecutive HBA-512 records in one contiguous output array.
+*
+* \param session: [struct] The HBA-512 session structure initialized for encryption
+* \param output: The output array; must be the sum of the message lengths plus count * QSC_HBA512_RECORD_OVERHEAD in length
+* \param records: [const][struct] The array of queued messages
+* \param count: The number of queued messages
+*
+* \return: Returns the number of bytes written to the output array, or zero on failure
+*/
+QSC_EXPORT_API size_t qsc_rhx_hba512_record_seal_batch(qsc_rhx_hba512_session* session, uint8_t* output, const qsc_rhx_hba_record* records, size_t count);
+
 #endif
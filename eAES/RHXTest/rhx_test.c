@@ -10,8 +10,13 @@
 
 #define CTR_OUTPUT_LENGTH 33
 #define MONTE_CARLO_CYCLES 10000
+#define HBA_RECORD_COUNT 8
+#define HBA_STREAM_AAD_SIZE 4099
+#define HBA_STREAM_INFO_SIZE 1031
+#define HBA_STREAM_MSG_SIZE 211
 #define HBA_TEST_CYCLES 100
 #define RHX_TEST_CYCLES 100
+#define RHX_BATCH_COUNT 13
 
 
 static bool aes128_cbc_monte_carlo(const uint8_t* key, const uint8_t* iv, const uint8_t message[4][QSC_RHX_BLOCK_SIZE], const uint8_t expected[4][QSC_RHX_BLOCK_SIZE])
@@ -1629,6 +1634,7 @@ bool qsctest_hba_rhx256_kat()
 	/* reset the nonce for decryption */
 	memcpy(kp1.nonce, n1copy, QSC_RHX_BLOCK_SIZE);
 
+	qsc_rhx_hba256_dispose(&state);
 	qsc_rhx_hba256_initialize(&state, &kp1, false);
 	qsc_rhx_hba256_set_associated(&state, aad1, sizeof(aad1));
 
@@ -1645,6 +1651,7 @@ bool qsctest_hba_rhx256_kat()
 	/* second KAT vector */
 
 	const qsc_rhx_keyparams kp2 = { key, sizeof(key), nce2, NULL, 0 };
+	qsc_rhx_hba256_dispose(&state);
 	qsc_rhx_hba256_initialize(&state, &kp2, true);
 	qsc_rhx_hba256_set_associated(&state, aad2, sizeof(aad2));
 
@@ -1661,6 +1668,7 @@ bool qsctest_hba_rhx256_kat()
 	/* reset the nonce for decryption */
 	memcpy(kp2.nonce, n2copy, QSC_RHX_BLOCK_SIZE);
 
+	qsc_rhx_hba256_dispose(&state);
 	qsc_rhx_hba256_initialize(&state, &kp2, false);
 	qsc_rhx_hba256_set_associated(&state, aad2, sizeof(aad2));
 
@@ -1677,6 +1685,7 @@ bool qsctest_hba_rhx256_kat()
 	/* third KAT vector */
 
 	const qsc_rhx_keyparams kp3 = { key, sizeof(key), nce3, NULL, 0 };
+	qsc_rhx_hba256_dispose(&state);
 	qsc_rhx_hba256_initialize(&state, &kp3, true);
 	qsc_rhx_hba256_set_associated(&state, aad3, sizeof(aad3));
 
@@ -1693,6 +1702,7 @@ bool qsctest_hba_rhx256_kat()
 	/* reset the nonce for decryption */
 	memcpy(kp3.nonce, n3copy, QSC_RHX_BLOCK_SIZE);
 
+	qsc_rhx_hba256_dispose(&state);
 	qsc_rhx_hba256_initialize(&state, &kp3, false);
 	qsc_rhx_hba256_set_associated(&state, aad3, sizeof(aad3));
 
@@ -1706,6 +1716,8 @@ bool qsctest_hba_rhx256_kat()
 		status = false;
 	}
 
+	qsc_rhx_hba256_dispose(&state);
+
 	return status;
 }
 
@@ -1789,6 +1801,7 @@ bool qsctest_hba_rhx512_kat()
 	/* reset the nonce for decryption */
 	memcpy(kp1.nonce, n1copy, QSC_RHX_BLOCK_SIZE);
 
+	qsc_rhx_hba512_dispose(&state);
 	qsc_rhx_hba512_initialize(&state, &kp1, false);
 	qsc_rhx_hba512_set_associated(&state, aad1, sizeof(aad1));
 
@@ -1805,6 +1818,7 @@ bool qsctest_hba_rhx512_kat()
 	/* second KAT vector */
 
 	const qsc_rhx_keyparams kp2 = { key, sizeof(key), nce2, NULL, 0 };
+	qsc_rhx_hba512_dispose(&state);
 	qsc_rhx_hba512_initialize(&state, &kp2, true);
 	qsc_rhx_hba512_set_associated(&state, aad2, sizeof(aad2));
 
@@ -1821,6 +1835,7 @@ bool qsctest_hba_rhx512_kat()
 	/* reset the nonce for decryption */
 	memcpy(kp2.nonce, n2copy, QSC_RHX_BLOCK_SIZE);
 
+	qsc_rhx_hba512_dispose(&state);
 	qsc_rhx_hba512_initialize(&state, &kp2, false);
 	qsc_rhx_hba512_set_associated(&state, aad2, sizeof(aad2));
 
@@ -1837,6 +1852,7 @@ bool qsctest_hba_rhx512_kat()
 	/* third KAT vector */
 
 	const qsc_rhx_keyparams kp3 = { key, sizeof(key), nce3, NULL, 0 };
+	qsc_rhx_hba512_dispose(&state);
 	qsc_rhx_hba512_initialize(&state, &kp3, true);
 	qsc_rhx_hba512_set_associated(&state, aad3, sizeof(aad3));
 
@@ -1853,6 +1869,7 @@ bool qsctest_hba_rhx512_kat()
 	/* reset the nonce for decryption */
 	memcpy(kp3.nonce, n3copy, QSC_RHX_BLOCK_SIZE);
 
+	qsc_rhx_hba512_dispose(&state);
 	qsc_rhx_hba512_initialize(&state, &kp3, false);
 	qsc_rhx_hba512_set_associated(&state, aad3, sizeof(aad3));
 
@@ -1866,6 +1883,8 @@ bool qsctest_hba_rhx512_kat()
 		status = false;
 	}
 
+	qsc_rhx_hba512_dispose(&state);
+
 	return status;
 }
 
@@ -1932,6 +1951,7 @@ bool qsctest_hba_rhx256_stress()
 			memcpy(kp1.nonce, ncopy, QSC_RHX_BLOCK_SIZE);
 
 			/* decrypt the message */
+			qsc_rhx_hba256_dispose(&state);
 			qsc_rhx_hba256_initialize(&state, &kp1, false);
 			qsc_rhx_hba256_set_associated(&state, aad, sizeof(aad));
 
@@ -1946,6 +1966,8 @@ bool qsctest_hba_rhx256_stress()
 				status = false;
 			}
 
+			qsc_rhx_hba256_dispose(&state);
+
 			free(dec);
 			free(enc);
 			free(msg);
@@ -2025,6 +2047,7 @@ bool qsctest_hba_rhx512_stress()
 			memcpy(kp1.nonce, ncopy, QSC_RHX_BLOCK_SIZE);
 
 			/* decrypt the message */
+			qsc_rhx_hba512_dispose(&state);
 			qsc_rhx_hba512_initialize(&state, &kp1, false);
 			qsc_rhx_hba512_set_associated(&state, aad, sizeof(aad));
 
@@ -2039,6 +2062,8 @@ bool qsctest_hba_rhx512_stress()
 				status = false;
 			}
 
+			qsc_rhx_hba512_dispose(&state);
+
 			free(dec);
 			free(enc);
 			free(msg);
@@ -2055,6 +2080,693 @@ bool qsctest_hba_rhx512_stress()
 	return status;
 }
 
+bool qsctest_hba_rhx256_associated()
+{
+	uint8_t aad[HBA_STREAM_AAD_SIZE] = { 0 };
+	uint8_t dec[HBA_STREAM_MSG_SIZE] = { 0 };
+	uint8_t enc1[HBA_STREAM_MSG_SIZE + QSC_HBA256_MAC_LENGTH] = { 0 };
+	uint8_t enc2[HBA_STREAM_MSG_SIZE + QSC_HBA256_MAC_LENGTH] = { 0 };
+	uint8_t info[HBA_STREAM_INFO_SIZE] = { 0 };
+	uint8_t key[QSC_RHX256_KEY_SIZE] = { 0 };
+	uint8_t msg[HBA_STREAM_MSG_SIZE] = { 0 };
+	uint8_t ncopy[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t nonce[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t rnd[sizeof(uint16_t)] = { 0 };
+	qsc_rhx_hba256_state state;
+	size_t clen;
+	size_t oft;
+	bool status;
+
+	qsc_csp_generate(aad, sizeof(aad));
+	qsc_csp_generate(info, sizeof(info));
+	qsc_csp_generate(key, sizeof(key));
+	qsc_csp_generate(msg, sizeof(msg));
+	qsc_csp_generate(ncopy, sizeof(ncopy));
+	status = true;
+
+	/* the info array is longer than the previous fixed customization array */
+	qsc_rhx_keyparams kp = { key, sizeof(key), nonce, info, sizeof(info) };
+
+	/* encrypt with the associated data set in one call */
+	memcpy(nonce, ncopy, QSC_RHX_BLOCK_SIZE);
+	qsc_rhx_hba256_initialize(&state, &kp, true);
+	qsc_rhx_hba256_set_associated(&state, aad, sizeof(aad));
+	qsc_rhx_hba256_transform(&state, enc1, msg, sizeof(msg));
+	qsc_rhx_hba256_dispose(&state);
+
+	/* encrypt with the associated data streamed in random sized segments */
+	memcpy(nonce, ncopy, QSC_RHX_BLOCK_SIZE);
+	qsc_rhx_hba256_initialize(&state, &kp, true);
+	oft = 0;
+
+	while (oft < sizeof(aad))
+	{
+		qsc_csp_generate(rnd, sizeof(rnd));
+		clen = qsc_intutils_min((size_t)(rnd[0] | (rnd[1] << 8)) & 0x01FF, sizeof(aad) - oft);
+		qsc_rhx_hba256_update_associated(&state, (uint8_t*)(aad + oft), clen);
+		oft += clen;
+	}
+
+	qsc_rhx_hba256_transform(&state, enc2, msg, sizeof(msg));
+	qsc_rhx_hba256_dispose(&state);
+
+	if (qsc_intutils_are_equal8(enc1, enc2, sizeof(enc1)) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_hba_rhx256_associated: streamed and single call output are not equal -HA1 \n");
+		status = false;
+	}
+
+	/* decrypt with the associated data streamed in two segments */
+	memcpy(nonce, ncopy, QSC_RHX_BLOCK_SIZE);
+	qsc_rhx_hba256_initialize(&state, &kp, false);
+	qsc_rhx_hba256_update_associated(&state, aad, 1);
+	qsc_rhx_hba256_update_associated(&state, (uint8_t*)(aad + 1), sizeof(aad) - 1);
+
+	if (qsc_rhx_hba256_transform(&state, dec, enc2, sizeof(msg)) == false ||
+		qsc_intutils_are_equal8(dec, msg, sizeof(msg)) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_hba_rhx256_associated: decryption failed -HA2 \n");
+		status = false;
+	}
+
+	qsc_rhx_hba256_dispose(&state);
+
+	return status;
+}
+
+bool qsctest_hba_rhx512_associated()
+{
+	uint8_t aad[HBA_STREAM_AAD_SIZE] = { 0 };
+	uint8_t dec[HBA_STREAM_MSG_SIZE] = { 0 };
+	uint8_t enc1[HBA_STREAM_MSG_SIZE + QSC_HBA512_MAC_LENGTH] = { 0 };
+	uint8_t enc2[HBA_STREAM_MSG_SIZE + QSC_HBA512_MAC_LENGTH] = { 0 };
+	uint8_t info[HBA_STREAM_INFO_SIZE] = { 0 };
+	uint8_t key[QSC_RHX512_KEY_SIZE] = { 0 };
+	uint8_t msg[HBA_STREAM_MSG_SIZE] = { 0 };
+	uint8_t ncopy[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t nonce[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t rnd[sizeof(uint16_t)] = { 0 };
+	qsc_rhx_hba512_state state;
+	size_t clen;
+	size_t oft;
+	bool status;
+
+	qsc_csp_generate(aad, sizeof(aad));
+	qsc_csp_generate(info, sizeof(info));
+	qsc_csp_generate(key, sizeof(key));
+	qsc_csp_generate(msg, sizeof(msg));
+	qsc_csp_generate(ncopy, sizeof(ncopy));
+	status = true;
+
+	/* the info array is longer than the previous fixed customization array */
+	qsc_rhx_keyparams kp = { key, sizeof(key), nonce, info, sizeof(info) };
+
+	/* encrypt with the associated data set in one call */
+	memcpy(nonce, ncopy, QSC_RHX_BLOCK_SIZE);
+	qsc_rhx_hba512_initialize(&state, &kp, true);
+	qsc_rhx_hba512_set_associated(&state, aad, sizeof(aad));
+	qsc_rhx_hba512_transform(&state, enc1, msg, sizeof(msg));
+	qsc_rhx_hba512_dispose(&state);
+
+	/* encrypt with the associated data streamed in random sized segments */
+	memcpy(nonce, ncopy, QSC_RHX_BLOCK_SIZE);
+	qsc_rhx_hba512_initialize(&state, &kp, true);
+	oft = 0;
+
+	while (oft < sizeof(aad))
+	{
+		qsc_csp_generate(rnd, sizeof(rnd));
+		clen = qsc_intutils_min((size_t)(rnd[0] | (rnd[1] << 8)) & 0x01FF, sizeof(aad) - oft);
+		qsc_rhx_hba512_update_associated(&state, (uint8_t*)(aad + oft), clen);
+		oft += clen;
+	}
+
+	qsc_rhx_hba512_transform(&state, enc2, msg, sizeof(msg));
+	qsc_rhx_hba512_dispose(&state);
+
+	if (qsc_intutils_are_equal8(enc1, enc2, sizeof(enc1)) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_hba_rhx512_associated: streamed and single call output are not equal -HA1 \n");
+		status = false;
+	}
+
+	/* decrypt with the associated data streamed in two segments */
+	memcpy(nonce, ncopy, QSC_RHX_BLOCK_SIZE);
+	qsc_rhx_hba512_initialize(&state, &kp, false);
+	qsc_rhx_hba512_update_associated(&state, aad, 1);
+	qsc_rhx_hba512_update_associated(&state, (uint8_t*)(aad + 1), sizeof(aad) - 1);
+
+	if (qsc_rhx_hba512_transform(&state, dec, enc2, sizeof(msg)) == false ||
+		qsc_intutils_are_equal8(dec, msg, sizeof(msg)) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_hba_rhx512_associated: decryption failed -HA2 \n");
+		status = false;
+	}
+
+	qsc_rhx_hba512_dispose(&state);
+
+	return status;
+}
+
+bool qsctest_hba_rhx256_record()
+{
+	qsc_rhx_hba_record recs[HBA_RECORD_COUNT];
+	uint8_t* msgs[HBA_RECORD_COUNT] = { NULL };
+	uint8_t key[QSC_RHX256_KEY_SIZE] = { 0 };
+	uint8_t nonce[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	uint8_t* bout;
+	uint8_t* dec;
+	uint8_t* sout;
+	qsc_rhx_hba256_session sdec;
+	qsc_rhx_hba256_session senc;
+	size_t blen;
+	size_t declen;
+	size_t i;
+	size_t oft;
+	size_t tlen;
+	uint16_t mlen;
+	bool status;
+
+	qsctest_hex_to_bin("000102030405060708090A0B0C0D0E0F000102030405060708090A0B0C0D0E0F", key, sizeof(key));
+	qsctest_hex_to_bin("FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F0", nonce, sizeof(nonce));
+
+	status = true;
+	tlen = 0;
+
+	for (i = 0; i < HBA_RECORD_COUNT; ++i)
+	{
+		/* random sized messages 0-1023, the first record is empty */
+		mlen = 0;
+
+		if (i != 0)
+		{
+			qsc_csp_generate(pmcnt, sizeof(pmcnt));
+			memcpy(&mlen, pmcnt, sizeof(uint16_t));
+			mlen &= 0x03FF;
+		}
+
+		msgs[i] = (uint8_t*)malloc(mlen + 1);
+
+		if (msgs[i] != NULL)
+		{
+			qsc_csp_generate(msgs[i], mlen + 1);
+		}
+		else
+		{
+			status = false;
+		}
+
+		recs[i].message = msgs[i];
+		recs[i].msglen = mlen;
+		tlen += mlen + QSC_HBA256_RECORD_OVERHEAD;
+	}
+
+	bout = (uint8_t*)malloc(tlen);
+	sout = (uint8_t*)malloc(tlen);
+	dec = (uint8_t*)malloc(0x0400);
+
+	if (status == true && bout != NULL && sout != NULL && dec != NULL)
+	{
+		qsc_rhx_keyparams kp = { key, sizeof(key), nonce, NULL, 0 };
+
+		/* seal the queue in one call */
+		qsc_rhx_hba256_session_initialize(&senc, &kp, true);
+		blen = qsc_rhx_hba256_record_seal_batch(&senc, bout, recs, HBA_RECORD_COUNT);
+
+		if (blen != tlen || senc.sequence != HBA_RECORD_COUNT)
+		{
+			qsctest_print_safe("Failure! qsctest_hba_rhx256_record: batch length is incorrect -HR1 \n");
+			status = false;
+		}
+
+		/* seal the records individually and compare to the batch output */
+		qsc_rhx_hba256_session_initialize(&senc, &kp, true);
+		oft = 0;
+
+		for (i = 0; i < HBA_RECORD_COUNT; ++i)
+		{
+			if (qsc_rhx_hba256_record_seal(&senc, (uint8_t*)(sout + oft), recs[i].message, recs[i].msglen) == false)
+			{
+				status = false;
+			}
+
+			oft += recs[i].msglen + QSC_HBA256_RECORD_OVERHEAD;
+		}
+
+		if (qsc_intutils_are_equal8(bout, sout, tlen) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_hba_rhx256_record: batch and sequential output are not equal -HR2 \n");
+			status = false;
+		}
+
+		/* a record must not be opened out of sequence */
+		qsc_rhx_hba256_session_initialize(&sdec, &kp, false);
+
+		if (qsc_rhx_hba256_record_open(&sdec, dec, &declen, (uint8_t*)(bout + QSC_HBA256_RECORD_OVERHEAD), recs[1].msglen + QSC_HBA256_RECORD_OVERHEAD) == true)
+		{
+			qsctest_print_safe("Failure! qsctest_hba_rhx256_record: out of sequence record was accepted -HR3 \n");
+			status = false;
+		}
+
+		/* open the records in order */
+		oft = 0;
+
+		for (i = 0; i < HBA_RECORD_COUNT; ++i)
+		{
+			if (qsc_rhx_hba256_record_open(&sdec, dec, &declen, (uint8_t*)(bout + oft), recs[i].msglen + QSC_HBA256_RECORD_OVERHEAD) == false ||
+				declen != recs[i].msglen || qsc_intutils_are_equal8(dec, recs[i].message, declen) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_hba_rhx256_record: record decryption failed -HR4 \n");
+				status = false;
+			}
+
+			oft += recs[i].msglen + QSC_HBA256_RECORD_OVERHEAD;
+		}
+
+		/* a modified cipher-text must fail authentication */
+		qsc_rhx_hba256_session_initialize(&sdec, &kp, false);
+		sout[QSC_HBA_RECORD_HEADER_SIZE] ^= 0x01;
+
+		if (qsc_rhx_hba256_record_open(&sdec, dec, &declen, sout, recs[0].msglen + QSC_HBA256_RECORD_OVERHEAD) == true)
+		{
+			qsctest_print_safe("Failure! qsctest_hba_rhx256_record: modified record was accepted -HR5 \n");
+			status = false;
+		}
+
+		qsc_rhx_hba256_session_dispose(&sdec);
+		qsc_rhx_hba256_session_dispose(&senc);
+	}
+	else
+	{
+		status = false;
+	}
+
+	for (i = 0; i < HBA_RECORD_COUNT; ++i)
+	{
+		free(msgs[i]);
+	}
+
+	free(bout);
+	free(dec);
+	free(sout);
+
+	return status;
+}
+
+bool qsctest_hba_rhx512_record()
+{
+	qsc_rhx_hba_record recs[HBA_RECORD_COUNT];
+	uint8_t* msgs[HBA_RECORD_COUNT] = { NULL };
+	uint8_t key[QSC_RHX512_KEY_SIZE] = { 0 };
+	uint8_t nonce[QSC_RHX_BLOCK_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	uint8_t* bout;
+	uint8_t* dec;
+	uint8_t* sout;
+	qsc_rhx_hba512_session sdec;
+	qsc_rhx_hba512_session senc;
+	size_t blen;
+	size_t declen;
+	size_t i;
+	size_t oft;
+	size_t tlen;
+	uint16_t mlen;
+	bool status;
+
+	qsctest_hex_to_bin("000102030405060708090A0B0C0D0E0F000102030405060708090A0B0C0D0E0F000102030405060708090A0B0C0D0E0F000102030405060708090A0B0C0D0E0F", key, sizeof(key));
+	qsctest_hex_to_bin("FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F0", nonce, sizeof(nonce));
+
+	status = true;
+	tlen = 0;
+
+	for (i = 0; i < HBA_RECORD_COUNT; ++i)
+	{
+		/* random sized messages 0-1023, the first record is empty */
+		mlen = 0;
+
+		if (i != 0)
+		{
+			qsc_csp_generate(pmcnt, sizeof(pmcnt));
+			memcpy(&mlen, pmcnt, sizeof(uint16_t));
+			mlen &= 0x03FF;
+		}
+
+		msgs[i] = (uint8_t*)malloc(mlen + 1);
+
+		if (msgs[i] != NULL)
+		{
+			qsc_csp_generate(msgs[i], mlen + 1);
+		}
+		else
+		{
+			status = false;
+		}
+
+		recs[i].message = msgs[i];
+		recs[i].msglen = mlen;
+		tlen += mlen + QSC_HBA512_RECORD_OVERHEAD;
+	}
+
+	bout = (uint8_t*)malloc(tlen);
+	sout = (uint8_t*)malloc(tlen);
+	dec = (uint8_t*)malloc(0x0400);
+
+	if (status == true && bout != NULL && sout != NULL && dec != NULL)
+	{
+		qsc_rhx_keyparams kp = { key, sizeof(key), nonce, NULL, 0 };
+
+		/* seal the queue in one call */
+		qsc_rhx_hba512_session_initialize(&senc, &kp, true);
+		blen = qsc_rhx_hba512_record_seal_batch(&senc, bout, recs, HBA_RECORD_COUNT);
+
+		if (blen != tlen || senc.sequence != HBA_RECORD_COUNT)
+		{
+			qsctest_print_safe("Failure! qsctest_hba_rhx512_record: batch length is incorrect -HR1 \n");
+			status = false;
+		}
+
+		/* seal the records individually and compare to the batch output */
+		qsc_rhx_hba512_session_initialize(&senc, &kp, true);
+		oft = 0;
+
+		for (i = 0; i < HBA_RECORD_COUNT; ++i)
+		{
+			if (qsc_rhx_hba512_record_seal(&senc, (uint8_t*)(sout + oft), recs[i].message, recs[i].msglen) == false)
+			{
+				status = false;
+			}
+
+			oft += recs[i].msglen + QSC_HBA512_RECORD_OVERHEAD;
+		}
+
+		if (qsc_intutils_are_equal8(bout, sout, tlen) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_hba_rhx512_record: batch and sequential output are not equal -HR2 \n");
+			status = false;
+		}
+
+		/* a record must not be opened out of sequence */
+		qsc_rhx_hba512_session_initialize(&sdec, &kp, false);
+
+		if (qsc_rhx_hba512_record_open(&sdec, dec, &declen, (uint8_t*)(bout + QSC_HBA512_RECORD_OVERHEAD), recs[1].msglen + QSC_HBA512_RECORD_OVERHEAD) == true)
+		{
+			qsctest_print_safe("Failure! qsctest_hba_rhx512_record: out of sequence record was accepted -HR3 \n");
+			status = false;
+		}
+
+		/* open the records in order */
+		oft = 0;
+
+		for (i = 0; i < HBA_RECORD_COUNT; ++i)
+		{
+			if (qsc_rhx_hba512_record_open(&sdec, dec, &declen, (uint8_t*)(bout + oft), recs[i].msglen + QSC_HBA512_RECORD_OVERHEAD) == false ||
+				declen != recs[i].msglen || qsc_intutils_are_equal8(dec, recs[i].message, declen) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_hba_rhx512_record: record decryption failed -HR4 \n");
+				status = false;
+			}
+
+			oft += recs[i].msglen + QSC_HBA512_RECORD_OVERHEAD;
+		}
+
+		/* a modified cipher-text must fail authentication */
+		qsc_rhx_hba512_session_initialize(&sdec, &kp, false);
+		sout[QSC_HBA_RECORD_HEADER_SIZE] ^= 0x01;
+
+		if (qsc_rhx_hba512_record_open(&sdec, dec, &declen, sout, recs[0].msglen + QSC_HBA512_RECORD_OVERHEAD) == true)
+		{
+			qsctest_print_safe("Failure! qsctest_hba_rhx512_record: modified record was accepted -HR5 \n");
+			status = false;
+		}
+
+		qsc_rhx_hba512_session_dispose(&sdec);
+		qsc_rhx_hba512_session_dispose(&senc);
+	}
+	else
+	{
+		status = false;
+	}
+
+	for (i = 0; i < HBA_RECORD_COUNT; ++i)
+	{
+		free(msgs[i]);
+	}
+
+	free(bout);
+	free(dec);
+	free(sout);
+
+	return status;
+}
+
+static bool rhx_pmac_compare(const uint8_t* key, size_t keylen, qsc_rhx_cipher_type ctype, const uint8_t* message, size_t msglen, const char* expected)
+{
+	uint8_t exp[QSC_RHX_PMAC_TAG_SIZE] = { 0 };
+	uint8_t otp[QSC_RHX_PMAC_TAG_SIZE] = { 0 };
+	qsc_rhx_pmac_state ctx;
+	size_t i;
+	bool status;
+
+	qsctest_hex_to_bin(expected, exp, sizeof(exp));
+	status = true;
+
+	qsc_rhx_keyparams kp = { key, keylen, NULL, NULL, 0 };
+
+	/* test the short form api */
+	qsc_rhx_pmac_compute(otp, message, msglen, &kp, ctype);
+
+	if (qsc_intutils_are_equal8(otp, exp, sizeof(exp)) == false)
+	{
+		status = false;
+	}
+
+	/* test the long form api, one byte at a time */
+	qsc_rhx_pmac_initialize(&ctx, &kp, ctype);
+
+	for (i = 0; i < msglen; ++i)
+	{
+		qsc_rhx_pmac_update(&ctx, (uint8_t*)(message + i), 1);
+	}
+
+	qsc_rhx_pmac_finalize(&ctx, otp);
+	qsc_rhx_pmac_dispose(&ctx);
+
+	if (qsc_intutils_are_equal8(otp, exp, sizeof(exp)) == false)
+	{
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_rhx_pmac_kat()
+{
+	uint8_t key[QSC_RHX512_KEY_SIZE] = { 0 };
+	uint8_t msg[1000] = { 0 };
+	size_t i;
+	bool status;
+
+	/* PMAC1 reference vectors; the key and message are counting bytes */
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)i;
+	}
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)i;
+	}
+
+	status = true;
+
+	/* aes-128 */
+	status &= rhx_pmac_compare(key, 16, AES128, msg, 0, "4399572CD6EA5341B8D35876A7098AF7");
+	status &= rhx_pmac_compare(key, 16, AES128, msg, 3, "256BA5193C1B991B4DF0C51F388A9E27");
+	status &= rhx_pmac_compare(key, 16, AES128, msg, 16, "EBBD822FA458DAF6DFDAD7C27DA76338");
+	status &= rhx_pmac_compare(key, 16, AES128, msg, 20, "0412CA150BBF79058D8C75A58C993F55");
+	status &= rhx_pmac_compare(key, 16, AES128, msg, 32, "E97AC04E9E5E3399CE5355CD7407BC75");
+	status &= rhx_pmac_compare(key, 16, AES128, msg, 34, "5CBA7D5EB24F7C86CCC54604E53D5512");
+
+	/* aes-256 */
+	status &= rhx_pmac_compare(key, 32, AES256, msg, 0, "E620F52FE75BBE87AB758C0624943D8B");
+	status &= rhx_pmac_compare(key, 32, AES256, msg, 3, "FFE124CC152CFB2BF1EF5409333C1C9A");
+	status &= rhx_pmac_compare(key, 32, AES256, msg, 16, "853FDBF3F91DCD36380D698A64770BAB");
+	status &= rhx_pmac_compare(key, 32, AES256, msg, 20, "7711395FBE9DEC19861AEB96E052CD1B");
+	status &= rhx_pmac_compare(key, 32, AES256, msg, 32, "08FA25C28678C84D383130653E77F4C0");
+	status &= rhx_pmac_compare(key, 32, AES256, msg, 34, "EDD8A05F4B66761F9EEE4FEB4ED0C3A1");
+
+	/* the 1000 byte message exercises the 16 and 8 block parallel paths */
+	status &= rhx_pmac_compare(key, 16, AES128, msg, 1000, "01CC3529FCB42950D4327116B06DCBA7");
+	status &= rhx_pmac_compare(key, 32, AES256, msg, 1000, "80F202C5BA2F9F947C21E79D6296018B");
+
+	/* rhx-256 and rhx-512 */
+#if defined(QSC_RHX_SHAKE_EXTENSION)
+	status &= rhx_pmac_compare(key, QSC_RHX256_KEY_SIZE, RHX256, msg, 0, "C82BB11D646080DBCFFF7691BB1C6070");
+	status &= rhx_pmac_compare(key, QSC_RHX256_KEY_SIZE, RHX256, msg, 34, "52B1F8358E68E198CCC4DA8635AF079A");
+	status &= rhx_pmac_compare(key, QSC_RHX256_KEY_SIZE, RHX256, msg, 1000, "441A46CCEE92C7F2132B1F752AAB217B");
+	status &= rhx_pmac_compare(key, QSC_RHX512_KEY_SIZE, RHX512, msg, 0, "AFD4E627F86873678C9964EEFC3BFEA7");
+	status &= rhx_pmac_compare(key, QSC_RHX512_KEY_SIZE, RHX512, msg, 34, "E0E7B7AAAB2EC22EEADCE8181CE5571D");
+	status &= rhx_pmac_compare(key, QSC_RHX512_KEY_SIZE, RHX512, msg, 1000, "F65983AE1F325DC4BABF0A9528609451");
+#else
+	/* HKDF extension */
+	status &= rhx_pmac_compare(key, QSC_RHX256_KEY_SIZE, RHX256, msg, 0, "5702FD736D8E1F1124CBE621175F7037");
+	status &= rhx_pmac_compare(key, QSC_RHX256_KEY_SIZE, RHX256, msg, 34, "CA94180E768B1BB429297433019B68F5");
+	status &= rhx_pmac_compare(key, QSC_RHX256_KEY_SIZE, RHX256, msg, 1000, "CA7ADE0F674B094CE00186CC42DC2931");
+	status &= rhx_pmac_compare(key, QSC_RHX512_KEY_SIZE, RHX512, msg, 0, "206072B51CDF5ECB0E8746136B28C719");
+	status &= rhx_pmac_compare(key, QSC_RHX512_KEY_SIZE, RHX512, msg, 34, "81EECCD726922862CE0E3D4718CAF146");
+	status &= rhx_pmac_compare(key, QSC_RHX512_KEY_SIZE, RHX512, msg, 1000, "B79907F7AF9699F8370C6E7BB73CF14C");
+#endif
+
+	return status;
+}
+
+bool qsctest_rhx_pmac_stress()
+{
+	uint8_t key[QSC_RHX512_KEY_SIZE] = { 0 };
+	uint8_t otp1[QSC_RHX_PMAC_TAG_SIZE] = { 0 };
+	uint8_t otp2[QSC_RHX_PMAC_TAG_SIZE] = { 0 };
+	uint8_t otp3[QSC_RHX_PMAC_TAG_SIZE] = { 0 };
+	uint8_t rnd[sizeof(uint16_t)] = { 0 };
+	uint8_t* msg;
+	qsc_rhx_pmac_state ctx;
+	size_t clen;
+	size_t mlen;
+	size_t oft;
+	size_t tctr;
+	bool status;
+
+	status = true;
+
+	qsc_csp_generate(key, sizeof(key));
+	qsc_rhx_keyparams kp = { key, QSC_RHX512_KEY_SIZE, NULL, NULL, 0 };
+
+	for (tctr = 0; tctr < RHX_TEST_CYCLES; ++tctr)
+	{
+		/* use a random sized message 0-4095 */
+		qsc_csp_generate(rnd, sizeof(rnd));
+		mlen = (size_t)(rnd[0] | (rnd[1] << 8)) & 0x0FFF;
+		msg = (uint8_t*)malloc(mlen + 1);
+
+		if (msg != NULL)
+		{
+			qsc_csp_generate(msg, mlen + 1);
+			qsc_rhx_pmac_compute(otp1, msg, mlen, &kp, RHX512);
+
+			/* add the message in random sized segments */
+			qsc_rhx_pmac_initialize(&ctx, &kp, RHX512);
+			oft = 0;
+
+			while (oft < mlen)
+			{
+				qsc_csp_generate(rnd, sizeof(rnd));
+				clen = qsc_intutils_min((size_t)(rnd[0] | (rnd[1] << 8)) & 0x01FF, mlen - oft);
+				qsc_rhx_pmac_update(&ctx, (uint8_t*)(msg + oft), clen);
+				oft += clen;
+			}
+
+			qsc_rhx_pmac_finalize(&ctx, otp2);
+
+			/* the finalized state retains the key and is reused */
+			qsc_rhx_pmac_update(&ctx, msg, mlen);
+			qsc_rhx_pmac_finalize(&ctx, otp3);
+			qsc_rhx_pmac_dispose(&ctx);
+
+			if (qsc_intutils_are_equal8(otp1, otp2, sizeof(otp1)) == false ||
+				qsc_intutils_are_equal8(otp1, otp3, sizeof(otp1)) == false)
+			{
+				status = false;
+			}
+
+			free(msg);
+		}
+		else
+		{
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
+static bool rhx_batch_compare(size_t keylen, qsc_rhx_cipher_type ctype, bool encryption)
+{
+	uint8_t key[RHX_BATCH_COUNT][QSC_RHX512_KEY_SIZE] = { 0 };
+	uint8_t info[16] = { 0 };
+	qsc_rhx_keyparams kp[RHX_BATCH_COUNT];
+	qsc_rhx_state state1[RHX_BATCH_COUNT];
+	qsc_rhx_state state2;
+	size_t i;
+	bool status;
+
+	status = true;
+	qsc_csp_generate(info, sizeof(info));
+
+	for (i = 0; i < RHX_BATCH_COUNT; ++i)
+	{
+		qsc_csp_generate(key[i], keylen);
+		kp[i].key = key[i];
+		kp[i].keylen = keylen;
+		kp[i].nonce = NULL;
+		/* the last key uses a unique tweak, forcing a sequential expansion */
+		kp[i].info = info;
+		kp[i].infolen = (i == RHX_BATCH_COUNT - 1) ? sizeof(info) / 2 : sizeof(info);
+	}
+
+	qsc_rhx_initialize_batch(state1, kp, RHX_BATCH_COUNT, encryption, ctype);
+
+	for (i = 0; i < RHX_BATCH_COUNT; ++i)
+	{
+		qsc_rhx_initialize(&state2, &kp[i], encryption, ctype);
+
+		if (state1[i].roundkeylen != state2.roundkeylen || state1[i].rounds != state2.rounds ||
+			qsc_intutils_are_equal8((uint8_t*)state1[i].roundkeys, (uint8_t*)state2.roundkeys, sizeof(state2.roundkeys)) == false)
+		{
+			status = false;
+		}
+
+		qsc_rhx_dispose(&state1[i]);
+		qsc_rhx_dispose(&state2);
+	}
+
+	return status;
+}
+
+bool qsctest_rhx_batch_equality()
+{
+	bool status;
+
+	status = true;
+
+	/* 13 keys exercise the 8 lane, 4 lane, and sequential paths */
+	if (rhx_batch_compare(QSC_RHX256_KEY_SIZE, RHX256, true) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_rhx_batch_equality: RHX-256 encryption round-keys do not match -RB1 \n");
+		status = false;
+	}
+
+	if (rhx_batch_compare(QSC_RHX256_KEY_SIZE, RHX256, false) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_rhx_batch_equality: RHX-256 decryption round-keys do not match -RB2 \n");
+		status = false;
+	}
+
+	if (rhx_batch_compare(QSC_RHX512_KEY_SIZE, RHX512, true) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_rhx_batch_equality: RHX-512 encryption round-keys do not match -RB3 \n");
+		status = false;
+	}
+
+	if (rhx_batch_compare(QSC_RHX512_KEY_SIZE, RHX512, false) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_rhx_batch_equality: RHX-512 decryption round-keys do not match -RB4 \n");
+		status = false;
+	}
+
+	return status;
+}
+
 bool qsctest_rhx_padding_test()
 {
 	uint8_t iv[QSC_RHX_BLOCK_SIZE] = { 0 };
@@ -2325,6 +3037,69 @@ void qsctest_rhx_run()
 		qsctest_print_safe("Failure! Failed the RHX-512 HBA AEAD mode stress test. \n");
 	}
 
+	if (qsctest_hba_rhx256_associated() == true)
+	{
+		qsctest_print_safe("Success! Passed the RHX-256 HBA streamed associated data test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the RHX-256 HBA streamed associated data test. \n");
+	}
+
+	if (qsctest_hba_rhx512_associated() == true)
+	{
+		qsctest_print_safe("Success! Passed the RHX-512 HBA streamed associated data test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the RHX-512 HBA streamed associated data test. \n");
+	}
+
+	if (qsctest_hba_rhx256_record() == true)
+	{
+		qsctest_print_safe("Success! Passed the RHX-256 HBA record layer test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the RHX-256 HBA record layer test. \n");
+	}
+
+	if (qsctest_hba_rhx512_record() == true)
+	{
+		qsctest_print_safe("Success! Passed the RHX-512 HBA record layer test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the RHX-512 HBA record layer test. \n");
+	}
+
+	if (qsctest_rhx_pmac_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the PMAC(AES/RHX) KAT test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the PMAC(AES/RHX) KAT test. \n");
+	}
+
+	if (qsctest_rhx_pmac_stress() == true)
+	{
+		qsctest_print_safe("Success! Passed the PMAC(RHX-512) stress test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the PMAC(RHX-512) stress test. \n");
+	}
+
+	if (qsctest_rhx_batch_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the RHX batched key schedule equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the RHX batched key schedule equality test. \n");
+	}
+
 	if (qsctest_rhx_padding_test() == true)
 	{
 		qsctest_print_safe("Success! Passed the PKCS7 padding mode stress test. \n");
@@ -231,6 +231,59 @@ bool qsctest_hba_rhx256_stress();
 */
 bool qsctest_hba_rhx512_stress();
 
+/**
+* \brief Tests the HBA-RHX256 associated data streaming; segmented and single call associated data must produce identical output.
+*
+* \return Returns true for success
+*/
+bool qsctest_hba_rhx256_associated();
+
+/**
+* \brief Tests the HBA-RHX512 associated data streaming; segmented and single call associated data must produce identical output.
+*
+* \return Returns true for success
+*/
+bool qsctest_hba_rhx512_associated();
+
+/**
+* \brief Tests the HBA-RHX256 record layer; batch and sequential sealing equality, sequence enforcement, and authentication.
+*
+* \return Returns true for success
+*/
+bool qsctest_hba_rhx256_record();
+
+/**
+* \brief Tests the HBA-RHX512 record layer; batch and sequential sealing equality, sequence enforcement, and authentication.
+*
+* \return Returns true for success
+*/
+bool qsctest_hba_rhx512_record();
+
+/**
+* \brief Tests the PMAC mode with AES-128, AES-256, RHX-256 and RHX-512 known answer vectors.
+* The short form api, and the long form api with single byte updates, are compared to the expected output.
+*
+* \return Returns true for success
+*
+* \remarks <b>Test References:</b> \n
+* AES vectors from the PMAC1 reference implementation; the key and message are counting bytes
+*/
+bool qsctest_rhx_pmac_kat();
+
+/**
+* \brief Tests the PMAC long form api with random sized message segments for equality with the short form api.
+*
+* \return Returns true for success
+*/
+bool qsctest_rhx_pmac_stress();
+
+/**
+* \brief Tests the batched RHX-256 and RHX-512 key schedules for equality with the sequential implementation.
+*
+* \return Returns true for success
+*/
+bool qsctest_rhx_batch_equality();
+
 /**
 * \brief Tests the padding functions for correct operation.
 *
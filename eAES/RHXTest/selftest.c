@@ -811,6 +811,7 @@ static bool hba_rhx256_kat_test()
 	/* reset the nonce for decryption */
 	memcpy(kp1.nonce, n1copy, QSC_RHX_BLOCK_SIZE);
 
+	qsc_rhx_hba256_dispose(&state);
 	qsc_rhx_hba256_initialize(&state, &kp1, false);
 	qsc_rhx_hba256_set_associated(&state, aad1, sizeof(aad1));
 
@@ -827,6 +828,7 @@ static bool hba_rhx256_kat_test()
 	/* second KAT vector */
 
 	const qsc_rhx_keyparams kp2 = { key, sizeof(key), nce2, NULL, 0 };
+	qsc_rhx_hba256_dispose(&state);
 	qsc_rhx_hba256_initialize(&state, &kp2, true);
 	qsc_rhx_hba256_set_associated(&state, aad2, sizeof(aad2));
 
@@ -843,6 +845,7 @@ static bool hba_rhx256_kat_test()
 	/* reset the nonce for decryption */
 	memcpy(kp2.nonce, n2copy, QSC_RHX_BLOCK_SIZE);
 
+	qsc_rhx_hba256_dispose(&state);
 	qsc_rhx_hba256_initialize(&state, &kp2, false);
 	qsc_rhx_hba256_set_associated(&state, aad2, sizeof(aad2));
 
@@ -859,6 +862,7 @@ static bool hba_rhx256_kat_test()
 	/* third KAT vector */
 
 	const qsc_rhx_keyparams kp3 = { key, sizeof(key), nce3, NULL, 0 };
+	qsc_rhx_hba256_dispose(&state);
 	qsc_rhx_hba256_initialize(&state, &kp3, true);
 	qsc_rhx_hba256_set_associated(&state, aad3, sizeof(aad3));
 
@@ -875,6 +879,7 @@ static bool hba_rhx256_kat_test()
 	/* reset the nonce for decryption */
 	memcpy(kp3.nonce, n3copy, QSC_RHX_BLOCK_SIZE);
 
+	qsc_rhx_hba256_dispose(&state);
 	qsc_rhx_hba256_initialize(&state, &kp3, false);
 	qsc_rhx_hba256_set_associated(&state, aad3, sizeof(aad3));
 
@@ -888,6 +893,8 @@ static bool hba_rhx256_kat_test()
 		status = false;
 	}
 
+	qsc_rhx_hba256_dispose(&state);
+
 	return status;
 }
 
@@ -971,6 +978,7 @@ static bool hba_rhx512_kat_test()
 	/* reset the nonce for decryption */
 	memcpy(kp1.nonce, n1copy, QSC_RHX_BLOCK_SIZE);
 
+	qsc_rhx_hba512_dispose(&state);
 	qsc_rhx_hba512_initialize(&state, &kp1, false);
 	qsc_rhx_hba512_set_associated(&state, aad1, sizeof(aad1));
 
@@ -987,6 +995,7 @@ static bool hba_rhx512_kat_test()
 	/* second KAT vector */
 
 	const qsc_rhx_keyparams kp2 = { key, sizeof(key), nce2, NULL, 0 };
+	qsc_rhx_hba512_dispose(&state);
 	qsc_rhx_hba512_initialize(&state, &kp2, true);
 	qsc_rhx_hba512_set_associated(&state, aad2, sizeof(aad2));
 
@@ -1003,6 +1012,7 @@ static bool hba_rhx512_kat_test()
 	/* reset the nonce for decryption */
 	memcpy(kp2.nonce, n2copy, QSC_RHX_BLOCK_SIZE);
 
+	qsc_rhx_hba512_dispose(&state);
 	qsc_rhx_hba512_initialize(&state, &kp2, false);
 	qsc_rhx_hba512_set_associated(&state, aad2, sizeof(aad2));
 
@@ -1019,6 +1029,7 @@ static bool hba_rhx512_kat_test()
 	/* third KAT vector */
 
 	const qsc_rhx_keyparams kp3 = { key, sizeof(key), nce3, NULL, 0 };
+	qsc_rhx_hba512_dispose(&state);
 	qsc_rhx_hba512_initialize(&state, &kp3, true);
 	qsc_rhx_hba512_set_associated(&state, aad3, sizeof(aad3));
 
@@ -1035,6 +1046,7 @@ static bool hba_rhx512_kat_test()
 	/* reset the nonce for decryption */
 	memcpy(kp3.nonce, n3copy, QSC_RHX_BLOCK_SIZE);
 
+	qsc_rhx_hba512_dispose(&state);
 	qsc_rhx_hba512_initialize(&state, &kp3, false);
 	qsc_rhx_hba512_set_associated(&state, aad3, sizeof(aad3));
 
@@ -1048,6 +1060,8 @@ static bool hba_rhx512_kat_test()
 		status = false;
 	}
 
+	qsc_rhx_hba512_dispose(&state);
+
 	return status;
 }
 
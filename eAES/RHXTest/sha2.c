@@ -1,4 +1,5 @@
 #include "sha2.h"
+#include "cpuidex.h"
 #include "intrinsics.h"
 #include "intutils.h"
 #include "memutils.h"
@@ -22,6 +23,15 @@ static const uint32_t sha256_iv[8] =
 	0x5BE0CD19UL
 };
 
+/* the padding block of a 64 byte message: the end bit, and a 512 bit length */
+static const uint8_t sha256_pad64[QSC_SHA2_256_RATE] =
+{
+	0x80U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U,
+	0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U,
+	0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U,
+	0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x02U, 0x00U
+};
+
 static void sha256_increase(qsc_sha256_state* ctx, size_t msglen)
 {
 	ctx->t += msglen;
@@ -53,6 +63,25 @@ void qsc_sha256_compute(uint8_t* output, const uint8_t* message, size_t msglen)
 	qsc_sha256_finalize(&ctx, output);
 }
 
+void qsc_sha256_compute64(uint8_t* output, const uint8_t* message)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+	uint32_t state[QSC_SHA2_STATE_SIZE];
+	size_t i;
+
+	/* the message is one full block, followed by the constant padding block */
+	qsc_memutils_copy((uint8_t*)state, (const uint8_t*)sha256_iv, sizeof(state));
+	qsc_sha256_permute(state, message);
+	qsc_sha256_permute(state, sha256_pad64);
+
+	for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+	{
+		qsc_intutils_be32to8(output + (i * sizeof(uint32_t)), state[i]);
+	}
+}
+
 void qsc_sha256_finalize(qsc_sha256_state* ctx, uint8_t* output)
 {
 	assert(ctx != NULL);
@@ -113,12 +142,16 @@ void qsc_sha256_initialize(qsc_sha256_state* ctx)
 	ctx->position = 0;
 }
 
-#if defined(QSC_SHA2_SHANI_ENABLED)
-void qsc_sha256_permute(uint32_t* output, const uint8_t* message)
-{
-	assert(output != NULL);
-	assert(message != NULL);
+#if defined(QSC_SYSTEM_ARCH_X86_X64) && (defined(QSC_SYSTEM_COMPILER_MSC) || defined(QSC_SYSTEM_COMPILER_GCC))
+#	define SHA256_SHANI_AVAILABLE
+#endif
 
+typedef void (*sha256_permute_function)(uint32_t*, const uint8_t*);
+
+#if defined(SHA256_SHANI_AVAILABLE)
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha256_permute_shani(uint32_t* output, const uint8_t* message)
+{
 	__m128i s0;
 	__m128i s1;
 	__m128i t0;
@@ -133,7 +166,7 @@ void qsc_sha256_permute(uint32_t* output, const uint8_t* message)
 
 	/* load initial values */
 	ptmp = _mm_loadu_si128((const __m128i*)output);
-	s1 = _mm_loadu_si128((const __m128i*)(uint32_t*)(output + (4 * sizeof(uint32_t))));
+	s1 = _mm_loadu_si128((const __m128i*)(output + 4));
 	mask = _mm_set_epi64x(0x0C0D0E0F08090A0BULL, 0x0405060700010203ULL);
 	ptmp = _mm_shuffle_epi32(ptmp, 0xB1);
 	s1 = _mm_shuffle_epi32(s1, 0x1B);
@@ -289,14 +322,12 @@ void qsc_sha256_permute(uint32_t* output, const uint8_t* message)
 
 	/* store */
 	_mm_storeu_si128((__m128i*)output, s0);
-	_mm_storeu_si128((__m128i*)(uint32_t*)(output + (4 * sizeof(uint32_t))), s1);
+	_mm_storeu_si128((__m128i*)(output + 4), s1);
 }
-#else
-void qsc_sha256_permute(uint32_t* output, const uint8_t* message)
-{
-	assert(output != NULL);
-	assert(message != NULL);
+#endif
 
+static void sha256_permute_c(uint32_t* output, const uint8_t* message)
+{
 	uint32_t a;
 	uint32_t b;
 	uint32_t c;
@@ -602,8 +633,46 @@ void qsc_sha256_permute(uint32_t* output, const uint8_t* message)
 	output[6] += g;
 	output[7] += h;
 }
+
+static void sha256_permute_select(uint32_t* output, const uint8_t* message);
+
+/* resolved on first use; every thread writes the same pointer value */
+static sha256_permute_function sha256_permute_p256 = &sha256_permute_select;
+
+static void sha256_permute_select(uint32_t* output, const uint8_t* message)
+{
+	sha256_permute_function pfunc;
+
+	pfunc = &sha256_permute_c;
+
+#if defined(SHA256_SHANI_AVAILABLE)
+#	if defined(QSC_SHA2_SHANI_ENABLED)
+	pfunc = &sha256_permute_shani;
+#	else
+	qsc_cpuidex_cpu_features features;
+
+	if (qsc_cpuidex_features_set(&features) == true)
+	{
+		if (features.shani == true)
+		{
+			pfunc = &sha256_permute_shani;
+		}
+	}
+#	endif
 #endif
 
+	sha256_permute_p256 = pfunc;
+	pfunc(output, message);
+}
+
+void qsc_sha256_permute(uint32_t* output, const uint8_t* message)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+	sha256_permute_p256(output, message);
+}
+
 void qsc_sha256_update(qsc_sha256_state* ctx, const uint8_t* message, size_t msglen)
 {
 	assert(ctx != NULL);
@@ -647,6 +716,8 @@ void qsc_sha256_update(qsc_sha256_state* ctx, const uint8_t* message, size_t msg
 
 /* SHA2-384 */
 
+static void sha512_permute_blocks(uint64_t* output, const uint8_t* message, size_t blocks);
+
 static const uint64_t sha384_iv[8] =
 {
 	0xCBBB9D5DC1059ED8ULL,
@@ -782,13 +853,15 @@ void qsc_sha384_update(qsc_sha384_state* ctx, const uint8_t* message, size_t msg
 			msglen -= RMDLEN;
 		}
 
-		/* sequential loop through blocks */
-		while (msglen >= QSC_SHA2_384_RATE)
+		/* compress the whole blocks in one call, the vectorized schedule processes them in pairs */
+		if (msglen >= QSC_SHA2_384_RATE)
 		{
-			qsc_sha512_permute(ctx->state, message);
-			sha384_increase(ctx, QSC_SHA2_384_RATE);
-			message += QSC_SHA2_384_RATE;
-			msglen -= QSC_SHA2_384_RATE;
+			const size_t BLKLEN = msglen - (msglen % QSC_SHA2_384_RATE);
+
+			sha512_permute_blocks(ctx->state, message, BLKLEN / QSC_SHA2_384_RATE);
+			sha384_increase(ctx, BLKLEN);
+			message += BLKLEN;
+			msglen -= BLKLEN;
 		}
 
 		/* store unaligned bytes */
@@ -914,11 +987,8 @@ void qsc_sha512_initialize(qsc_sha512_state* ctx)
 	ctx->position = 0;
 }
 
-void qsc_sha512_permute(uint64_t* output, const uint8_t* message)
+static void sha512_permute_c(uint64_t* output, const uint8_t* message)
 {
-	assert(output != NULL);
-	assert(message != NULL);
-
 	uint64_t a;
 	uint64_t b;
 	uint64_t c;
@@ -1290,6 +1360,200 @@ void qsc_sha512_permute(uint64_t* output, const uint8_t* message)
 	output[7] += h;
 }
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static const uint64_t sha512_k[SHA2_512_ROUNDS_COUNT] =
+{
+	0x428A2F98D728AE22ULL, 0x7137449123EF65CDULL, 0xB5C0FBCFEC4D3B2FULL, 0xE9B5DBA58189DBBCULL,
+	0x3956C25BF348B538ULL, 0x59F111F1B605D019ULL, 0x923F82A4AF194F9BULL, 0xAB1C5ED5DA6D8118ULL,
+	0xD807AA98A3030242ULL, 0x12835B0145706FBEULL, 0x243185BE4EE4B28CULL, 0x550C7DC3D5FFB4E2ULL,
+	0x72BE5D74F27B896FULL, 0x80DEB1FE3B1696B1ULL, 0x9BDC06A725C71235ULL, 0xC19BF174CF692694ULL,
+	0xE49B69C19EF14AD2ULL, 0xEFBE4786384F25E3ULL, 0x0FC19DC68B8CD5B5ULL, 0x240CA1CC77AC9C65ULL,
+	0x2DE92C6F592B0275ULL, 0x4A7484AA6EA6E483ULL, 0x5CB0A9DCBD41FBD4ULL, 0x76F988DA831153B5ULL,
+	0x983E5152EE66DFABULL, 0xA831C66D2DB43210ULL, 0xB00327C898FB213FULL, 0xBF597FC7BEEF0EE4ULL,
+	0xC6E00BF33DA88FC2ULL, 0xD5A79147930AA725ULL, 0x06CA6351E003826FULL, 0x142929670A0E6E70ULL,
+	0x27B70A8546D22FFCULL, 0x2E1B21385C26C926ULL, 0x4D2C6DFC5AC42AEDULL, 0x53380D139D95B3DFULL,
+	0x650A73548BAF63DEULL, 0x766A0ABB3C77B2A8ULL, 0x81C2C92E47EDAEE6ULL, 0x92722C851482353BULL,
+	0xA2BFE8A14CF10364ULL, 0xA81A664BBC423001ULL, 0xC24B8B70D0F89791ULL, 0xC76C51A30654BE30ULL,
+	0xD192E819D6EF5218ULL, 0xD69906245565A910ULL, 0xF40E35855771202AULL, 0x106AA07032BBD1B8ULL,
+	0x19A4C116B8D2D0C8ULL, 0x1E376C085141AB53ULL, 0x2748774CDF8EEB99ULL, 0x34B0BCB5E19B48A8ULL,
+	0x391C0CB3C5C95A63ULL, 0x4ED8AA4AE3418ACBULL, 0x5B9CCA4F7763E373ULL, 0x682E6FF3D6B2B8A3ULL,
+	0x748F82EE5DEFB2FCULL, 0x78A5636F43172F60ULL, 0x84C87814A1F0AB72ULL, 0x8CC702081A6439ECULL,
+	0x90BEFFFA23631E28ULL, 0xA4506CEBDE82BDE9ULL, 0xBEF9A3F7B2C67915ULL, 0xC67178F2E372532BULL,
+	0xCA273ECEEA26619CULL, 0xD186B8C721C0C207ULL, 0xEADA7DD6CDE0EB1EULL, 0xF57D4F7FEE6ED178ULL,
+	0x06F067AA72176FBAULL, 0x0A637DC5A2C898A6ULL, 0x113F9804BEF90DAEULL, 0x1B710B35131C471BULL,
+	0x28DB77F523047D84ULL, 0x32CAAB7B40C72493ULL, 0x3C9EBE0A15C9BEBCULL, 0x431D67C49C100D4CULL,
+	0x4CC5D4BECB3E42B6ULL, 0x597F299CFC657E2AULL, 0x5FCB6FAB3AD6FAECULL, 0x6C44198C4A475817ULL
+};
+
+#	define SHA512_ROTR(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+#	define SHA512_ROUND(a, b, c, d, e, f, g, h, wk) \
+		r = (h) + (SHA512_ROTR((e), 14) ^ SHA512_ROTR((e), 18) ^ SHA512_ROTR((e), 41)) + (((e) & (f)) ^ (~(e) & (g))) + (wk); \
+		(d) += r; \
+		(h) = r + (SHA512_ROTR((a), 28) ^ SHA512_ROTR((a), 34) ^ SHA512_ROTR((a), 39)) + (((a) & (b)) ^ ((a) & (c)) ^ ((b) & (c)))
+#	define SHA512X2_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi64((x), (n)), _mm256_slli_epi64((x), 64 - (n)))
+#	define SHA512X2_SIG0(x) _mm256_xor_si256(_mm256_xor_si256(SHA512X2_ROTR((x), 1), SHA512X2_ROTR((x), 8)), _mm256_srli_epi64((x), 7))
+#	define SHA512X2_SIG1(x) _mm256_xor_si256(_mm256_xor_si256(SHA512X2_ROTR((x), 19), SHA512X2_ROTR((x), 61)), _mm256_srli_epi64((x), 6))
+
+static void sha512_schedule_avx2(uint64_t wka[SHA2_512_ROUNDS_COUNT], uint64_t wkb[SHA2_512_ROUNDS_COUNT], const uint8_t* blocka, const uint8_t* blockb)
+{
+	const __m256i BSWP = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+		7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+	__m256i w[8];
+	__m256i t;
+	size_t i;
+
+	/* each 128-bit lane holds a pair of consecutive schedule words, the low lane from
+	   the first block and the high lane from the second; a pair depends only on earlier pairs */
+	for (i = 0; i < 8; ++i)
+	{
+		w[i] = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(blocka + (i * 16)))),
+			_mm_loadu_si128((const __m128i*)(blockb + (i * 16))), 1), BSWP);
+		t = _mm256_add_epi64(w[i], _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(sha512_k + (i * 2)))));
+		_mm_storeu_si128((__m128i*)(wka + (i * 2)), _mm256_castsi256_si128(t));
+		_mm_storeu_si128((__m128i*)(wkb + (i * 2)), _mm256_extracti128_si256(t, 1));
+	}
+
+	for (i = 8; i < SHA2_512_ROUNDS_COUNT / 2; ++i)
+	{
+		/* w[t] = s1(w[t-2]) + w[t-7] + s0(w[t-15]) + w[t-16], the odd offsets are realigned within each lane */
+		w[i & 7] = _mm256_add_epi64(_mm256_add_epi64(w[i & 7], SHA512X2_SIG0(_mm256_alignr_epi8(w[(i + 1) & 7], w[i & 7], 8))),
+			_mm256_add_epi64(_mm256_alignr_epi8(w[(i - 3) & 7], w[(i - 4) & 7], 8), SHA512X2_SIG1(w[(i - 1) & 7])));
+		t = _mm256_add_epi64(w[i & 7], _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(sha512_k + (i * 2)))));
+		_mm_storeu_si128((__m128i*)(wka + (i * 2)), _mm256_castsi256_si128(t));
+		_mm_storeu_si128((__m128i*)(wkb + (i * 2)), _mm256_extracti128_si256(t, 1));
+	}
+}
+
+static void sha512_rounds(uint64_t* output, const uint64_t* wk)
+{
+	uint64_t a;
+	uint64_t b;
+	uint64_t c;
+	uint64_t d;
+	uint64_t e;
+	uint64_t f;
+	uint64_t g;
+	uint64_t h;
+	uint64_t r;
+	size_t i;
+
+	a = output[0];
+	b = output[1];
+	c = output[2];
+	d = output[3];
+	e = output[4];
+	f = output[5];
+	g = output[6];
+	h = output[7];
+
+	for (i = 0; i < SHA2_512_ROUNDS_COUNT; i += 8)
+	{
+		SHA512_ROUND(a, b, c, d, e, f, g, h, wk[i]);
+		SHA512_ROUND(h, a, b, c, d, e, f, g, wk[i + 1]);
+		SHA512_ROUND(g, h, a, b, c, d, e, f, wk[i + 2]);
+		SHA512_ROUND(f, g, h, a, b, c, d, e, wk[i + 3]);
+		SHA512_ROUND(e, f, g, h, a, b, c, d, wk[i + 4]);
+		SHA512_ROUND(d, e, f, g, h, a, b, c, wk[i + 5]);
+		SHA512_ROUND(c, d, e, f, g, h, a, b, wk[i + 6]);
+		SHA512_ROUND(b, c, d, e, f, g, h, a, wk[i + 7]);
+	}
+
+	output[0] += a;
+	output[1] += b;
+	output[2] += c;
+	output[3] += d;
+	output[4] += e;
+	output[5] += f;
+	output[6] += g;
+	output[7] += h;
+}
+
+static void sha512_permute_blocks_avx2(uint64_t* output, const uint8_t* message, size_t blocks)
+{
+	uint64_t wka[SHA2_512_ROUNDS_COUNT];
+	uint64_t wkb[SHA2_512_ROUNDS_COUNT];
+	bool used;
+
+	used = false;
+
+	while (blocks >= 2)
+	{
+		/* the second block's schedule is ready while the first block's rounds run */
+		sha512_schedule_avx2(wka, wkb, message, message + QSC_SHA2_512_RATE);
+		sha512_rounds(output, wka);
+		sha512_rounds(output, wkb);
+		message += 2 * QSC_SHA2_512_RATE;
+		blocks -= 2;
+		used = true;
+	}
+
+	if (blocks != 0)
+	{
+		sha512_permute_c(output, message);
+	}
+
+	if (used == true)
+	{
+		qsc_memutils_clear((uint8_t*)wka, sizeof(wka));
+		qsc_memutils_clear((uint8_t*)wkb, sizeof(wkb));
+	}
+}
+
+#endif
+
+static void sha512_permute_blocks_c(uint64_t* output, const uint8_t* message, size_t blocks)
+{
+	while (blocks != 0)
+	{
+		sha512_permute_c(output, message);
+		message += QSC_SHA2_512_RATE;
+		--blocks;
+	}
+}
+
+typedef void (*sha512_permute_function)(uint64_t*, const uint8_t*, size_t);
+
+static void sha512_permute_select(uint64_t* output, const uint8_t* message, size_t blocks);
+
+/* resolved on first use; every thread writes the same pointer value */
+static sha512_permute_function sha512_permute_p1024 = &sha512_permute_select;
+
+static void sha512_permute_select(uint64_t* output, const uint8_t* message, size_t blocks)
+{
+	sha512_permute_function pfunc;
+
+	pfunc = &sha512_permute_blocks_c;
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_cpuidex_cpu_features features;
+
+	if (qsc_cpuidex_features_set(&features) == true)
+	{
+		if (features.avx2 == true)
+		{
+			pfunc = &sha512_permute_blocks_avx2;
+		}
+	}
+#endif
+
+	sha512_permute_p1024 = pfunc;
+	pfunc(output, message, blocks);
+}
+
+static void sha512_permute_blocks(uint64_t* output, const uint8_t* message, size_t blocks)
+{
+	sha512_permute_p1024(output, message, blocks);
+}
+
+void qsc_sha512_permute(uint64_t* output, const uint8_t* message)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+	sha512_permute_p1024(output, message, 1);
+}
+
 void qsc_sha512_update(qsc_sha512_state* ctx, const uint8_t* message, size_t msglen)
 {
 	assert(ctx != NULL);
@@ -1313,13 +1577,15 @@ void qsc_sha512_update(qsc_sha512_state* ctx, const uint8_t* message, size_t msg
 			msglen -= RMDLEN;
 		}
 
-		/* sequential loop through blocks */
-		while (msglen >= QSC_SHA2_512_RATE)
+		/* compress the whole blocks in one call, the vectorized schedule processes them in pairs */
+		if (msglen >= QSC_SHA2_512_RATE)
 		{
-			qsc_sha512_permute(ctx->state, message);
-			sha512_increase(ctx, QSC_SHA2_512_RATE);
-			message += QSC_SHA2_512_RATE;
-			msglen -= QSC_SHA2_512_RATE;
+			const size_t BLKLEN = msglen - (msglen % QSC_SHA2_512_RATE);
+
+			sha512_permute_blocks(ctx->state, message, BLKLEN / QSC_SHA2_512_RATE);
+			sha512_increase(ctx, BLKLEN);
+			message += BLKLEN;
+			msglen -= BLKLEN;
 		}
 
 		/* store unaligned bytes */
@@ -1333,6 +1599,16 @@ void qsc_sha512_update(qsc_sha512_state* ctx, const uint8_t* message, size_t msg
 
 /* HMAC-256 */
 
+void qsc_hmac256_clone(qsc_hmac256_state* output, const qsc_hmac256_state* input)
+{
+	assert(output != NULL);
+	assert(input != NULL);
+
+	qsc_memutils_copy(&output->pstate, &input->pstate, sizeof(qsc_sha256_state));
+	qsc_memutils_copy(&output->ostate, &input->ostate, sizeof(qsc_sha256_state));
+	qsc_memutils_copy(output->ikey, input->ikey, sizeof(output->ikey));
+}
+
 void qsc_hmac256_compute(uint8_t* output, const uint8_t* message, size_t msglen, const uint8_t* key, size_t keylen)
 {
 	assert(output != NULL);
@@ -1353,9 +1629,9 @@ void qsc_hmac256_dispose(qsc_hmac256_state* ctx)
 	
 	if (ctx != NULL)
 	{
-		qsc_memutils_clear(ctx->ipad, sizeof(ctx->ipad));
-		qsc_memutils_clear(ctx->opad, sizeof(ctx->ipad));
 		qsc_sha256_dispose(&ctx->pstate);
+		qsc_sha256_dispose(&ctx->ostate);
+		qsc_memutils_clear((uint8_t*)ctx->ikey, sizeof(ctx->ikey));
 	}
 }
 QSC_SYSTEM_OPTIMIZE_RESUME
@@ -1368,13 +1644,33 @@ void qsc_hmac256_finalize(qsc_hmac256_state* ctx, uint8_t* output)
 	uint8_t tmpv[QSC_SHA2_256_HASH_SIZE] = { 0 };
 
 	qsc_sha256_finalize(&ctx->pstate, tmpv);
-	qsc_sha256_initialize(&ctx->pstate);
-	qsc_sha256_update(&ctx->pstate, ctx->opad, sizeof(ctx->opad));
-	qsc_sha256_update(&ctx->pstate, tmpv, sizeof(tmpv));
-	qsc_sha256_finalize(&ctx->pstate, output);
+	/* the outer state was keyed with the output pad at initialization */
+	qsc_sha256_update(&ctx->ostate, tmpv, sizeof(tmpv));
+	qsc_sha256_finalize(&ctx->ostate, output);
 	qsc_hmac256_dispose(ctx);
 }
 
+void qsc_hmac256_finalize_and_reset(qsc_hmac256_state* ctx, uint8_t* output)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+
+	qsc_sha256_state tmpo;
+	uint8_t tmpv[QSC_SHA2_256_HASH_SIZE] = { 0 };
+
+	qsc_sha256_finalize(&ctx->pstate, tmpv);
+	/* the outer hash runs on a copy, the keyed outer state is kept for the next message */
+	qsc_memutils_copy(&tmpo, &ctx->ostate, sizeof(tmpo));
+	qsc_sha256_update(&tmpo, tmpv, sizeof(tmpv));
+	qsc_sha256_finalize(&tmpo, output);
+	qsc_memutils_clear(tmpv, sizeof(tmpv));
+
+	/* restore the inner state to the keyed input pad */
+	qsc_memutils_copy((uint8_t*)ctx->pstate.state, (const uint8_t*)ctx->ikey, sizeof(ctx->ikey));
+	ctx->pstate.t = QSC_SHA2_256_RATE;
+	ctx->pstate.position = 0;
+}
+
 void qsc_hmac256_initialize(qsc_hmac256_state* ctx, const uint8_t* key, size_t keylen)
 {
 	assert(ctx != NULL);
@@ -1382,26 +1678,33 @@ void qsc_hmac256_initialize(qsc_hmac256_state* ctx, const uint8_t* key, size_t k
 
 	const uint8_t IPAD = 0x36;
 	const uint8_t OPAD = 0x5C;
-
-	qsc_memutils_clear(ctx->ipad, QSC_SHA2_256_RATE);
+	uint8_t ipad[QSC_SHA2_256_RATE] = { 0 };
+	uint8_t opad[QSC_SHA2_256_RATE] = { 0 };
 
 	if (keylen > QSC_SHA2_256_RATE)
 	{
 		qsc_sha256_initialize(&ctx->pstate);
 		qsc_sha256_update(&ctx->pstate, key, keylen);
-		qsc_sha256_finalize(&ctx->pstate, ctx->ipad);
+		qsc_sha256_finalize(&ctx->pstate, ipad);
 	}
 	else
 	{
-		qsc_memutils_copy(ctx->ipad, key, keylen);
+		qsc_memutils_copy(ipad, key, keylen);
 	}
 
-	qsc_memutils_copy(ctx->opad, ctx->ipad, QSC_SHA2_256_RATE);
-	qsc_memutils_xorv(ctx->opad, OPAD, QSC_SHA2_256_RATE);
-	qsc_memutils_xorv(ctx->ipad, IPAD, QSC_SHA2_256_RATE);
+	qsc_memutils_copy(opad, ipad, QSC_SHA2_256_RATE);
+	qsc_memutils_xorv(opad, OPAD, QSC_SHA2_256_RATE);
+	qsc_memutils_xorv(ipad, IPAD, QSC_SHA2_256_RATE);
 
+	/* precompute the inner and outer keyed states */
 	qsc_sha256_initialize(&ctx->pstate);
-	qsc_sha256_update(&ctx->pstate, ctx->ipad, sizeof(ctx->ipad));
+	qsc_sha256_update(&ctx->pstate, ipad, sizeof(ipad));
+	qsc_memutils_copy((uint8_t*)ctx->ikey, (const uint8_t*)ctx->pstate.state, sizeof(ctx->ikey));
+	qsc_sha256_initialize(&ctx->ostate);
+	qsc_sha256_update(&ctx->ostate, opad, sizeof(opad));
+
+	qsc_memutils_clear(ipad, sizeof(ipad));
+	qsc_memutils_clear(opad, sizeof(opad));
 }
 
 void qsc_hmac256_update(qsc_hmac256_state* ctx, const uint8_t* message, size_t msglen)
@@ -1414,6 +1717,16 @@ void qsc_hmac256_update(qsc_hmac256_state* ctx, const uint8_t* message, size_t m
 
 /* HMAC-512 */
 
+void qsc_hmac512_clone(qsc_hmac512_state* output, const qsc_hmac512_state* input)
+{
+	assert(output != NULL);
+	assert(input != NULL);
+
+	qsc_memutils_copy(&output->pstate, &input->pstate, sizeof(qsc_sha512_state));
+	qsc_memutils_copy(&output->ostate, &input->ostate, sizeof(qsc_sha512_state));
+	qsc_memutils_copy(output->ikey, input->ikey, sizeof(output->ikey));
+}
+
 void qsc_hmac512_compute(uint8_t* output, const uint8_t* message, size_t msglen, const uint8_t* key, size_t keylen)
 {
 	assert(output != NULL);
@@ -1434,9 +1747,9 @@ void qsc_hmac512_dispose(qsc_hmac512_state* ctx)
 	
 	if (ctx != NULL)
 	{
-		qsc_memutils_clear(ctx->ipad, sizeof(ctx->ipad));
-		qsc_memutils_clear(ctx->opad, sizeof(ctx->ipad));
 		qsc_sha512_dispose(&ctx->pstate);
+		qsc_sha512_dispose(&ctx->ostate);
+		qsc_memutils_clear((uint8_t*)ctx->ikey, sizeof(ctx->ikey));
 	}
 }
 QSC_SYSTEM_OPTIMIZE_RESUME
@@ -1449,13 +1762,34 @@ void qsc_hmac512_finalize(qsc_hmac512_state* ctx, uint8_t* output)
 	uint8_t tmpv[QSC_SHA2_512_HASH_SIZE] = { 0 };
 
 	qsc_sha512_finalize(&ctx->pstate, tmpv);
-	qsc_sha512_initialize(&ctx->pstate);
-	qsc_sha512_update(&ctx->pstate, ctx->opad, sizeof(ctx->opad));
-	qsc_sha512_update(&ctx->pstate, tmpv, sizeof(tmpv));
-	qsc_sha512_finalize(&ctx->pstate, output);
+	/* the outer state was keyed with the output pad at initialization */
+	qsc_sha512_update(&ctx->ostate, tmpv, sizeof(tmpv));
+	qsc_sha512_finalize(&ctx->ostate, output);
 	qsc_hmac512_dispose(ctx);
 }
 
+void qsc_hmac512_finalize_and_reset(qsc_hmac512_state* ctx, uint8_t* output)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+
+	qsc_sha512_state tmpo;
+	uint8_t tmpv[QSC_SHA2_512_HASH_SIZE] = { 0 };
+
+	qsc_sha512_finalize(&ctx->pstate, tmpv);
+	/* the outer hash runs on a copy, the keyed outer state is kept for the next message */
+	qsc_memutils_copy(&tmpo, &ctx->ostate, sizeof(tmpo));
+	qsc_sha512_update(&tmpo, tmpv, sizeof(tmpv));
+	qsc_sha512_finalize(&tmpo, output);
+	qsc_memutils_clear(tmpv, sizeof(tmpv));
+
+	/* restore the inner state to the keyed input pad */
+	qsc_memutils_copy((uint8_t*)ctx->pstate.state, (const uint8_t*)ctx->ikey, sizeof(ctx->ikey));
+	ctx->pstate.t[0] = QSC_SHA2_512_RATE;
+	ctx->pstate.t[1] = 0;
+	ctx->pstate.position = 0;
+}
+
 void qsc_hmac512_initialize(qsc_hmac512_state* ctx, const uint8_t* key, size_t keylen)
 {
 	assert(ctx != NULL);
@@ -1463,26 +1797,33 @@ void qsc_hmac512_initialize(qsc_hmac512_state* ctx, const uint8_t* key, size_t k
 
 	const uint8_t IPAD = 0x36;
 	const uint8_t OPAD = 0x5C;
-
-	qsc_memutils_clear(ctx->ipad, QSC_SHA2_512_RATE);
+	uint8_t ipad[QSC_SHA2_512_RATE] = { 0 };
+	uint8_t opad[QSC_SHA2_512_RATE] = { 0 };
 
 	if (keylen > QSC_SHA2_512_RATE)
 	{
 		qsc_sha512_initialize(&ctx->pstate);
 		qsc_sha512_update(&ctx->pstate, key, keylen);
-		qsc_sha512_finalize(&ctx->pstate, ctx->ipad);
+		qsc_sha512_finalize(&ctx->pstate, ipad);
 	}
 	else
 	{
-		qsc_memutils_copy(ctx->ipad, key, keylen);
+		qsc_memutils_copy(ipad, key, keylen);
 	}
 
-	qsc_memutils_copy(ctx->opad, ctx->ipad, QSC_SHA2_512_RATE);
-	qsc_memutils_xorv(ctx->opad, OPAD, QSC_SHA2_512_RATE);
-	qsc_memutils_xorv(ctx->ipad, IPAD, QSC_SHA2_512_RATE);
+	qsc_memutils_copy(opad, ipad, QSC_SHA2_512_RATE);
+	qsc_memutils_xorv(opad, OPAD, QSC_SHA2_512_RATE);
+	qsc_memutils_xorv(ipad, IPAD, QSC_SHA2_512_RATE);
 
+	/* precompute the inner and outer keyed states */
 	qsc_sha512_initialize(&ctx->pstate);
-	qsc_sha512_update(&ctx->pstate, ctx->ipad, sizeof(ctx->ipad));
+	qsc_sha512_update(&ctx->pstate, ipad, sizeof(ipad));
+	qsc_memutils_copy((uint8_t*)ctx->ikey, (const uint8_t*)ctx->pstate.state, sizeof(ctx->ikey));
+	qsc_sha512_initialize(&ctx->ostate);
+	qsc_sha512_update(&ctx->ostate, opad, sizeof(opad));
+
+	qsc_memutils_clear(ipad, sizeof(ipad));
+	qsc_memutils_clear(opad, sizeof(opad));
 }
 
 void qsc_hmac512_update(qsc_hmac512_state* ctx, const uint8_t* message, size_t msglen)
@@ -1501,12 +1842,16 @@ void qsc_hkdf256_expand(uint8_t* output, size_t outlen, const uint8_t* key, size
 	assert(key != NULL);
 
 	qsc_hmac256_state ctx;
+	qsc_hmac256_state kctx;
 	uint8_t buf[QSC_SHA2_256_HASH_SIZE] = { 0 };
 	uint8_t ctr[1] = { 0 };
 
+	/* key the pads once, each output block starts from a clone of the keyed state */
+	qsc_hmac256_initialize(&kctx, key, keylen);
+
 	while (outlen != 0)
 	{
-		qsc_hmac256_initialize(&ctx, key, keylen);
+		qsc_hmac256_clone(&ctx, &kctx);
 
 		if (ctr[0] != 0)
 		{
@@ -1528,6 +1873,9 @@ void qsc_hkdf256_expand(uint8_t* output, size_t outlen, const uint8_t* key, size
 		outlen -= RMDLEN;
 		output += RMDLEN;
 	}
+
+	qsc_hmac256_dispose(&kctx);
+	qsc_memutils_clear(buf, sizeof(buf));
 }
 
 void qsc_hkdf256_extract(uint8_t* output, size_t outlen, const uint8_t* key, size_t keylen, const uint8_t* salt, size_t saltlen)
@@ -1562,12 +1910,16 @@ void qsc_hkdf512_expand(uint8_t* output, size_t outlen, const uint8_t* key, size
 	assert(key != NULL);
 
 	qsc_hmac512_state ctx;
+	qsc_hmac512_state kctx;
 	uint8_t buf[QSC_SHA2_512_HASH_SIZE] = { 0 };
 	uint8_t ctr[1] = { 0 };
 
+	/* key the pads once, each output block starts from a clone of the keyed state */
+	qsc_hmac512_initialize(&kctx, key, keylen);
+
 	while (outlen != 0)
 	{
-		qsc_hmac512_initialize(&ctx, key, keylen);
+		qsc_hmac512_clone(&ctx, &kctx);
 
 		if (ctr[0] != 0)
 		{
@@ -1589,6 +1941,9 @@ void qsc_hkdf512_expand(uint8_t* output, size_t outlen, const uint8_t* key, size
 		outlen -= RMDLEN;
 		output += RMDLEN;
 	}
+
+	qsc_hmac512_dispose(&kctx);
+	qsc_memutils_clear(buf, sizeof(buf));
 }
 
 void qsc_hkdf512_extract(uint8_t* output, size_t outlen, const uint8_t* key, size_t keylen, const uint8_t* salt, size_t saltlen)
@@ -1614,3 +1969,1659 @@ void qsc_hkdf512_extract(uint8_t* output, size_t outlen, const uint8_t* key, siz
         qsc_hmac512_finalize(&ctx, output);
     }
 }
+
+/* multi-lane SHA2 jobs */
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+#define SHA2_JOB_SEGMENTS 4
+
+typedef struct
+{
+	const uint8_t* segment[SHA2_JOB_SEGMENTS];
+	size_t seglen[SHA2_JOB_SEGMENTS];
+	uint8_t ipad[QSC_SHA2_512_RATE];
+	uint8_t opad[QSC_SHA2_512_RATE];
+	uint8_t inner[QSC_SHA2_512_HASH_SIZE];
+	uint8_t prev[QSC_SHA2_512_HASH_SIZE];
+	uint8_t ctr[1];
+	const qsc_sha2_job* job;
+	uint64_t t;
+	size_t count;
+	size_t index;
+	size_t offset;
+	size_t outpos;
+	bool last;
+	bool marked;
+	bool outer;
+} sha2_job_lane;
+
+static void sha2_job_lane_add(sha2_job_lane* lane, const uint8_t* segment, size_t seglen)
+{
+	lane->segment[lane->count] = segment;
+	lane->seglen[lane->count] = seglen;
+	++lane->count;
+}
+
+static void sha2_job_lane_begin(sha2_job_lane* lane, bool outer)
+{
+	lane->t = 0;
+	lane->count = 0;
+	lane->index = 0;
+	lane->offset = 0;
+	lane->last = false;
+	lane->marked = false;
+	lane->outer = outer;
+}
+
+static void sha2_job_lane_inner(sha2_job_lane* lane, qsc_sha2_job_mode mode, size_t rate, size_t hashlen)
+{
+	sha2_job_lane_begin(lane, false);
+
+	if (mode != qsc_sha2_job_hash)
+	{
+		sha2_job_lane_add(lane, lane->ipad, rate);
+	}
+
+	if (mode == qsc_sha2_job_hkdf)
+	{
+		/* T(i) = HMAC(K, T(i-1) || info || i) */
+		if (lane->ctr[0] != 0)
+		{
+			sha2_job_lane_add(lane, lane->prev, hashlen);
+		}
+
+		sha2_job_lane_add(lane, lane->job->message, lane->job->msglen);
+		++lane->ctr[0];
+		sha2_job_lane_add(lane, lane->ctr, sizeof(lane->ctr));
+	}
+	else
+	{
+		sha2_job_lane_add(lane, lane->job->message, lane->job->msglen);
+	}
+}
+
+static void sha2_job_lane_outer(sha2_job_lane* lane, size_t rate, size_t hashlen)
+{
+	sha2_job_lane_begin(lane, true);
+	sha2_job_lane_add(lane, lane->opad, rate);
+	sha2_job_lane_add(lane, lane->inner, hashlen);
+}
+
+static void sha2_job_lane_key(sha2_job_lane* lane, size_t rate)
+{
+	const uint8_t IPAD = 0x36;
+	const uint8_t OPAD = 0x5C;
+
+	qsc_memutils_copy(lane->opad, lane->ipad, rate);
+	qsc_memutils_xorv(lane->opad, OPAD, rate);
+	qsc_memutils_xorv(lane->ipad, IPAD, rate);
+}
+
+static void sha2_job_lane_fill(sha2_job_lane* lane, uint8_t* block, size_t rate)
+{
+	size_t len;
+	size_t pos;
+
+	pos = 0;
+
+	while (pos < rate && lane->index < lane->count)
+	{
+		len = qsc_intutils_min(lane->seglen[lane->index] - lane->offset, rate - pos);
+
+		if (len != 0)
+		{
+			qsc_memutils_copy(block + pos, lane->segment[lane->index] + lane->offset, len);
+		}
+
+		pos += len;
+		lane->offset += len;
+		lane->t += len;
+
+		if (lane->offset == lane->seglen[lane->index])
+		{
+			++lane->index;
+			lane->offset = 0;
+		}
+	}
+
+	if (pos < rate)
+	{
+		/* the stream is exhausted, pad the lane independently of the others */
+		if (lane->marked == false)
+		{
+			block[pos] = 0x80U;
+			++pos;
+			lane->marked = true;
+		}
+
+		/* the bit length field is 8 bytes for SHA2-256, and 16 bytes for SHA2-512 */
+		if (pos <= rate - (rate / 8))
+		{
+			qsc_intutils_be64to8(block + (rate - sizeof(uint64_t)), lane->t << 3);
+			lane->last = true;
+		}
+	}
+}
+
+static const uint8_t* sha2_job_lane_next(sha2_job_lane* lane, uint8_t* block, size_t rate)
+{
+	const uint8_t* pblk;
+
+	if (lane->index < lane->count && lane->seglen[lane->index] - lane->offset >= rate)
+	{
+		/* a whole block inside the current segment is compressed in place */
+		pblk = lane->segment[lane->index] + lane->offset;
+		lane->offset += rate;
+		lane->t += rate;
+
+		if (lane->offset == lane->seglen[lane->index])
+		{
+			++lane->index;
+			lane->offset = 0;
+		}
+	}
+	else
+	{
+		qsc_memutils_clear(block, rate);
+		sha2_job_lane_fill(lane, block, rate);
+		pblk = block;
+	}
+
+	return pblk;
+}
+
+#endif
+
+/* multi-lane SHA2-256 */
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static const uint32_t sha256_k[SHA2_256_ROUNDS_COUNT] =
+{
+	0x428A2F98UL, 0x71374491UL, 0xB5C0FBCFUL, 0xE9B5DBA5UL, 0x3956C25BUL, 0x59F111F1UL, 0x923F82A4UL, 0xAB1C5ED5UL,
+	0xD807AA98UL, 0x12835B01UL, 0x243185BEUL, 0x550C7DC3UL, 0x72BE5D74UL, 0x80DEB1FEUL, 0x9BDC06A7UL, 0xC19BF174UL,
+	0xE49B69C1UL, 0xEFBE4786UL, 0x0FC19DC6UL, 0x240CA1CCUL, 0x2DE92C6FUL, 0x4A7484AAUL, 0x5CB0A9DCUL, 0x76F988DAUL,
+	0x983E5152UL, 0xA831C66DUL, 0xB00327C8UL, 0xBF597FC7UL, 0xC6E00BF3UL, 0xD5A79147UL, 0x06CA6351UL, 0x14292967UL,
+	0x27B70A85UL, 0x2E1B2138UL, 0x4D2C6DFCUL, 0x53380D13UL, 0x650A7354UL, 0x766A0ABBUL, 0x81C2C92EUL, 0x92722C85UL,
+	0xA2BFE8A1UL, 0xA81A664BUL, 0xC24B8B70UL, 0xC76C51A3UL, 0xD192E819UL, 0xD6990624UL, 0xF40E3585UL, 0x106AA070UL,
+	0x19A4C116UL, 0x1E376C08UL, 0x2748774CUL, 0x34B0BCB5UL, 0x391C0CB3UL, 0x4ED8AA4AUL, 0x5B9CCA4FUL, 0x682E6FF3UL,
+	0x748F82EEUL, 0x78A5636FUL, 0x84C87814UL, 0x8CC70208UL, 0x90BEFFFAUL, 0xA4506CEBUL, 0xBEF9A3F7UL, 0xC67178F2UL
+};
+
+#	if defined(QSC_SYSTEM_HAS_AVX512)
+
+#		define SHA256X16_SUM0(x) _mm512_ternarylogic_epi32(_mm512_ror_epi32((x), 2), _mm512_ror_epi32((x), 13), _mm512_ror_epi32((x), 22), 0x96)
+#		define SHA256X16_SUM1(x) _mm512_ternarylogic_epi32(_mm512_ror_epi32((x), 6), _mm512_ror_epi32((x), 11), _mm512_ror_epi32((x), 25), 0x96)
+#		define SHA256X16_SIG0(x) _mm512_ternarylogic_epi32(_mm512_ror_epi32((x), 7), _mm512_ror_epi32((x), 18), _mm512_srli_epi32((x), 3), 0x96)
+#		define SHA256X16_SIG1(x) _mm512_ternarylogic_epi32(_mm512_ror_epi32((x), 17), _mm512_ror_epi32((x), 19), _mm512_srli_epi32((x), 10), 0x96)
+#		define SHA256X16_CH(x, y, z) _mm512_ternarylogic_epi32((x), (y), (z), 0xCA)
+#		define SHA256X16_MAJ(x, y, z) _mm512_ternarylogic_epi32((x), (y), (z), 0xE8)
+#		define SHA256X16_SCHEDULE(j) w[(j) & 15] = _mm512_add_epi32(_mm512_add_epi32(w[(j) & 15], SHA256X16_SIG1(w[((j) - 2) & 15])), \
+		_mm512_add_epi32(w[((j) - 7) & 15], SHA256X16_SIG0(w[((j) - 15) & 15])))
+#		define SHA256X16_ROUND(a, b, c, d, e, f, g, h, j) \
+		t = _mm512_add_epi32(_mm512_add_epi32((h), SHA256X16_SUM1(e)), _mm512_add_epi32(SHA256X16_CH((e), (f), (g)), \
+			_mm512_add_epi32(_mm512_set1_epi32((int32_t)sha256_k[(j)]), w[(j) & 15]))); \
+		(d) = _mm512_add_epi32((d), t); \
+		(h) = _mm512_add_epi32(t, _mm512_add_epi32(SHA256X16_SUM0(a), SHA256X16_MAJ((a), (b), (c))))
+
+static void sha256_permutex16(uint32_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_256_JOB_LANES], const uint8_t* const block[QSC_SHA2_256_JOB_LANES])
+{
+	const __m512i BMSK = _mm512_set1_epi32(0x00FF00FFL);
+	int64_t oft[QSC_SHA2_256_JOB_LANES];
+	__m512i w[16];
+	__m512i a;
+	__m512i b;
+	__m512i c;
+	__m512i d;
+	__m512i e;
+	__m512i f;
+	__m512i g;
+	__m512i h;
+	__m512i t;
+	__m512i x0;
+	__m512i x1;
+	size_t i;
+
+	/* the lane blocks are gathered through their offsets from the first block */
+	for (i = 0; i < QSC_SHA2_256_JOB_LANES; ++i)
+	{
+		oft[i] = (int64_t)(uintptr_t)block[i] - (int64_t)(uintptr_t)block[0];
+	}
+
+	x0 = _mm512_loadu_si512((const void*)oft);
+	x1 = _mm512_loadu_si512((const void*)(oft + 8));
+
+	/* gather word i of every lane block, and swap the bytes to big-endian order */
+	for (i = 0; i < 16; ++i)
+	{
+		t = _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_i64gather_epi32(x0, (const void*)(block[0] + (i * sizeof(uint32_t))), 1)),
+			_mm512_i64gather_epi32(x1, (const void*)(block[0] + (i * sizeof(uint32_t))), 1), 1);
+		w[i] = _mm512_or_si512(_mm512_ror_epi32(_mm512_and_si512(t, BMSK), 8), _mm512_rol_epi32(_mm512_andnot_si512(BMSK, t), 8));
+	}
+
+	a = _mm512_loadu_si512((const void*)state[0]);
+	b = _mm512_loadu_si512((const void*)state[1]);
+	c = _mm512_loadu_si512((const void*)state[2]);
+	d = _mm512_loadu_si512((const void*)state[3]);
+	e = _mm512_loadu_si512((const void*)state[4]);
+	f = _mm512_loadu_si512((const void*)state[5]);
+	g = _mm512_loadu_si512((const void*)state[6]);
+	h = _mm512_loadu_si512((const void*)state[7]);
+
+	for (i = 0; i < SHA2_256_ROUNDS_COUNT; i += 8)
+	{
+		if (i >= 16)
+		{
+			SHA256X16_SCHEDULE(i);
+			SHA256X16_SCHEDULE(i + 1);
+			SHA256X16_SCHEDULE(i + 2);
+			SHA256X16_SCHEDULE(i + 3);
+			SHA256X16_SCHEDULE(i + 4);
+			SHA256X16_SCHEDULE(i + 5);
+			SHA256X16_SCHEDULE(i + 6);
+			SHA256X16_SCHEDULE(i + 7);
+		}
+
+		SHA256X16_ROUND(a, b, c, d, e, f, g, h, i);
+		SHA256X16_ROUND(h, a, b, c, d, e, f, g, i + 1);
+		SHA256X16_ROUND(g, h, a, b, c, d, e, f, i + 2);
+		SHA256X16_ROUND(f, g, h, a, b, c, d, e, i + 3);
+		SHA256X16_ROUND(e, f, g, h, a, b, c, d, i + 4);
+		SHA256X16_ROUND(d, e, f, g, h, a, b, c, i + 5);
+		SHA256X16_ROUND(c, d, e, f, g, h, a, b, i + 6);
+		SHA256X16_ROUND(b, c, d, e, f, g, h, a, i + 7);
+	}
+
+	_mm512_storeu_si512((void*)state[0], _mm512_add_epi32(_mm512_loadu_si512((const void*)state[0]), a));
+	_mm512_storeu_si512((void*)state[1], _mm512_add_epi32(_mm512_loadu_si512((const void*)state[1]), b));
+	_mm512_storeu_si512((void*)state[2], _mm512_add_epi32(_mm512_loadu_si512((const void*)state[2]), c));
+	_mm512_storeu_si512((void*)state[3], _mm512_add_epi32(_mm512_loadu_si512((const void*)state[3]), d));
+	_mm512_storeu_si512((void*)state[4], _mm512_add_epi32(_mm512_loadu_si512((const void*)state[4]), e));
+	_mm512_storeu_si512((void*)state[5], _mm512_add_epi32(_mm512_loadu_si512((const void*)state[5]), f));
+	_mm512_storeu_si512((void*)state[6], _mm512_add_epi32(_mm512_loadu_si512((const void*)state[6]), g));
+	_mm512_storeu_si512((void*)state[7], _mm512_add_epi32(_mm512_loadu_si512((const void*)state[7]), h));
+}
+
+#	else
+
+#		define SHA256X8_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+#		define SHA256X8_XOR3(x, y, z) _mm256_xor_si256(_mm256_xor_si256((x), (y)), (z))
+#		define SHA256X8_SUM0(x) SHA256X8_XOR3(SHA256X8_ROTR((x), 2), SHA256X8_ROTR((x), 13), SHA256X8_ROTR((x), 22))
+#		define SHA256X8_SUM1(x) SHA256X8_XOR3(SHA256X8_ROTR((x), 6), SHA256X8_ROTR((x), 11), SHA256X8_ROTR((x), 25))
+#		define SHA256X8_SIG0(x) SHA256X8_XOR3(SHA256X8_ROTR((x), 7), SHA256X8_ROTR((x), 18), _mm256_srli_epi32((x), 3))
+#		define SHA256X8_SIG1(x) SHA256X8_XOR3(SHA256X8_ROTR((x), 17), SHA256X8_ROTR((x), 19), _mm256_srli_epi32((x), 10))
+#		define SHA256X8_CH(x, y, z) _mm256_xor_si256(_mm256_and_si256((x), (y)), _mm256_andnot_si256((x), (z)))
+#		define SHA256X8_MAJ(x, y, z) _mm256_or_si256(_mm256_and_si256((x), (y)), _mm256_and_si256((z), _mm256_or_si256((x), (y))))
+#		define SHA256X8_SCHEDULE(j) w[(j) & 15] = _mm256_add_epi32(_mm256_add_epi32(w[(j) & 15], SHA256X8_SIG1(w[((j) - 2) & 15])), \
+		_mm256_add_epi32(w[((j) - 7) & 15], SHA256X8_SIG0(w[((j) - 15) & 15])))
+#		define SHA256X8_ROUND(a, b, c, d, e, f, g, h, j) \
+		t = _mm256_add_epi32(_mm256_add_epi32((h), SHA256X8_SUM1(e)), _mm256_add_epi32(SHA256X8_CH((e), (f), (g)), \
+			_mm256_add_epi32(_mm256_set1_epi32((int32_t)sha256_k[(j)]), w[(j) & 15]))); \
+		(d) = _mm256_add_epi32((d), t); \
+		(h) = _mm256_add_epi32(t, _mm256_add_epi32(SHA256X8_SUM0(a), SHA256X8_MAJ((a), (b), (c))))
+
+static void sha256_permutex8(uint32_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_256_JOB_LANES], const uint8_t* const block[QSC_SHA2_256_JOB_LANES])
+{
+	const __m256i BSWP = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+		3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+	int64_t oft[QSC_SHA2_256_JOB_LANES];
+	__m256i w[16];
+	__m256i a;
+	__m256i b;
+	__m256i c;
+	__m256i d;
+	__m256i e;
+	__m256i f;
+	__m256i g;
+	__m256i h;
+	__m256i t;
+	__m256i x0;
+	__m256i x1;
+	size_t i;
+
+	/* the lane blocks are gathered through their offsets from the first block */
+	for (i = 0; i < QSC_SHA2_256_JOB_LANES; ++i)
+	{
+		oft[i] = (int64_t)(uintptr_t)block[i] - (int64_t)(uintptr_t)block[0];
+	}
+
+	x0 = _mm256_loadu_si256((const __m256i*)oft);
+	x1 = _mm256_loadu_si256((const __m256i*)(oft + 4));
+
+	/* gather word i of every lane block, and swap the bytes to big-endian order */
+	for (i = 0; i < 16; ++i)
+	{
+		t = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm256_i64gather_epi32((const int*)(block[0] + (i * sizeof(uint32_t))), x0, 1)),
+			_mm256_i64gather_epi32((const int*)(block[0] + (i * sizeof(uint32_t))), x1, 1), 1);
+		w[i] = _mm256_shuffle_epi8(t, BSWP);
+	}
+
+	a = _mm256_loadu_si256((const __m256i*)state[0]);
+	b = _mm256_loadu_si256((const __m256i*)state[1]);
+	c = _mm256_loadu_si256((const __m256i*)state[2]);
+	d = _mm256_loadu_si256((const __m256i*)state[3]);
+	e = _mm256_loadu_si256((const __m256i*)state[4]);
+	f = _mm256_loadu_si256((const __m256i*)state[5]);
+	g = _mm256_loadu_si256((const __m256i*)state[6]);
+	h = _mm256_loadu_si256((const __m256i*)state[7]);
+
+	for (i = 0; i < SHA2_256_ROUNDS_COUNT; i += 8)
+	{
+		if (i >= 16)
+		{
+			SHA256X8_SCHEDULE(i);
+			SHA256X8_SCHEDULE(i + 1);
+			SHA256X8_SCHEDULE(i + 2);
+			SHA256X8_SCHEDULE(i + 3);
+			SHA256X8_SCHEDULE(i + 4);
+			SHA256X8_SCHEDULE(i + 5);
+			SHA256X8_SCHEDULE(i + 6);
+			SHA256X8_SCHEDULE(i + 7);
+		}
+
+		SHA256X8_ROUND(a, b, c, d, e, f, g, h, i);
+		SHA256X8_ROUND(h, a, b, c, d, e, f, g, i + 1);
+		SHA256X8_ROUND(g, h, a, b, c, d, e, f, i + 2);
+		SHA256X8_ROUND(f, g, h, a, b, c, d, e, i + 3);
+		SHA256X8_ROUND(e, f, g, h, a, b, c, d, i + 4);
+		SHA256X8_ROUND(d, e, f, g, h, a, b, c, i + 5);
+		SHA256X8_ROUND(c, d, e, f, g, h, a, b, i + 6);
+		SHA256X8_ROUND(b, c, d, e, f, g, h, a, i + 7);
+	}
+
+	_mm256_storeu_si256((__m256i*)state[0], _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)state[0]), a));
+	_mm256_storeu_si256((__m256i*)state[1], _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)state[1]), b));
+	_mm256_storeu_si256((__m256i*)state[2], _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)state[2]), c));
+	_mm256_storeu_si256((__m256i*)state[3], _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)state[3]), d));
+	_mm256_storeu_si256((__m256i*)state[4], _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)state[4]), e));
+	_mm256_storeu_si256((__m256i*)state[5], _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)state[5]), f));
+	_mm256_storeu_si256((__m256i*)state[6], _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)state[6]), g));
+	_mm256_storeu_si256((__m256i*)state[7], _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)state[7]), h));
+}
+
+#	endif
+
+static void sha256_jobs_permute(uint32_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_256_JOB_LANES], const uint8_t* const block[QSC_SHA2_256_JOB_LANES])
+{
+#	if defined(QSC_SYSTEM_HAS_AVX512)
+	sha256_permutex16(state, block);
+#	else
+	sha256_permutex8(state, block);
+#	endif
+}
+
+static void sha256_jobs_reset(uint32_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_256_JOB_LANES], size_t lane)
+{
+	for (size_t i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+	{
+		state[i][lane] = sha256_iv[i];
+	}
+}
+
+static void sha256_job_lane_load(sha2_job_lane* lane, const qsc_sha2_job* job, qsc_sha2_job_mode mode)
+{
+	lane->job = job;
+	lane->outpos = 0;
+	lane->ctr[0] = 0;
+
+	if (mode != qsc_sha2_job_hash)
+	{
+		qsc_memutils_clear(lane->ipad, QSC_SHA2_256_RATE);
+
+		if (job->keylen > QSC_SHA2_256_RATE)
+		{
+			qsc_sha256_compute(lane->ipad, job->key, job->keylen);
+		}
+		else
+		{
+			qsc_memutils_copy(lane->ipad, job->key, job->keylen);
+		}
+
+		sha2_job_lane_key(lane, QSC_SHA2_256_RATE);
+	}
+
+	sha2_job_lane_inner(lane, mode, QSC_SHA2_256_RATE, QSC_SHA2_256_HASH_SIZE);
+}
+
+static void sha256_jobs_lanes(const qsc_sha2_job* jobs, size_t jobcount, qsc_sha2_job_mode mode)
+{
+	uint32_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_256_JOB_LANES];
+	uint8_t blk[QSC_SHA2_256_JOB_LANES][QSC_SHA2_256_RATE];
+	const uint8_t* pblk[QSC_SHA2_256_JOB_LANES];
+	uint8_t hash[QSC_SHA2_256_HASH_SIZE];
+	sha2_job_lane lanes[QSC_SHA2_256_JOB_LANES];
+	size_t active;
+	size_t i;
+	size_t j;
+	size_t len;
+	size_t next;
+	bool done;
+
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	qsc_memutils_clear((uint8_t*)blk, sizeof(blk));
+	active = 0;
+	next = 0;
+
+	for (j = 0; j < QSC_SHA2_256_JOB_LANES; ++j)
+	{
+		lanes[j].job = NULL;
+		pblk[j] = blk[j];
+
+		if (next < jobcount)
+		{
+			sha256_job_lane_load(&lanes[j], &jobs[next], mode);
+			sha256_jobs_reset(state, j);
+			++active;
+			++next;
+		}
+	}
+
+	while (active != 0)
+	{
+		/* compress the next padded block of every active lane */
+		for (j = 0; j < QSC_SHA2_256_JOB_LANES; ++j)
+		{
+			if (lanes[j].job != NULL)
+			{
+				pblk[j] = sha2_job_lane_next(&lanes[j], blk[j], QSC_SHA2_256_RATE);
+			}
+		}
+
+		sha256_jobs_permute(state, pblk);
+
+		for (j = 0; j < QSC_SHA2_256_JOB_LANES; ++j)
+		{
+			if (lanes[j].job != NULL && lanes[j].last == true)
+			{
+				for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+				{
+					qsc_intutils_be32to8(hash + (i * sizeof(uint32_t)), state[i][j]);
+				}
+
+				done = true;
+
+				if (mode != qsc_sha2_job_hash && lanes[j].outer == false)
+				{
+					/* run the outer hash in the same lane */
+					qsc_memutils_copy(lanes[j].inner, hash, sizeof(hash));
+					sha2_job_lane_outer(&lanes[j], QSC_SHA2_256_RATE, QSC_SHA2_256_HASH_SIZE);
+					done = false;
+				}
+				else if (mode == qsc_sha2_job_hkdf)
+				{
+					len = qsc_intutils_min(lanes[j].job->outlen - lanes[j].outpos, sizeof(hash));
+					qsc_memutils_copy(lanes[j].job->output + lanes[j].outpos, hash, len);
+					lanes[j].outpos += len;
+
+					if (lanes[j].outpos < lanes[j].job->outlen)
+					{
+						/* chain the next expansion block */
+						qsc_memutils_copy(lanes[j].prev, hash, sizeof(hash));
+						sha2_job_lane_inner(&lanes[j], mode, QSC_SHA2_256_RATE, QSC_SHA2_256_HASH_SIZE);
+						done = false;
+					}
+				}
+				else
+				{
+					qsc_memutils_copy(lanes[j].job->output, hash, sizeof(hash));
+				}
+
+				if (done == true)
+				{
+					if (next < jobcount)
+					{
+						sha256_job_lane_load(&lanes[j], &jobs[next], mode);
+						++next;
+					}
+					else
+					{
+						lanes[j].job = NULL;
+						pblk[j] = blk[j];
+						--active;
+					}
+				}
+
+				sha256_jobs_reset(state, j);
+			}
+		}
+	}
+
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	qsc_memutils_clear((uint8_t*)blk, sizeof(blk));
+	qsc_memutils_clear((uint8_t*)lanes, sizeof(lanes));
+	qsc_memutils_clear(hash, sizeof(hash));
+}
+
+#endif
+
+#if !defined(QSC_SYSTEM_HAS_AVX512)
+
+static void sha256_jobs_sequential(const qsc_sha2_job* jobs, size_t jobcount, qsc_sha2_job_mode mode)
+{
+	for (size_t i = 0; i < jobcount; ++i)
+	{
+		if (mode == qsc_sha2_job_hash)
+		{
+			qsc_sha256_compute(jobs[i].output, jobs[i].message, jobs[i].msglen);
+		}
+		else if (mode == qsc_sha2_job_hmac)
+		{
+			qsc_hmac256_compute(jobs[i].output, jobs[i].message, jobs[i].msglen, jobs[i].key, jobs[i].keylen);
+		}
+		else
+		{
+			qsc_hkdf256_expand(jobs[i].output, jobs[i].outlen, jobs[i].key, jobs[i].keylen, jobs[i].message, jobs[i].msglen);
+		}
+	}
+}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2) && !defined(QSC_SYSTEM_HAS_AVX512)
+
+typedef void (*sha256_jobs_function)(const qsc_sha2_job*, size_t, qsc_sha2_job_mode);
+
+static void sha256_jobs_select(const qsc_sha2_job* jobs, size_t jobcount, qsc_sha2_job_mode mode);
+
+/* resolved on first use; every thread writes the same pointer value */
+static sha256_jobs_function sha256_jobs_process = &sha256_jobs_select;
+
+static void sha256_jobs_select(const qsc_sha2_job* jobs, size_t jobcount, qsc_sha2_job_mode mode)
+{
+	qsc_cpuidex_cpu_features features;
+	sha256_jobs_function pfunc;
+
+	pfunc = &sha256_jobs_lanes;
+
+	/* eight 32-bit lanes are slower than the SHA-NI instructions applied to one message at a time */
+	if (qsc_cpuidex_features_set(&features) == true && features.shani == true)
+	{
+		pfunc = &sha256_jobs_sequential;
+	}
+
+	sha256_jobs_process = pfunc;
+	pfunc(jobs, jobcount, mode);
+}
+
+#endif
+
+void qsc_sha256_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount, qsc_sha2_job_mode mode)
+{
+	assert(jobs != NULL);
+
+	if (jobs != NULL)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+		sha256_jobs_lanes(jobs, jobcount, mode);
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+		sha256_jobs_process(jobs, jobcount, mode);
+#else
+		sha256_jobs_sequential(jobs, jobcount, mode);
+#endif
+	}
+}
+
+void qsc_hmac256_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount)
+{
+	assert(jobs != NULL);
+
+	qsc_sha256_jobs_compute(jobs, jobcount, qsc_sha2_job_hmac);
+}
+
+void qsc_hkdf256_jobs_expand(const qsc_sha2_job* jobs, size_t jobcount)
+{
+	assert(jobs != NULL);
+
+	qsc_sha256_jobs_compute(jobs, jobcount, qsc_sha2_job_hkdf);
+}
+
+/* multi-lane 64 byte SHA2-256 */
+
+static void sha256_compute64_serial(uint8_t* output, const uint8_t* message, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		qsc_sha256_compute64(output + (i * QSC_SHA2_256_HASH_SIZE), message + (i * QSC_SHA2_256_RATE));
+	}
+}
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static void sha256_compute64_lanes(uint8_t* output, const uint8_t* message, size_t count)
+{
+	uint32_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_256_JOB_LANES];
+	const uint8_t* pblk[QSC_SHA2_256_JOB_LANES];
+	size_t i;
+	size_t j;
+	size_t len;
+
+	while (count != 0)
+	{
+		len = qsc_intutils_min(count, (size_t)QSC_SHA2_256_JOB_LANES);
+
+		/* idle lanes repeat the first message */
+		for (j = 0; j < QSC_SHA2_256_JOB_LANES; ++j)
+		{
+			sha256_jobs_reset(state, j);
+			pblk[j] = (j < len) ? message + (j * QSC_SHA2_256_RATE) : message;
+		}
+
+		sha256_jobs_permute(state, pblk);
+
+		/* every lane compresses the same constant padding block */
+		for (j = 0; j < QSC_SHA2_256_JOB_LANES; ++j)
+		{
+			pblk[j] = sha256_pad64;
+		}
+
+		sha256_jobs_permute(state, pblk);
+
+		for (j = 0; j < len; ++j)
+		{
+			for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+			{
+				qsc_intutils_be32to8(output + (j * QSC_SHA2_256_HASH_SIZE) + (i * sizeof(uint32_t)), state[i][j]);
+			}
+		}
+
+		output += len * QSC_SHA2_256_HASH_SIZE;
+		message += len * QSC_SHA2_256_RATE;
+		count -= len;
+	}
+}
+
+#	if defined(QSC_SYSTEM_HAS_AVX512)
+
+static void sha256_compute64_mixed(uint8_t* output, const uint8_t* message, size_t count)
+{
+	/* sixteen full lanes outpace SHA-NI, a partly filled set of lanes does not */
+	const size_t FULL = count - (count % QSC_SHA2_256_JOB_LANES);
+
+	sha256_compute64_lanes(output, message, FULL);
+	sha256_compute64_serial(output + (FULL * QSC_SHA2_256_HASH_SIZE), message + (FULL * QSC_SHA2_256_RATE), count - FULL);
+}
+
+#	endif
+
+typedef void (*sha256_compute64_function)(uint8_t*, const uint8_t*, size_t);
+
+static void sha256_compute64_select(uint8_t* output, const uint8_t* message, size_t count);
+
+/* resolved on first use; every thread writes the same pointer value */
+static sha256_compute64_function sha256_compute64_process = &sha256_compute64_select;
+
+static void sha256_compute64_select(uint8_t* output, const uint8_t* message, size_t count)
+{
+	qsc_cpuidex_cpu_features features;
+	sha256_compute64_function pfunc;
+
+	pfunc = &sha256_compute64_lanes;
+
+	if (qsc_cpuidex_features_set(&features) == true && features.shani == true)
+	{
+#	if defined(QSC_SYSTEM_HAS_AVX512)
+		pfunc = &sha256_compute64_mixed;
+#	else
+		pfunc = &sha256_compute64_serial;
+#	endif
+	}
+
+	sha256_compute64_process = pfunc;
+	pfunc(output, message, count);
+}
+
+#endif
+
+static void sha256_compute64_many(uint8_t* output, const uint8_t* message, size_t count)
+{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	sha256_compute64_process(output, message, count);
+#else
+	sha256_compute64_serial(output, message, count);
+#endif
+}
+
+void qsc_sha256_compute64x4(uint8_t* output, const uint8_t* message)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+	sha256_compute64_many(output, message, 4);
+}
+
+void qsc_sha256_compute64x8(uint8_t* output, const uint8_t* message)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+	sha256_compute64_many(output, message, 8);
+}
+
+void qsc_sha256_compute64x16(uint8_t* output, const uint8_t* message)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+	sha256_compute64_many(output, message, 16);
+}
+
+/* multi-lane SHA2-512 */
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+#	if defined(QSC_SYSTEM_HAS_AVX512)
+
+#		define SHA512X8_SUM0(x) _mm512_ternarylogic_epi64(_mm512_ror_epi64((x), 28), _mm512_ror_epi64((x), 34), _mm512_ror_epi64((x), 39), 0x96)
+#		define SHA512X8_SUM1(x) _mm512_ternarylogic_epi64(_mm512_ror_epi64((x), 14), _mm512_ror_epi64((x), 18), _mm512_ror_epi64((x), 41), 0x96)
+#		define SHA512X8_SIG0(x) _mm512_ternarylogic_epi64(_mm512_ror_epi64((x), 1), _mm512_ror_epi64((x), 8), _mm512_srli_epi64((x), 7), 0x96)
+#		define SHA512X8_SIG1(x) _mm512_ternarylogic_epi64(_mm512_ror_epi64((x), 19), _mm512_ror_epi64((x), 61), _mm512_srli_epi64((x), 6), 0x96)
+#		define SHA512X8_CH(x, y, z) _mm512_ternarylogic_epi64((x), (y), (z), 0xCA)
+#		define SHA512X8_MAJ(x, y, z) _mm512_ternarylogic_epi64((x), (y), (z), 0xE8)
+#		define SHA512X8_SCHEDULE(j) w[(j) & 15] = _mm512_add_epi64(_mm512_add_epi64(w[(j) & 15], SHA512X8_SIG1(w[((j) - 2) & 15])), \
+		_mm512_add_epi64(w[((j) - 7) & 15], SHA512X8_SIG0(w[((j) - 15) & 15])))
+#		define SHA512X8_ROUND(a, b, c, d, e, f, g, h, j) \
+		t = _mm512_add_epi64(_mm512_add_epi64((h), SHA512X8_SUM1(e)), _mm512_add_epi64(SHA512X8_CH((e), (f), (g)), \
+			_mm512_add_epi64(_mm512_set1_epi64((int64_t)sha512_k[(j)]), w[(j) & 15]))); \
+		(d) = _mm512_add_epi64((d), t); \
+		(h) = _mm512_add_epi64(t, _mm512_add_epi64(SHA512X8_SUM0(a), SHA512X8_MAJ((a), (b), (c))))
+
+static void sha512_permutex8(uint64_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_512_JOB_LANES], const uint8_t* const block[QSC_SHA2_512_JOB_LANES])
+{
+	const __m512i BMSK = _mm512_set1_epi32(0x00FF00FFL);
+	int64_t oft[QSC_SHA2_512_JOB_LANES];
+	__m512i w[16];
+	__m512i a;
+	__m512i b;
+	__m512i c;
+	__m512i d;
+	__m512i e;
+	__m512i f;
+	__m512i g;
+	__m512i h;
+	__m512i t;
+	__m512i x0;
+	size_t i;
+
+	/* the lane blocks are gathered through their offsets from the first block */
+	for (i = 0; i < QSC_SHA2_512_JOB_LANES; ++i)
+	{
+		oft[i] = (int64_t)(uintptr_t)block[i] - (int64_t)(uintptr_t)block[0];
+	}
+
+	x0 = _mm512_loadu_si512((const void*)oft);
+
+	/* gather word i of every lane block, swap the bytes in each half, then swap the halves */
+	for (i = 0; i < 16; ++i)
+	{
+		t = _mm512_i64gather_epi64(x0, (const void*)(block[0] + (i * sizeof(uint64_t))), 1);
+		t = _mm512_or_si512(_mm512_ror_epi32(_mm512_and_si512(t, BMSK), 8), _mm512_rol_epi32(_mm512_andnot_si512(BMSK, t), 8));
+		w[i] = _mm512_ror_epi64(t, 32);
+	}
+
+	a = _mm512_loadu_si512((const void*)state[0]);
+	b = _mm512_loadu_si512((const void*)state[1]);
+	c = _mm512_loadu_si512((const void*)state[2]);
+	d = _mm512_loadu_si512((const void*)state[3]);
+	e = _mm512_loadu_si512((const void*)state[4]);
+	f = _mm512_loadu_si512((const void*)state[5]);
+	g = _mm512_loadu_si512((const void*)state[6]);
+	h = _mm512_loadu_si512((const void*)state[7]);
+
+	for (i = 0; i < SHA2_512_ROUNDS_COUNT; i += 8)
+	{
+		if (i >= 16)
+		{
+			SHA512X8_SCHEDULE(i);
+			SHA512X8_SCHEDULE(i + 1);
+			SHA512X8_SCHEDULE(i + 2);
+			SHA512X8_SCHEDULE(i + 3);
+			SHA512X8_SCHEDULE(i + 4);
+			SHA512X8_SCHEDULE(i + 5);
+			SHA512X8_SCHEDULE(i + 6);
+			SHA512X8_SCHEDULE(i + 7);
+		}
+
+		SHA512X8_ROUND(a, b, c, d, e, f, g, h, i);
+		SHA512X8_ROUND(h, a, b, c, d, e, f, g, i + 1);
+		SHA512X8_ROUND(g, h, a, b, c, d, e, f, i + 2);
+		SHA512X8_ROUND(f, g, h, a, b, c, d, e, i + 3);
+		SHA512X8_ROUND(e, f, g, h, a, b, c, d, i + 4);
+		SHA512X8_ROUND(d, e, f, g, h, a, b, c, i + 5);
+		SHA512X8_ROUND(c, d, e, f, g, h, a, b, i + 6);
+		SHA512X8_ROUND(b, c, d, e, f, g, h, a, i + 7);
+	}
+
+	_mm512_storeu_si512((void*)state[0], _mm512_add_epi64(_mm512_loadu_si512((const void*)state[0]), a));
+	_mm512_storeu_si512((void*)state[1], _mm512_add_epi64(_mm512_loadu_si512((const void*)state[1]), b));
+	_mm512_storeu_si512((void*)state[2], _mm512_add_epi64(_mm512_loadu_si512((const void*)state[2]), c));
+	_mm512_storeu_si512((void*)state[3], _mm512_add_epi64(_mm512_loadu_si512((const void*)state[3]), d));
+	_mm512_storeu_si512((void*)state[4], _mm512_add_epi64(_mm512_loadu_si512((const void*)state[4]), e));
+	_mm512_storeu_si512((void*)state[5], _mm512_add_epi64(_mm512_loadu_si512((const void*)state[5]), f));
+	_mm512_storeu_si512((void*)state[6], _mm512_add_epi64(_mm512_loadu_si512((const void*)state[6]), g));
+	_mm512_storeu_si512((void*)state[7], _mm512_add_epi64(_mm512_loadu_si512((const void*)state[7]), h));
+}
+
+#	else
+
+#		define SHA512X4_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi64((x), (n)), _mm256_slli_epi64((x), 64 - (n)))
+#		define SHA512X4_XOR3(x, y, z) _mm256_xor_si256(_mm256_xor_si256((x), (y)), (z))
+#		define SHA512X4_SUM0(x) SHA512X4_XOR3(SHA512X4_ROTR((x), 28), SHA512X4_ROTR((x), 34), SHA512X4_ROTR((x), 39))
+#		define SHA512X4_SUM1(x) SHA512X4_XOR3(SHA512X4_ROTR((x), 14), SHA512X4_ROTR((x), 18), SHA512X4_ROTR((x), 41))
+#		define SHA512X4_SIG0(x) SHA512X4_XOR3(SHA512X4_ROTR((x), 1), SHA512X4_ROTR((x), 8), _mm256_srli_epi64((x), 7))
+#		define SHA512X4_SIG1(x) SHA512X4_XOR3(SHA512X4_ROTR((x), 19), SHA512X4_ROTR((x), 61), _mm256_srli_epi64((x), 6))
+#		define SHA512X4_CH(x, y, z) _mm256_xor_si256(_mm256_and_si256((x), (y)), _mm256_andnot_si256((x), (z)))
+#		define SHA512X4_MAJ(x, y, z) _mm256_or_si256(_mm256_and_si256((x), (y)), _mm256_and_si256((z), _mm256_or_si256((x), (y))))
+#		define SHA512X4_SCHEDULE(j) w[(j) & 15] = _mm256_add_epi64(_mm256_add_epi64(w[(j) & 15], SHA512X4_SIG1(w[((j) - 2) & 15])), \
+		_mm256_add_epi64(w[((j) - 7) & 15], SHA512X4_SIG0(w[((j) - 15) & 15])))
+#		define SHA512X4_ROUND(a, b, c, d, e, f, g, h, j) \
+		t = _mm256_add_epi64(_mm256_add_epi64((h), SHA512X4_SUM1(e)), _mm256_add_epi64(SHA512X4_CH((e), (f), (g)), \
+			_mm256_add_epi64(_mm256_set1_epi64x((int64_t)sha512_k[(j)]), w[(j) & 15]))); \
+		(d) = _mm256_add_epi64((d), t); \
+		(h) = _mm256_add_epi64(t, _mm256_add_epi64(SHA512X4_SUM0(a), SHA512X4_MAJ((a), (b), (c))))
+
+static void sha512_permutex4(uint64_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_512_JOB_LANES], const uint8_t* const block[QSC_SHA2_512_JOB_LANES])
+{
+	const __m256i BSWP = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+		7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+	int64_t oft[QSC_SHA2_512_JOB_LANES];
+	__m256i w[16];
+	__m256i a;
+	__m256i b;
+	__m256i c;
+	__m256i d;
+	__m256i e;
+	__m256i f;
+	__m256i g;
+	__m256i h;
+	__m256i t;
+	__m256i x0;
+	size_t i;
+
+	/* the lane blocks are gathered through their offsets from the first block */
+	for (i = 0; i < QSC_SHA2_512_JOB_LANES; ++i)
+	{
+		oft[i] = (int64_t)(uintptr_t)block[i] - (int64_t)(uintptr_t)block[0];
+	}
+
+	x0 = _mm256_loadu_si256((const __m256i*)oft);
+
+	/* gather word i of every lane block, and swap the bytes to big-endian order */
+	for (i = 0; i < 16; ++i)
+	{
+		t = _mm256_i64gather_epi64((const long long*)(block[0] + (i * sizeof(uint64_t))), x0, 1);
+		w[i] = _mm256_shuffle_epi8(t, BSWP);
+	}
+
+	a = _mm256_loadu_si256((const __m256i*)state[0]);
+	b = _mm256_loadu_si256((const __m256i*)state[1]);
+	c = _mm256_loadu_si256((const __m256i*)state[2]);
+	d = _mm256_loadu_si256((const __m256i*)state[3]);
+	e = _mm256_loadu_si256((const __m256i*)state[4]);
+	f = _mm256_loadu_si256((const __m256i*)state[5]);
+	g = _mm256_loadu_si256((const __m256i*)state[6]);
+	h = _mm256_loadu_si256((const __m256i*)state[7]);
+
+	for (i = 0; i < SHA2_512_ROUNDS_COUNT; i += 8)
+	{
+		if (i >= 16)
+		{
+			SHA512X4_SCHEDULE(i);
+			SHA512X4_SCHEDULE(i + 1);
+			SHA512X4_SCHEDULE(i + 2);
+			SHA512X4_SCHEDULE(i + 3);
+			SHA512X4_SCHEDULE(i + 4);
+			SHA512X4_SCHEDULE(i + 5);
+			SHA512X4_SCHEDULE(i + 6);
+			SHA512X4_SCHEDULE(i + 7);
+		}
+
+		SHA512X4_ROUND(a, b, c, d, e, f, g, h, i);
+		SHA512X4_ROUND(h, a, b, c, d, e, f, g, i + 1);
+		SHA512X4_ROUND(g, h, a, b, c, d, e, f, i + 2);
+		SHA512X4_ROUND(f, g, h, a, b, c, d, e, i + 3);
+		SHA512X4_ROUND(e, f, g, h, a, b, c, d, i + 4);
+		SHA512X4_ROUND(d, e, f, g, h, a, b, c, i + 5);
+		SHA512X4_ROUND(c, d, e, f, g, h, a, b, i + 6);
+		SHA512X4_ROUND(b, c, d, e, f, g, h, a, i + 7);
+	}
+
+	_mm256_storeu_si256((__m256i*)state[0], _mm256_add_epi64(_mm256_loadu_si256((const __m256i*)state[0]), a));
+	_mm256_storeu_si256((__m256i*)state[1], _mm256_add_epi64(_mm256_loadu_si256((const __m256i*)state[1]), b));
+	_mm256_storeu_si256((__m256i*)state[2], _mm256_add_epi64(_mm256_loadu_si256((const __m256i*)state[2]), c));
+	_mm256_storeu_si256((__m256i*)state[3], _mm256_add_epi64(_mm256_loadu_si256((const __m256i*)state[3]), d));
+	_mm256_storeu_si256((__m256i*)state[4], _mm256_add_epi64(_mm256_loadu_si256((const __m256i*)state[4]), e));
+	_mm256_storeu_si256((__m256i*)state[5], _mm256_add_epi64(_mm256_loadu_si256((const __m256i*)state[5]), f));
+	_mm256_storeu_si256((__m256i*)state[6], _mm256_add_epi64(_mm256_loadu_si256((const __m256i*)state[6]), g));
+	_mm256_storeu_si256((__m256i*)state[7], _mm256_add_epi64(_mm256_loadu_si256((const __m256i*)state[7]), h));
+}
+
+#	endif
+
+static void sha512_jobs_permute(uint64_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_512_JOB_LANES], const uint8_t* const block[QSC_SHA2_512_JOB_LANES])
+{
+#	if defined(QSC_SYSTEM_HAS_AVX512)
+	sha512_permutex8(state, block);
+#	else
+	sha512_permutex4(state, block);
+#	endif
+}
+
+static void sha512_jobs_reset(uint64_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_512_JOB_LANES], const uint64_t* iv, size_t lane)
+{
+	for (size_t i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+	{
+		state[i][lane] = iv[i];
+	}
+}
+
+static void sha512_job_lane_load(sha2_job_lane* lane, const qsc_sha2_job* job, qsc_sha2_job_mode mode, size_t hashlen)
+{
+	lane->job = job;
+	lane->outpos = 0;
+	lane->ctr[0] = 0;
+
+	if (mode != qsc_sha2_job_hash)
+	{
+		qsc_memutils_clear(lane->ipad, QSC_SHA2_512_RATE);
+
+		if (job->keylen > QSC_SHA2_512_RATE)
+		{
+			qsc_sha512_compute(lane->ipad, job->key, job->keylen);
+		}
+		else
+		{
+			qsc_memutils_copy(lane->ipad, job->key, job->keylen);
+		}
+
+		sha2_job_lane_key(lane, QSC_SHA2_512_RATE);
+	}
+
+	sha2_job_lane_inner(lane, mode, QSC_SHA2_512_RATE, hashlen);
+}
+
+static void sha512_jobs_lanes(const qsc_sha2_job* jobs, size_t jobcount, qsc_sha2_job_mode mode, const uint64_t* iv, size_t hashlen)
+{
+	uint64_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_512_JOB_LANES];
+	uint8_t blk[QSC_SHA2_512_JOB_LANES][QSC_SHA2_512_RATE];
+	const uint8_t* pblk[QSC_SHA2_512_JOB_LANES];
+	uint8_t hash[QSC_SHA2_512_HASH_SIZE];
+	sha2_job_lane lanes[QSC_SHA2_512_JOB_LANES];
+	size_t active;
+	size_t i;
+	size_t j;
+	size_t len;
+	size_t next;
+	bool done;
+
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	qsc_memutils_clear((uint8_t*)blk, sizeof(blk));
+	active = 0;
+	next = 0;
+
+	for (j = 0; j < QSC_SHA2_512_JOB_LANES; ++j)
+	{
+		lanes[j].job = NULL;
+		pblk[j] = blk[j];
+
+		if (next < jobcount)
+		{
+			sha512_job_lane_load(&lanes[j], &jobs[next], mode, hashlen);
+			sha512_jobs_reset(state, iv, j);
+			++active;
+			++next;
+		}
+	}
+
+	while (active != 0)
+	{
+		/* compress the next padded block of every active lane */
+		for (j = 0; j < QSC_SHA2_512_JOB_LANES; ++j)
+		{
+			if (lanes[j].job != NULL)
+			{
+				pblk[j] = sha2_job_lane_next(&lanes[j], blk[j], QSC_SHA2_512_RATE);
+			}
+		}
+
+		sha512_jobs_permute(state, pblk);
+
+		for (j = 0; j < QSC_SHA2_512_JOB_LANES; ++j)
+		{
+			if (lanes[j].job != NULL && lanes[j].last == true)
+			{
+				for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+				{
+					qsc_intutils_be64to8(hash + (i * sizeof(uint64_t)), state[i][j]);
+				}
+
+				done = true;
+
+				if (mode != qsc_sha2_job_hash && lanes[j].outer == false)
+				{
+					/* run the outer hash in the same lane */
+					qsc_memutils_copy(lanes[j].inner, hash, hashlen);
+					sha2_job_lane_outer(&lanes[j], QSC_SHA2_512_RATE, hashlen);
+					done = false;
+				}
+				else if (mode == qsc_sha2_job_hkdf)
+				{
+					len = qsc_intutils_min(lanes[j].job->outlen - lanes[j].outpos, hashlen);
+					qsc_memutils_copy(lanes[j].job->output + lanes[j].outpos, hash, len);
+					lanes[j].outpos += len;
+
+					if (lanes[j].outpos < lanes[j].job->outlen)
+					{
+						/* chain the next expansion block */
+						qsc_memutils_copy(lanes[j].prev, hash, hashlen);
+						sha2_job_lane_inner(&lanes[j], mode, QSC_SHA2_512_RATE, hashlen);
+						done = false;
+					}
+				}
+				else
+				{
+					qsc_memutils_copy(lanes[j].job->output, hash, hashlen);
+				}
+
+				if (done == true)
+				{
+					if (next < jobcount)
+					{
+						sha512_job_lane_load(&lanes[j], &jobs[next], mode, hashlen);
+						++next;
+					}
+					else
+					{
+						lanes[j].job = NULL;
+						pblk[j] = blk[j];
+						--active;
+					}
+				}
+
+				sha512_jobs_reset(state, iv, j);
+			}
+		}
+	}
+
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	qsc_memutils_clear((uint8_t*)blk, sizeof(blk));
+	qsc_memutils_clear((uint8_t*)lanes, sizeof(lanes));
+	qsc_memutils_clear(hash, sizeof(hash));
+}
+
+#endif
+
+void qsc_sha384_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount)
+{
+	assert(jobs != NULL);
+
+	if (jobs != NULL)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+		sha512_jobs_lanes(jobs, jobcount, qsc_sha2_job_hash, sha384_iv, QSC_SHA2_384_HASH_SIZE);
+#else
+		for (size_t i = 0; i < jobcount; ++i)
+		{
+			qsc_sha384_compute(jobs[i].output, jobs[i].message, jobs[i].msglen);
+		}
+#endif
+	}
+}
+
+void qsc_sha512_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount, qsc_sha2_job_mode mode)
+{
+	assert(jobs != NULL);
+
+	if (jobs != NULL)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+		sha512_jobs_lanes(jobs, jobcount, mode, sha512_iv, QSC_SHA2_512_HASH_SIZE);
+#else
+		for (size_t i = 0; i < jobcount; ++i)
+		{
+			if (mode == qsc_sha2_job_hash)
+			{
+				qsc_sha512_compute(jobs[i].output, jobs[i].message, jobs[i].msglen);
+			}
+			else if (mode == qsc_sha2_job_hmac)
+			{
+				qsc_hmac512_compute(jobs[i].output, jobs[i].message, jobs[i].msglen, jobs[i].key, jobs[i].keylen);
+			}
+			else
+			{
+				qsc_hkdf512_expand(jobs[i].output, jobs[i].outlen, jobs[i].key, jobs[i].keylen, jobs[i].message, jobs[i].msglen);
+			}
+		}
+#endif
+	}
+}
+
+void qsc_hmac512_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount)
+{
+	assert(jobs != NULL);
+
+	qsc_sha512_jobs_compute(jobs, jobcount, qsc_sha2_job_hmac);
+}
+
+void qsc_hkdf512_jobs_expand(const qsc_sha2_job* jobs, size_t jobcount)
+{
+	assert(jobs != NULL);
+
+	qsc_sha512_jobs_compute(jobs, jobcount, qsc_sha2_job_hkdf);
+}
+
+/* PBKDF2-SHA256 */
+
+static void pbkdf2_sha256_first(uint8_t* block, const qsc_hmac256_state* kctx, const uint8_t* salt, size_t saltlen, uint32_t index)
+{
+	qsc_hmac256_state ctx;
+	uint8_t ctr[sizeof(uint32_t)] = { 0 };
+
+	/* U1 = HMAC(P, S || INT(i)) */
+	qsc_hmac256_clone(&ctx, kctx);
+
+	if (saltlen != 0)
+	{
+		qsc_hmac256_update(&ctx, salt, saltlen);
+	}
+
+	qsc_intutils_be32to8(ctr, index);
+	qsc_hmac256_update(&ctx, ctr, sizeof(ctr));
+	qsc_hmac256_finalize(&ctx, block);
+
+	/* the later inner and outer messages are one hash following a keyed pad block,
+	   so every iteration compresses the same padded block layout */
+	qsc_memutils_clear(block + QSC_SHA2_256_HASH_SIZE, QSC_SHA2_256_RATE - QSC_SHA2_256_HASH_SIZE);
+	block[QSC_SHA2_256_HASH_SIZE] = 0x80;
+	qsc_intutils_be64to8(block + QSC_SHA2_256_RATE - sizeof(uint64_t), (uint64_t)(QSC_SHA2_256_RATE + QSC_SHA2_256_HASH_SIZE) * 8);
+}
+
+static void pbkdf2_sha256_iterate(uint8_t* tmpt, uint8_t* block, const qsc_hmac256_state* kctx, size_t iterations)
+{
+	uint32_t state[QSC_SHA2_STATE_SIZE];
+	size_t i;
+	size_t j;
+
+	for (i = 1; i < iterations; ++i)
+	{
+		/* Ui = HMAC(P, Ui-1), the inner and outer hashes start from the keyed chaining values */
+		qsc_memutils_copy(state, kctx->pstate.state, sizeof(state));
+		qsc_sha256_permute(state, block);
+
+		for (j = 0; j < QSC_SHA2_STATE_SIZE; ++j)
+		{
+			qsc_intutils_be32to8(block + (j * sizeof(uint32_t)), state[j]);
+		}
+
+		qsc_memutils_copy(state, kctx->ostate.state, sizeof(state));
+		qsc_sha256_permute(state, block);
+
+		for (j = 0; j < QSC_SHA2_STATE_SIZE; ++j)
+		{
+			qsc_intutils_be32to8(block + (j * sizeof(uint32_t)), state[j]);
+		}
+
+		qsc_memutils_xor(tmpt, block, QSC_SHA2_256_HASH_SIZE);
+	}
+
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+}
+
+#if !defined(QSC_SYSTEM_HAS_AVX512)
+
+static void pbkdf2_sha256_sequential(const qsc_sha2_job* jobs, size_t jobcount, size_t iterations)
+{
+	qsc_hmac256_state kctx;
+	uint8_t blk[QSC_SHA2_256_RATE];
+	uint8_t tmpt[QSC_SHA2_256_HASH_SIZE];
+	size_t i;
+	size_t len;
+	size_t pos;
+
+	for (i = 0; i < jobcount; ++i)
+	{
+		if (jobs[i].outlen != 0)
+		{
+			qsc_hmac256_initialize(&kctx, jobs[i].key, jobs[i].keylen);
+
+			for (pos = 0; pos < jobs[i].outlen; pos += len)
+			{
+				len = qsc_intutils_min(jobs[i].outlen - pos, (size_t)QSC_SHA2_256_HASH_SIZE);
+				pbkdf2_sha256_first(blk, &kctx, jobs[i].message, jobs[i].msglen, (uint32_t)((pos / QSC_SHA2_256_HASH_SIZE) + 1));
+				qsc_memutils_copy(tmpt, blk, sizeof(tmpt));
+				pbkdf2_sha256_iterate(tmpt, blk, &kctx, iterations);
+				qsc_memutils_copy(jobs[i].output + pos, tmpt, len);
+			}
+
+			qsc_hmac256_dispose(&kctx);
+		}
+	}
+
+	qsc_memutils_clear(blk, sizeof(blk));
+	qsc_memutils_clear(tmpt, sizeof(tmpt));
+}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static void pbkdf2_sha256_lanes(const qsc_sha2_job* jobs, size_t jobcount, size_t iterations)
+{
+	uint32_t istate[QSC_SHA2_STATE_SIZE][QSC_SHA2_256_JOB_LANES];
+	uint32_t ostate[QSC_SHA2_STATE_SIZE][QSC_SHA2_256_JOB_LANES];
+	uint32_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_256_JOB_LANES];
+	uint8_t blk[QSC_SHA2_256_JOB_LANES][QSC_SHA2_256_RATE];
+	uint8_t tmpt[QSC_SHA2_256_JOB_LANES][QSC_SHA2_256_HASH_SIZE];
+	const uint8_t* pblk[QSC_SHA2_256_JOB_LANES];
+	uint8_t* pout[QSC_SHA2_256_JOB_LANES];
+	size_t olen[QSC_SHA2_256_JOB_LANES];
+	qsc_hmac256_state kctx;
+	size_t count;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t next;
+	size_t pos;
+
+	qsc_memutils_clear((uint8_t*)istate, sizeof(istate));
+	qsc_memutils_clear((uint8_t*)ostate, sizeof(ostate));
+	qsc_memutils_clear((uint8_t*)blk, sizeof(blk));
+	qsc_memutils_clear((uint8_t*)&kctx, sizeof(kctx));
+	next = 0;
+	pos = 0;
+
+	for (j = 0; j < QSC_SHA2_256_JOB_LANES; ++j)
+	{
+		pblk[j] = blk[j];
+	}
+
+	while (next < jobcount)
+	{
+		count = 0;
+
+		/* each lane derives one output block; the blocks of a long output and the blocks of the next jobs fill the lanes */
+		while (count < QSC_SHA2_256_JOB_LANES && next < jobcount)
+		{
+			if (pos >= jobs[next].outlen)
+			{
+				++next;
+				pos = 0;
+				continue;
+			}
+
+			if (pos == 0)
+			{
+				qsc_hmac256_initialize(&kctx, jobs[next].key, jobs[next].keylen);
+			}
+
+			olen[count] = qsc_intutils_min(jobs[next].outlen - pos, (size_t)QSC_SHA2_256_HASH_SIZE);
+			pout[count] = jobs[next].output + pos;
+			pbkdf2_sha256_first(blk[count], &kctx, jobs[next].message, jobs[next].msglen, (uint32_t)((pos / QSC_SHA2_256_HASH_SIZE) + 1));
+			qsc_memutils_copy(tmpt[count], blk[count], QSC_SHA2_256_HASH_SIZE);
+
+			for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+			{
+				istate[i][count] = kctx.pstate.state[i];
+				ostate[i][count] = kctx.ostate.state[i];
+			}
+
+			pos += olen[count];
+			++count;
+		}
+
+		if (count == 1)
+		{
+			/* a single block runs faster on the serial compression */
+			pbkdf2_sha256_iterate(tmpt[0], blk[0], &kctx, iterations);
+		}
+		else if (count != 0)
+		{
+			for (k = 1; k < iterations; ++k)
+			{
+				qsc_memutils_copy((uint8_t*)state, (const uint8_t*)istate, sizeof(state));
+				sha256_jobs_permute(state, pblk);
+
+				for (j = 0; j < count; ++j)
+				{
+					for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+					{
+						qsc_intutils_be32to8(blk[j] + (i * sizeof(uint32_t)), state[i][j]);
+					}
+				}
+
+				qsc_memutils_copy((uint8_t*)state, (const uint8_t*)ostate, sizeof(state));
+				sha256_jobs_permute(state, pblk);
+
+				for (j = 0; j < count; ++j)
+				{
+					for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+					{
+						qsc_intutils_be32to8(blk[j] + (i * sizeof(uint32_t)), state[i][j]);
+					}
+
+					qsc_memutils_xor(tmpt[j], blk[j], QSC_SHA2_256_HASH_SIZE);
+				}
+			}
+		}
+
+		for (j = 0; j < count; ++j)
+		{
+			qsc_memutils_copy(pout[j], tmpt[j], olen[j]);
+		}
+	}
+
+	qsc_hmac256_dispose(&kctx);
+	qsc_memutils_clear((uint8_t*)istate, sizeof(istate));
+	qsc_memutils_clear((uint8_t*)ostate, sizeof(ostate));
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	qsc_memutils_clear((uint8_t*)blk, sizeof(blk));
+	qsc_memutils_clear((uint8_t*)tmpt, sizeof(tmpt));
+}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2) && !defined(QSC_SYSTEM_HAS_AVX512)
+
+typedef void (*pbkdf2_sha256_function)(const qsc_sha2_job*, size_t, size_t);
+
+static void pbkdf2_sha256_select(const qsc_sha2_job* jobs, size_t jobcount, size_t iterations);
+
+/* resolved on first use; every thread writes the same pointer value */
+static pbkdf2_sha256_function pbkdf2_sha256_process = &pbkdf2_sha256_select;
+
+static void pbkdf2_sha256_select(const qsc_sha2_job* jobs, size_t jobcount, size_t iterations)
+{
+	qsc_cpuidex_cpu_features features;
+	pbkdf2_sha256_function pfunc;
+
+	pfunc = &pbkdf2_sha256_lanes;
+
+	/* as with the SHA2-256 jobs, SHA-NI outpaces eight 32-bit lanes */
+	if (qsc_cpuidex_features_set(&features) == true && features.shani == true)
+	{
+		pfunc = &pbkdf2_sha256_sequential;
+	}
+
+	pbkdf2_sha256_process = pfunc;
+	pfunc(jobs, jobcount, iterations);
+}
+
+#endif
+
+void qsc_pbkdf2_sha256_compute(uint8_t* output, size_t outlen, const uint8_t* password, size_t passlen, const uint8_t* salt, size_t saltlen, size_t iterations)
+{
+	assert(output != NULL);
+	assert(password != NULL);
+	assert(iterations != 0);
+
+	qsc_sha2_job job;
+
+	job.message = salt;
+	job.msglen = saltlen;
+	job.key = password;
+	job.keylen = passlen;
+	job.output = output;
+	job.outlen = outlen;
+
+	qsc_pbkdf2_sha256_jobs_compute(&job, 1, iterations);
+}
+
+void qsc_pbkdf2_sha256_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount, size_t iterations)
+{
+	assert(jobs != NULL);
+	assert(iterations != 0);
+
+	if (jobs != NULL)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+		pbkdf2_sha256_lanes(jobs, jobcount, iterations);
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+		pbkdf2_sha256_process(jobs, jobcount, iterations);
+#else
+		pbkdf2_sha256_sequential(jobs, jobcount, iterations);
+#endif
+	}
+}
+
+/* PBKDF2-SHA512 */
+
+static void pbkdf2_sha512_first(uint8_t* block, const qsc_hmac512_state* kctx, const uint8_t* salt, size_t saltlen, uint32_t index)
+{
+	qsc_hmac512_state ctx;
+	uint8_t ctr[sizeof(uint32_t)] = { 0 };
+
+	/* U1 = HMAC(P, S || INT(i)) */
+	qsc_hmac512_clone(&ctx, kctx);
+
+	if (saltlen != 0)
+	{
+		qsc_hmac512_update(&ctx, salt, saltlen);
+	}
+
+	qsc_intutils_be32to8(ctr, index);
+	qsc_hmac512_update(&ctx, ctr, sizeof(ctr));
+	qsc_hmac512_finalize(&ctx, block);
+
+	/* the later inner and outer messages are one hash following a keyed pad block,
+	   so every iteration compresses the same padded block layout */
+	qsc_memutils_clear(block + QSC_SHA2_512_HASH_SIZE, QSC_SHA2_512_RATE - QSC_SHA2_512_HASH_SIZE);
+	block[QSC_SHA2_512_HASH_SIZE] = 0x80;
+	qsc_intutils_be64to8(block + QSC_SHA2_512_RATE - sizeof(uint64_t), (uint64_t)(QSC_SHA2_512_RATE + QSC_SHA2_512_HASH_SIZE) * 8);
+}
+
+static void pbkdf2_sha512_iterate(uint8_t* tmpt, uint8_t* block, const qsc_hmac512_state* kctx, size_t iterations)
+{
+	uint64_t state[QSC_SHA2_STATE_SIZE];
+	size_t i;
+	size_t j;
+
+	for (i = 1; i < iterations; ++i)
+	{
+		/* Ui = HMAC(P, Ui-1), the inner and outer hashes start from the keyed chaining values */
+		qsc_memutils_copy(state, kctx->pstate.state, sizeof(state));
+		qsc_sha512_permute(state, block);
+
+		for (j = 0; j < QSC_SHA2_STATE_SIZE; ++j)
+		{
+			qsc_intutils_be64to8(block + (j * sizeof(uint64_t)), state[j]);
+		}
+
+		qsc_memutils_copy(state, kctx->ostate.state, sizeof(state));
+		qsc_sha512_permute(state, block);
+
+		for (j = 0; j < QSC_SHA2_STATE_SIZE; ++j)
+		{
+			qsc_intutils_be64to8(block + (j * sizeof(uint64_t)), state[j]);
+		}
+
+		qsc_memutils_xor(tmpt, block, QSC_SHA2_512_HASH_SIZE);
+	}
+
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+}
+
+#if !defined(QSC_SYSTEM_HAS_AVX2)
+
+static void pbkdf2_sha512_sequential(const qsc_sha2_job* jobs, size_t jobcount, size_t iterations)
+{
+	qsc_hmac512_state kctx;
+	uint8_t blk[QSC_SHA2_512_RATE];
+	uint8_t tmpt[QSC_SHA2_512_HASH_SIZE];
+	size_t i;
+	size_t len;
+	size_t pos;
+
+	for (i = 0; i < jobcount; ++i)
+	{
+		if (jobs[i].outlen != 0)
+		{
+			qsc_hmac512_initialize(&kctx, jobs[i].key, jobs[i].keylen);
+
+			for (pos = 0; pos < jobs[i].outlen; pos += len)
+			{
+				len = qsc_intutils_min(jobs[i].outlen - pos, (size_t)QSC_SHA2_512_HASH_SIZE);
+				pbkdf2_sha512_first(blk, &kctx, jobs[i].message, jobs[i].msglen, (uint32_t)((pos / QSC_SHA2_512_HASH_SIZE) + 1));
+				qsc_memutils_copy(tmpt, blk, sizeof(tmpt));
+				pbkdf2_sha512_iterate(tmpt, blk, &kctx, iterations);
+				qsc_memutils_copy(jobs[i].output + pos, tmpt, len);
+			}
+
+			qsc_hmac512_dispose(&kctx);
+		}
+	}
+
+	qsc_memutils_clear(blk, sizeof(blk));
+	qsc_memutils_clear(tmpt, sizeof(tmpt));
+}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static void pbkdf2_sha512_lanes(const qsc_sha2_job* jobs, size_t jobcount, size_t iterations)
+{
+	uint64_t istate[QSC_SHA2_STATE_SIZE][QSC_SHA2_512_JOB_LANES];
+	uint64_t ostate[QSC_SHA2_STATE_SIZE][QSC_SHA2_512_JOB_LANES];
+	uint64_t state[QSC_SHA2_STATE_SIZE][QSC_SHA2_512_JOB_LANES];
+	uint8_t blk[QSC_SHA2_512_JOB_LANES][QSC_SHA2_512_RATE];
+	uint8_t tmpt[QSC_SHA2_512_JOB_LANES][QSC_SHA2_512_HASH_SIZE];
+	const uint8_t* pblk[QSC_SHA2_512_JOB_LANES];
+	uint8_t* pout[QSC_SHA2_512_JOB_LANES];
+	size_t olen[QSC_SHA2_512_JOB_LANES];
+	qsc_hmac512_state kctx;
+	size_t count;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t next;
+	size_t pos;
+
+	qsc_memutils_clear((uint8_t*)istate, sizeof(istate));
+	qsc_memutils_clear((uint8_t*)ostate, sizeof(ostate));
+	qsc_memutils_clear((uint8_t*)blk, sizeof(blk));
+	qsc_memutils_clear((uint8_t*)&kctx, sizeof(kctx));
+	next = 0;
+	pos = 0;
+
+	for (j = 0; j < QSC_SHA2_512_JOB_LANES; ++j)
+	{
+		pblk[j] = blk[j];
+	}
+
+	while (next < jobcount)
+	{
+		count = 0;
+
+		/* each lane derives one output block; the blocks of a long output and the blocks of the next jobs fill the lanes */
+		while (count < QSC_SHA2_512_JOB_LANES && next < jobcount)
+		{
+			if (pos >= jobs[next].outlen)
+			{
+				++next;
+				pos = 0;
+				continue;
+			}
+
+			if (pos == 0)
+			{
+				qsc_hmac512_initialize(&kctx, jobs[next].key, jobs[next].keylen);
+			}
+
+			olen[count] = qsc_intutils_min(jobs[next].outlen - pos, (size_t)QSC_SHA2_512_HASH_SIZE);
+			pout[count] = jobs[next].output + pos;
+			pbkdf2_sha512_first(blk[count], &kctx, jobs[next].message, jobs[next].msglen, (uint32_t)((pos / QSC_SHA2_512_HASH_SIZE) + 1));
+			qsc_memutils_copy(tmpt[count], blk[count], QSC_SHA2_512_HASH_SIZE);
+
+			for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+			{
+				istate[i][count] = kctx.pstate.state[i];
+				ostate[i][count] = kctx.ostate.state[i];
+			}
+
+			pos += olen[count];
+			++count;
+		}
+
+		if (count == 1)
+		{
+			/* a single block runs faster on the serial compression */
+			pbkdf2_sha512_iterate(tmpt[0], blk[0], &kctx, iterations);
+		}
+		else if (count != 0)
+		{
+			for (k = 1; k < iterations; ++k)
+			{
+				qsc_memutils_copy((uint8_t*)state, (const uint8_t*)istate, sizeof(state));
+				sha512_jobs_permute(state, pblk);
+
+				for (j = 0; j < count; ++j)
+				{
+					for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+					{
+						qsc_intutils_be64to8(blk[j] + (i * sizeof(uint64_t)), state[i][j]);
+					}
+				}
+
+				qsc_memutils_copy((uint8_t*)state, (const uint8_t*)ostate, sizeof(state));
+				sha512_jobs_permute(state, pblk);
+
+				for (j = 0; j < count; ++j)
+				{
+					for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+					{
+						qsc_intutils_be64to8(blk[j] + (i * sizeof(uint64_t)), state[i][j]);
+					}
+
+					qsc_memutils_xor(tmpt[j], blk[j], QSC_SHA2_512_HASH_SIZE);
+				}
+			}
+		}
+
+		for (j = 0; j < count; ++j)
+		{
+			qsc_memutils_copy(pout[j], tmpt[j], olen[j]);
+		}
+	}
+
+	qsc_hmac512_dispose(&kctx);
+	qsc_memutils_clear((uint8_t*)istate, sizeof(istate));
+	qsc_memutils_clear((uint8_t*)ostate, sizeof(ostate));
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	qsc_memutils_clear((uint8_t*)blk, sizeof(blk));
+	qsc_memutils_clear((uint8_t*)tmpt, sizeof(tmpt));
+}
+
+#endif
+
+void qsc_pbkdf2_sha512_compute(uint8_t* output, size_t outlen, const uint8_t* password, size_t passlen, const uint8_t* salt, size_t saltlen, size_t iterations)
+{
+	assert(output != NULL);
+	assert(password != NULL);
+	assert(iterations != 0);
+
+	qsc_sha2_job job;
+
+	job.message = salt;
+	job.msglen = saltlen;
+	job.key = password;
+	job.keylen = passlen;
+	job.output = output;
+	job.outlen = outlen;
+
+	qsc_pbkdf2_sha512_jobs_compute(&job, 1, iterations);
+}
+
+void qsc_pbkdf2_sha512_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount, size_t iterations)
+{
+	assert(jobs != NULL);
+	assert(iterations != 0);
+
+	if (jobs != NULL)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+		pbkdf2_sha512_lanes(jobs, jobcount, iterations);
+#else
+		pbkdf2_sha512_sequential(jobs, jobcount, iterations);
+#endif
+	}
+}
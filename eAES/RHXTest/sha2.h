@@ -66,8 +66,9 @@
 
 /*!
 * \def QSC_SHA2_SHANI_ENABLED
-* \brief Enables the SHA2 permutation intrinsics.
-* For testing only; add this flag to your preprocessor definitions to enable SHA-NI intrinsics.
+* \brief Forces the SHA2-256 permutation to use the SHA-NI intrinsics.
+* By default the SHA-NI permutation is selected at runtime when the CPU reports support for it.
+* For testing only; add this flag to your preprocessor definitions to bypass the runtime check.
 */
 #if !defined(QSC_SHA2_SHANI_ENABLED)
 //#	define QSC_SHA2_SHANI_ENABLED
@@ -189,6 +190,17 @@ QSC_EXPORT_API typedef struct
 */
 QSC_EXPORT_API void qsc_sha256_compute(uint8_t* output, const uint8_t* message, size_t msglen);
 
+/**
+* \brief Compute the SHA2-256 hash of a 64 byte message, such as a Merkle tree node of two 32 byte child hashes.
+* The message is compressed as one block, followed by a constant padding block; the state buffering is bypassed.
+*
+* \warning The output array must be at least 32 bytes in length.
+*
+* \param output: The output byte array; receives the hash code
+* \param message: [const] The 64 byte message array
+*/
+QSC_EXPORT_API void qsc_sha256_compute64(uint8_t* output, const uint8_t* message);
+
 /**
 * \brief Dispose of the SHA2-256 state.
 * This function destroys the internal state of the cipher.
@@ -398,11 +410,22 @@ QSC_EXPORT_API void qsc_sha512_update(qsc_sha512_state* ctx, const uint8_t* mess
 */
 QSC_EXPORT_API typedef struct
 {
-	qsc_sha256_state pstate;			/*!< The SHA2-256 state  */
-	uint8_t ipad[QSC_SHA2_256_RATE];	/*!< The input pad array  */
-	uint8_t opad[QSC_SHA2_256_RATE];	/*!< The output pad array  */
+	qsc_sha256_state pstate;			/*!< The inner SHA2-256 state, keyed with the input pad  */
+	qsc_sha256_state ostate;			/*!< The outer SHA2-256 state, keyed with the output pad  */
+	uint32_t ikey[QSC_SHA2_STATE_SIZE];		/*!< The inner chaining value after the input pad; restored by the reset  */
 } qsc_hmac256_state;
 
+/**
+* \brief Clone a keyed HMAC-256 state.
+* The state is keyed once with the initialize function, and cloned for each message,
+* the clone replaces the two compression calls used to process the input and output pads.
+* The clone is erased by the finalize or dispose functions, the source state is unchanged.
+*
+* \param output: [struct] The destination state; receives a copy of the input state
+* \param input: [const][struct] The initialized source state
+*/
+QSC_EXPORT_API void qsc_hmac256_clone(qsc_hmac256_state* output, const qsc_hmac256_state* input);
+
 /**
 * \brief Process a message with HMAC(SHA2-256) and returns the hash code in the output byte array.
 * Short form api: processes the key and complete message, and generates the MAC code with a single call.
@@ -439,6 +462,19 @@ QSC_EXPORT_API void qsc_hmac256_dispose(qsc_hmac256_state* ctx);
 */
 QSC_EXPORT_API void qsc_hmac256_finalize(qsc_hmac256_state* ctx, uint8_t* output);
 
+/**
+* \brief Finalize the HMAC-256 message state, return the hash value in output, and reset the state for the next message.
+* The outer hash is computed on a copy of the keyed outer state, and the inner state is restored to the keyed input pad,
+* so a sequence of messages under one key is processed without calling the initialize function again.
+* Produces a 32 byte output code.
+*
+* \warning The state must be erased with the dispose function when the key is no longer needed.
+*
+* \param ctx: [struct] The function state; must be initialized
+* \param output: The output byte array; receives the hash code
+*/
+QSC_EXPORT_API void qsc_hmac256_finalize_and_reset(qsc_hmac256_state* ctx, uint8_t* output);
+
 /**
 * \brief Initializes an HMAC-256 state structure with a key, must be called before message processing.
 * Long form api: must be used in conjunction with the update and finalize functions.
@@ -469,11 +505,22 @@ QSC_EXPORT_API void qsc_hmac256_update(qsc_hmac256_state* ctx, const uint8_t* me
 */
 QSC_EXPORT_API typedef struct
 {
-	qsc_sha512_state pstate;			/*!< The SHA2-512 state  */
-	uint8_t ipad[QSC_SHA2_512_RATE];	/*!< The input pad array  */
-	uint8_t opad[QSC_SHA2_512_RATE];	/*!< The output pad array  */
+	qsc_sha512_state pstate;			/*!< The inner SHA2-512 state, keyed with the input pad  */
+	qsc_sha512_state ostate;			/*!< The outer SHA2-512 state, keyed with the output pad  */
+	uint64_t ikey[QSC_SHA2_STATE_SIZE];		/*!< The inner chaining value after the input pad; restored by the reset  */
 } qsc_hmac512_state;
 
+/**
+* \brief Clone a keyed HMAC-512 state.
+* The state is keyed once with the initialize function, and cloned for each message,
+* the clone replaces the two compression calls used to process the input and output pads.
+* The clone is erased by the finalize or dispose functions, the source state is unchanged.
+*
+* \param output: [struct] The destination state; receives a copy of the input state
+* \param input: [const][struct] The initialized source state
+*/
+QSC_EXPORT_API void qsc_hmac512_clone(qsc_hmac512_state* output, const qsc_hmac512_state* input);
+
 /**
 * \brief Process a message with SHA2-512 and returns the hash code in the output byte array.
 * Short form api: processes the key and complete message, and generates the MAC code with a single call.
@@ -512,6 +559,19 @@ QSC_EXPORT_API void qsc_hmac512_dispose(qsc_hmac512_state* ctx);
 */
 QSC_EXPORT_API void qsc_hmac512_finalize(qsc_hmac512_state* ctx, uint8_t* output);
 
+/**
+* \brief Finalize the HMAC-512 message state, return the hash value in output, and reset the state for the next message.
+* The outer hash is computed on a copy of the keyed outer state, and the inner state is restored to the keyed input pad,
+* so a sequence of messages under one key is processed without calling the initialize function again.
+* Produces a 64 byte output code.
+*
+* \warning The state must be erased with the dispose function when the key is no longer needed.
+*
+* \param ctx: [struct] The function state; must be initialized
+* \param output: The output byte array; receives the hash code
+*/
+QSC_EXPORT_API void qsc_hmac512_finalize_and_reset(qsc_hmac512_state* ctx, uint8_t* output);
+
 /**
 * \brief Initializes an HMAC-512 state structure with a key, must be called before message processing.
 * Long form api: must be used in conjunction with the update and finalize functions.
@@ -539,6 +599,7 @@ QSC_EXPORT_API void qsc_hmac512_update(qsc_hmac512_state* ctx, const uint8_t* me
 /**
 * \brief Initialize an instance of HKDF(HMAC(SHA2-256)), and output an array of pseudo-random.
 * Short form api: initializes with the key and user info, and generates the output pseudo-random with a single call.
+* The HMAC pads are keyed once, and each output block is generated from a clone of the keyed state.
 *
 * \param output: The output pseudo-random byte array
 * \param outlen: The output array length
@@ -564,6 +625,7 @@ QSC_EXPORT_API void qsc_hkdf256_extract(uint8_t* output, size_t outlen, const ui
 /**
 * \brief Initialize an instance of HKDF(HMAC(SHA2-512)), and output an array of pseudo-random.
 * Short form api: initializes with the key and user info, and generates the output pseudo-random with a single call.
+* The HMAC pads are keyed once, and each output block is generated from a clone of the keyed state.
 *
 * \param output: The output pseudo-random byte array
 * \param outlen: The output array length
@@ -586,4 +648,219 @@ QSC_EXPORT_API void qsc_hkdf512_expand(uint8_t* output, size_t outlen, const uin
 */
 QSC_EXPORT_API void qsc_hkdf512_extract(uint8_t* output, size_t outlen, const uint8_t* key, size_t keylen, const uint8_t* salt, size_t saltlen);
 
+/* multi-lane SHA2 jobs */
+
+/*!
+* \def QSC_SHA2_256_JOB_LANES
+* \brief The number of SHA2-256 instances processed simultaneously by the job scheduler
+*/
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define QSC_SHA2_256_JOB_LANES 16
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define QSC_SHA2_256_JOB_LANES 8
+#else
+#	define QSC_SHA2_256_JOB_LANES 1
+#endif
+
+/*!
+* \def QSC_SHA2_512_JOB_LANES
+* \brief The number of SHA2-384 or SHA2-512 instances processed simultaneously by the job scheduler
+*/
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define QSC_SHA2_512_JOB_LANES 8
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define QSC_SHA2_512_JOB_LANES 4
+#else
+#	define QSC_SHA2_512_JOB_LANES 1
+#endif
+
+/*!
+* \enum qsc_sha2_job_mode
+* \brief The SHA2 function applied to every job in a queue
+*/
+typedef enum
+{
+	qsc_sha2_job_hash = 0x01,						/*!< SHA2; the output is the digest  */
+	qsc_sha2_job_hmac = 0x02,						/*!< HMAC(SHA2); the output is the mac-code  */
+	qsc_sha2_job_hkdf = 0x03,						/*!< HKDF-Expand(HMAC(SHA2)); the message is the info string  */
+} qsc_sha2_job_mode;
+
+/*!
+* \struct qsc_sha2_job
+* \brief A single hash, MAC or key derivation request; lengths are independent of the other jobs in the queue
+*/
+QSC_EXPORT_API typedef struct
+{
+	const uint8_t* message;							/*!< The message, the HKDF info string, or the PBKDF2 salt  */
+	size_t msglen;									/*!< The message length in bytes  */
+	const uint8_t* key;								/*!< The HMAC or HKDF key, or the PBKDF2 password; unused by the hash mode  */
+	size_t keylen;									/*!< The key length in bytes  */
+	uint8_t* output;								/*!< The output array  */
+	size_t outlen;									/*!< The HKDF or PBKDF2 output length; the hash and MAC modes write a full digest  */
+} qsc_sha2_job;
+
+/**
+* \brief Process a queue of independent SHA2-256 jobs across the SIMD lanes.
+* Each lane holds one message in a 32-bit word of the vector state, and pads its message independently;
+* when a lane has generated its output, the next pending job is loaded into it.
+* HMAC jobs run the inner and outer hashes in the same lane, and HKDF jobs chain their expansion blocks.
+* Processes 16 lanes with AVX-512, 8 lanes with AVX2, or the jobs sequentially;
+* AVX2 builds also run the jobs sequentially on a CPU with SHA-NI, which outpaces eight 32-bit lanes.
+*
+* \param jobs: [const] The array of jobs
+* \param jobcount: The number of jobs in the array
+* \param mode: The SHA2 function applied to all jobs
+*/
+QSC_EXPORT_API void qsc_sha256_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount, qsc_sha2_job_mode mode);
+
+/**
+* \brief Compute the HMAC(SHA2-256) mac-codes of a queue of jobs across the SIMD lanes.
+* Each job has its own key and message; the 32 byte mac-code is written to the job output.
+*
+* \param jobs: [const] The array of jobs
+* \param jobcount: The number of jobs in the array
+*/
+QSC_EXPORT_API void qsc_hmac256_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount);
+
+/**
+* \brief Expand the keys of a queue of jobs with HKDF(HMAC(SHA2-256)) across the SIMD lanes.
+* Each job has its own key, info string and output length.
+*
+* \param jobs: [const] The array of jobs
+* \param jobcount: The number of jobs in the array
+*/
+QSC_EXPORT_API void qsc_hkdf256_jobs_expand(const qsc_sha2_job* jobs, size_t jobcount);
+
+/**
+* \brief Compute the SHA2-256 hashes of 4 contiguous 64 byte messages.
+* Message i is read at offset i * 64, and its hash is written at output offset i * 32,
+* so one call hashes four adjacent pairs of Merkle child nodes into their parents.
+* The messages are hashed across the SIMD lanes, or with SHA-NI one at a time when the CPU supports it.
+*
+* \warning The message array must be at least 256 bytes, and the output array at least 128 bytes in length.
+*
+* \param output: The output byte array; receives the 4 hash codes
+* \param message: [const] The 4 contiguous message arrays
+*/
+QSC_EXPORT_API void qsc_sha256_compute64x4(uint8_t* output, const uint8_t* message);
+
+/**
+* \brief Compute the SHA2-256 hashes of 8 contiguous 64 byte messages.
+* Message i is read at offset i * 64, and its hash is written at output offset i * 32.
+*
+* \warning The message array must be at least 512 bytes, and the output array at least 256 bytes in length.
+*
+* \param output: The output byte array; receives the 8 hash codes
+* \param message: [const] The 8 contiguous message arrays
+*/
+QSC_EXPORT_API void qsc_sha256_compute64x8(uint8_t* output, const uint8_t* message);
+
+/**
+* \brief Compute the SHA2-256 hashes of 16 contiguous 64 byte messages.
+* Message i is read at offset i * 64, and its hash is written at output offset i * 32.
+*
+* \warning The message array must be at least 1024 bytes, and the output array at least 512 bytes in length.
+*
+* \param output: The output byte array; receives the 16 hash codes
+* \param message: [const] The 16 contiguous message arrays
+*/
+QSC_EXPORT_API void qsc_sha256_compute64x16(uint8_t* output, const uint8_t* message);
+
+/**
+* \brief Process a queue of independent SHA2-384 hash jobs across the SIMD lanes.
+* Each lane holds one message in a 64-bit word of the vector state; the 48 byte digest is written to the job output.
+* Processes 8 lanes with AVX-512, 4 lanes with AVX2, or the jobs sequentially.
+*
+* \param jobs: [const] The array of jobs
+* \param jobcount: The number of jobs in the array
+*/
+QSC_EXPORT_API void qsc_sha384_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount);
+
+/**
+* \brief Process a queue of independent SHA2-512 jobs across the SIMD lanes.
+* Each lane holds one message in a 64-bit word of the vector state, and pads its message independently;
+* when a lane has generated its output, the next pending job is loaded into it.
+* HMAC jobs run the inner and outer hashes in the same lane, and HKDF jobs chain their expansion blocks.
+* Processes 8 lanes with AVX-512, 4 lanes with AVX2, or the jobs sequentially.
+*
+* \param jobs: [const] The array of jobs
+* \param jobcount: The number of jobs in the array
+* \param mode: The SHA2 function applied to all jobs
+*/
+QSC_EXPORT_API void qsc_sha512_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount, qsc_sha2_job_mode mode);
+
+/**
+* \brief Compute the HMAC(SHA2-512) mac-codes of a queue of jobs across the SIMD lanes.
+* Each job has its own key and message; the 64 byte mac-code is written to the job output.
+*
+* \param jobs: [const] The array of jobs
+* \param jobcount: The number of jobs in the array
+*/
+QSC_EXPORT_API void qsc_hmac512_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount);
+
+/**
+* \brief Expand the keys of a queue of jobs with HKDF(HMAC(SHA2-512)) across the SIMD lanes.
+* Each job has its own key, info string and output length.
+*
+* \param jobs: [const] The array of jobs
+* \param jobcount: The number of jobs in the array
+*/
+QSC_EXPORT_API void qsc_hkdf512_jobs_expand(const qsc_sha2_job* jobs, size_t jobcount);
+
+/* PBKDF2 */
+
+/**
+* \brief Derive a key from a password with PBKDF2(HMAC(SHA2-256)).
+* The HMAC pads are keyed once, and each iteration is two compressions starting from the keyed chaining values;
+* the output blocks of a key longer than 32 bytes are derived in parallel across the SIMD lanes.
+*
+* \param output: The output key array
+* \param outlen: The output key length in bytes
+* \param password: [const] The password array
+* \param passlen: The password length in bytes
+* \param salt: [const] The salt array; can be NULL if the salt length is zero
+* \param saltlen: The salt length in bytes
+* \param iterations: The iteration count; must be at least one
+*/
+QSC_EXPORT_API void qsc_pbkdf2_sha256_compute(uint8_t* output, size_t outlen, const uint8_t* password, size_t passlen, const uint8_t* salt, size_t saltlen, size_t iterations);
+
+/**
+* \brief Derive the keys of a queue of jobs with PBKDF2(HMAC(SHA2-256)) across the SIMD lanes.
+* The job key is the password, and the job message is the salt; each lane iterates one 32 byte output block,
+* so several passwords, or the blocks of a long output, are derived at once.
+* Processes 16 lanes with AVX-512, 8 lanes with AVX2, or the jobs sequentially;
+* AVX2 builds also run the jobs sequentially on a CPU with SHA-NI.
+*
+* \param jobs: [const] The array of jobs
+* \param jobcount: The number of jobs in the array
+* \param iterations: The iteration count applied to every job; must be at least one
+*/
+QSC_EXPORT_API void qsc_pbkdf2_sha256_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount, size_t iterations);
+
+/**
+* \brief Derive a key from a password with PBKDF2(HMAC(SHA2-512)).
+* The HMAC pads are keyed once, and each iteration is two compressions starting from the keyed chaining values;
+* the output blocks of a key longer than 64 bytes are derived in parallel across the SIMD lanes.
+*
+* \param output: The output key array
+* \param outlen: The output key length in bytes
+* \param password: [const] The password array
+* \param passlen: The password length in bytes
+* \param salt: [const] The salt array; can be NULL if the salt length is zero
+* \param saltlen: The salt length in bytes
+* \param iterations: The iteration count; must be at least one
+*/
+QSC_EXPORT_API void qsc_pbkdf2_sha512_compute(uint8_t* output, size_t outlen, const uint8_t* password, size_t passlen, const uint8_t* salt, size_t saltlen, size_t iterations);
+
+/**
+* \brief Derive the keys of a queue of jobs with PBKDF2(HMAC(SHA2-512)) across the SIMD lanes.
+* The job key is the password, and the job message is the salt; each lane iterates one 64 byte output block.
+* Processes 8 lanes with AVX-512, 4 lanes with AVX2, or the jobs sequentially.
+*
+* \param jobs: [const] The array of jobs
+* \param jobcount: The number of jobs in the array
+* \param iterations: The iteration count applied to every job; must be at least one
+*/
+QSC_EXPORT_API void qsc_pbkdf2_sha512_jobs_compute(const qsc_sha2_job* jobs, size_t jobcount, size_t iterations);
+
 #endif
@@ -1,9 +1,15 @@
 #include "sha2_test.h"
 #include "testutils.h"
 #include "intutils.h"
+#include "memutils.h"
 #include "sha2.h"
 #include <stdio.h>
 
+#define SHA2_JOB_TEST_COUNT 37
+#define SHA2_JOB_TEST_MSGLEN 300
+#define SHA2_JOB_TEST_OUTLEN 200
+#define SHA2_PBKDF2_TEST_ITERATIONS 3
+
 bool qsctest_hkdf_256_kat() 
 {
 	uint8_t exp0[42] = { 0 };
@@ -408,6 +414,480 @@ bool qsctest_hmac_512_kat()
 	return status;
 }
 
+bool qsctest_hmac_clone_equality()
+{
+	uint8_t exp[QSC_HMAC_512_MAC_SIZE] = { 0 };
+	uint8_t key[131] = { 0 };
+	uint8_t msg[300] = { 0 };
+	uint8_t otp[QSC_HMAC_512_MAC_SIZE] = { 0 };
+	qsc_hmac256_state clone256;
+	qsc_hmac256_state tmpl256;
+	qsc_hmac512_state clone512;
+	qsc_hmac512_state tmpl512;
+	size_t i;
+	size_t klen;
+	bool status;
+
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)(i + 0x40);
+	}
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)i;
+	}
+
+	status = true;
+
+	/* short, block sized, and hashed keys */
+	for (klen = 20; klen <= sizeof(key); klen += 111)
+	{
+		/* key the templates once, and clone them for each message length */
+		qsc_hmac256_initialize(&tmpl256, key, klen);
+		qsc_hmac512_initialize(&tmpl512, key, klen);
+
+		for (i = 0; i <= sizeof(msg); i += 50)
+		{
+			qsc_hmac256_compute(exp, msg, i, key, klen);
+			qsc_hmac256_clone(&clone256, &tmpl256);
+			qsc_hmac256_update(&clone256, msg, i);
+			qsc_hmac256_finalize(&clone256, otp);
+
+			if (qsc_intutils_are_equal8(exp, otp, QSC_HMAC_256_MAC_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_hmac_clone_equality: HMAC-256 clone output does not match -HC1 \n");
+				status = false;
+			}
+
+			qsc_hmac512_compute(exp, msg, i, key, klen);
+			qsc_hmac512_clone(&clone512, &tmpl512);
+			qsc_hmac512_update(&clone512, msg, i);
+			qsc_hmac512_finalize(&clone512, otp);
+
+			if (qsc_intutils_are_equal8(exp, otp, QSC_HMAC_512_MAC_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_hmac_clone_equality: HMAC-512 clone output does not match -HC2 \n");
+				status = false;
+			}
+		}
+
+		qsc_hmac256_dispose(&tmpl256);
+		qsc_hmac512_dispose(&tmpl512);
+	}
+
+	return status;
+}
+
+bool qsctest_hmac_reset_equality()
+{
+	uint8_t exp[QSC_HMAC_512_MAC_SIZE] = { 0 };
+	uint8_t key[131] = { 0 };
+	uint8_t msg[300] = { 0 };
+	uint8_t otp[QSC_HMAC_512_MAC_SIZE] = { 0 };
+	qsc_hmac256_state ctx256;
+	qsc_hmac512_state ctx512;
+	size_t i;
+	size_t klen;
+	bool status;
+
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)(i + 0x20);
+	}
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)(i * 3);
+	}
+
+	status = true;
+
+	/* short, block sized, and hashed keys */
+	for (klen = 20; klen <= sizeof(key); klen += 111)
+	{
+		/* key once, and reuse the keyed state for every message length */
+		qsc_hmac256_initialize(&ctx256, key, klen);
+		qsc_hmac512_initialize(&ctx512, key, klen);
+
+		for (i = 0; i <= sizeof(msg); i += 25)
+		{
+			qsc_hmac256_compute(exp, msg, i, key, klen);
+			qsc_hmac256_update(&ctx256, msg, i);
+			qsc_hmac256_finalize_and_reset(&ctx256, otp);
+
+			if (qsc_intutils_are_equal8(exp, otp, QSC_HMAC_256_MAC_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_hmac_reset_equality: HMAC-256 reset output does not match -HR1 \n");
+				status = false;
+			}
+
+			qsc_hmac512_compute(exp, msg, i, key, klen);
+			qsc_hmac512_update(&ctx512, msg, i);
+			qsc_hmac512_finalize_and_reset(&ctx512, otp);
+
+			if (qsc_intutils_are_equal8(exp, otp, QSC_HMAC_512_MAC_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_hmac_reset_equality: HMAC-512 reset output does not match -HR2 \n");
+				status = false;
+			}
+		}
+
+		qsc_hmac256_dispose(&ctx256);
+		qsc_hmac512_dispose(&ctx512);
+	}
+
+	return status;
+}
+
+bool qsctest_pbkdf2_jobs_equality()
+{
+	uint8_t exp[SHA2_JOB_TEST_COUNT][SHA2_JOB_TEST_OUTLEN] = { 0 };
+	uint8_t otp[SHA2_JOB_TEST_COUNT][SHA2_JOB_TEST_OUTLEN] = { 0 };
+	uint8_t key[SHA2_JOB_TEST_COUNT * 4] = { 0 };
+	uint8_t msg[SHA2_JOB_TEST_MSGLEN] = { 0 };
+	uint8_t tmps[SHA2_JOB_TEST_MSGLEN + sizeof(uint32_t)] = { 0 };
+	uint8_t tmpu[QSC_SHA2_512_HASH_SIZE] = { 0 };
+	qsc_sha2_job jobs[SHA2_JOB_TEST_COUNT];
+	size_t blk;
+	size_t hlen;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t len;
+	bool status;
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)((i * 7) + 1);
+	}
+
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)(i + 0x40);
+	}
+
+	/* passwords, salts and output lengths differ per job, so lanes hold blocks of one job and of several jobs */
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		jobs[i].message = msg;
+		jobs[i].msglen = (i * 29) % SHA2_JOB_TEST_MSGLEN;
+		jobs[i].key = key;
+		jobs[i].keylen = 1 + ((i * 11) % sizeof(key));
+		jobs[i].output = otp[i];
+		jobs[i].outlen = (i * 37) % SHA2_JOB_TEST_OUTLEN;
+	}
+
+	status = true;
+
+	for (hlen = QSC_SHA2_256_HASH_SIZE; hlen <= QSC_SHA2_512_HASH_SIZE; hlen += QSC_SHA2_256_HASH_SIZE)
+	{
+		/* the reference is the PBKDF2 definition applied with the short form HMAC api */
+		for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+		{
+			for (j = 0, blk = 1; j < jobs[i].outlen; j += len, ++blk)
+			{
+				len = qsc_intutils_min(jobs[i].outlen - j, hlen);
+				qsc_memutils_copy(tmps, msg, jobs[i].msglen);
+				qsc_intutils_be32to8(tmps + jobs[i].msglen, (uint32_t)blk);
+
+				if (hlen == QSC_SHA2_256_HASH_SIZE)
+				{
+					qsc_hmac256_compute(tmpu, tmps, jobs[i].msglen + sizeof(uint32_t), key, jobs[i].keylen);
+				}
+				else
+				{
+					qsc_hmac512_compute(tmpu, tmps, jobs[i].msglen + sizeof(uint32_t), key, jobs[i].keylen);
+				}
+
+				qsc_memutils_copy(exp[i] + j, tmpu, len);
+
+				for (k = 1; k < SHA2_PBKDF2_TEST_ITERATIONS; ++k)
+				{
+					if (hlen == QSC_SHA2_256_HASH_SIZE)
+					{
+						qsc_hmac256_compute(tmpu, tmpu, hlen, key, jobs[i].keylen);
+					}
+					else
+					{
+						qsc_hmac512_compute(tmpu, tmpu, hlen, key, jobs[i].keylen);
+					}
+
+					qsc_memutils_xor(exp[i] + j, tmpu, len);
+				}
+			}
+		}
+
+		if (hlen == QSC_SHA2_256_HASH_SIZE)
+		{
+			qsc_pbkdf2_sha256_jobs_compute(jobs, SHA2_JOB_TEST_COUNT, SHA2_PBKDF2_TEST_ITERATIONS);
+		}
+		else
+		{
+			qsc_pbkdf2_sha512_jobs_compute(jobs, SHA2_JOB_TEST_COUNT, SHA2_PBKDF2_TEST_ITERATIONS);
+		}
+
+		for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+		{
+			if (qsc_intutils_are_equal8(exp[i], otp[i], jobs[i].outlen) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_pbkdf2_jobs_equality: PBKDF2 output does not match -PJ1 \n");
+				status = false;
+				break;
+			}
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_pbkdf2_kat()
+{
+	uint8_t exp0[QSC_SHA2_256_HASH_SIZE] = { 0 };
+	uint8_t exp1[QSC_SHA2_256_HASH_SIZE] = { 0 };
+	uint8_t exp2[40] = { 0 };
+	uint8_t exp3[QSC_SHA2_512_HASH_SIZE] = { 0 };
+	uint8_t exp4[QSC_SHA2_512_HASH_SIZE] = { 0 };
+	uint8_t exp5[72] = { 0 };
+	uint8_t otp[72] = { 0 };
+	const uint8_t pwd0[] = "password";
+	const uint8_t pwd1[] = "passwordPASSWORDpassword";
+	const uint8_t salt0[] = "salt";
+	const uint8_t salt1[] = "saltSALTsaltSALTsaltSALTsaltSALTsalt";
+	bool status;
+
+	qsctest_hex_to_bin("120FB6CFFCF8B32C43E7225256C4F837A86548C92CCC35480805987CB70BE17B", exp0, sizeof(exp0));
+	qsctest_hex_to_bin("C5E478D59288C841AA530DB6845C4C8D962893A001CE4E11A4963873AA98134A", exp1, sizeof(exp1));
+	qsctest_hex_to_bin("348C89DBCBD32B2F32D814B8116E84CF2B17347EBC1800181C4E2A1FB8DD53E1"
+		"C635518C7DAC47E9", exp2, sizeof(exp2));
+	qsctest_hex_to_bin("867F70CF1ADE02CFF3752599A3A53DC4AF34C7A669815AE5D513554E1C8CF252"
+		"C02D470A285A0501BAD999BFE943C08F050235D7D68B1DA55E63F73B60A57FCE", exp3, sizeof(exp3));
+	qsctest_hex_to_bin("D197B1B33DB0143E018B12F3D1D1479E6CDEBDCC97C5C0F87F6902E072F457B5"
+		"143F30602641B3D55CD335988CB36B84376060ECD532E039B742A239434AF2D5", exp4, sizeof(exp4));
+	qsctest_hex_to_bin("8C0511F4C6E597C6AC6315D8F0362E225F3C501495BA23B868C005174DC4EE71"
+		"115B59F9E60CD9532FA33E0F75AEFE30225C583A186CD82BD4DAEA9724A3D3B8"
+		"04F75BDD41494FA3", exp5, sizeof(exp5));
+
+	status = true;
+
+	/* PBKDF2(HMAC(SHA2-256)) */
+
+	qsc_pbkdf2_sha256_compute(otp, sizeof(exp0), pwd0, sizeof(pwd0) - 1, salt0, sizeof(salt0) - 1, 1);
+
+	if (qsc_intutils_are_equal8(otp, exp0, sizeof(exp0)) != true)
+	{
+		qsctest_print_safe("Failure! qsctest_pbkdf2_kat: output does not match the known answer -PK1 \n");
+		status = false;
+	}
+
+	qsc_pbkdf2_sha256_compute(otp, sizeof(exp1), pwd0, sizeof(pwd0) - 1, salt0, sizeof(salt0) - 1, 4096);
+
+	if (qsc_intutils_are_equal8(otp, exp1, sizeof(exp1)) != true)
+	{
+		qsctest_print_safe("Failure! qsctest_pbkdf2_kat: output does not match the known answer -PK2 \n");
+		status = false;
+	}
+
+	/* two output blocks derived in parallel */
+	qsc_pbkdf2_sha256_compute(otp, sizeof(exp2), pwd1, sizeof(pwd1) - 1, salt1, sizeof(salt1) - 1, 4096);
+
+	if (qsc_intutils_are_equal8(otp, exp2, sizeof(exp2)) != true)
+	{
+		qsctest_print_safe("Failure! qsctest_pbkdf2_kat: output does not match the known answer -PK3 \n");
+		status = false;
+	}
+
+	/* PBKDF2(HMAC(SHA2-512)) */
+
+	qsc_pbkdf2_sha512_compute(otp, sizeof(exp3), pwd0, sizeof(pwd0) - 1, salt0, sizeof(salt0) - 1, 1);
+
+	if (qsc_intutils_are_equal8(otp, exp3, sizeof(exp3)) != true)
+	{
+		qsctest_print_safe("Failure! qsctest_pbkdf2_kat: output does not match the known answer -PK4 \n");
+		status = false;
+	}
+
+	qsc_pbkdf2_sha512_compute(otp, sizeof(exp4), pwd0, sizeof(pwd0) - 1, salt0, sizeof(salt0) - 1, 4096);
+
+	if (qsc_intutils_are_equal8(otp, exp4, sizeof(exp4)) != true)
+	{
+		qsctest_print_safe("Failure! qsctest_pbkdf2_kat: output does not match the known answer -PK5 \n");
+		status = false;
+	}
+
+	qsc_pbkdf2_sha512_compute(otp, sizeof(exp5), pwd1, sizeof(pwd1) - 1, salt1, sizeof(salt1) - 1, 4096);
+
+	if (qsc_intutils_are_equal8(otp, exp5, sizeof(exp5)) != true)
+	{
+		qsctest_print_safe("Failure! qsctest_pbkdf2_kat: output does not match the known answer -PK6 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_sha2_256_compute64_equality()
+{
+	uint8_t exp[16 * QSC_SHA2_256_HASH_SIZE] = { 0 };
+	uint8_t msg[16 * QSC_SHA2_256_RATE] = { 0 };
+	uint8_t otp[16 * QSC_SHA2_256_HASH_SIZE] = { 0 };
+	size_t i;
+	bool status;
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)((i * 13) + 5);
+	}
+
+	for (i = 0; i < 16; ++i)
+	{
+		qsc_sha256_compute(exp + (i * QSC_SHA2_256_HASH_SIZE), msg + (i * QSC_SHA2_256_RATE), QSC_SHA2_256_RATE);
+	}
+
+	status = true;
+
+	for (i = 0; i < 16; ++i)
+	{
+		qsc_sha256_compute64(otp + (i * QSC_SHA2_256_HASH_SIZE), msg + (i * QSC_SHA2_256_RATE));
+	}
+
+	if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_sha2_256_compute64_equality: compute64 output does not match -SC1 \n");
+		status = false;
+	}
+
+	qsc_memutils_clear(otp, sizeof(otp));
+
+	for (i = 0; i < 4; ++i)
+	{
+		qsc_sha256_compute64x4(otp + (i * 4 * QSC_SHA2_256_HASH_SIZE), msg + (i * 4 * QSC_SHA2_256_RATE));
+	}
+
+	if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_sha2_256_compute64_equality: compute64x4 output does not match -SC2 \n");
+		status = false;
+	}
+
+	qsc_memutils_clear(otp, sizeof(otp));
+	qsc_sha256_compute64x8(otp, msg);
+	qsc_sha256_compute64x8(otp + (8 * QSC_SHA2_256_HASH_SIZE), msg + (8 * QSC_SHA2_256_RATE));
+
+	if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_sha2_256_compute64_equality: compute64x8 output does not match -SC3 \n");
+		status = false;
+	}
+
+	qsc_memutils_clear(otp, sizeof(otp));
+	qsc_sha256_compute64x16(otp, msg);
+
+	if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_sha2_256_compute64_equality: compute64x16 output does not match -SC4 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_sha2_256_jobs_equality()
+{
+	uint8_t exp[SHA2_JOB_TEST_COUNT][SHA2_JOB_TEST_OUTLEN] = { 0 };
+	uint8_t otp[SHA2_JOB_TEST_COUNT][SHA2_JOB_TEST_OUTLEN] = { 0 };
+	uint8_t key[SHA2_JOB_TEST_COUNT * 4] = { 0 };
+	uint8_t msg[SHA2_JOB_TEST_MSGLEN] = { 0 };
+	qsc_sha2_job jobs[SHA2_JOB_TEST_COUNT];
+	size_t i;
+	bool status;
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)((i * 7) + 1);
+	}
+
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)(i + 0x40);
+	}
+
+	/* every job has its own message, key and output lengths;
+	   the count is not a multiple of the lane count so lanes are refilled mid-queue */
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		jobs[i].message = msg;
+		jobs[i].msglen = (i * 29) % SHA2_JOB_TEST_MSGLEN;
+		jobs[i].key = key;
+		jobs[i].keylen = 1 + ((i * 11) % sizeof(key));
+		jobs[i].output = otp[i];
+		jobs[i].outlen = 1 + ((i * 37) % SHA2_JOB_TEST_OUTLEN);
+	}
+
+	/* messages on either side of the length field boundary, and a full block */
+	jobs[1].msglen = 55;
+	jobs[2].msglen = 56;
+	jobs[3].msglen = QSC_SHA2_256_RATE;
+	jobs[4].keylen = QSC_SHA2_256_RATE;
+	status = true;
+
+	/* SHA2-256 */
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		qsc_sha256_compute(exp[i], msg, jobs[i].msglen);
+	}
+
+	qsc_sha256_jobs_compute(jobs, SHA2_JOB_TEST_COUNT, qsc_sha2_job_hash);
+
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], QSC_SHA2_256_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_sha2_256_jobs_equality: SHA2-256 output does not match -SJ1 \n");
+			status = false;
+			break;
+		}
+	}
+
+	/* HMAC(SHA2-256) */
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		qsc_hmac256_compute(exp[i], msg, jobs[i].msglen, key, jobs[i].keylen);
+	}
+
+	qsc_hmac256_jobs_compute(jobs, SHA2_JOB_TEST_COUNT);
+
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], QSC_HMAC_256_MAC_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_sha2_256_jobs_equality: HMAC-256 output does not match -SJ2 \n");
+			status = false;
+			break;
+		}
+	}
+
+	/* HKDF-Expand(HMAC(SHA2-256)) */
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		qsc_hkdf256_expand(exp[i], jobs[i].outlen, key, jobs[i].keylen, msg, jobs[i].msglen);
+	}
+
+	qsc_hkdf256_jobs_expand(jobs, SHA2_JOB_TEST_COUNT);
+
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], jobs[i].outlen) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_sha2_256_jobs_equality: HKDF-256 output does not match -SJ3 \n");
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
 bool qsctest_sha2_256_kat()
 {
 	uint8_t exp0[QSC_SHA2_256_HASH_SIZE] = { 0 };
@@ -649,6 +1129,120 @@ bool qsctest_sha2_384_kat()
 	return status;
 }
 
+bool qsctest_sha2_512_jobs_equality()
+{
+	uint8_t exp[SHA2_JOB_TEST_COUNT][SHA2_JOB_TEST_OUTLEN] = { 0 };
+	uint8_t otp[SHA2_JOB_TEST_COUNT][SHA2_JOB_TEST_OUTLEN] = { 0 };
+	uint8_t key[SHA2_JOB_TEST_COUNT * 4] = { 0 };
+	uint8_t msg[SHA2_JOB_TEST_MSGLEN] = { 0 };
+	qsc_sha2_job jobs[SHA2_JOB_TEST_COUNT];
+	size_t i;
+	bool status;
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)((i * 7) + 1);
+	}
+
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)(i + 0x40);
+	}
+
+	/* every job has its own message, key and output lengths;
+	   the count is not a multiple of the lane count so lanes are refilled mid-queue */
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		jobs[i].message = msg;
+		jobs[i].msglen = (i * 29) % SHA2_JOB_TEST_MSGLEN;
+		jobs[i].key = key;
+		jobs[i].keylen = 1 + ((i * 11) % sizeof(key));
+		jobs[i].output = otp[i];
+		jobs[i].outlen = 1 + ((i * 37) % SHA2_JOB_TEST_OUTLEN);
+	}
+
+	/* messages on either side of the length field boundary, and a full block */
+	jobs[1].msglen = 111;
+	jobs[2].msglen = 112;
+	jobs[3].msglen = QSC_SHA2_512_RATE;
+	jobs[4].keylen = QSC_SHA2_512_RATE;
+	status = true;
+
+	/* SHA2-384 */
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		qsc_sha384_compute(exp[i], msg, jobs[i].msglen);
+	}
+
+	qsc_sha384_jobs_compute(jobs, SHA2_JOB_TEST_COUNT);
+
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], QSC_SHA2_384_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_sha2_512_jobs_equality: SHA2-384 output does not match -SJ1 \n");
+			status = false;
+			break;
+		}
+	}
+
+	/* SHA2-512 */
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		qsc_sha512_compute(exp[i], msg, jobs[i].msglen);
+	}
+
+	qsc_sha512_jobs_compute(jobs, SHA2_JOB_TEST_COUNT, qsc_sha2_job_hash);
+
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], QSC_SHA2_512_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_sha2_512_jobs_equality: SHA2-512 output does not match -SJ2 \n");
+			status = false;
+			break;
+		}
+	}
+
+	/* HMAC(SHA2-512) */
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		qsc_hmac512_compute(exp[i], msg, jobs[i].msglen, key, jobs[i].keylen);
+	}
+
+	qsc_hmac512_jobs_compute(jobs, SHA2_JOB_TEST_COUNT);
+
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], QSC_HMAC_512_MAC_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_sha2_512_jobs_equality: HMAC-512 output does not match -SJ3 \n");
+			status = false;
+			break;
+		}
+	}
+
+	/* HKDF-Expand(HMAC(SHA2-512)) */
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		qsc_hkdf512_expand(exp[i], jobs[i].outlen, key, jobs[i].keylen, msg, jobs[i].msglen);
+	}
+
+	qsc_hkdf512_jobs_expand(jobs, SHA2_JOB_TEST_COUNT);
+
+	for (i = 0; i < SHA2_JOB_TEST_COUNT; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], jobs[i].outlen) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_sha2_512_jobs_equality: HKDF-512 output does not match -SJ4 \n");
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
 bool qsctest_sha2_512_kat()
 {
 	uint8_t exp0[QSC_SHA2_512_HASH_SIZE] = { 0 };
@@ -833,4 +1427,67 @@ void qsctest_sha2_run()
 	{
 		qsctest_print_safe("Failure! Failed the HMAC(SHA2-512) KAT test. \n");
 	}
+
+	if (qsctest_hmac_clone_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the HMAC keyed state clone test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the HMAC keyed state clone test. \n");
+	}
+
+	if (qsctest_hmac_reset_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the HMAC finalize and reset test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the HMAC finalize and reset test. \n");
+	}
+
+	if (qsctest_sha2_256_compute64_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the SHA2-256 64 byte message equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the SHA2-256 64 byte message equality test. \n");
+	}
+
+	if (qsctest_sha2_256_jobs_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the multi-lane SHA2-256 job equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the multi-lane SHA2-256 job equality test. \n");
+	}
+
+	if (qsctest_sha2_512_jobs_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the multi-lane SHA2-384 and SHA2-512 job equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the multi-lane SHA2-384 and SHA2-512 job equality test. \n");
+	}
+
+	if (qsctest_pbkdf2_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the PBKDF2(HMAC(SHA2-256)) and PBKDF2(HMAC(SHA2-512)) KAT test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the PBKDF2(HMAC(SHA2-256)) and PBKDF2(HMAC(SHA2-512)) KAT test. \n");
+	}
+
+	if (qsctest_pbkdf2_jobs_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the multi-lane PBKDF2 job equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the multi-lane PBKDF2 job equality test. \n");
+	}
 }
@@ -60,6 +60,54 @@ bool qsctest_hmac_256_kat(void);
 */
 bool qsctest_hmac_512_kat(void);
 
+/**
+* \brief Tests cloned keyed HMAC-256 and HMAC-512 states for equality with the short form api.
+*
+* \return Returns true for success
+*/
+bool qsctest_hmac_clone_equality(void);
+
+/**
+* \brief Tests reused keyed HMAC-256 and HMAC-512 states, finalized and reset after each message, for equality with the short form api.
+*
+* \return Returns true for success
+*/
+bool qsctest_hmac_reset_equality(void);
+
+/**
+* \brief Tests the multi-lane PBKDF2(HMAC(SHA2-256)) and PBKDF2(HMAC(SHA2-512)) job queues for equality with
+* the PBKDF2 definition computed with the HMAC short form api, using jobs with unequal password, salt and output lengths.
+*
+* \return Returns true for success
+*/
+bool qsctest_pbkdf2_jobs_equality(void);
+
+/**
+* \brief Tests the PBKDF2(HMAC(SHA2-256)) and PBKDF2(HMAC(SHA2-512)) password based key derivation functions for correct operation.
+*
+* \return Returns true for success
+*
+* \remarks <b>Test References:</b> \n
+* The SHA2 counterparts of the RFC 6070 PBKDF2 test cases.
+*/
+bool qsctest_pbkdf2_kat(void);
+
+/**
+* \brief Tests the 64 byte message SHA2-256 function, and its 4, 8 and 16 message versions,
+* for equality with the short form api.
+*
+* \return Returns true for success
+*/
+bool qsctest_sha2_256_compute64_equality(void);
+
+/**
+* \brief Tests the multi-lane SHA2-256, HMAC-256 and HKDF-256 job scheduler for equality with the sequential functions,
+* using a queue of jobs with unequal message, key and output lengths.
+*
+* \return Returns true for success
+*/
+bool qsctest_sha2_256_jobs_equality(void);
+
 /**
 * \brief Tests the 256-bit version of the SHA2 message digest for correct operation,
 * using selected vectors from the NIST SHA2 official KAT file.
@@ -82,6 +130,14 @@ bool qsctest_sha2_256_kat(void);
 */
 bool qsctest_sha2_384_kat(void);
 
+/**
+* \brief Tests the multi-lane SHA2-384, SHA2-512, HMAC-512 and HKDF-512 job scheduler for equality with the sequential functions,
+* using a queue of jobs with unequal message, key and output lengths.
+*
+* \return Returns true for success
+*/
+bool qsctest_sha2_512_jobs_equality(void);
+
 /**
 * \brief Tests the 512-bit version of the SHA2 message digest for correct operation,
 * using selected vectors from the NIST SHA2 official KAT file.
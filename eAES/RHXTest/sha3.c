@@ -1,6 +1,10 @@
 #include "sha3.h"
+#include "cpuidex.h"
 #include "intutils.h"
 #include "memutils.h"
+#if defined(_OPENMP)
+#	include <omp.h>
+#endif
 
 #define KPA_LEAF_HASH128 16
 #define KPA_LEAF_HASH256 32
@@ -23,12 +27,144 @@ static const uint64_t KECCAK_ROUND_CONSTANTS[QSC_KECCAK_PERMUTATION_MAX_ROUNDS]
 	0x8000000080008009ULL, 0x8000000080000000ULL, 0x0000000080000080ULL, 0x0000000080008003ULL
 };
 
+/* the kmac state after the name block with an empty customization string is absorbed and permuted */
+static const uint64_t KMAC_128_NAME_STATE[QSC_KECCAK_STATE_SIZE] =
+{
+	0xFFA0EE44987DB36BULL, 0xFEC0B86E809A27BAULL, 0x3528E28B621C28CEULL, 0xA8797B0274435120ULL,
+	0x2060F5BA623111A8ULL, 0x9E84D835E828CFF3ULL, 0x1A299E1B5E66EEE2ULL, 0xC4429016A5B7EE43ULL,
+	0x7F58C7FCDB925B1DULL, 0x28A7DB99FCCEE64DULL, 0x4417A644DE121570ULL, 0xEB99FAF9BCD49450ULL,
+	0xB75C8A2D86B129D2ULL, 0x7A0A2BD92DDF8C47ULL, 0x94B29A341CB0D2C7ULL, 0x89F48A7ED3AD8354ULL,
+	0xBABD2AC6570F4348ULL, 0x7A16387CB56D4E3BULL, 0xB46418DCE00D0353ULL, 0x8DB5077E73FF5632ULL,
+	0x26269D5702747069ULL, 0x8F92017A2C00FBA8ULL, 0x01701EBD78EBDDF4ULL, 0xF7CA6CE64A444181ULL,
+	0x21FE84F33785D54BULL
+};
+
+static const uint64_t KMAC_256_NAME_STATE[QSC_KECCAK_STATE_SIZE] =
+{
+	0x5D63037BF8951C6CULL, 0x135E3D7FC6DAEC35ULL, 0x2973806376579045ULL, 0x4EBC74C87A5E2335ULL,
+	0xA4A0E667022AC913ULL, 0x368146419B711C90ULL, 0x8DE967B112A254D4ULL, 0x2DBB7D958EB74823ULL,
+	0xBED03C20B7468278ULL, 0x0694C0A8C0F3A003ULL, 0x6440FC65E87FA80EULL, 0xE5F35ADA0CEB58FDULL,
+	0x3B87E0848E2D0CF7ULL, 0x7B2A181FC5A0771CULL, 0x761723C0B19AD57DULL, 0xACBADC5A4EF67104ULL,
+	0x7A215118AF302F29ULL, 0xEB94D1EE16DD140AULL, 0xB41F33BF1E494FBDULL, 0xF467770C830B4B3EULL,
+	0x910DE5C7FA00B554ULL, 0x6BEC5C175246425BULL, 0x38CFDEF1CFD61864ULL, 0x29E4A93011CBD8C6ULL,
+	0x07800C825FCD86C6ULL
+};
+
+static const uint64_t KMAC_512_NAME_STATE[QSC_KECCAK_STATE_SIZE] =
+{
+	0x57A7961417A62DFAULL, 0x6771656C5732049CULL, 0x9DD305C460F012B0ULL, 0x989F85F634EC5E9AULL,
+	0xD7989B129A369294ULL, 0x925AE8D6D07BDE30ULL, 0x9B930A35D4614A55ULL, 0xDE0897076DBB2946ULL,
+	0x422E9241F2A9657BULL, 0x3E16EACDB7B08547ULL, 0x70C6821D2AC5FBECULL, 0xBAD5477697743AD2ULL,
+	0x2D4F75A704D2ECD1ULL, 0xBE6EDDF39CC6E92BULL, 0x7BA79A24C3D36356ULL, 0xA1839FA187F9B0E8ULL,
+	0x23406472B82D5ED6ULL, 0x2EC9A16542C1D9CAULL, 0xF65CAED129F85FE4ULL, 0xC72888D649AB9384ULL,
+	0xC377008D0EF0951AULL, 0x1BE31B78E108E30DULL, 0xA87ABEE6AA95644EULL, 0x7D70B34C5A0D861CULL,
+	0xCDF0C616EB3B1E9FULL
+};
+
+#if defined(QSC_SYSTEM_HAS_AVX2) || defined(QSC_SYSTEM_HAS_AVX512)
+/* keccak rho rotation offsets, in state lane order */
+static const uint64_t KECCAK_RHO_OFFSETS[QSC_KECCAK_STATE_SIZE] =
+{
+	0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14
+};
+#endif
+
 /* Common */
 
+#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
+static void keccak_xor_bytes(uint64_t* state, size_t offset, const uint8_t* message, size_t msglen)
+{
+	/* xor the message directly into the state at a byte offset; the state is 200 bytes,
+	   so full vectors never cross the end of the state array */
+	uint8_t* pst = (uint8_t*)state + offset;
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	while (msglen >= 64)
+	{
+		_mm512_storeu_si512((void*)pst, _mm512_xor_si512(_mm512_loadu_si512((const void*)pst), _mm512_loadu_si512((const void*)message)));
+		pst += 64;
+		message += 64;
+		msglen -= 64;
+	}
+
+	if (msglen >= sizeof(uint64_t))
+	{
+		/* the remaining whole words in one masked load */
+		const __mmask8 MASK = (__mmask8)((1U << (msglen / sizeof(uint64_t))) - 1);
+
+		_mm512_mask_storeu_epi64((void*)pst, MASK, _mm512_xor_si512(_mm512_maskz_loadu_epi64(MASK, (const void*)pst),
+			_mm512_maskz_loadu_epi64(MASK, (const void*)message)));
+		pst += msglen & ~(sizeof(uint64_t) - 1);
+		message += msglen & ~(sizeof(uint64_t) - 1);
+		msglen &= sizeof(uint64_t) - 1;
+	}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	while (msglen >= 32)
+	{
+		_mm256_storeu_si256((__m256i*)pst, _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)pst), _mm256_loadu_si256((const __m256i*)message)));
+		pst += 32;
+		message += 32;
+		msglen -= 32;
+	}
+
+	if (msglen >= 16)
+	{
+		_mm_storeu_si128((__m128i*)pst, _mm_xor_si128(_mm_loadu_si128((const __m128i*)pst), _mm_loadu_si128((const __m128i*)message)));
+		pst += 16;
+		message += 16;
+		msglen -= 16;
+	}
+#endif
+
+	if (msglen != 0)
+	{
+		qsc_memutils_xor(pst, message, msglen);
+	}
+}
+#endif
+
+static void keccak_extract_bytes(const uint64_t* state, size_t offset, uint8_t* output, size_t outlen)
+{
+#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
+	/* copy the state bytes straight to the destination; the tail words use a masked store */
+	const uint8_t* pst = (const uint8_t*)state + offset;
+
+#	if defined(QSC_SYSTEM_HAS_AVX512)
+	while (outlen >= 64)
+	{
+		_mm512_storeu_si512((void*)output, _mm512_loadu_si512((const void*)pst));
+		pst += 64;
+		output += 64;
+		outlen -= 64;
+	}
+
+	if (outlen >= sizeof(uint64_t))
+	{
+		const __mmask8 MASK = (__mmask8)((1U << (outlen / sizeof(uint64_t))) - 1);
+
+		_mm512_mask_storeu_epi64((void*)output, MASK, _mm512_maskz_loadu_epi64(MASK, (const void*)pst));
+		pst += outlen & ~(sizeof(uint64_t) - 1);
+		output += outlen & ~(sizeof(uint64_t) - 1);
+		outlen &= sizeof(uint64_t) - 1;
+	}
+#	endif
+
+	if (outlen != 0)
+	{
+		qsc_memutils_copy(output, pst, outlen);
+	}
+#else
+	for (size_t i = 0; i < outlen; ++i)
+	{
+		output[i] = (uint8_t)(state[(offset + i) / sizeof(uint64_t)] >> (8 * ((offset + i) % sizeof(uint64_t))));
+	}
+#endif
+}
+
 static void keccak_fast_absorb(uint64_t* state, const uint8_t* message, size_t msglen)
 {
 #if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
-	qsc_memutils_xor((uint8_t*)state, message, msglen);
+	keccak_xor_bytes(state, 0, message, msglen);
 #else
 	for (size_t i = 0; i < msglen / sizeof(uint64_t); ++i)
 	{
@@ -81,10 +217,54 @@ static size_t keccak_right_encode(uint8_t* buffer, size_t value)
 	return n + 1;
 }
 
+static const uint64_t* keccak_kmac_name_state(qsc_keccak_rate rate, const uint8_t* name, size_t namelen, size_t custlen, size_t rounds)
+{
+	/* returns the precomputed kmac name block state, or NULL if the customization is not the empty kmac string */
+	const uint8_t KMAC_NAME[4] = { 0x4B, 0x4D, 0x41, 0x43 };
+	const uint64_t* pst;
+
+	pst = NULL;
+
+	if (custlen == 0 && rounds == QSC_KECCAK_PERMUTATION_ROUNDS && name != NULL && namelen == sizeof(KMAC_NAME) &&
+		qsc_intutils_are_equal8(name, KMAC_NAME, sizeof(KMAC_NAME)) == true)
+	{
+		if (rate == qsc_keccak_rate_128)
+		{
+			pst = KMAC_128_NAME_STATE;
+		}
+		else if (rate == qsc_keccak_rate_256)
+		{
+			pst = KMAC_256_NAME_STATE;
+		}
+		else if (rate == qsc_keccak_rate_512)
+		{
+			pst = KMAC_512_NAME_STATE;
+		}
+	}
+
+	return pst;
+}
+
+static void keccak_short_absorb(uint64_t* state, qsc_keccak_rate rate, const uint8_t* message, size_t msglen, uint8_t domain)
+{
+	/* write a message shorter than the rate and its padding into a cleared state as a single block */
+#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
+	qsc_memutils_copy((uint8_t*)state, message, msglen);
+#else
+	for (size_t i = 0; i < msglen; ++i)
+	{
+		state[i / sizeof(uint64_t)] |= (uint64_t)message[i] << (8 * (i % sizeof(uint64_t)));
+	}
+#endif
+
+	state[msglen / sizeof(uint64_t)] ^= (uint64_t)domain << (8 * (msglen % sizeof(uint64_t)));
+	state[((size_t)rate / sizeof(uint64_t)) - 1] ^= 1ULL << 63;
+}
+
 #if defined(QSC_SYSTEM_HAS_AVX512)
 #	if defined(QSC_KECCAK_UNROLLED_PERMUTATION)
 
-void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rounds)
+static void keccak_permute_p8x1600_rc(__m512i state[QSC_KECCAK_STATE_SIZE], const uint64_t* constants, size_t rounds)
 {
 	assert(rounds % 2 == 0);
 
@@ -200,7 +380,7 @@ void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		a24 = _mm512_xor_si512(a24, d4);
 		c4 = _mm512_or_si512(_mm512_slli_epi64(a24, 14), _mm512_srli_epi64(a24, 64 - 14));
 		e0 = _mm512_xor_si512(c0, _mm512_and_si512(_mm512_xor_epi64(c1, _mm512_set1_epi64(-1)), c2));
-		e0 = _mm512_xor_si512(e0, _mm512_set1_epi64(KECCAK_ROUND_CONSTANTS[i]));
+		e0 = _mm512_xor_si512(e0, _mm512_set1_epi64(constants[i]));
 		e1 = _mm512_xor_si512(c1, _mm512_and_si512(_mm512_xor_epi64(c2, _mm512_set1_epi64(-1)), c3));
 		e2 = _mm512_xor_si512(c2, _mm512_and_si512(_mm512_xor_epi64(c3, _mm512_set1_epi64(-1)), c4));
 		e3 = _mm512_xor_si512(c3, _mm512_and_si512(_mm512_xor_epi64(c4, _mm512_set1_epi64(-1)), c0));
@@ -287,7 +467,7 @@ void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		e24 = _mm512_xor_si512(e24, d4);
 		c4 = _mm512_or_si512(_mm512_slli_epi64(e24, 14), _mm512_srli_epi64(e24, 64 - 14));
 		a0 = _mm512_xor_si512(c0, _mm512_and_si512(_mm512_xor_epi64(c1, _mm512_set1_epi64(-1)), c2));
-		a0 = _mm512_xor_si512(a0, _mm512_set1_epi64(KECCAK_ROUND_CONSTANTS[i + 1]));
+		a0 = _mm512_xor_si512(a0, _mm512_set1_epi64(constants[i + 1]));
 		a1 = _mm512_xor_si512(c1, _mm512_and_si512(_mm512_xor_epi64(c2, _mm512_set1_epi64(-1)), c3));
 		a2 = _mm512_xor_si512(c2, _mm512_and_si512(_mm512_xor_epi64(c3, _mm512_set1_epi64(-1)), c4));
 		a3 = _mm512_xor_si512(c3, _mm512_and_si512(_mm512_xor_epi64(c4, _mm512_set1_epi64(-1)), c0));
@@ -383,7 +563,7 @@ void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rou
 
 #	else
 
-void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rounds)
+static void keccak_permute_p8x1600_rc(__m512i state[QSC_KECCAK_STATE_SIZE], const uint64_t* constants, size_t rounds)
 {
 	assert(rounds % 2 == 0);
 
@@ -422,7 +602,7 @@ void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		a[24] = _mm512_xor_si512(a[24], d[4]);
 		c[4] = _mm512_or_si512(_mm512_slli_epi64(a[24], 14), _mm512_srli_epi64(a[24], 64 - 14));
 		e[0] = _mm512_xor_si512(c[0], _mm512_and_si512(_mm512_xor_epi64(c[1], _mm512_set1_epi64(-1)), c[2]));
-		e[0] = _mm512_xor_si512(e[0], _mm512_set1_epi64(KECCAK_ROUND_CONSTANTS[i]));
+		e[0] = _mm512_xor_si512(e[0], _mm512_set1_epi64(constants[i]));
 		e[1] = _mm512_xor_si512(c[1], _mm512_and_si512(_mm512_xor_epi64(c[2], _mm512_set1_epi64(-1)), c[3]));
 		e[2] = _mm512_xor_si512(c[2], _mm512_and_si512(_mm512_xor_epi64(c[3], _mm512_set1_epi64(-1)), c[4]));
 		e[3] = _mm512_xor_si512(c[3], _mm512_and_si512(_mm512_xor_epi64(c[4], _mm512_set1_epi64(-1)), c[0]));
@@ -510,7 +690,7 @@ void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		e[24] = _mm512_xor_si512(e[24], d[4]);
 		c[4] = _mm512_or_si512(_mm512_slli_epi64(e[24], 14), _mm512_srli_epi64(e[24], 64 - 14));
 		a[0] = _mm512_xor_si512(c[0], _mm512_and_si512(_mm512_xor_epi64(c[1], _mm512_set1_epi64(-1)), c[2]));
-		a[0] = _mm512_xor_si512(a[0], _mm512_set1_epi64(KECCAK_ROUND_CONSTANTS[i + 1]));
+		a[0] = _mm512_xor_si512(a[0], _mm512_set1_epi64(constants[i + 1]));
 		a[1] = _mm512_xor_si512(c[1], _mm512_and_si512(_mm512_xor_epi64(c[2], _mm512_set1_epi64(-1)), c[3]));
 		a[2] = _mm512_xor_si512(c[2], _mm512_and_si512(_mm512_xor_epi64(c[3], _mm512_set1_epi64(-1)), c[4]));
 		a[3] = _mm512_xor_si512(c[3], _mm512_and_si512(_mm512_xor_epi64(c[4], _mm512_set1_epi64(-1)), c[0]));
@@ -584,12 +764,95 @@ void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rou
 }
 
 #	endif
+
+void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rounds)
+{
+	keccak_permute_p8x1600_rc(state, KECCAK_ROUND_CONSTANTS, rounds);
+}
+
+/* single-state AVX-512 permutation: each plane is a 512-bit row with the five
+   lanes in the low positions, rho is a variable rotate, the theta parity and chi
+   are three-input logic ops, and pi is a two-source lane permute */
+
+static const uint64_t KECCAK_PI_PERMUTE[5][8] =
+{
+	{ 0, 9, 2, 11, 4, 0, 0, 0 },
+	{ 3, 12, 0, 9, 2, 0, 0, 0 },
+	{ 1, 10, 3, 12, 0, 0, 0, 0 },
+	{ 4, 8, 1, 10, 3, 0, 0, 0 },
+	{ 2, 11, 4, 8, 1, 0, 0, 0 }
+};
+
+static void keccak_permute_p1600avx512_rc(uint64_t* state, const uint64_t* constants, size_t rounds)
+{
+	assert(state != NULL);
+	assert(rounds % 2 == 0);
+
+	const __m512i rm1 = _mm512_set_epi64(7, 6, 5, 3, 2, 1, 0, 4);
+	const __m512i rp1 = _mm512_set_epi64(7, 6, 5, 0, 4, 3, 2, 1);
+	const __m512i rp2 = _mm512_set_epi64(7, 6, 5, 1, 0, 4, 3, 2);
+	__m512i a[5];
+	__m512i b[5];
+	__m512i c;
+	__m512i d;
+	__m512i pi[5];
+	__m512i rho[5];
+	size_t i;
+	size_t y;
+
+	for (y = 0; y < 5; ++y)
+	{
+		a[y] = _mm512_maskz_loadu_epi64(0x1F, state + (5 * y));
+		rho[y] = _mm512_maskz_loadu_epi64(0x1F, KECCAK_RHO_OFFSETS + (5 * y));
+		pi[y] = _mm512_loadu_si512((const void*)KECCAK_PI_PERMUTE[y]);
+	}
+
+	for (i = 0; i < rounds; ++i)
+	{
+		/* theta */
+		c = _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64(a[0], a[1], a[2], 0x96), a[3], a[4], 0x96);
+		d = _mm512_rol_epi64(_mm512_permutexvar_epi64(rp1, c), 1);
+		c = _mm512_permutexvar_epi64(rm1, c);
+
+		/* theta and rho */
+		for (y = 0; y < 5; ++y)
+		{
+			a[y] = _mm512_rolv_epi64(_mm512_ternarylogic_epi64(a[y], c, d, 0x96), rho[y]);
+		}
+
+		/* pi */
+		for (y = 0; y < 5; ++y)
+		{
+			b[y] = _mm512_mask_blend_epi64(0x0C, _mm512_permutex2var_epi64(a[0], pi[y], a[1]), _mm512_permutex2var_epi64(a[2], pi[y], a[3]));
+			b[y] = _mm512_mask_permutexvar_epi64(b[y], 0x10, pi[y], a[4]);
+		}
+
+		/* chi: x ^ (~x1 & x2) */
+		for (y = 0; y < 5; ++y)
+		{
+			a[y] = _mm512_ternarylogic_epi64(b[y], _mm512_permutexvar_epi64(rp1, b[y]), _mm512_permutexvar_epi64(rp2, b[y]), 0xD2);
+		}
+
+		/* iota */
+		a[0] = _mm512_mask_xor_epi64(a[0], 0x01, a[0], _mm512_set1_epi64((int64_t)constants[i]));
+	}
+
+	for (y = 0; y < 5; ++y)
+	{
+		_mm512_mask_storeu_epi64(state + (5 * y), 0x1F, a[y]);
+	}
+}
+
+void qsc_keccak_permute_p1600avx512(uint64_t* state, size_t rounds)
+{
+	keccak_permute_p1600avx512_rc(state, KECCAK_ROUND_CONSTANTS, rounds);
+}
 #endif
 
 #if defined(QSC_SYSTEM_HAS_AVX2)
 #	if defined(QSC_KECCAK_UNROLLED_PERMUTATION)
 
-void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rounds)
+static void keccak_permute_p4x1600_rc(__m256i state[QSC_KECCAK_STATE_SIZE], const uint64_t* constants, size_t rounds)
 {
 	assert(rounds % 2 == 0);
 
@@ -707,7 +970,7 @@ void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		a24 = _mm256_xor_si256(a24, d4);
 		c4 = _mm256_or_si256(_mm256_slli_epi64(a24, 14), _mm256_srli_epi64(a24, 64 - 14));
 		e0 = _mm256_xor_si256(c0, _mm256_and_si256(_mm256_xor_si256(c1, _mm256_set1_epi64x(-1)), c2));
-		e0 = _mm256_xor_si256(e0, _mm256_set1_epi64x(KECCAK_ROUND_CONSTANTS[i]));
+		e0 = _mm256_xor_si256(e0, _mm256_set1_epi64x(constants[i]));
 		e1 = _mm256_xor_si256(c1, _mm256_and_si256(_mm256_xor_si256(c2, _mm256_set1_epi64x(-1)), c3));
 		e2 = _mm256_xor_si256(c2, _mm256_and_si256(_mm256_xor_si256(c3, _mm256_set1_epi64x(-1)), c4));
 		e3 = _mm256_xor_si256(c3, _mm256_and_si256(_mm256_xor_si256(c4, _mm256_set1_epi64x(-1)), c0));
@@ -794,7 +1057,7 @@ void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		e24 = _mm256_xor_si256(e24, d4);
 		c4 = _mm256_or_si256(_mm256_slli_epi64(e24, 14), _mm256_srli_epi64(e24, 64 - 14));
 		a0 = _mm256_xor_si256(c0, _mm256_and_si256(_mm256_xor_si256(c1, _mm256_set1_epi64x(-1)), c2));
-		a0 = _mm256_xor_si256(a0, _mm256_set1_epi64x(KECCAK_ROUND_CONSTANTS[i + 1]));
+		a0 = _mm256_xor_si256(a0, _mm256_set1_epi64x(constants[i + 1]));
 		a1 = _mm256_xor_si256(c1, _mm256_and_si256(_mm256_xor_si256(c2, _mm256_set1_epi64x(-1)), c3));
 		a2 = _mm256_xor_si256(c2, _mm256_and_si256(_mm256_xor_si256(c3, _mm256_set1_epi64x(-1)), c4));
 		a3 = _mm256_xor_si256(c3, _mm256_and_si256(_mm256_xor_si256(c4, _mm256_set1_epi64x(-1)), c0));
@@ -890,7 +1153,7 @@ void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rou
 
 #	else
 
-void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rounds)
+static void keccak_permute_p4x1600_rc(__m256i state[QSC_KECCAK_STATE_SIZE], const uint64_t* constants, size_t rounds)
 {
 	assert(rounds % 2 == 0);
 
@@ -929,7 +1192,7 @@ void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		a[24] = _mm256_xor_si256(a[24], d[4]);
 		c[4] = _mm256_or_si256(_mm256_slli_epi64(a[24], 14), _mm256_srli_epi64(a[24], 64 - 14));
 		e[0] = _mm256_xor_si256(c[0], _mm256_and_si256(_mm256_xor_si256(c[1], _mm256_set1_epi64x(-1)), c[2]));
-		e[0] = _mm256_xor_si256(e[0], _mm256_set1_epi64x(KECCAK_ROUND_CONSTANTS[i]));
+		e[0] = _mm256_xor_si256(e[0], _mm256_set1_epi64x(constants[i]));
 		e[1] = _mm256_xor_si256(c[1], _mm256_and_si256(_mm256_xor_si256(c[2], _mm256_set1_epi64x(-1)), c[3]));
 		e[2] = _mm256_xor_si256(c[2], _mm256_and_si256(_mm256_xor_si256(c[3], _mm256_set1_epi64x(-1)), c[4]));
 		e[3] = _mm256_xor_si256(c[3], _mm256_and_si256(_mm256_xor_si256(c[4], _mm256_set1_epi64x(-1)), c[0]));
@@ -1017,7 +1280,7 @@ void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		e[24] = _mm256_xor_si256(e[24], d[4]);
 		c[4] = _mm256_or_si256(_mm256_slli_epi64(e[24], 14), _mm256_srli_epi64(e[24], 64 - 14));
 		a[0] = _mm256_xor_si256(c[0], _mm256_and_si256(_mm256_xor_si256(c[1], _mm256_set1_epi64x(-1)), c[2]));
-		a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(KECCAK_ROUND_CONSTANTS[i + 1]));
+		a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(constants[i + 1]));
 		a[1] = _mm256_xor_si256(c[1], _mm256_and_si256(_mm256_xor_si256(c[2], _mm256_set1_epi64x(-1)), c[3]));
 		a[2] = _mm256_xor_si256(c[2], _mm256_and_si256(_mm256_xor_si256(c[3], _mm256_set1_epi64x(-1)), c[4]));
 		a[3] = _mm256_xor_si256(c[3], _mm256_and_si256(_mm256_xor_si256(c[4], _mm256_set1_epi64x(-1)), c[0]));
@@ -1091,10 +1354,164 @@ void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rou
 }
 
 #	endif
+
+void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rounds)
+{
+	keccak_permute_p4x1600_rc(state, KECCAK_ROUND_CONSTANTS, rounds);
+}
+
+/* single-state AVX2 permutation: the five lanes of each plane are held as one
+   256-bit row (x = 0..3) and a scalar (x = 4), theta and chi are computed a row
+   at a time and pi reloads the rows from the rotated plane array */
+
+static const size_t KECCAK_PI_LANES[20] =
+{
+	0, 6, 12, 18, 3, 9, 10, 16, 1, 7, 13, 19, 4, 5, 11, 17, 2, 8, 14, 15
+};
+
+static const size_t KECCAK_PI_SCALAR[5] =
+{
+	24, 22, 20, 23, 21
+};
+
+static __m256i keccak_rotlv256(__m256i x, __m256i shl, __m256i shr)
+{
+	return _mm256_or_si256(_mm256_sllv_epi64(x, shl), _mm256_srlv_epi64(x, shr));
+}
+
+static __m256i keccak_row_next256(__m256i row, uint64_t x4)
+{
+	/* {x1, x2, x3, x4} */
+	return _mm256_blend_epi32(_mm256_permute4x64_epi64(row, 0x39), _mm256_set1_epi64x((int64_t)x4), 0xC0);
+}
+
+static void keccak_permute_p1600avx2_rc(uint64_t* state, const uint64_t* constants, size_t rounds)
+{
+	assert(state != NULL);
+	assert(rounds % 2 == 0);
+
+	QSC_ALIGN(32) uint64_t b[QSC_KECCAK_STATE_SIZE + 3];
+	__m256i c;
+	__m256i d;
+	__m256i r[5];
+	__m256i shl[5];
+	__m256i shr[5];
+	__m256i t1;
+	__m256i t2;
+	uint64_t c0;
+	uint64_t c3;
+	uint64_t c4;
+	uint64_t d4;
+	uint64_t s[5];
+	uint64_t t;
+	size_t i;
+	size_t y;
+
+	for (y = 0; y < 5; ++y)
+	{
+		r[y] = _mm256_loadu_si256((const __m256i*)(state + (5 * y)));
+		s[y] = state[(5 * y) + 4];
+		shl[y] = _mm256_loadu_si256((const __m256i*)(KECCAK_RHO_OFFSETS + (5 * y)));
+		shr[y] = _mm256_sub_epi64(_mm256_set1_epi64x(64), shl[y]);
+	}
+
+	for (i = 0; i < rounds; ++i)
+	{
+		/* theta */
+		c = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(r[0], r[1]), _mm256_xor_si256(r[2], r[3])), r[4]);
+		c4 = s[0] ^ s[1] ^ s[2] ^ s[3] ^ s[4];
+		c0 = (uint64_t)_mm256_extract_epi64(c, 0);
+		c3 = (uint64_t)_mm256_extract_epi64(c, 3);
+		/* {c4, c0, c1, c2} ^ rotl({c1, c2, c3, c4}, 1) */
+		t1 = _mm256_blend_epi32(_mm256_permute4x64_epi64(c, 0x93), _mm256_set1_epi64x((int64_t)c4), 0x03);
+		t2 = keccak_row_next256(c, c4);
+		d = _mm256_xor_si256(t1, _mm256_or_si256(_mm256_slli_epi64(t2, 1), _mm256_srli_epi64(t2, 64 - 1)));
+		d4 = c3 ^ qsc_intutils_rotl64(c0, 1);
+
+		/* theta, rho and the pi scatter */
+		for (y = 0; y < 5; ++y)
+		{
+			r[y] = keccak_rotlv256(_mm256_xor_si256(r[y], d), shl[y], shr[y]);
+			_mm256_storeu_si256((__m256i*)(b + (5 * y)), r[y]);
+			b[(5 * y) + 4] = qsc_intutils_rotl64(s[y] ^ d4, KECCAK_RHO_OFFSETS[(5 * y) + 4]);
+		}
+
+		/* pi and chi */
+		for (y = 0; y < 5; ++y)
+		{
+			r[y] = _mm256_set_epi64x((int64_t)b[KECCAK_PI_LANES[(4 * y) + 3]], (int64_t)b[KECCAK_PI_LANES[(4 * y) + 2]],
+				(int64_t)b[KECCAK_PI_LANES[(4 * y) + 1]], (int64_t)b[KECCAK_PI_LANES[4 * y]]);
+			t = b[KECCAK_PI_SCALAR[y]];
+			/* {x2, x3, x4, x0} */
+			t2 = _mm256_blend_epi32(_mm256_permute4x64_epi64(r[y], 0x0E), _mm256_set1_epi64x((int64_t)t), 0x30);
+			t1 = keccak_row_next256(r[y], t);
+			s[y] = t ^ (~b[KECCAK_PI_LANES[4 * y]] & b[KECCAK_PI_LANES[(4 * y) + 1]]);
+			r[y] = _mm256_xor_si256(r[y], _mm256_andnot_si256(t1, t2));
+		}
+
+		/* iota */
+		r[0] = _mm256_xor_si256(r[0], _mm256_set_epi64x(0, 0, 0, (int64_t)constants[i]));
+	}
+
+	for (y = 0; y < 5; ++y)
+	{
+		_mm256_storeu_si256((__m256i*)(state + (5 * y)), r[y]);
+		state[(5 * y) + 4] = s[y];
+	}
+}
+
+void qsc_keccak_permute_p1600avx2(uint64_t* state, size_t rounds)
+{
+	keccak_permute_p1600avx2_rc(state, KECCAK_ROUND_CONSTANTS, rounds);
+}
+
 #endif
 
 /* Keccak */
 
+typedef void (*keccak_permute_function)(uint64_t*, const uint64_t*, size_t);
+
+static void keccak_permute_p1600c_rc(uint64_t* state, const uint64_t* constants, size_t rounds);
+
+static void keccak_permute_select(uint64_t* state, const uint64_t* constants, size_t rounds);
+
+/* resolved on first use; every thread writes the same pointer value */
+static keccak_permute_function keccak_permute_rc_p1600 = &keccak_permute_select;
+
+static void keccak_permute_select(uint64_t* state, const uint64_t* constants, size_t rounds)
+{
+	keccak_permute_function pfunc;
+
+	pfunc = &keccak_permute_p1600c_rc;
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_cpuidex_cpu_features features;
+
+	if (qsc_cpuidex_features_set(&features) == true)
+	{
+		if (features.avx2 == true)
+		{
+			pfunc = &keccak_permute_p1600avx2_rc;
+		}
+
+#	if defined(QSC_SYSTEM_HAS_AVX512)
+		if (features.avx512f == true)
+		{
+			pfunc = &keccak_permute_p1600avx512_rc;
+		}
+#	endif
+	}
+#endif
+
+	keccak_permute_rc_p1600 = pfunc;
+	pfunc(state, constants, rounds);
+}
+
+static void keccak_permute_p1600(uint64_t* state, size_t rounds)
+{
+	keccak_permute_rc_p1600(state, KECCAK_ROUND_CONSTANTS, rounds);
+}
+
 void qsc_keccak_absorb(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_t* message, size_t msglen, uint8_t domain, size_t rounds)
 {
 	assert(ctx != NULL);
@@ -1190,49 +1607,58 @@ void qsc_keccak_absorb_key_custom(qsc_keccak_state* ctx, qsc_keccak_rate rate, c
 	assert(ctx != NULL);
 
 	uint8_t pad[QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	const uint64_t* kst;
 	size_t oft;
 	size_t i;
 
-	qsc_memutils_clear((uint8_t*)ctx->state, sizeof(ctx->state));
 	qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
 	ctx->position = 0;
+	kst = keccak_kmac_name_state(rate, name, namelen, custlen, rounds);
 
-	/* stage 1: name + custom */
+	if (kst != NULL)
+	{
+		/* stage 1 is a constant for kmac without a customization string */
+		qsc_memutils_copy((uint8_t*)ctx->state, (const uint8_t*)kst, sizeof(ctx->state));
+	}
+	else
+	{
+		/* stage 1: name + custom */
+		qsc_memutils_clear((uint8_t*)ctx->state, sizeof(ctx->state));
 
-	oft = keccak_left_encode(pad, rate);
-	oft += keccak_left_encode((pad + oft), namelen * 8);
+		oft = keccak_left_encode(pad, rate);
+		oft += keccak_left_encode((pad + oft), namelen * 8);
 
-	if (name != NULL)
-	{
-		for (i = 0; i < namelen; ++i)
+		if (name != NULL)
 		{
-			pad[oft + i] = name[i];
+			for (i = 0; i < namelen; ++i)
+			{
+				pad[oft + i] = name[i];
+			}
 		}
-	}
 
-	oft += namelen;
-	oft += keccak_left_encode((pad + oft), custlen * 8);
+		oft += namelen;
+		oft += keccak_left_encode((pad + oft), custlen * 8);
 
-	if (custom != NULL)
-	{
-		for (i = 0; i < custlen; ++i)
+		if (custom != NULL)
 		{
-			if (oft == rate)
+			for (i = 0; i < custlen; ++i)
 			{
-				keccak_fast_absorb(ctx->state, pad, rate);
-				qsc_keccak_permute(ctx, rounds);
-				oft = 0;
+				if (oft == rate)
+				{
+					keccak_fast_absorb(ctx->state, pad, rate);
+					qsc_keccak_permute(ctx, rounds);
+					oft = 0;
+				}
+
+				pad[oft] = custom[i];
+				++oft;
 			}
-
-			pad[oft] = custom[i];
-			++oft;
 		}
-	}
-
-	qsc_memutils_clear((pad + oft), rate - oft);
-	keccak_fast_absorb(ctx->state, pad, rate);
-	qsc_keccak_permute(ctx, rounds);
 
+		qsc_memutils_clear((pad + oft), rate - oft);
+		keccak_fast_absorb(ctx->state, pad, rate);
+		qsc_keccak_permute(ctx, rounds);
+	}
 
 	/* stage 2: key */
 
@@ -1262,6 +1688,22 @@ void qsc_keccak_absorb_key_custom(qsc_keccak_state* ctx, qsc_keccak_rate rate, c
 	qsc_keccak_permute(ctx, rounds);
 }
 
+void qsc_keccak_clone(qsc_keccak_state* output, const qsc_keccak_state* input)
+{
+	assert(output != NULL);
+	assert(input != NULL);
+
+	/* only the buffered bytes are copied, a freshly keyed state has an empty buffer */
+	qsc_memutils_copy((uint8_t*)output->state, (const uint8_t*)input->state, sizeof(input->state));
+
+	if (input->position != 0)
+	{
+		qsc_memutils_copy(output->buffer, input->buffer, input->position);
+	}
+
+	output->position = input->position;
+}
+
 void qsc_keccak_dispose(qsc_keccak_state* ctx)
 {
 	assert(ctx != NULL);
@@ -1299,19 +1741,8 @@ void qsc_keccak_finalize(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_t* o
 	pad[rate - 1] |= 128U;
 	keccak_fast_absorb(ctx->state, pad, rate);
 
-	while (outlen >= (size_t)rate)
-	{
-		qsc_keccak_squeezeblocks(ctx, pad, 1, rate, rounds);
-		qsc_memutils_copy(output, pad, rate);
-		output += rate;
-		outlen -= rate;
-	}
-
-	if (outlen > 0)
-	{
-		qsc_keccak_squeezeblocks(ctx, pad, 1, rate, rounds);
-		qsc_memutils_copy(output, pad, outlen);
-	}
+	ctx->position = 0;
+	qsc_keccak_squeeze(ctx, rate, output, outlen, rounds);
 
 	qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
 	ctx->position = 0;
@@ -1322,23 +1753,56 @@ void qsc_keccak_incremental_absorb(qsc_keccak_state* ctx, uint32_t rate, const u
 	assert(ctx != NULL);
 	assert(message != NULL);
 
-	uint8_t t[8] = { 0 };
-	size_t i;
+#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
+	size_t mlen;
 
-	if ((ctx->position & 7) > 0)
+	/* the message is xored straight into the state; the position is a byte offset into the rate */
+	if (ctx->position != 0)
 	{
-		i = ctx->position & 7;
+		mlen = qsc_intutils_min((size_t)rate - ctx->position, msglen);
+		keccak_xor_bytes(ctx->state, ctx->position, message, mlen);
+		ctx->position += mlen;
+		message += mlen;
+		msglen -= mlen;
 
-		while (i < 8 && msglen > 0)
+		if (ctx->position == (size_t)rate)
 		{
-			t[i] = *message;
-			message++;
-			i++;
-			msglen--;
-			ctx->position++;
+			keccak_permute_p1600(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			ctx->position = 0;
 		}
-
-		ctx->state[(ctx->position - i) / 8] ^= qsc_intutils_le8to64(t);
+	}
+
+	while (msglen >= (size_t)rate)
+	{
+		keccak_xor_bytes(ctx->state, 0, message, (size_t)rate);
+		keccak_permute_p1600(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		message += rate;
+		msglen -= rate;
+	}
+
+	if (msglen != 0)
+	{
+		keccak_xor_bytes(ctx->state, 0, message, msglen);
+		ctx->position = msglen;
+	}
+#else
+	uint8_t t[8] = { 0 };
+	size_t i;
+
+	if ((ctx->position & 7) > 0)
+	{
+		i = ctx->position & 7;
+
+		while (i < 8 && msglen > 0)
+		{
+			t[i] = *message;
+			message++;
+			i++;
+			msglen--;
+			ctx->position++;
+		}
+
+		ctx->state[(ctx->position - i) / 8] ^= qsc_intutils_le8to64(t);
 	}
 
 	if (ctx->position && msglen >= rate - ctx->position)
@@ -1351,7 +1815,7 @@ void qsc_keccak_incremental_absorb(qsc_keccak_state* ctx, uint32_t rate, const u
 		message += rate - ctx->position;
 		msglen -= rate - ctx->position;
 		ctx->position = 0;
-		qsc_keccak_permute_p1600c(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		keccak_permute_p1600(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
 	}
 
 	while (msglen >= rate)
@@ -1363,7 +1827,7 @@ void qsc_keccak_incremental_absorb(qsc_keccak_state* ctx, uint32_t rate, const u
 
 		message += rate;
 		msglen -= rate;
-		qsc_keccak_permute_p1600c(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		keccak_permute_p1600(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
 	}
 
 	for (i = 0; i < msglen / 8; ++i)
@@ -1390,6 +1854,7 @@ void qsc_keccak_incremental_absorb(qsc_keccak_state* ctx, uint32_t rate, const u
 		ctx->state[ctx->position / 8] ^= qsc_intutils_le8to64(t);
 		ctx->position += msglen;
 	}
+#endif
 }
 
 void qsc_keccak_incremental_finalize(qsc_keccak_state* ctx, uint32_t rate, uint8_t domain)
@@ -1411,74 +1876,7 @@ void qsc_keccak_incremental_squeeze(qsc_keccak_state* ctx, size_t rate, uint8_t*
 	assert(ctx != NULL);
 	assert(output != NULL);
 
-	size_t i;
-	uint8_t t[8];
-
-	if ((ctx->position & 7) > 0)
-	{
-		qsc_intutils_le64to8(t, ctx->state[ctx->position / 8]);
-		i = ctx->position & 7;
-
-		while (i < 8 && outlen > 0)
-		{
-			*output = t[i];
-			output++;
-			i++;
-			outlen--;
-			ctx->position++;
-		}
-	}
-
-	if (ctx->position && outlen >= rate - ctx->position)
-	{
-		for (i = 0; i < (rate - ctx->position) / 8; ++i)
-		{
-			qsc_intutils_le64to8(output + (8 * i), ctx->state[(ctx->position / 8) + i]);
-		}
-
-		output += rate - ctx->position;
-		outlen -= rate - ctx->position;
-		ctx->position = 0;
-	}
-
-	while (outlen >= rate)
-	{
-		qsc_keccak_permute_p1600c(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
-
-		for (i = 0; i < rate / 8; ++i)
-		{
-			qsc_intutils_le64to8(output + (8 * i), ctx->state[i]);
-		}
-
-		output += rate;
-		outlen -= rate;
-	}
-
-	if (outlen > 0)
-	{
-		if (ctx->position == 0)
-		{
-			qsc_keccak_permute_p1600c(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
-		}
-
-		for (i = 0; i < outlen / 8; ++i)
-		{
-			qsc_intutils_le64to8(output + (8 * i), ctx->state[(ctx->position / 8) + i]);
-		}
-
-		output += 8 * i;
-		outlen -= 8 * i;
-		ctx->position += 8 * i;
-
-		qsc_intutils_le64to8(t, ctx->state[ctx->position / 8]);
-
-		for (i = 0; i < outlen; ++i)
-		{
-			output[i] = t[i];
-		}
-
-		ctx->position += outlen;
-	}
+	qsc_keccak_squeeze(ctx, (qsc_keccak_rate)rate, output, outlen, QSC_KECCAK_PERMUTATION_ROUNDS);
 }
 
 void qsc_keccak_permute(qsc_keccak_state* ctx, size_t rounds)
@@ -1488,14 +1886,14 @@ void qsc_keccak_permute(qsc_keccak_state* ctx, size_t rounds)
 	if (ctx != NULL)
 	{
 #if defined(QSC_KECCAK_UNROLLED_PERMUTATION)
-		qsc_keccak_permute_p1600u(ctx->state)
+		qsc_keccak_permute_p1600u(ctx->state);
 #else
-		qsc_keccak_permute_p1600c(ctx->state, rounds);
+		keccak_permute_p1600(ctx->state, rounds);
 #endif
 	}
 }
 
-void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
+static void keccak_permute_p1600c_rc(uint64_t* state, const uint64_t* constants, size_t rounds)
 {
 	assert(state != NULL);
 	assert(rounds % 2 == 0);
@@ -1615,7 +2013,7 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 		Asu ^= Du;
 		BCu = qsc_intutils_rotl64(Asu, 14);
 		Eba = BCa ^ ((~BCe) & BCi);
-		Eba ^= KECCAK_ROUND_CONSTANTS[i];
+		Eba ^= constants[i];
 		Ebe = BCe ^ ((~BCi) & BCo);
 		Ebi = BCi ^ ((~BCo) & BCu);
 		Ebo = BCo ^ ((~BCu) & BCa);
@@ -1710,7 +2108,7 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 		Esu ^= Du;
 		BCu = qsc_intutils_rotl64(Esu, 14);
 		Aba = BCa ^ ((~BCe) & BCi);
-		Aba ^= KECCAK_ROUND_CONSTANTS[i + 1];
+		Aba ^= constants[i + 1];
 		Abe = BCe ^ ((~BCi) & BCo);
 		Abi = BCi ^ ((~BCo) & BCu);
 		Abo = BCo ^ ((~BCu) & BCa);
@@ -1809,6 +2207,11 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 	state[24] = Asu;
 }
 
+void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
+{
+	keccak_permute_p1600c_rc(state, KECCAK_ROUND_CONSTANTS, rounds);
+}
+
 void qsc_keccak_permute_p1600u(uint64_t* state)
 {
 	assert(state != NULL);
@@ -4016,6 +4419,47 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	state[24] = Asu;
 }
 
+void qsc_keccak_squeeze(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_t* output, size_t outlen, size_t rounds)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+
+	size_t blen;
+
+	if (ctx != NULL && output != NULL)
+	{
+		/* drain the remainder of the current block; the position is the byte offset already squeezed */
+		if (ctx->position != 0)
+		{
+			blen = qsc_intutils_min((size_t)rate - ctx->position, outlen);
+			keccak_extract_bytes(ctx->state, ctx->position, output, blen);
+			ctx->position += blen;
+			output += blen;
+			outlen -= blen;
+
+			if (ctx->position == (size_t)rate)
+			{
+				ctx->position = 0;
+			}
+		}
+
+		while (outlen >= (size_t)rate)
+		{
+			keccak_permute_p1600(ctx->state, rounds);
+			keccak_extract_bytes(ctx->state, 0, output, (size_t)rate);
+			output += (size_t)rate;
+			outlen -= (size_t)rate;
+		}
+
+		if (outlen != 0)
+		{
+			keccak_permute_p1600(ctx->state, rounds);
+			keccak_extract_bytes(ctx->state, 0, output, outlen);
+			ctx->position = outlen;
+		}
+	}
+}
+
 void qsc_keccak_squeezeblocks(qsc_keccak_state* ctx, uint8_t* output, size_t nblocks, qsc_keccak_rate rate, size_t rounds)
 {
 	assert(ctx != NULL);
@@ -4064,12 +4508,18 @@ void qsc_keccak_update(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_
 		{
 			const size_t RMDLEN = rate - ctx->position;
 
+#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
+			/* complete the block from the caller's message without staging it */
+			keccak_xor_bytes(ctx->state, 0, ctx->buffer, ctx->position);
+			keccak_xor_bytes(ctx->state, ctx->position, message, RMDLEN);
+#else
 			if (RMDLEN != 0)
 			{
 				qsc_memutils_copy((ctx->buffer + ctx->position), message, RMDLEN);
 			}
 
 			keccak_fast_absorb(ctx->state, ctx->buffer, (size_t)rate);
+#endif
 			qsc_keccak_permute(ctx, rounds);
 			ctx->position = 0;
 			message += RMDLEN;
@@ -4096,19 +4546,35 @@ void qsc_keccak_update(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_
 
 /* SHA3 */
 
+static void keccak_compute_short(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, qsc_keccak_rate rate, uint8_t domain)
+{
+	/* a message shorter than the rate with a single block of output; one permutation and no context staging */
+	uint64_t state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	keccak_short_absorb(state, rate, message, msglen, domain);
+	keccak_permute_p1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+	keccak_extract_bytes(state, 0, output, outlen);
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+}
+
 void qsc_sha3_compute128(uint8_t* output, const uint8_t* message, size_t msglen)
 {
 	assert(output != NULL);
 	assert(message != NULL);
 
 	qsc_keccak_state ctx;
-	uint8_t hash[QSC_KECCAK_128_RATE] = { 0 };
 
-	qsc_sha3_initialize(&ctx);
-	qsc_keccak_absorb(&ctx, qsc_keccak_rate_128, message, msglen, QSC_KECCAK_SHA3_DOMAIN_ID, QSC_KECCAK_PERMUTATION_ROUNDS);
-	qsc_keccak_squeezeblocks(&ctx, hash, 1, qsc_keccak_rate_128, QSC_KECCAK_PERMUTATION_ROUNDS);
-	qsc_memutils_copy(output, hash, QSC_SHA3_128_HASH_SIZE);
-	qsc_keccak_dispose(&ctx);
+	if (msglen < QSC_KECCAK_128_RATE)
+	{
+		keccak_compute_short(output, QSC_SHA3_128_HASH_SIZE, message, msglen, qsc_keccak_rate_128, QSC_KECCAK_SHA3_DOMAIN_ID);
+	}
+	else
+	{
+		qsc_sha3_initialize(&ctx);
+		qsc_keccak_absorb(&ctx, qsc_keccak_rate_128, message, msglen, QSC_KECCAK_SHA3_DOMAIN_ID, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_squeeze(&ctx, qsc_keccak_rate_128, output, QSC_SHA3_128_HASH_SIZE, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_dispose(&ctx);
+	}
 }
 
 void qsc_sha3_compute256(uint8_t* output, const uint8_t* message, size_t msglen)
@@ -4117,13 +4583,18 @@ void qsc_sha3_compute256(uint8_t* output, const uint8_t* message, size_t msglen)
 	assert(message != NULL);
 
 	qsc_keccak_state ctx;
-	uint8_t hash[QSC_KECCAK_256_RATE] = { 0 };
 
-	qsc_sha3_initialize(&ctx);
-	qsc_keccak_absorb(&ctx, qsc_keccak_rate_256, message, msglen, QSC_KECCAK_SHA3_DOMAIN_ID, QSC_KECCAK_PERMUTATION_ROUNDS);
-	qsc_keccak_squeezeblocks(&ctx, hash, 1, qsc_keccak_rate_256, QSC_KECCAK_PERMUTATION_ROUNDS);
-	qsc_memutils_copy(output, hash, QSC_SHA3_256_HASH_SIZE);
-	qsc_keccak_dispose(&ctx);
+	if (msglen < QSC_KECCAK_256_RATE)
+	{
+		keccak_compute_short(output, QSC_SHA3_256_HASH_SIZE, message, msglen, qsc_keccak_rate_256, QSC_KECCAK_SHA3_DOMAIN_ID);
+	}
+	else
+	{
+		qsc_sha3_initialize(&ctx);
+		qsc_keccak_absorb(&ctx, qsc_keccak_rate_256, message, msglen, QSC_KECCAK_SHA3_DOMAIN_ID, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_squeeze(&ctx, qsc_keccak_rate_256, output, QSC_SHA3_256_HASH_SIZE, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_dispose(&ctx);
+	}
 }
 
 void qsc_sha3_compute512(uint8_t* output, const uint8_t* message, size_t msglen)
@@ -4132,13 +4603,18 @@ void qsc_sha3_compute512(uint8_t* output, const uint8_t* message, size_t msglen)
 	assert(message != NULL);
 
 	qsc_keccak_state ctx;
-	uint8_t hash[QSC_KECCAK_512_RATE] = { 0 };
 
-	qsc_sha3_initialize(&ctx);
-	qsc_keccak_absorb(&ctx, qsc_keccak_rate_512, message, msglen, QSC_KECCAK_SHA3_DOMAIN_ID, QSC_KECCAK_PERMUTATION_ROUNDS);
-	qsc_keccak_squeezeblocks(&ctx, hash, 1, qsc_keccak_rate_512, QSC_KECCAK_PERMUTATION_ROUNDS);
-	qsc_memutils_copy(output, hash, QSC_SHA3_512_HASH_SIZE);
-	qsc_keccak_dispose(&ctx);
+	if (msglen < QSC_KECCAK_512_RATE)
+	{
+		keccak_compute_short(output, QSC_SHA3_512_HASH_SIZE, message, msglen, qsc_keccak_rate_512, QSC_KECCAK_SHA3_DOMAIN_ID);
+	}
+	else
+	{
+		qsc_sha3_initialize(&ctx);
+		qsc_keccak_absorb(&ctx, qsc_keccak_rate_512, message, msglen, QSC_KECCAK_SHA3_DOMAIN_ID, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_squeeze(&ctx, qsc_keccak_rate_512, output, QSC_SHA3_512_HASH_SIZE, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_dispose(&ctx);
+	}
 }
 
 void qsc_sha3_finalize(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_t* output)
@@ -4185,22 +4661,18 @@ void qsc_shake128_compute(uint8_t* output, size_t outlen, const uint8_t* key, si
 	assert(output != NULL);
 	assert(key != NULL);
 
-	const size_t nblocks = outlen / QSC_KECCAK_128_RATE;
 	qsc_keccak_state ctx;
-	uint8_t hash[QSC_KECCAK_128_RATE] = { 0 };
 
-	qsc_shake_initialize(&ctx, qsc_keccak_rate_128, key, keylen);
-	qsc_shake_squeezeblocks(&ctx, qsc_keccak_rate_128, output, nblocks);
-	output += (nblocks * QSC_KECCAK_128_RATE);
-	outlen -= (nblocks * QSC_KECCAK_128_RATE);
-
-	if (outlen != 0)
+	if (keylen < QSC_KECCAK_128_RATE && outlen <= QSC_KECCAK_128_RATE)
 	{
-		qsc_shake_squeezeblocks(&ctx, qsc_keccak_rate_128, hash, 1);
-		qsc_memutils_copy(output, hash, outlen);
+		keccak_compute_short(output, outlen, key, keylen, qsc_keccak_rate_128, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	}
+	else
+	{
+		qsc_shake_initialize(&ctx, qsc_keccak_rate_128, key, keylen);
+		qsc_keccak_squeeze(&ctx, qsc_keccak_rate_128, output, outlen, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_dispose(&ctx);
 	}
-
-	qsc_keccak_dispose(&ctx);
 }
 
 void qsc_shake256_compute(uint8_t* output, size_t outlen, const uint8_t* key, size_t keylen)
@@ -4208,22 +4680,18 @@ void qsc_shake256_compute(uint8_t* output, size_t outlen, const uint8_t* key, si
 	assert(output != NULL);
 	assert(key != NULL);
 
-	const size_t nblocks = outlen / QSC_KECCAK_256_RATE;
 	qsc_keccak_state ctx;
-	uint8_t hash[QSC_KECCAK_256_RATE] = { 0 };
 
-	qsc_shake_initialize(&ctx, qsc_keccak_rate_256, key, keylen);
-	qsc_shake_squeezeblocks(&ctx, qsc_keccak_rate_256, output, nblocks);
-	output += (nblocks * QSC_KECCAK_256_RATE);
-	outlen -= (nblocks * QSC_KECCAK_256_RATE);
-
-	if (outlen != 0)
+	if (keylen < QSC_KECCAK_256_RATE && outlen <= QSC_KECCAK_256_RATE)
 	{
-		qsc_shake_squeezeblocks(&ctx, qsc_keccak_rate_256, hash, 1);
-		qsc_memutils_copy(output, hash, outlen);
+		keccak_compute_short(output, outlen, key, keylen, qsc_keccak_rate_256, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	}
+	else
+	{
+		qsc_shake_initialize(&ctx, qsc_keccak_rate_256, key, keylen);
+		qsc_keccak_squeeze(&ctx, qsc_keccak_rate_256, output, outlen, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_dispose(&ctx);
 	}
-
-	qsc_keccak_dispose(&ctx);
 }
 
 void qsc_shake512_compute(uint8_t* output, size_t outlen, const uint8_t* key, size_t keylen)
@@ -4231,22 +4699,18 @@ void qsc_shake512_compute(uint8_t* output, size_t outlen, const uint8_t* key, si
 	assert(output != NULL);
 	assert(key != NULL);
 
-	const size_t nblocks = outlen / QSC_KECCAK_512_RATE;
 	qsc_keccak_state ctx;
-	uint8_t hash[QSC_KECCAK_512_RATE] = { 0 };
 
-	qsc_shake_initialize(&ctx, qsc_keccak_rate_512, key, keylen);
-	qsc_shake_squeezeblocks(&ctx, qsc_keccak_rate_512, output, nblocks);
-	output += (nblocks * QSC_KECCAK_512_RATE);
-	outlen -= (nblocks * QSC_KECCAK_512_RATE);
-
-	if (outlen != 0)
+	if (keylen < QSC_KECCAK_512_RATE && outlen <= QSC_KECCAK_512_RATE)
 	{
-		qsc_shake_squeezeblocks(&ctx, qsc_keccak_rate_512, hash, 1);
-		qsc_memutils_copy(output, hash, outlen);
+		keccak_compute_short(output, outlen, key, keylen, qsc_keccak_rate_512, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	}
+	else
+	{
+		qsc_shake_initialize(&ctx, qsc_keccak_rate_512, key, keylen);
+		qsc_keccak_squeeze(&ctx, qsc_keccak_rate_512, output, outlen, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_dispose(&ctx);
 	}
-
-	qsc_keccak_dispose(&ctx);
 }
 
 void qsc_shake_initialize(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_t* key, size_t keylen)
@@ -4266,6 +4730,14 @@ void qsc_shake_squeezeblocks(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_
 	qsc_keccak_squeezeblocks(ctx, output, nblocks, rate, QSC_KECCAK_PERMUTATION_ROUNDS);
 }
 
+void qsc_shake_squeeze(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_t* output, size_t outlen)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+
+	qsc_keccak_squeeze(ctx, rate, output, outlen, QSC_KECCAK_PERMUTATION_ROUNDS);
+}
+
 /* cSHAKE */
 
 void qsc_cshake128_compute(uint8_t* output, size_t outlen, const uint8_t* key, size_t keylen, const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen)
@@ -4273,9 +4745,7 @@ void qsc_cshake128_compute(uint8_t* output, size_t outlen, const uint8_t* key, s
 	assert(output != NULL);
 	assert(key != NULL);
 
-	const size_t nblocks = outlen / QSC_KECCAK_128_RATE;
 	qsc_keccak_state ctx;
-	uint8_t hash[QSC_KECCAK_128_RATE] = { 0 };
 
 	if (custlen + namelen != 0)
 	{
@@ -4286,16 +4756,7 @@ void qsc_cshake128_compute(uint8_t* output, size_t outlen, const uint8_t* key, s
 		qsc_shake_initialize(&ctx, qsc_keccak_rate_128, key, keylen);
 	}
 
-	qsc_cshake_squeezeblocks(&ctx, qsc_keccak_rate_128, output, nblocks);
-	output += (nblocks * QSC_KECCAK_128_RATE);
-	outlen -= (nblocks * QSC_KECCAK_128_RATE);
-
-	if (outlen != 0)
-	{
-		qsc_cshake_squeezeblocks(&ctx, qsc_keccak_rate_128, hash, 1);
-		qsc_memutils_copy(output, hash, outlen);
-	}
-
+	qsc_keccak_squeeze(&ctx, qsc_keccak_rate_128, output, outlen, QSC_KECCAK_PERMUTATION_ROUNDS);
 	qsc_keccak_dispose(&ctx);
 }
 
@@ -4304,9 +4765,7 @@ void qsc_cshake256_compute(uint8_t* output, size_t outlen, const uint8_t* key, s
 	assert(output != NULL);
 	assert(key != NULL);
 
-	const size_t nblocks = outlen / QSC_KECCAK_256_RATE;
 	qsc_keccak_state ctx;
-	uint8_t hash[QSC_KECCAK_256_RATE] = { 0 };
 
 	if (custlen + namelen != 0)
 	{
@@ -4317,17 +4776,7 @@ void qsc_cshake256_compute(uint8_t* output, size_t outlen, const uint8_t* key, s
 		qsc_shake_initialize(&ctx, qsc_keccak_rate_256, key, keylen);
 	}
 
-	qsc_cshake_squeezeblocks(&ctx, qsc_keccak_rate_256, output, nblocks);
-
-	output += (nblocks * QSC_KECCAK_256_RATE);
-	outlen -= (nblocks * QSC_KECCAK_256_RATE);
-
-	if (outlen != 0)
-	{
-		qsc_cshake_squeezeblocks(&ctx, qsc_keccak_rate_256, hash, 1);
-		qsc_memutils_copy(output, hash, outlen);
-	}
-
+	qsc_keccak_squeeze(&ctx, qsc_keccak_rate_256, output, outlen, QSC_KECCAK_PERMUTATION_ROUNDS);
 	qsc_keccak_dispose(&ctx);
 }
 
@@ -4336,9 +4785,7 @@ void qsc_cshake512_compute(uint8_t* output, size_t outlen, const uint8_t* key, s
 	assert(output != NULL);
 	assert(key != NULL);
 
-	const size_t nblocks = outlen / QSC_KECCAK_512_RATE;
 	qsc_keccak_state ctx;
-	uint8_t hash[QSC_KECCAK_512_RATE] = { 0 };
 
 	if (custlen + namelen != 0)
 	{
@@ -4349,16 +4796,7 @@ void qsc_cshake512_compute(uint8_t* output, size_t outlen, const uint8_t* key, s
 		qsc_shake_initialize(&ctx, qsc_keccak_rate_512, key, keylen);
 	}
 
-	qsc_cshake_squeezeblocks(&ctx, qsc_keccak_rate_512, output, nblocks);
-	output += (nblocks * QSC_KECCAK_512_RATE);
-	outlen -= (nblocks * QSC_KECCAK_512_RATE);
-
-	if (outlen != 0)
-	{
-		qsc_cshake_squeezeblocks(&ctx, qsc_keccak_rate_512, hash, 1);
-		qsc_memutils_copy(output, hash, outlen);
-	}
-
+	qsc_keccak_squeeze(&ctx, qsc_keccak_rate_512, output, outlen, QSC_KECCAK_PERMUTATION_ROUNDS);
 	qsc_keccak_dispose(&ctx);
 }
 
@@ -4379,6 +4817,14 @@ void qsc_cshake_squeezeblocks(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8
 	qsc_keccak_squeezeblocks(ctx, output, nblocks, rate, QSC_KECCAK_PERMUTATION_ROUNDS);
 }
 
+void qsc_cshake_squeeze(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_t* output, size_t outlen)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+
+	qsc_keccak_squeeze(ctx, rate, output, outlen, QSC_KECCAK_PERMUTATION_ROUNDS);
+}
+
 void qsc_cshake_update(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_t* key, size_t keylen)
 {
 	assert(ctx != NULL);
@@ -4401,6 +4847,43 @@ void qsc_cshake_update(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_
 
 /* KMAC */
 
+static bool kmac_is_short(qsc_keccak_rate rate, size_t outlen, size_t msglen, size_t keylen, size_t custlen)
+{
+	/* the key and the message each fit one block with their encodings, and the output is one block */
+	return (custlen == 0 && outlen <= (size_t)rate &&
+		keylen + (2 * (sizeof(size_t) + 1)) <= (size_t)rate &&
+		msglen + sizeof(size_t) + 2 < (size_t)rate);
+}
+
+static void kmac_compute_short(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, const uint8_t* key, size_t keylen, qsc_keccak_rate rate)
+{
+	/* the precomputed name state, one key block and one message block */
+	uint64_t state[QSC_KECCAK_STATE_SIZE];
+	uint8_t pad[QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	const uint8_t name[4] = { 0x4B, 0x4D, 0x41, 0x43 };
+	size_t oft;
+
+	qsc_memutils_copy((uint8_t*)state, (const uint8_t*)keccak_kmac_name_state(rate, name, sizeof(name), 0, QSC_KECCAK_PERMUTATION_ROUNDS), sizeof(state));
+
+	oft = keccak_left_encode(pad, (size_t)rate);
+	oft += keccak_left_encode((pad + oft), keylen * 8);
+	qsc_memutils_copy((pad + oft), key, keylen);
+	keccak_fast_absorb(state, pad, (size_t)rate);
+	keccak_permute_p1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+	qsc_memutils_clear(pad, (size_t)rate);
+	qsc_memutils_copy(pad, message, msglen);
+	oft = msglen + keccak_right_encode((pad + msglen), outlen * 8);
+	pad[oft] = QSC_KECCAK_KMAC_DOMAIN_ID;
+	pad[(size_t)rate - 1] |= 128U;
+	keccak_fast_absorb(state, pad, (size_t)rate);
+	keccak_permute_p1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+	keccak_extract_bytes(state, 0, output, outlen);
+	qsc_memutils_clear(pad, sizeof(pad));
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+}
+
 void qsc_kmac128_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen)
 {
 	assert(output != NULL);
@@ -4409,9 +4892,16 @@ void qsc_kmac128_compute(uint8_t* output, size_t outlen, const uint8_t* message,
 
 	qsc_keccak_state ctx;
 
-	qsc_kmac_initialize(&ctx, qsc_keccak_rate_128, key, keylen, custom, custlen);
-	qsc_kmac_update(&ctx, qsc_keccak_rate_128, message, msglen);
-	qsc_kmac_finalize(&ctx, qsc_keccak_rate_128, output, outlen);
+	if (kmac_is_short(qsc_keccak_rate_128, outlen, msglen, keylen, custlen) == true)
+	{
+		kmac_compute_short(output, outlen, message, msglen, key, keylen, qsc_keccak_rate_128);
+	}
+	else
+	{
+		qsc_kmac_initialize(&ctx, qsc_keccak_rate_128, key, keylen, custom, custlen);
+		qsc_kmac_update(&ctx, qsc_keccak_rate_128, message, msglen);
+		qsc_kmac_finalize(&ctx, qsc_keccak_rate_128, output, outlen);
+	}
 }
 
 void qsc_kmac256_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen)
@@ -4422,9 +4912,16 @@ void qsc_kmac256_compute(uint8_t* output, size_t outlen, const uint8_t* message,
 
 	qsc_keccak_state ctx;
 
-	qsc_kmac_initialize(&ctx, qsc_keccak_rate_256, key, keylen, custom, custlen);
-	qsc_kmac_update(&ctx, qsc_keccak_rate_256, message, msglen);
-	qsc_kmac_finalize(&ctx, qsc_keccak_rate_256, output, outlen);
+	if (kmac_is_short(qsc_keccak_rate_256, outlen, msglen, keylen, custlen) == true)
+	{
+		kmac_compute_short(output, outlen, message, msglen, key, keylen, qsc_keccak_rate_256);
+	}
+	else
+	{
+		qsc_kmac_initialize(&ctx, qsc_keccak_rate_256, key, keylen, custom, custlen);
+		qsc_kmac_update(&ctx, qsc_keccak_rate_256, message, msglen);
+		qsc_kmac_finalize(&ctx, qsc_keccak_rate_256, output, outlen);
+	}
 }
 
 void qsc_kmac512_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen)
@@ -4435,9 +4932,16 @@ void qsc_kmac512_compute(uint8_t* output, size_t outlen, const uint8_t* message,
 
 	qsc_keccak_state ctx;
 
-	qsc_kmac_initialize(&ctx, qsc_keccak_rate_512, key, keylen, custom, custlen);
-	qsc_kmac_update(&ctx, qsc_keccak_rate_512, message, msglen);
-	qsc_kmac_finalize(&ctx, qsc_keccak_rate_512, output, outlen);
+	if (kmac_is_short(qsc_keccak_rate_512, outlen, msglen, keylen, custlen) == true)
+	{
+		kmac_compute_short(output, outlen, message, msglen, key, keylen, qsc_keccak_rate_512);
+	}
+	else
+	{
+		qsc_kmac_initialize(&ctx, qsc_keccak_rate_512, key, keylen, custom, custlen);
+		qsc_kmac_update(&ctx, qsc_keccak_rate_512, message, msglen);
+		qsc_kmac_finalize(&ctx, qsc_keccak_rate_512, output, outlen);
+	}
 }
 
 void qsc_kmac_finalize(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_t* output, size_t outlen)
@@ -4480,7 +4984,7 @@ static void kpa_absorb_leaves(uint64_t* state, qsc_keccak_rate rate, const uint8
 			state[i] ^= qsc_intutils_le8to64(input + (sizeof(uint64_t) * i));
 		}
 #endif
-		qsc_keccak_permute_p1600c(state, QSC_KPA_ROUNDS);
+		keccak_permute_p1600(state, QSC_KPA_ROUNDS);
 		inplen -= rate;
 		input += rate;
 	}
@@ -4496,7 +5000,7 @@ static void kpa_absorb_leaves(uint64_t* state, qsc_keccak_rate rate, const uint8
 		}
 #endif
 
-		qsc_keccak_permute_p1600c(state, QSC_KPA_ROUNDS);
+		keccak_permute_p1600(state, QSC_KPA_ROUNDS);
 	}
 }
 
@@ -4578,7 +5082,7 @@ static void kpa_permutex8(qsc_kpa_state* ctx)
 #else
 	for (size_t i = 0; i < QSC_KPA_PARALLELISM; ++i)
 	{
-		qsc_keccak_permute_p1600c(ctx->state[i], QSC_KPA_ROUNDS);
+		keccak_permute_p1600(ctx->state[i], QSC_KPA_ROUNDS);
 	}
 #endif
 }
@@ -4590,7 +5094,7 @@ static void kpa_squeezeblocks(uint64_t* state, uint8_t* output, size_t nblocks,
 
 	while (nblocks > 0)
 	{
-		qsc_keccak_permute_p1600c(state, QSC_KPA_ROUNDS);
+		keccak_permute_p1600(state, QSC_KPA_ROUNDS);
 
 #if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
 		qsc_memutils_copy(output, (uint8_t*)state, (size_t)rate);
@@ -4791,7 +5295,7 @@ void qsc_kpa_finalize(qsc_kpa_state* ctx, uint8_t* output, size_t outlen)
 	ctx->processed = 0;
 }
 
-void qsc_kpa_initialize(qsc_kpa_state* ctx, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen)
+static void kpa_initialize(qsc_kpa_state* ctx, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen, const uint8_t* node, size_t nodelen)
 {
 	assert(ctx != NULL);
 	assert(key != NULL);
@@ -4815,21 +5319,22 @@ void qsc_kpa_initialize(qsc_kpa_state* ctx, const uint8_t* key, size_t keylen, c
 
 	/* stage 1: add customization to state */
 
-	if (custlen != 0)
+	/* a tree node name extends the customization string */
+	if (custlen + nodelen != 0)
 	{
 		oft = keccak_left_encode(pad, ctx->rate);
-		oft += keccak_left_encode((pad + oft), custlen * 8);
+		oft += keccak_left_encode((pad + oft), (custlen + nodelen) * 8);
 
-		for (i = 0; i < custlen; ++i)
+		for (i = 0; i < custlen + nodelen; ++i)
 		{
 			if (oft == (size_t)ctx->rate)
 			{
 				keccak_fast_absorb(tmps, pad, ctx->rate);
-				qsc_keccak_permute_p1600c(tmps, QSC_KPA_ROUNDS);
+				keccak_permute_p1600(tmps, QSC_KPA_ROUNDS);
 				oft = 0;
 			}
 
-			pad[oft] = custom[i];
+			pad[oft] = (i < custlen) ? custom[i] : node[i - custlen];
 			++oft;
 		}
 
@@ -4838,7 +5343,7 @@ void qsc_kpa_initialize(qsc_kpa_state* ctx, const uint8_t* key, size_t keylen, c
 			/* absorb custom and name, and permute state */
 			qsc_memutils_clear((pad + oft), (size_t)ctx->rate - oft);
 			keccak_fast_absorb(tmps, pad, ctx->rate);
-			qsc_keccak_permute_p1600c(tmps, QSC_KPA_ROUNDS);
+			keccak_permute_p1600(tmps, QSC_KPA_ROUNDS);
 		}
 	}
 
@@ -4855,7 +5360,7 @@ void qsc_kpa_initialize(qsc_kpa_state* ctx, const uint8_t* key, size_t keylen, c
 			if (oft == (size_t)ctx->rate)
 			{
 				keccak_fast_absorb(tmps, pad, ctx->rate);
-				qsc_keccak_permute_p1600c(tmps, QSC_KPA_ROUNDS);
+				keccak_permute_p1600(tmps, QSC_KPA_ROUNDS);
 				oft = 0;
 			}
 
@@ -4868,7 +5373,7 @@ void qsc_kpa_initialize(qsc_kpa_state* ctx, const uint8_t* key, size_t keylen, c
 			/* absorb the key and permute the state */
 			qsc_memutils_clear((pad + oft), (size_t)ctx->rate - oft);
 			keccak_fast_absorb(tmps, pad, ctx->rate);
-			qsc_keccak_permute_p1600c(tmps, QSC_KPA_ROUNDS);
+			keccak_permute_p1600(tmps, QSC_KPA_ROUNDS);
 		}
 	}
 
@@ -4939,6 +5444,14 @@ void qsc_kpa_initialize(qsc_kpa_state* ctx, const uint8_t* key, size_t keylen, c
 	kpa_permutex8(ctx);
 }
 
+void qsc_kpa_initialize(qsc_kpa_state* ctx, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen)
+{
+	assert(ctx != NULL);
+	assert(key != NULL);
+
+	kpa_initialize(ctx, key, keylen, custom, custlen, NULL, 0);
+}
+
 void qsc_kpa_update(qsc_kpa_state* ctx, const uint8_t* message, size_t msglen)
 {
 	assert(ctx != NULL);
@@ -4984,42 +5497,338 @@ void qsc_kpa_update(qsc_kpa_state* ctx, const uint8_t* message, size_t msglen)
 	}
 }
 
-/* parallel SHAKE x4 */
+/* KPA-tree */
 
-#if defined(QSC_SYSTEM_HAS_AVX2)
+#define KPA_TREE_BATCH 64
+#define KPA_TREE_NODE_SIZE 16
+#define KPA_TREE_ROOT_INDEX 0xFFFFFFFFFFFFFFFFULL
 
-void qsc_keccakx4_absorb(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen, uint8_t domain)
+static void kpa_tree_node(uint8_t* node, uint64_t index)
 {
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
+	const uint8_t name[8] = { 0x4B, 0x50, 0x41, 0x54, 0x52, 0x45, 0x45, QSC_KPA_TREE_VERSION };
 
-	__m256i t;
-	__m256i idx = { 0 };
-	int64_t p0;
-	int64_t p1;
-	int64_t p2;
-	int64_t p3;
-	size_t pos;
-	size_t i;
+	qsc_memutils_copy(node, name, sizeof(name));
+	qsc_intutils_be64to8(node + sizeof(name), index);
+}
 
-	pos = 0;
-	p0 = (int64_t)inp0;
-	p1 = (int64_t)inp1;
-	p2 = (int64_t)inp2;
-	p3 = (int64_t)inp3;
+static void kpa_tree_leaf(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen,
+	const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen, uint64_t index)
+{
+	uint8_t node[KPA_TREE_NODE_SIZE];
+	qsc_kpa_state ctx;
+
+	kpa_tree_node(node, index);
+	kpa_initialize(&ctx, key, keylen, custom, custlen, node, sizeof(node));
+	qsc_kpa_update(&ctx, message, msglen);
+	qsc_kpa_finalize(&ctx, output, outlen);
+	qsc_kpa_dispose(&ctx);
+}
 
-	idx = _mm256_set_epi64x(p3, p2, p1, p0);
+void qsc_kpa_tree_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen,
+	const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen, size_t threads)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+	assert(key != NULL);
 
-	while (inplen >= (size_t)rate)
+	uint8_t leaves[KPA_TREE_BATCH * KPA_LEAF_HASH512];
+	uint8_t node[KPA_TREE_NODE_SIZE];
+	qsc_kpa_state ctx;
+	size_t base;
+	size_t hlen;
+	size_t nchunk;
+	int32_t bcnt;
+	int32_t j;
+
+	if (msglen <= QSC_KPA_TREE_CHUNK_SIZE)
 	{
-		for (i = 0; i < (size_t)rate / sizeof(uint64_t); ++i)
+		/* a single superchunk is plain KPA */
+		qsc_kpa_initialize(&ctx, key, keylen, custom, custlen);
+		qsc_kpa_update(&ctx, message, msglen);
+		qsc_kpa_finalize(&ctx, output, outlen);
+	}
+	else
+	{
+		hlen = (keylen == QSC_KPA_128_KEY_SIZE) ? KPA_LEAF_HASH128 : (keylen == QSC_KPA_256_KEY_SIZE) ? KPA_LEAF_HASH256 : KPA_LEAF_HASH512;
+		nchunk = (size_t)((msglen + QSC_KPA_TREE_CHUNK_SIZE - 1) / QSC_KPA_TREE_CHUNK_SIZE);
+		kpa_tree_node(node, KPA_TREE_ROOT_INDEX);
+		kpa_initialize(&ctx, key, keylen, custom, custlen, node, sizeof(node));
+
+#if defined(_OPENMP)
+		if (threads == 0)
 		{
-			t = _mm256_i64gather_epi64((int64_t*)pos, idx, 1);
-			state[i] = _mm256_xor_si256(state[i], t);
-			pos += sizeof(uint64_t);
+			threads = (size_t)omp_get_max_threads();
+		}
+#else
+		(void)threads;
+#endif
+
+		/* superchunks are authenticated in batches, and the batch leaf codes are absorbed by the root in order */
+		for (base = 0; base < nchunk; base += KPA_TREE_BATCH)
+		{
+			bcnt = (int32_t)qsc_intutils_min(KPA_TREE_BATCH, nchunk - base);
+
+#if defined(_OPENMP)
+#	pragma omp parallel for num_threads((int32_t)qsc_intutils_min(threads, (size_t)bcnt)) schedule(dynamic, 1)
+#endif
+			for (j = 0; j < bcnt; ++j)
+			{
+				const size_t OFT = (size_t)((base + (size_t)j) * QSC_KPA_TREE_CHUNK_SIZE);
+
+				kpa_tree_leaf(leaves + ((size_t)j * hlen), hlen, message + OFT, (size_t)qsc_intutils_min(QSC_KPA_TREE_CHUNK_SIZE, msglen - OFT),
+					key, keylen, custom, custlen, (uint64_t)(base + (size_t)j));
+			}
+
+			qsc_kpa_update(&ctx, leaves, (size_t)bcnt * hlen);
+		}
+
+		qsc_kpa_finalize(&ctx, output, outlen);
+		qsc_memutils_clear(leaves, sizeof(leaves));
+	}
+
+	qsc_kpa_dispose(&ctx);
+}
+
+/* parallel SHA3 x4 */
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static void sha3x4_compute(qsc_keccak_rate rate, uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+{
+	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint64_t lanes[4];
+	size_t i;
+
+	qsc_keccakx4_absorb(state, rate, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHA3_DOMAIN_ID);
+	qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+	/* the digest is always shorter than the rate, only its words are extracted from the state */
+	for (i = 0; i < outlen / sizeof(uint64_t); ++i)
+	{
+		_mm256_storeu_si256((__m256i*)lanes, state[i]);
+		qsc_intutils_le64to8(out0 + (i * sizeof(uint64_t)), lanes[0]);
+		qsc_intutils_le64to8(out1 + (i * sizeof(uint64_t)), lanes[1]);
+		qsc_intutils_le64to8(out2 + (i * sizeof(uint64_t)), lanes[2]);
+		qsc_intutils_le64to8(out3 + (i * sizeof(uint64_t)), lanes[3]);
+	}
+}
+
+#endif
+
+void sha3_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	sha3x4_compute(qsc_keccak_rate_256, out0, out1, out2, out3, QSC_SHA3_256_HASH_SIZE, inp0, inp1, inp2, inp3, inplen);
+
+#else
+
+	qsc_sha3_compute256(out0, inp0, inplen);
+	qsc_sha3_compute256(out1, inp1, inplen);
+	qsc_sha3_compute256(out2, inp2, inplen);
+	qsc_sha3_compute256(out3, inp3, inplen);
+
+#endif
+}
+
+void sha3_512x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	sha3x4_compute(qsc_keccak_rate_512, out0, out1, out2, out3, QSC_SHA3_512_HASH_SIZE, inp0, inp1, inp2, inp3, inplen);
+
+#else
+
+	qsc_sha3_compute512(out0, inp0, inplen);
+	qsc_sha3_compute512(out1, inp1, inplen);
+	qsc_sha3_compute512(out2, inp2, inplen);
+	qsc_sha3_compute512(out3, inp3, inplen);
+
+#endif
+}
+
+/* parallel SHA3 x8 */
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+static void sha3x8_compute(qsc_keccak_rate rate, uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+{
+	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint64_t lanes[8];
+	size_t i;
+
+	qsc_keccakx8_absorb(state, rate, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHA3_DOMAIN_ID);
+	qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+	/* the digest is always shorter than the rate, only its words are extracted from the state */
+	for (i = 0; i < outlen / sizeof(uint64_t); ++i)
+	{
+		_mm512_storeu_si512((void*)lanes, state[i]);
+		qsc_intutils_le64to8(out0 + (i * sizeof(uint64_t)), lanes[0]);
+		qsc_intutils_le64to8(out1 + (i * sizeof(uint64_t)), lanes[1]);
+		qsc_intutils_le64to8(out2 + (i * sizeof(uint64_t)), lanes[2]);
+		qsc_intutils_le64to8(out3 + (i * sizeof(uint64_t)), lanes[3]);
+		qsc_intutils_le64to8(out4 + (i * sizeof(uint64_t)), lanes[4]);
+		qsc_intutils_le64to8(out5 + (i * sizeof(uint64_t)), lanes[5]);
+		qsc_intutils_le64to8(out6 + (i * sizeof(uint64_t)), lanes[6]);
+		qsc_intutils_le64to8(out7 + (i * sizeof(uint64_t)), lanes[7]);
+	}
+}
+
+#endif
+
+void sha3_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(inp4 != NULL);
+	assert(inp5 != NULL);
+	assert(inp6 != NULL);
+	assert(inp7 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	sha3x8_compute(qsc_keccak_rate_256, out0, out1, out2, out3, out4, out5, out6, out7, QSC_SHA3_256_HASH_SIZE,
+		inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen);
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+	sha3_256x4(out0, out1, out2, out3, inp0, inp1, inp2, inp3, inplen);
+	sha3_256x4(out4, out5, out6, out7, inp4, inp5, inp6, inp7, inplen);
+
+#else
+
+	qsc_sha3_compute256(out0, inp0, inplen);
+	qsc_sha3_compute256(out1, inp1, inplen);
+	qsc_sha3_compute256(out2, inp2, inplen);
+	qsc_sha3_compute256(out3, inp3, inplen);
+	qsc_sha3_compute256(out4, inp4, inplen);
+	qsc_sha3_compute256(out5, inp5, inplen);
+	qsc_sha3_compute256(out6, inp6, inplen);
+	qsc_sha3_compute256(out7, inp7, inplen);
+
+#endif
+}
+
+void sha3_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(inp4 != NULL);
+	assert(inp5 != NULL);
+	assert(inp6 != NULL);
+	assert(inp7 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	sha3x8_compute(qsc_keccak_rate_512, out0, out1, out2, out3, out4, out5, out6, out7, QSC_SHA3_512_HASH_SIZE,
+		inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen);
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+	sha3_512x4(out0, out1, out2, out3, inp0, inp1, inp2, inp3, inplen);
+	sha3_512x4(out4, out5, out6, out7, inp4, inp5, inp6, inp7, inplen);
+
+#else
+
+	qsc_sha3_compute512(out0, inp0, inplen);
+	qsc_sha3_compute512(out1, inp1, inplen);
+	qsc_sha3_compute512(out2, inp2, inplen);
+	qsc_sha3_compute512(out3, inp3, inplen);
+	qsc_sha3_compute512(out4, inp4, inplen);
+	qsc_sha3_compute512(out5, inp5, inplen);
+	qsc_sha3_compute512(out6, inp6, inplen);
+	qsc_sha3_compute512(out7, inp7, inplen);
+
+#endif
+}
+
+/* parallel SHAKE x4 */
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+void qsc_keccakx4_absorb(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen, uint8_t domain)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+
+	__m256i t;
+	__m256i idx = { 0 };
+	int64_t p0;
+	int64_t p1;
+	int64_t p2;
+	int64_t p3;
+	size_t pos;
+	size_t i;
+
+	pos = 0;
+	p0 = (int64_t)inp0;
+	p1 = (int64_t)inp1;
+	p2 = (int64_t)inp2;
+	p3 = (int64_t)inp3;
+
+	idx = _mm256_set_epi64x(p3, p2, p1, p0);
+
+	while (inplen >= (size_t)rate)
+	{
+		for (i = 0; i < (size_t)rate / sizeof(uint64_t); ++i)
+		{
+			t = _mm256_i64gather_epi64((int64_t*)pos, idx, 1);
+			state[i] = _mm256_xor_si256(state[i], t);
+			pos += sizeof(uint64_t);
 		}
 
 		qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
@@ -5716,43 +6525,59 @@ static void kmacx4_customize(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_ra
 	const uint8_t* name, size_t nmelen)
 {
 	uint8_t pad[4][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	const uint64_t* kst;
 	size_t oft;
 	size_t i;
 
-	/* stage 1: name + custom */
-
-	oft = keccak_left_encode(pad[0], (size_t)rate);
-	oft += keccak_left_encode((pad[0] + oft), nmelen * 8);
+	kst = keccak_kmac_name_state(rate, name, nmelen, cstlen, QSC_KECCAK_PERMUTATION_ROUNDS);
 
-	for (i = 0; i < nmelen; ++i)
+	if (kst != NULL)
 	{
-		pad[0][oft + i] = name[i];
+		/* stage 1 is a constant for kmac without a customization string */
+		for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+		{
+			state[i] = _mm256_set1_epi64x((int64_t)kst[i]);
+		}
+
+		oft = 0;
 	}
+	else
+	{
+		/* stage 1: name + custom */
 
-	oft += nmelen;
-	oft += keccak_left_encode((pad[0] + oft), cstlen * 8);
-	qsc_memutils_copy(pad[1], pad[0], oft);
-	qsc_memutils_copy(pad[2], pad[0], oft);
-	qsc_memutils_copy(pad[3], pad[0], oft);
+		oft = keccak_left_encode(pad[0], (size_t)rate);
+		oft += keccak_left_encode((pad[0] + oft), nmelen * 8);
 
-	for (i = 0; i < cstlen; ++i)
-	{
-		if (oft == rate)
+		for (i = 0; i < nmelen; ++i)
 		{
-			kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
-			qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-			oft = 0;
+			pad[0][oft + i] = name[i];
 		}
 
-		pad[0][oft] = cst0[i];
-		pad[1][oft] = cst1[i];
-		pad[2][oft] = cst2[i];
-		pad[3][oft] = cst3[i];
-		++oft;
-	}
+		oft += nmelen;
+		oft += keccak_left_encode((pad[0] + oft), cstlen * 8);
+		qsc_memutils_copy(pad[1], pad[0], oft);
+		qsc_memutils_copy(pad[2], pad[0], oft);
+		qsc_memutils_copy(pad[3], pad[0], oft);
 
-	kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], oft + (sizeof(uint64_t) - oft % sizeof(uint64_t)));
-	qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		for (i = 0; i < cstlen; ++i)
+		{
+			if (oft == rate)
+			{
+				kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
+				qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+				oft = 0;
+			}
+
+			pad[0][oft] = cst0[i];
+			pad[1][oft] = cst1[i];
+			pad[2][oft] = cst2[i];
+			pad[3][oft] = cst3[i];
+			++oft;
+		}
+
+		kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], oft + (sizeof(uint64_t) - oft % sizeof(uint64_t)));
+		qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+	}
 
 	/* stage 2: key */
 
@@ -6025,53 +6850,69 @@ static void kmacx8_customize(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_ra
 	const uint8_t* name, size_t nmelen)
 {
 	uint8_t pad[8][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	const uint64_t* kst;
 	size_t oft;
 	size_t i;
 
-	/* stage 1: name + custom */
+	kst = keccak_kmac_name_state(rate, name, nmelen, cstlen, QSC_KECCAK_PERMUTATION_ROUNDS);
 
-	oft = keccak_left_encode(pad[0], rate);
-	oft += keccak_left_encode((pad[0] + oft), nmelen * 8);
-
-	for (i = 0; i < nmelen; ++i)
-	{
-		pad[0][oft + i] = name[i];
-	}
-
-	oft += nmelen;
-	oft += keccak_left_encode((pad[0] + oft), cstlen * 8);
-	qsc_memutils_copy(pad[1], pad[0], oft);
-	qsc_memutils_copy(pad[2], pad[0], oft);
-	qsc_memutils_copy(pad[3], pad[0], oft);
-	qsc_memutils_copy(pad[4], pad[0], oft);
-	qsc_memutils_copy(pad[5], pad[0], oft);
-	qsc_memutils_copy(pad[6], pad[0], oft);
-	qsc_memutils_copy(pad[7], pad[0], oft);
-
-	for (i = 0; i < cstlen; ++i)
+	if (kst != NULL)
 	{
-		if (oft == rate)
+		/* stage 1 is a constant for kmac without a customization string */
+		for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
 		{
-			kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], (size_t)rate);
-			qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-			oft = 0;
+			state[i] = _mm512_set1_epi64((int64_t)kst[i]);
 		}
 
-		pad[0][oft] = cst0[i];
-		pad[1][oft] = cst1[i];
-		pad[2][oft] = cst2[i];
-		pad[3][oft] = cst3[i];
-		pad[4][oft] = cst4[i];
-		pad[5][oft] = cst5[i];
-		pad[6][oft] = cst6[i];
-		pad[7][oft] = cst7[i];
-		++oft;
+		oft = 0;
 	}
+	else
+	{
+		/* stage 1: name + custom */
 
-	kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], oft + (sizeof(uint64_t) - oft % sizeof(uint64_t)));
-	qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		oft = keccak_left_encode(pad[0], rate);
+		oft += keccak_left_encode((pad[0] + oft), nmelen * 8);
 
-	/* stage 2: key */
+		for (i = 0; i < nmelen; ++i)
+		{
+			pad[0][oft + i] = name[i];
+		}
+
+		oft += nmelen;
+		oft += keccak_left_encode((pad[0] + oft), cstlen * 8);
+		qsc_memutils_copy(pad[1], pad[0], oft);
+		qsc_memutils_copy(pad[2], pad[0], oft);
+		qsc_memutils_copy(pad[3], pad[0], oft);
+		qsc_memutils_copy(pad[4], pad[0], oft);
+		qsc_memutils_copy(pad[5], pad[0], oft);
+		qsc_memutils_copy(pad[6], pad[0], oft);
+		qsc_memutils_copy(pad[7], pad[0], oft);
+
+		for (i = 0; i < cstlen; ++i)
+		{
+			if (oft == rate)
+			{
+				kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], (size_t)rate);
+				qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+				oft = 0;
+			}
+
+			pad[0][oft] = cst0[i];
+			pad[1][oft] = cst1[i];
+			pad[2][oft] = cst2[i];
+			pad[3][oft] = cst3[i];
+			pad[4][oft] = cst4[i];
+			pad[5][oft] = cst5[i];
+			pad[6][oft] = cst6[i];
+			pad[7][oft] = cst7[i];
+			++oft;
+		}
+
+		kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], oft + (sizeof(uint64_t) - oft % sizeof(uint64_t)));
+		qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+	}
+
+	/* stage 2: key */
 
 	qsc_memutils_clear(pad[0], oft);
 	qsc_memutils_clear(pad[1], oft);
@@ -6416,3 +7257,2053 @@ void kmac512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
 
 #endif
 }
+
+/* parallel cSHAKE x4 */
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static void cshakex4_customize(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate, const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen)
+{
+	uint8_t pad[4][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	uint8_t enc[sizeof(size_t) + 1] = { 0 };
+	size_t elen;
+	size_t oft;
+	size_t i;
+
+	/* bytepad(encode_string(name) || encode_string(custom), rate), the name is common to every lane */
+
+	oft = keccak_left_encode(pad[0], (size_t)rate);
+	oft += keccak_left_encode((pad[0] + oft), namelen * 8);
+	qsc_memutils_copy(pad[1], pad[0], oft);
+	qsc_memutils_copy(pad[2], pad[0], oft);
+	qsc_memutils_copy(pad[3], pad[0], oft);
+
+	for (i = 0; i < namelen; ++i)
+	{
+		if (oft == rate)
+		{
+			kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
+			qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			oft = 0;
+		}
+
+		pad[0][oft] = name[i];
+		pad[1][oft] = name[i];
+		pad[2][oft] = name[i];
+		pad[3][oft] = name[i];
+		++oft;
+	}
+
+	elen = keccak_left_encode(enc, cstlen * 8);
+
+	for (i = 0; i < elen; ++i)
+	{
+		if (oft == rate)
+		{
+			kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
+			qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			oft = 0;
+		}
+
+		pad[0][oft] = enc[i];
+		pad[1][oft] = enc[i];
+		pad[2][oft] = enc[i];
+		pad[3][oft] = enc[i];
+		++oft;
+	}
+
+	for (i = 0; i < cstlen; ++i)
+	{
+		if (oft == rate)
+		{
+			kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
+			qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			oft = 0;
+		}
+
+		pad[0][oft] = cst0[i];
+		pad[1][oft] = cst1[i];
+		pad[2][oft] = cst2[i];
+		pad[3][oft] = cst3[i];
+		++oft;
+	}
+
+	qsc_memutils_clear((pad[0] + oft), (size_t)rate - oft);
+	qsc_memutils_clear((pad[1] + oft), (size_t)rate - oft);
+	qsc_memutils_clear((pad[2] + oft), (size_t)rate - oft);
+	qsc_memutils_clear((pad[3] + oft), (size_t)rate - oft);
+
+	kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
+	qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+}
+
+static void cshakex4_compute(qsc_keccak_rate rate, uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen)
+{
+	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint8_t tmps[4][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	const size_t BLKCNT = outlen / (size_t)rate;
+	size_t i;
+
+	if (namelen + cstlen != 0)
+	{
+		cshakex4_customize(state, rate, name, namelen, cst0, cst1, cst2, cst3, cstlen);
+		qsc_keccakx4_absorb(state, rate, key0, key1, key2, key3, keylen, QSC_KECCAK_CSHAKE_DOMAIN_ID);
+	}
+	else
+	{
+		qsc_keccakx4_absorb(state, rate, key0, key1, key2, key3, keylen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	}
+
+	if (BLKCNT != 0)
+	{
+		qsc_keccakx4_squeezeblocks(state, rate, out0, out1, out2, out3, BLKCNT);
+
+		out0 += BLKCNT * (size_t)rate;
+		out1 += BLKCNT * (size_t)rate;
+		out2 += BLKCNT * (size_t)rate;
+		out3 += BLKCNT * (size_t)rate;
+		outlen -= BLKCNT * (size_t)rate;
+	}
+
+	if (outlen != 0)
+	{
+		qsc_keccakx4_squeezeblocks(state, rate, tmps[0], tmps[1], tmps[2], tmps[3], 1);
+
+		for (i = 0; i < outlen; ++i)
+		{
+			out0[i] = tmps[0][i];
+			out1[i] = tmps[1][i];
+			out2[i] = tmps[2][i];
+			out3[i] = tmps[3][i];
+		}
+	}
+}
+
+#endif
+
+void cshake128x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen)
+{
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	cshakex4_compute(qsc_keccak_rate_128, out0, out1, out2, out3, outlen, key0, key1, key2, key3, keylen,
+		name, namelen, cst0, cst1, cst2, cst3, cstlen);
+
+#else
+
+	qsc_cshake128_compute(out0, outlen, key0, keylen, name, namelen, cst0, cstlen);
+	qsc_cshake128_compute(out1, outlen, key1, keylen, name, namelen, cst1, cstlen);
+	qsc_cshake128_compute(out2, outlen, key2, keylen, name, namelen, cst2, cstlen);
+	qsc_cshake128_compute(out3, outlen, key3, keylen, name, namelen, cst3, cstlen);
+
+#endif
+}
+
+void cshake256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen)
+{
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	cshakex4_compute(qsc_keccak_rate_256, out0, out1, out2, out3, outlen, key0, key1, key2, key3, keylen,
+		name, namelen, cst0, cst1, cst2, cst3, cstlen);
+
+#else
+
+	qsc_cshake256_compute(out0, outlen, key0, keylen, name, namelen, cst0, cstlen);
+	qsc_cshake256_compute(out1, outlen, key1, keylen, name, namelen, cst1, cstlen);
+	qsc_cshake256_compute(out2, outlen, key2, keylen, name, namelen, cst2, cstlen);
+	qsc_cshake256_compute(out3, outlen, key3, keylen, name, namelen, cst3, cstlen);
+
+#endif
+}
+
+void cshake512x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen)
+{
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	cshakex4_compute(qsc_keccak_rate_512, out0, out1, out2, out3, outlen, key0, key1, key2, key3, keylen,
+		name, namelen, cst0, cst1, cst2, cst3, cstlen);
+
+#else
+
+	qsc_cshake512_compute(out0, outlen, key0, keylen, name, namelen, cst0, cstlen);
+	qsc_cshake512_compute(out1, outlen, key1, keylen, name, namelen, cst1, cstlen);
+	qsc_cshake512_compute(out2, outlen, key2, keylen, name, namelen, cst2, cstlen);
+	qsc_cshake512_compute(out3, outlen, key3, keylen, name, namelen, cst3, cstlen);
+
+#endif
+}
+
+/* parallel cSHAKE x8 */
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+static void cshakex8_customize(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate, const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen)
+{
+	uint8_t pad[8][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	uint8_t enc[sizeof(size_t) + 1] = { 0 };
+	size_t elen;
+	size_t oft;
+	size_t i;
+	size_t j;
+
+	/* bytepad(encode_string(name) || encode_string(custom), rate), the name is common to every lane */
+
+	oft = keccak_left_encode(pad[0], (size_t)rate);
+	oft += keccak_left_encode((pad[0] + oft), namelen * 8);
+
+	for (j = 1; j < 8; ++j)
+	{
+		qsc_memutils_copy(pad[j], pad[0], oft);
+	}
+
+	for (i = 0; i < namelen; ++i)
+	{
+		if (oft == rate)
+		{
+			kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], (size_t)rate);
+			qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			oft = 0;
+		}
+
+		for (j = 0; j < 8; ++j)
+		{
+			pad[j][oft] = name[i];
+		}
+
+		++oft;
+	}
+
+	elen = keccak_left_encode(enc, cstlen * 8);
+
+	for (i = 0; i < elen; ++i)
+	{
+		if (oft == rate)
+		{
+			kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], (size_t)rate);
+			qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			oft = 0;
+		}
+
+		for (j = 0; j < 8; ++j)
+		{
+			pad[j][oft] = enc[i];
+		}
+
+		++oft;
+	}
+
+	for (i = 0; i < cstlen; ++i)
+	{
+		if (oft == rate)
+		{
+			kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], (size_t)rate);
+			qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			oft = 0;
+		}
+
+		pad[0][oft] = cst0[i];
+		pad[1][oft] = cst1[i];
+		pad[2][oft] = cst2[i];
+		pad[3][oft] = cst3[i];
+		pad[4][oft] = cst4[i];
+		pad[5][oft] = cst5[i];
+		pad[6][oft] = cst6[i];
+		pad[7][oft] = cst7[i];
+		++oft;
+	}
+
+	for (j = 0; j < 8; ++j)
+	{
+		qsc_memutils_clear((pad[j] + oft), (size_t)rate - oft);
+	}
+
+	kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], (size_t)rate);
+	qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+}
+
+static void cshakex8_compute(qsc_keccak_rate rate, uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen)
+{
+	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint8_t tmps[8][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	const size_t BLKCNT = outlen / (size_t)rate;
+	size_t i;
+
+	if (namelen + cstlen != 0)
+	{
+		cshakex8_customize(state, rate, name, namelen, cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7, cstlen);
+		qsc_keccakx8_absorb(state, rate, key0, key1, key2, key3, key4, key5, key6, key7, keylen, QSC_KECCAK_CSHAKE_DOMAIN_ID);
+	}
+	else
+	{
+		qsc_keccakx8_absorb(state, rate, key0, key1, key2, key3, key4, key5, key6, key7, keylen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	}
+
+	if (BLKCNT != 0)
+	{
+		qsc_keccakx8_squeezeblocks(state, rate, out0, out1, out2, out3, out4, out5, out6, out7, BLKCNT);
+
+		out0 += BLKCNT * (size_t)rate;
+		out1 += BLKCNT * (size_t)rate;
+		out2 += BLKCNT * (size_t)rate;
+		out3 += BLKCNT * (size_t)rate;
+		out4 += BLKCNT * (size_t)rate;
+		out5 += BLKCNT * (size_t)rate;
+		out6 += BLKCNT * (size_t)rate;
+		out7 += BLKCNT * (size_t)rate;
+		outlen -= BLKCNT * (size_t)rate;
+	}
+
+	if (outlen != 0)
+	{
+		qsc_keccakx8_squeezeblocks(state, rate, tmps[0], tmps[1], tmps[2], tmps[3], tmps[4], tmps[5], tmps[6], tmps[7], 1);
+
+		for (i = 0; i < outlen; ++i)
+		{
+			out0[i] = tmps[0][i];
+			out1[i] = tmps[1][i];
+			out2[i] = tmps[2][i];
+			out3[i] = tmps[3][i];
+			out4[i] = tmps[4][i];
+			out5[i] = tmps[5][i];
+			out6[i] = tmps[6][i];
+			out7[i] = tmps[7][i];
+		}
+	}
+}
+
+#endif
+
+void cshake128x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen)
+{
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(key4 != NULL);
+	assert(key5 != NULL);
+	assert(key6 != NULL);
+	assert(key7 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	cshakex8_compute(qsc_keccak_rate_128, out0, out1, out2, out3, out4, out5, out6, out7, outlen,
+		key0, key1, key2, key3, key4, key5, key6, key7, keylen, name, namelen,
+		cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7, cstlen);
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+	cshake128x4(out0, out1, out2, out3, outlen, key0, key1, key2, key3, keylen,
+		name, namelen, cst0, cst1, cst2, cst3, cstlen);
+	cshake128x4(out4, out5, out6, out7, outlen, key4, key5, key6, key7, keylen,
+		name, namelen, cst4, cst5, cst6, cst7, cstlen);
+
+#else
+
+	qsc_cshake128_compute(out0, outlen, key0, keylen, name, namelen, cst0, cstlen);
+	qsc_cshake128_compute(out1, outlen, key1, keylen, name, namelen, cst1, cstlen);
+	qsc_cshake128_compute(out2, outlen, key2, keylen, name, namelen, cst2, cstlen);
+	qsc_cshake128_compute(out3, outlen, key3, keylen, name, namelen, cst3, cstlen);
+	qsc_cshake128_compute(out4, outlen, key4, keylen, name, namelen, cst4, cstlen);
+	qsc_cshake128_compute(out5, outlen, key5, keylen, name, namelen, cst5, cstlen);
+	qsc_cshake128_compute(out6, outlen, key6, keylen, name, namelen, cst6, cstlen);
+	qsc_cshake128_compute(out7, outlen, key7, keylen, name, namelen, cst7, cstlen);
+
+#endif
+}
+
+void cshake256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen)
+{
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(key4 != NULL);
+	assert(key5 != NULL);
+	assert(key6 != NULL);
+	assert(key7 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	cshakex8_compute(qsc_keccak_rate_256, out0, out1, out2, out3, out4, out5, out6, out7, outlen,
+		key0, key1, key2, key3, key4, key5, key6, key7, keylen, name, namelen,
+		cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7, cstlen);
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+	cshake256x4(out0, out1, out2, out3, outlen, key0, key1, key2, key3, keylen,
+		name, namelen, cst0, cst1, cst2, cst3, cstlen);
+	cshake256x4(out4, out5, out6, out7, outlen, key4, key5, key6, key7, keylen,
+		name, namelen, cst4, cst5, cst6, cst7, cstlen);
+
+#else
+
+	qsc_cshake256_compute(out0, outlen, key0, keylen, name, namelen, cst0, cstlen);
+	qsc_cshake256_compute(out1, outlen, key1, keylen, name, namelen, cst1, cstlen);
+	qsc_cshake256_compute(out2, outlen, key2, keylen, name, namelen, cst2, cstlen);
+	qsc_cshake256_compute(out3, outlen, key3, keylen, name, namelen, cst3, cstlen);
+	qsc_cshake256_compute(out4, outlen, key4, keylen, name, namelen, cst4, cstlen);
+	qsc_cshake256_compute(out5, outlen, key5, keylen, name, namelen, cst5, cstlen);
+	qsc_cshake256_compute(out6, outlen, key6, keylen, name, namelen, cst6, cstlen);
+	qsc_cshake256_compute(out7, outlen, key7, keylen, name, namelen, cst7, cstlen);
+
+#endif
+}
+
+void cshake512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen)
+{
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(key4 != NULL);
+	assert(key5 != NULL);
+	assert(key6 != NULL);
+	assert(key7 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	cshakex8_compute(qsc_keccak_rate_512, out0, out1, out2, out3, out4, out5, out6, out7, outlen,
+		key0, key1, key2, key3, key4, key5, key6, key7, keylen, name, namelen,
+		cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7, cstlen);
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+	cshake512x4(out0, out1, out2, out3, outlen, key0, key1, key2, key3, keylen,
+		name, namelen, cst0, cst1, cst2, cst3, cstlen);
+	cshake512x4(out4, out5, out6, out7, outlen, key4, key5, key6, key7, keylen,
+		name, namelen, cst4, cst5, cst6, cst7, cstlen);
+
+#else
+
+	qsc_cshake512_compute(out0, outlen, key0, keylen, name, namelen, cst0, cstlen);
+	qsc_cshake512_compute(out1, outlen, key1, keylen, name, namelen, cst1, cstlen);
+	qsc_cshake512_compute(out2, outlen, key2, keylen, name, namelen, cst2, cstlen);
+	qsc_cshake512_compute(out3, outlen, key3, keylen, name, namelen, cst3, cstlen);
+	qsc_cshake512_compute(out4, outlen, key4, keylen, name, namelen, cst4, cstlen);
+	qsc_cshake512_compute(out5, outlen, key5, keylen, name, namelen, cst5, cstlen);
+	qsc_cshake512_compute(out6, outlen, key6, keylen, name, namelen, cst6, cstlen);
+	qsc_cshake512_compute(out7, outlen, key7, keylen, name, namelen, cst7, cstlen);
+
+#endif
+}
+
+/* multi-lane jobs */
+
+#define KECCAK_JOB_SEGMENTS 12
+#define KECCAK_JOB_ENCODE_SIZE (2 * (sizeof(size_t) + 1))
+
+typedef struct
+{
+	const uint8_t* segment[KECCAK_JOB_SEGMENTS];	/* a null segment is a run of zeroes */
+	size_t seglen[KECCAK_JOB_SEGMENTS];
+	uint8_t encode[4][KECCAK_JOB_ENCODE_SIZE];
+	const qsc_keccak_job* job;
+	size_t count;
+	size_t index;
+	size_t offset;
+	size_t outpos;
+	uint8_t domain;
+	bool squeeze;
+} keccak_job_lane;
+
+/* the lane segments reference this after the job is loaded */
+static const uint8_t KECCAK_JOB_KMAC_NAME[4] = { 0x4B, 0x4D, 0x41, 0x43 };
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+typedef __m512i keccak_job_word;
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+typedef __m256i keccak_job_word;
+#else
+typedef uint64_t keccak_job_word;
+#endif
+
+static void keccak_jobs_absorb(keccak_job_word state[QSC_KECCAK_STATE_SIZE], const uint64_t wrd[QSC_KECCAK_STATE_SIZE][QSC_KECCAK_JOB_LANES], size_t words)
+{
+	for (size_t i = 0; i < words; ++i)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+		state[i] = _mm512_xor_si512(state[i], _mm512_loadu_si512((const void*)wrd[i]));
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+		state[i] = _mm256_xor_si256(state[i], _mm256_loadu_si256((const __m256i*)wrd[i]));
+#else
+		state[i] ^= wrd[i][0];
+#endif
+	}
+}
+
+static void keccak_jobs_permute(keccak_job_word state[QSC_KECCAK_STATE_SIZE])
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+#else
+	keccak_permute_p1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+#endif
+}
+
+static void keccak_jobs_reset(keccak_job_word state[QSC_KECCAK_STATE_SIZE], size_t lane)
+{
+	/* mask the finished lane out of the interleaved state */
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	const __mmask8 MASK = (__mmask8)~(1U << lane);
+
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		state[i] = _mm512_maskz_mov_epi64(MASK, state[i]);
+	}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	uint64_t msk[QSC_KECCAK_JOB_LANES] = { ~0ULL, ~0ULL, ~0ULL, ~0ULL };
+	__m256i mask;
+
+	msk[lane] = 0;
+	mask = _mm256_loadu_si256((const __m256i*)msk);
+
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		state[i] = _mm256_and_si256(state[i], mask);
+	}
+#else
+	(void)lane;
+	qsc_intutils_clear64(state, QSC_KECCAK_STATE_SIZE);
+#endif
+}
+
+static void keccak_jobs_store(uint64_t wrd[QSC_KECCAK_STATE_SIZE][QSC_KECCAK_JOB_LANES], const keccak_job_word state[QSC_KECCAK_STATE_SIZE], size_t words)
+{
+	for (size_t i = 0; i < words; ++i)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+		_mm512_storeu_si512((void*)wrd[i], state[i]);
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+		_mm256_storeu_si256((__m256i*)wrd[i], state[i]);
+#else
+		wrd[i][0] = state[i];
+#endif
+	}
+}
+
+static void keccak_job_lane_add(keccak_job_lane* lane, const uint8_t* segment, size_t seglen)
+{
+	lane->segment[lane->count] = segment;
+	lane->seglen[lane->count] = seglen;
+	++lane->count;
+}
+
+static void keccak_job_lane_load(keccak_job_lane* lane, const qsc_keccak_job* job, qsc_keccak_rate rate, qsc_keccak_job_mode mode)
+{
+	const uint8_t* name;
+	size_t namelen;
+	size_t oft;
+	size_t tail;
+
+	lane->job = job;
+	lane->count = 0;
+	lane->index = 0;
+	lane->offset = 0;
+	lane->outpos = 0;
+	lane->squeeze = false;
+
+	if (mode == qsc_keccak_job_sha3)
+	{
+		lane->domain = QSC_KECCAK_SHA3_DOMAIN_ID;
+	}
+	else if (mode == qsc_keccak_job_kmac)
+	{
+		lane->domain = QSC_KECCAK_KMAC_DOMAIN_ID;
+	}
+	else if (mode == qsc_keccak_job_cshake && job->namelen + job->custlen != 0)
+	{
+		lane->domain = QSC_KECCAK_CSHAKE_DOMAIN_ID;
+	}
+	else
+	{
+		/* cshake without a name or customization is shake */
+		lane->domain = QSC_KECCAK_SHAKE_DOMAIN_ID;
+	}
+
+	if (lane->domain == QSC_KECCAK_CSHAKE_DOMAIN_ID)
+	{
+		/* bytepad(encode_string(N) || encode_string(S), rate) */
+		name = (mode == qsc_keccak_job_kmac) ? KECCAK_JOB_KMAC_NAME : job->name;
+		namelen = (mode == qsc_keccak_job_kmac) ? sizeof(KECCAK_JOB_KMAC_NAME) : job->namelen;
+
+		oft = keccak_left_encode(lane->encode[0], (size_t)rate);
+		oft += keccak_left_encode(lane->encode[0] + oft, namelen * 8);
+		keccak_job_lane_add(lane, lane->encode[0], oft);
+		keccak_job_lane_add(lane, name, namelen);
+		tail = oft + namelen;
+		oft = keccak_left_encode(lane->encode[1], job->custlen * 8);
+		keccak_job_lane_add(lane, lane->encode[1], oft);
+		keccak_job_lane_add(lane, job->custom, job->custlen);
+		tail += oft + job->custlen;
+		keccak_job_lane_add(lane, NULL, ((size_t)rate - (tail % (size_t)rate)) % (size_t)rate);
+
+		if (mode == qsc_keccak_job_kmac)
+		{
+			/* bytepad(encode_string(K), rate) */
+			oft = keccak_left_encode(lane->encode[2], (size_t)rate);
+			oft += keccak_left_encode(lane->encode[2] + oft, job->keylen * 8);
+			keccak_job_lane_add(lane, lane->encode[2], oft);
+			keccak_job_lane_add(lane, job->key, job->keylen);
+			tail = oft + job->keylen;
+			keccak_job_lane_add(lane, NULL, ((size_t)rate - (tail % (size_t)rate)) % (size_t)rate);
+		}
+	}
+
+	keccak_job_lane_add(lane, job->message, job->msglen);
+
+	if (mode == qsc_keccak_job_kmac)
+	{
+		/* right_encode(L) */
+		oft = keccak_right_encode(lane->encode[3], job->outlen * 8);
+		tail = job->msglen % (size_t)rate;
+
+		if (tail != 0 && tail + oft >= (size_t)rate)
+		{
+			/* match qsc_keccak_finalize: when the encoding does not fit in the last message block,
+			   that block is closed with zeroes, and the final block carries the encoding and domain
+			   followed by the message tail bytes that remain in its padding buffer */
+			keccak_job_lane_add(lane, NULL, (size_t)rate - tail);
+			lane->encode[3][oft] = lane->domain;
+			keccak_job_lane_add(lane, lane->encode[3], oft + 1);
+			keccak_job_lane_add(lane, job->message + (job->msglen - tail) + oft + 1, tail - (oft + 1));
+			lane->domain = 0;
+		}
+		else
+		{
+			keccak_job_lane_add(lane, lane->encode[3], oft);
+		}
+	}
+}
+
+static void keccak_job_lane_fill(keccak_job_lane* lane, uint8_t* block, size_t rate)
+{
+	size_t len;
+	size_t pos;
+
+	pos = 0;
+
+	while (pos < rate && lane->index < lane->count)
+	{
+		len = qsc_intutils_min(lane->seglen[lane->index] - lane->offset, rate - pos);
+
+		if (lane->segment[lane->index] != NULL && len != 0)
+		{
+			qsc_memutils_copy(block + pos, lane->segment[lane->index] + lane->offset, len);
+		}
+
+		pos += len;
+		lane->offset += len;
+
+		if (lane->offset == lane->seglen[lane->index])
+		{
+			++lane->index;
+			lane->offset = 0;
+		}
+	}
+
+	if (pos < rate)
+	{
+		/* the stream is exhausted, pad the lane independently of the others */
+		block[pos] ^= lane->domain;
+		block[rate - 1] ^= 0x80U;
+		lane->squeeze = true;
+	}
+}
+
+void qsc_keccak_jobs_compute(const qsc_keccak_job* jobs, size_t jobcount, qsc_keccak_rate rate, qsc_keccak_job_mode mode)
+{
+	assert(jobs != NULL);
+	assert(rate != qsc_keccak_rate_none);
+
+	keccak_job_word state[QSC_KECCAK_STATE_SIZE];
+	uint64_t wrd[QSC_KECCAK_STATE_SIZE][QSC_KECCAK_JOB_LANES];
+	uint8_t blk[QSC_KECCAK_STATE_BYTE_SIZE];
+	keccak_job_lane lanes[QSC_KECCAK_JOB_LANES];
+	const size_t WRDCNT = (size_t)rate / sizeof(uint64_t);
+	size_t active;
+	size_t i;
+	size_t j;
+	size_t len;
+	size_t next;
+	bool squeeze;
+
+	if (jobs != NULL && rate != qsc_keccak_rate_none)
+	{
+		qsc_memutils_clear((uint8_t*)state, sizeof(state));
+		active = 0;
+		next = 0;
+
+		for (j = 0; j < QSC_KECCAK_JOB_LANES; ++j)
+		{
+			lanes[j].job = NULL;
+
+			if (next < jobcount)
+			{
+				keccak_job_lane_load(&lanes[j], &jobs[next], rate, mode);
+				++active;
+				++next;
+			}
+		}
+
+		while (active != 0)
+		{
+			qsc_memutils_clear((uint8_t*)wrd, sizeof(wrd));
+			squeeze = false;
+
+			/* absorb the next block of every lane that is still absorbing */
+			for (j = 0; j < QSC_KECCAK_JOB_LANES; ++j)
+			{
+				if (lanes[j].job != NULL && lanes[j].squeeze == false)
+				{
+					qsc_memutils_clear(blk, (size_t)rate);
+					keccak_job_lane_fill(&lanes[j], blk, (size_t)rate);
+
+					for (i = 0; i < WRDCNT; ++i)
+					{
+						wrd[i][j] = qsc_intutils_le8to64(blk + (i * sizeof(uint64_t)));
+					}
+				}
+
+				squeeze |= (lanes[j].job != NULL && lanes[j].squeeze == true);
+			}
+
+			keccak_jobs_absorb(state, wrd, WRDCNT);
+			keccak_jobs_permute(state);
+
+			if (squeeze == true)
+			{
+				keccak_jobs_store(wrd, state, WRDCNT);
+
+				/* squeeze the lanes that have finished absorbing, and refill drained lanes */
+				for (j = 0; j < QSC_KECCAK_JOB_LANES; ++j)
+				{
+					if (lanes[j].job != NULL && lanes[j].squeeze == true)
+					{
+						for (i = 0; i < WRDCNT; ++i)
+						{
+							qsc_intutils_le64to8(blk + (i * sizeof(uint64_t)), wrd[i][j]);
+						}
+
+						len = qsc_intutils_min((size_t)rate, lanes[j].job->outlen - lanes[j].outpos);
+						qsc_memutils_copy(lanes[j].job->output + lanes[j].outpos, blk, len);
+						lanes[j].outpos += len;
+
+						if (lanes[j].outpos == lanes[j].job->outlen)
+						{
+							keccak_jobs_reset(state, j);
+
+							if (next < jobcount)
+							{
+								keccak_job_lane_load(&lanes[j], &jobs[next], rate, mode);
+								++next;
+							}
+							else
+							{
+								lanes[j].job = NULL;
+								--active;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		qsc_memutils_clear((uint8_t*)state, sizeof(state));
+		qsc_memutils_clear((uint8_t*)wrd, sizeof(wrd));
+		qsc_memutils_clear(blk, sizeof(blk));
+	}
+}
+
+/* incremental multi-lane Keccak */
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static void keccakx4_absorb_lanes(qsc_keccakx4_state* ctx, uint32_t lanes)
+{
+	uint64_t wrd[4];
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < (size_t)ctx->rate / sizeof(uint64_t); ++i)
+	{
+		for (j = 0; j < 4; ++j)
+		{
+			wrd[j] = ((lanes >> j) & 1U) != 0 ? qsc_intutils_le8to64(ctx->buffer[j] + (i * sizeof(uint64_t))) : 0;
+		}
+
+		ctx->state[i] = _mm256_xor_si256(ctx->state[i], _mm256_loadu_si256((const __m256i*)wrd));
+	}
+}
+
+static void keccakx4_permute_lanes(qsc_keccakx4_state* ctx, uint32_t lanes)
+{
+	__m256i tmps[QSC_KECCAK_STATE_SIZE];
+	uint64_t msk[4];
+	__m256i mask;
+	size_t i;
+
+	if (lanes == 0x0FU)
+	{
+		qsc_keccak_permute_p4x1600(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
+	}
+	else
+	{
+		/* the idle lanes are carried through the permutation and then restored */
+		for (i = 0; i < 4; ++i)
+		{
+			msk[i] = ((lanes >> i) & 1U) != 0 ? ~0ULL : 0;
+		}
+
+		mask = _mm256_loadu_si256((const __m256i*)msk);
+		qsc_memutils_copy(tmps, ctx->state, sizeof(tmps));
+		qsc_keccak_permute_p4x1600(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+		for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+		{
+			ctx->state[i] = _mm256_blendv_epi8(tmps[i], ctx->state[i], mask);
+		}
+	}
+}
+
+void qsc_keccakx4_dispose(qsc_keccakx4_state* ctx)
+{
+	if (ctx != NULL)
+	{
+		qsc_memutils_clear(ctx, sizeof(qsc_keccakx4_state));
+	}
+}
+
+void qsc_keccakx4_initialize(qsc_keccakx4_state* ctx, qsc_keccak_rate rate)
+{
+	assert(ctx != NULL);
+
+	qsc_memutils_clear(ctx, sizeof(qsc_keccakx4_state));
+	ctx->rate = rate;
+}
+
+void qsc_keccakx4_kmac_initialize(qsc_keccakx4_state* ctx, qsc_keccak_rate rate,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen)
+{
+	assert(ctx != NULL);
+
+	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
+
+	qsc_keccakx4_initialize(ctx, rate);
+	kmacx4_customize(ctx->state, rate, key0, key1, key2, key3, keylen, cst0, cst1, cst2, cst3, cstlen, name, sizeof(name));
+}
+
+void qsc_keccakx4_update(qsc_keccakx4_state* ctx, const uint8_t* messages[4], const size_t msglens[4])
+{
+	assert(ctx != NULL);
+	assert(messages != NULL);
+	assert(msglens != NULL);
+
+	const uint8_t* msg[4];
+	size_t rem[4];
+	size_t i;
+	size_t mlen;
+	uint32_t lanes;
+
+	for (i = 0; i < 4; ++i)
+	{
+		msg[i] = messages[i];
+		rem[i] = msglens[i];
+	}
+
+	do
+	{
+		lanes = 0;
+
+		for (i = 0; i < 4; ++i)
+		{
+			if (rem[i] != 0)
+			{
+				mlen = qsc_intutils_min((size_t)ctx->rate - ctx->position[i], rem[i]);
+				qsc_memutils_copy(ctx->buffer[i] + ctx->position[i], msg[i], mlen);
+				ctx->position[i] += mlen;
+				msg[i] += mlen;
+				rem[i] -= mlen;
+
+				if (ctx->position[i] == (size_t)ctx->rate)
+				{
+					ctx->position[i] = 0;
+					lanes |= (1U << i);
+				}
+			}
+		}
+
+		if (lanes != 0)
+		{
+			keccakx4_absorb_lanes(ctx, lanes);
+			keccakx4_permute_lanes(ctx, lanes);
+		}
+	}
+	while (lanes != 0);
+}
+
+void qsc_keccakx4_finalize(qsc_keccakx4_state* ctx, uint8_t domain)
+{
+	assert(ctx != NULL);
+
+	size_t i;
+
+	for (i = 0; i < 4; ++i)
+	{
+		qsc_memutils_clear(ctx->buffer[i] + ctx->position[i], (size_t)ctx->rate - ctx->position[i]);
+		ctx->buffer[i][ctx->position[i]] = domain;
+		ctx->buffer[i][(size_t)ctx->rate - 1] |= 0x80U;
+	}
+
+	keccakx4_absorb_lanes(ctx, 0x0FU);
+
+	/* the squeeze permutes before the first output block */
+	for (i = 0; i < 4; ++i)
+	{
+		ctx->position[i] = (size_t)ctx->rate;
+	}
+}
+
+void qsc_keccakx4_kmac_finalize(qsc_keccakx4_state* ctx, uint8_t* outputs[4], size_t outlen)
+{
+	assert(ctx != NULL);
+	assert(outputs != NULL);
+
+	uint8_t enc[sizeof(size_t) + 1] = { 0 };
+	size_t bitlen;
+	size_t i;
+	uint32_t lanes;
+
+	bitlen = keccak_right_encode(enc, outlen * 8);
+	lanes = 0;
+
+	/* as in qsc_keccak_finalize; a lane that cannot fit the encoding closes its block with zeros */
+	for (i = 0; i < 4; ++i)
+	{
+		qsc_memutils_clear(ctx->buffer[i] + ctx->position[i], (size_t)ctx->rate - ctx->position[i]);
+
+		if (ctx->position[i] + bitlen >= (size_t)ctx->rate)
+		{
+			lanes |= (1U << i);
+		}
+	}
+
+	if (lanes != 0)
+	{
+		keccakx4_absorb_lanes(ctx, lanes);
+		keccakx4_permute_lanes(ctx, lanes);
+	}
+
+	/* the tail of the closed block stays in the buffer, matching the sequential kmac */
+	for (i = 0; i < 4; ++i)
+	{
+		if (((lanes >> i) & 1U) != 0)
+		{
+			ctx->position[i] = 0;
+		}
+
+		qsc_memutils_copy(ctx->buffer[i] + ctx->position[i], enc, bitlen);
+		ctx->buffer[i][ctx->position[i] + bitlen] = QSC_KECCAK_KMAC_DOMAIN_ID;
+		ctx->buffer[i][(size_t)ctx->rate - 1] |= 0x80U;
+		ctx->position[i] = (size_t)ctx->rate;
+	}
+
+	keccakx4_absorb_lanes(ctx, 0x0FU);
+	qsc_keccakx4_squeeze(ctx, outputs, outlen);
+}
+
+void qsc_keccakx4_squeeze(qsc_keccakx4_state* ctx, uint8_t* outputs[4], size_t outlen)
+{
+	assert(ctx != NULL);
+	assert(outputs != NULL);
+
+	uint64_t wrd[4];
+	size_t i;
+	size_t j;
+	size_t mlen;
+	size_t oft;
+
+	oft = 0;
+
+	while (outlen != 0)
+	{
+		/* the lanes squeeze in step, so lane 0 holds the common output position */
+		if (ctx->position[0] == (size_t)ctx->rate)
+		{
+			qsc_keccak_permute_p4x1600(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+			for (i = 0; i < (size_t)ctx->rate / sizeof(uint64_t); ++i)
+			{
+				_mm256_storeu_si256((__m256i*)wrd, ctx->state[i]);
+
+				for (j = 0; j < 4; ++j)
+				{
+					qsc_intutils_le64to8(ctx->buffer[j] + (i * sizeof(uint64_t)), wrd[j]);
+				}
+			}
+
+			for (j = 0; j < 4; ++j)
+			{
+				ctx->position[j] = 0;
+			}
+		}
+
+		mlen = qsc_intutils_min((size_t)ctx->rate - ctx->position[0], outlen);
+
+		for (j = 0; j < 4; ++j)
+		{
+			qsc_memutils_copy(outputs[j] + oft, ctx->buffer[j] + ctx->position[j], mlen);
+			ctx->position[j] += mlen;
+		}
+
+		oft += mlen;
+		outlen -= mlen;
+	}
+}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+static void keccakx8_absorb_lanes(qsc_keccakx8_state* ctx, uint32_t lanes)
+{
+	uint64_t wrd[8];
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < (size_t)ctx->rate / sizeof(uint64_t); ++i)
+	{
+		for (j = 0; j < 8; ++j)
+		{
+			wrd[j] = ((lanes >> j) & 1U) != 0 ? qsc_intutils_le8to64(ctx->buffer[j] + (i * sizeof(uint64_t))) : 0;
+		}
+
+		ctx->state[i] = _mm512_xor_si512(ctx->state[i], _mm512_loadu_si512((const void*)wrd));
+	}
+}
+
+static void keccakx8_permute_lanes(qsc_keccakx8_state* ctx, uint32_t lanes)
+{
+	__m512i tmps[QSC_KECCAK_STATE_SIZE];
+	size_t i;
+
+	if (lanes == 0xFFU)
+	{
+		qsc_keccak_permute_p8x1600(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
+	}
+	else
+	{
+		/* the idle lanes are carried through the permutation and then restored */
+		qsc_memutils_copy(tmps, ctx->state, sizeof(tmps));
+		qsc_keccak_permute_p8x1600(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+		for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+		{
+			ctx->state[i] = _mm512_mask_mov_epi64(tmps[i], (__mmask8)lanes, ctx->state[i]);
+		}
+	}
+}
+
+void qsc_keccakx8_dispose(qsc_keccakx8_state* ctx)
+{
+	if (ctx != NULL)
+	{
+		qsc_memutils_clear(ctx, sizeof(qsc_keccakx8_state));
+	}
+}
+
+void qsc_keccakx8_initialize(qsc_keccakx8_state* ctx, qsc_keccak_rate rate)
+{
+	assert(ctx != NULL);
+
+	qsc_memutils_clear(ctx, sizeof(qsc_keccakx8_state));
+	ctx->rate = rate;
+}
+
+void qsc_keccakx8_kmac_initialize(qsc_keccakx8_state* ctx, qsc_keccak_rate rate,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen)
+{
+	assert(ctx != NULL);
+
+	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
+
+	qsc_keccakx8_initialize(ctx, rate);
+	kmacx8_customize(ctx->state, rate, key0, key1, key2, key3, key4, key5, key6, key7, keylen,
+		cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7, cstlen, name, sizeof(name));
+}
+
+void qsc_keccakx8_update(qsc_keccakx8_state* ctx, const uint8_t* messages[8], const size_t msglens[8])
+{
+	assert(ctx != NULL);
+	assert(messages != NULL);
+	assert(msglens != NULL);
+
+	const uint8_t* msg[8];
+	size_t rem[8];
+	size_t i;
+	size_t mlen;
+	uint32_t lanes;
+
+	for (i = 0; i < 8; ++i)
+	{
+		msg[i] = messages[i];
+		rem[i] = msglens[i];
+	}
+
+	do
+	{
+		lanes = 0;
+
+		for (i = 0; i < 8; ++i)
+		{
+			if (rem[i] != 0)
+			{
+				mlen = qsc_intutils_min((size_t)ctx->rate - ctx->position[i], rem[i]);
+				qsc_memutils_copy(ctx->buffer[i] + ctx->position[i], msg[i], mlen);
+				ctx->position[i] += mlen;
+				msg[i] += mlen;
+				rem[i] -= mlen;
+
+				if (ctx->position[i] == (size_t)ctx->rate)
+				{
+					ctx->position[i] = 0;
+					lanes |= (1U << i);
+				}
+			}
+		}
+
+		if (lanes != 0)
+		{
+			keccakx8_absorb_lanes(ctx, lanes);
+			keccakx8_permute_lanes(ctx, lanes);
+		}
+	}
+	while (lanes != 0);
+}
+
+void qsc_keccakx8_finalize(qsc_keccakx8_state* ctx, uint8_t domain)
+{
+	assert(ctx != NULL);
+
+	size_t i;
+
+	for (i = 0; i < 8; ++i)
+	{
+		qsc_memutils_clear(ctx->buffer[i] + ctx->position[i], (size_t)ctx->rate - ctx->position[i]);
+		ctx->buffer[i][ctx->position[i]] = domain;
+		ctx->buffer[i][(size_t)ctx->rate - 1] |= 0x80U;
+	}
+
+	keccakx8_absorb_lanes(ctx, 0xFFU);
+
+	/* the squeeze permutes before the first output block */
+	for (i = 0; i < 8; ++i)
+	{
+		ctx->position[i] = (size_t)ctx->rate;
+	}
+}
+
+void qsc_keccakx8_kmac_finalize(qsc_keccakx8_state* ctx, uint8_t* outputs[8], size_t outlen)
+{
+	assert(ctx != NULL);
+	assert(outputs != NULL);
+
+	uint8_t enc[sizeof(size_t) + 1] = { 0 };
+	size_t bitlen;
+	size_t i;
+	uint32_t lanes;
+
+	bitlen = keccak_right_encode(enc, outlen * 8);
+	lanes = 0;
+
+	/* as in qsc_keccak_finalize; a lane that cannot fit the encoding closes its block with zeros */
+	for (i = 0; i < 8; ++i)
+	{
+		qsc_memutils_clear(ctx->buffer[i] + ctx->position[i], (size_t)ctx->rate - ctx->position[i]);
+
+		if (ctx->position[i] + bitlen >= (size_t)ctx->rate)
+		{
+			lanes |= (1U << i);
+		}
+	}
+
+	if (lanes != 0)
+	{
+		keccakx8_absorb_lanes(ctx, lanes);
+		keccakx8_permute_lanes(ctx, lanes);
+	}
+
+	/* the tail of the closed block stays in the buffer, matching the sequential kmac */
+	for (i = 0; i < 8; ++i)
+	{
+		if (((lanes >> i) & 1U) != 0)
+		{
+			ctx->position[i] = 0;
+		}
+
+		qsc_memutils_copy(ctx->buffer[i] + ctx->position[i], enc, bitlen);
+		ctx->buffer[i][ctx->position[i] + bitlen] = QSC_KECCAK_KMAC_DOMAIN_ID;
+		ctx->buffer[i][(size_t)ctx->rate - 1] |= 0x80U;
+		ctx->position[i] = (size_t)ctx->rate;
+	}
+
+	keccakx8_absorb_lanes(ctx, 0xFFU);
+	qsc_keccakx8_squeeze(ctx, outputs, outlen);
+}
+
+void qsc_keccakx8_squeeze(qsc_keccakx8_state* ctx, uint8_t* outputs[8], size_t outlen)
+{
+	assert(ctx != NULL);
+	assert(outputs != NULL);
+
+	uint64_t wrd[8];
+	size_t i;
+	size_t j;
+	size_t mlen;
+	size_t oft;
+
+	oft = 0;
+
+	while (outlen != 0)
+	{
+		/* the lanes squeeze in step, so lane 0 holds the common output position */
+		if (ctx->position[0] == (size_t)ctx->rate)
+		{
+			qsc_keccak_permute_p8x1600(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+			for (i = 0; i < (size_t)ctx->rate / sizeof(uint64_t); ++i)
+			{
+				_mm512_storeu_si512((void*)wrd, ctx->state[i]);
+
+				for (j = 0; j < 8; ++j)
+				{
+					qsc_intutils_le64to8(ctx->buffer[j] + (i * sizeof(uint64_t)), wrd[j]);
+				}
+			}
+
+			for (j = 0; j < 8; ++j)
+			{
+				ctx->position[j] = 0;
+			}
+		}
+
+		mlen = qsc_intutils_min((size_t)ctx->rate - ctx->position[0], outlen);
+
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_memutils_copy(outputs[j] + oft, ctx->buffer[j] + ctx->position[j], mlen);
+			ctx->position[j] += mlen;
+		}
+
+		oft += mlen;
+		outlen -= mlen;
+	}
+}
+
+#endif
+
+/* TurboSHAKE */
+
+/* Keccak-p[1600, 12] applies the last 12 rounds of Keccak-f[1600] */
+#define TURBOSHAKE_ROUND_CONSTANTS (KECCAK_ROUND_CONSTANTS + (QSC_KECCAK_PERMUTATION_ROUNDS - QSC_TURBOSHAKE_ROUNDS))
+
+static void turboshake_update(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_t* message, size_t msglen)
+{
+	size_t mlen;
+
+	while (msglen != 0)
+	{
+		if (ctx->position == 0 && msglen >= (size_t)rate)
+		{
+			keccak_fast_absorb(ctx->state, message, (size_t)rate);
+			keccak_permute_rc_p1600(ctx->state, TURBOSHAKE_ROUND_CONSTANTS, QSC_TURBOSHAKE_ROUNDS);
+			mlen = (size_t)rate;
+		}
+		else
+		{
+			mlen = qsc_intutils_min((size_t)rate - ctx->position, msglen);
+			qsc_memutils_copy(ctx->buffer + ctx->position, message, mlen);
+			ctx->position += mlen;
+
+			if (ctx->position == (size_t)rate)
+			{
+				keccak_fast_absorb(ctx->state, ctx->buffer, (size_t)rate);
+				keccak_permute_rc_p1600(ctx->state, TURBOSHAKE_ROUND_CONSTANTS, QSC_TURBOSHAKE_ROUNDS);
+				ctx->position = 0;
+			}
+		}
+
+		message += mlen;
+		msglen -= mlen;
+	}
+}
+
+static void turboshake_finalize(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_t* output, size_t outlen, uint8_t domain)
+{
+	uint8_t pad[QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	size_t mlen;
+
+	qsc_memutils_copy(pad, ctx->buffer, ctx->position);
+	pad[ctx->position] = domain;
+	pad[(size_t)rate - 1] |= 0x80U;
+	keccak_fast_absorb(ctx->state, pad, (size_t)rate);
+
+	while (outlen != 0)
+	{
+		keccak_permute_rc_p1600(ctx->state, TURBOSHAKE_ROUND_CONSTANTS, QSC_TURBOSHAKE_ROUNDS);
+		mlen = qsc_intutils_min((size_t)rate, outlen);
+		keccak_extract_bytes(ctx->state, 0, output, mlen);
+		output += mlen;
+		outlen -= mlen;
+	}
+
+	qsc_keccak_dispose(ctx);
+}
+
+void qsc_turboshake128_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, uint8_t domain)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+	assert(domain != 0 && domain < 0x80U);
+
+	qsc_keccak_state ctx;
+
+	qsc_keccak_initialize_state(&ctx);
+	turboshake_update(&ctx, qsc_keccak_rate_128, message, msglen);
+	turboshake_finalize(&ctx, qsc_keccak_rate_128, output, outlen, domain);
+}
+
+void qsc_turboshake256_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, uint8_t domain)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+	assert(domain != 0 && domain < 0x80U);
+
+	qsc_keccak_state ctx;
+
+	qsc_keccak_initialize_state(&ctx);
+	turboshake_update(&ctx, qsc_keccak_rate_256, message, msglen);
+	turboshake_finalize(&ctx, qsc_keccak_rate_256, output, outlen, domain);
+}
+
+/* KangarooTwelve */
+
+#define KT_SINGLE_DOMAIN_ID 0x07
+#define KT_LEAF_DOMAIN_ID 0x0B
+#define KT_FINAL_DOMAIN_ID 0x06
+#define KT_CV_MAX_SIZE 64
+
+static const uint8_t KT_FINAL_NODE_MARKER[8] = { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+static const uint8_t KT_FINAL_NODE_SUFFIX[2] = { 0xFF, 0xFF };
+
+typedef struct
+{
+	const uint8_t* segment[3];
+	size_t seglen[3];
+	uint8_t encode[sizeof(size_t) + 1];
+} kt_input;
+
+static size_t kt_length_encode(uint8_t* buffer, size_t value)
+{
+	size_t len;
+
+	/* as right_encode, except that zero is encoded as the single count byte */
+	if (value == 0)
+	{
+		buffer[0] = 0;
+		len = 1;
+	}
+	else
+	{
+		len = keccak_right_encode(buffer, value);
+	}
+
+	return len;
+}
+
+static void kt_update_range(qsc_keccak_state* ctx, qsc_keccak_rate rate, const kt_input* inp, size_t offset, size_t length)
+{
+	/* absorb the range [offset, offset + length) of S = M || C || length_encode(|C|) */
+	size_t i;
+	size_t mlen;
+
+	for (i = 0; i < 3 && length != 0; ++i)
+	{
+		if (offset >= inp->seglen[i])
+		{
+			offset -= inp->seglen[i];
+		}
+		else
+		{
+			mlen = qsc_intutils_min(inp->seglen[i] - offset, length);
+			turboshake_update(ctx, rate, inp->segment[i] + offset, mlen);
+			length -= mlen;
+			offset = 0;
+		}
+	}
+}
+
+static void kt_leaf_compute(uint8_t* cv, size_t cvlen, qsc_keccak_rate rate, const kt_input* inp, size_t offset, size_t length)
+{
+	qsc_keccak_state ctx;
+
+	qsc_keccak_initialize_state(&ctx);
+	kt_update_range(&ctx, rate, inp, offset, length);
+	turboshake_finalize(&ctx, rate, cv, cvlen, KT_LEAF_DOMAIN_ID);
+}
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+static void kt_leafx4_compute(uint8_t* cvs, size_t cvlen, qsc_keccak_rate rate, const uint8_t* chunks)
+{
+	/* four consecutive full chunks, one per lane */
+	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint64_t wrd[4];
+	size_t pos;
+	size_t i;
+	size_t j;
+
+	for (pos = 0; pos + (size_t)rate <= QSC_KT_CHUNK_SIZE; pos += (size_t)rate)
+	{
+		kmacx4_fast_absorb(state, chunks + pos, chunks + QSC_KT_CHUNK_SIZE + pos,
+			chunks + (2 * QSC_KT_CHUNK_SIZE) + pos, chunks + (3 * QSC_KT_CHUNK_SIZE) + pos, (size_t)rate);
+		keccak_permute_p4x1600_rc(state, TURBOSHAKE_ROUND_CONSTANTS, QSC_TURBOSHAKE_ROUNDS);
+	}
+
+	/* the chunk size is a multiple of 8, so the domain starts the next state word */
+	kmacx4_fast_absorb(state, chunks + pos, chunks + QSC_KT_CHUNK_SIZE + pos,
+		chunks + (2 * QSC_KT_CHUNK_SIZE) + pos, chunks + (3 * QSC_KT_CHUNK_SIZE) + pos, QSC_KT_CHUNK_SIZE - pos);
+	i = (QSC_KT_CHUNK_SIZE - pos) / sizeof(uint64_t);
+	state[i] = _mm256_xor_si256(state[i], _mm256_set1_epi64x(KT_LEAF_DOMAIN_ID));
+	i = ((size_t)rate / sizeof(uint64_t)) - 1;
+	state[i] = _mm256_xor_si256(state[i], _mm256_set1_epi64x((int64_t)(1ULL << 63)));
+	keccak_permute_p4x1600_rc(state, TURBOSHAKE_ROUND_CONSTANTS, QSC_TURBOSHAKE_ROUNDS);
+
+	for (i = 0; i < cvlen / sizeof(uint64_t); ++i)
+	{
+		_mm256_storeu_si256((__m256i*)wrd, state[i]);
+
+		for (j = 0; j < 4; ++j)
+		{
+			qsc_intutils_le64to8(cvs + (j * cvlen) + (i * sizeof(uint64_t)), wrd[j]);
+		}
+	}
+}
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static void kt_leafx8_compute(uint8_t* cvs, size_t cvlen, qsc_keccak_rate rate, const uint8_t* chunks)
+{
+	/* eight consecutive full chunks, one per lane */
+	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint64_t wrd[8];
+	size_t pos;
+	size_t i;
+	size_t j;
+
+	for (pos = 0; pos + (size_t)rate <= QSC_KT_CHUNK_SIZE; pos += (size_t)rate)
+	{
+		kmacx8_fast_absorb(state, chunks + pos, chunks + QSC_KT_CHUNK_SIZE + pos,
+			chunks + (2 * QSC_KT_CHUNK_SIZE) + pos, chunks + (3 * QSC_KT_CHUNK_SIZE) + pos,
+			chunks + (4 * QSC_KT_CHUNK_SIZE) + pos, chunks + (5 * QSC_KT_CHUNK_SIZE) + pos,
+			chunks + (6 * QSC_KT_CHUNK_SIZE) + pos, chunks + (7 * QSC_KT_CHUNK_SIZE) + pos, (size_t)rate);
+		keccak_permute_p8x1600_rc(state, TURBOSHAKE_ROUND_CONSTANTS, QSC_TURBOSHAKE_ROUNDS);
+	}
+
+	kmacx8_fast_absorb(state, chunks + pos, chunks + QSC_KT_CHUNK_SIZE + pos,
+		chunks + (2 * QSC_KT_CHUNK_SIZE) + pos, chunks + (3 * QSC_KT_CHUNK_SIZE) + pos,
+		chunks + (4 * QSC_KT_CHUNK_SIZE) + pos, chunks + (5 * QSC_KT_CHUNK_SIZE) + pos,
+		chunks + (6 * QSC_KT_CHUNK_SIZE) + pos, chunks + (7 * QSC_KT_CHUNK_SIZE) + pos, QSC_KT_CHUNK_SIZE - pos);
+	i = (QSC_KT_CHUNK_SIZE - pos) / sizeof(uint64_t);
+	state[i] = _mm512_xor_si512(state[i], _mm512_set1_epi64(KT_LEAF_DOMAIN_ID));
+	i = ((size_t)rate / sizeof(uint64_t)) - 1;
+	state[i] = _mm512_xor_si512(state[i], _mm512_set1_epi64((int64_t)(1ULL << 63)));
+	keccak_permute_p8x1600_rc(state, TURBOSHAKE_ROUND_CONSTANTS, QSC_TURBOSHAKE_ROUNDS);
+
+	for (i = 0; i < cvlen / sizeof(uint64_t); ++i)
+	{
+		_mm512_storeu_si512((void*)wrd, state[i]);
+
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_intutils_le64to8(cvs + (j * cvlen) + (i * sizeof(uint64_t)), wrd[j]);
+		}
+	}
+}
+#endif
+
+static void kt_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen, qsc_keccak_rate rate, size_t cvlen)
+{
+	uint8_t cvs[8 * KT_CV_MAX_SIZE];
+	uint8_t enc[sizeof(size_t) + 1];
+	qsc_keccak_state ctx;
+	kt_input inp;
+	size_t i;
+	size_t nleaf;
+	size_t slen;
+
+	inp.segment[0] = message;
+	inp.seglen[0] = msglen;
+	inp.segment[1] = custom;
+	inp.seglen[1] = custlen;
+	inp.segment[2] = inp.encode;
+	inp.seglen[2] = kt_length_encode(inp.encode, custlen);
+	slen = msglen + custlen + inp.seglen[2];
+
+	qsc_keccak_initialize_state(&ctx);
+
+	if (slen <= QSC_KT_CHUNK_SIZE)
+	{
+		kt_update_range(&ctx, rate, &inp, 0, slen);
+		turboshake_finalize(&ctx, rate, output, outlen, KT_SINGLE_DOMAIN_ID);
+	}
+	else
+	{
+		/* final node: S_0 || 0x03 0x00^7 || CV_1 .. CV_n || length_encode(n) || 0xFF 0xFF */
+		kt_update_range(&ctx, rate, &inp, 0, QSC_KT_CHUNK_SIZE);
+		turboshake_update(&ctx, rate, KT_FINAL_NODE_MARKER, sizeof(KT_FINAL_NODE_MARKER));
+		nleaf = (slen - 1) / QSC_KT_CHUNK_SIZE;
+		i = 0;
+
+		/* leaves wholly inside the message are hashed across the lanes */
+#if defined(QSC_SYSTEM_HAS_AVX512)
+		while (nleaf - i >= 8 && (i + 9) * QSC_KT_CHUNK_SIZE <= msglen)
+		{
+			kt_leafx8_compute(cvs, cvlen, rate, message + ((i + 1) * QSC_KT_CHUNK_SIZE));
+			turboshake_update(&ctx, rate, cvs, 8 * cvlen);
+			i += 8;
+		}
+#endif
+#if defined(QSC_SYSTEM_HAS_AVX2)
+		while (nleaf - i >= 4 && (i + 5) * QSC_KT_CHUNK_SIZE <= msglen)
+		{
+			kt_leafx4_compute(cvs, cvlen, rate, message + ((i + 1) * QSC_KT_CHUNK_SIZE));
+			turboshake_update(&ctx, rate, cvs, 4 * cvlen);
+			i += 4;
+		}
+#endif
+
+		/* the remaining leaves, including any that reach into the customization string */
+		while (i < nleaf)
+		{
+			kt_leaf_compute(cvs, cvlen, rate, &inp, (i + 1) * QSC_KT_CHUNK_SIZE,
+				qsc_intutils_min(QSC_KT_CHUNK_SIZE, slen - ((i + 1) * QSC_KT_CHUNK_SIZE)));
+			turboshake_update(&ctx, rate, cvs, cvlen);
+			++i;
+		}
+
+		turboshake_update(&ctx, rate, enc, kt_length_encode(enc, nleaf));
+		turboshake_update(&ctx, rate, KT_FINAL_NODE_SUFFIX, sizeof(KT_FINAL_NODE_SUFFIX));
+		turboshake_finalize(&ctx, rate, output, outlen, KT_FINAL_DOMAIN_ID);
+	}
+}
+
+void qsc_kt128_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+	assert(custom != NULL || custlen == 0);
+
+	kt_compute(output, outlen, message, msglen, custom, custlen, qsc_keccak_rate_128, 32);
+}
+
+void qsc_kt256_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+	assert(custom != NULL || custlen == 0);
+
+	kt_compute(output, outlen, message, msglen, custom, custlen, qsc_keccak_rate_256, 64);
+}
+
+/* Merkle tree */
+
+static void merkle_hash_leaves(uint8_t* output, const uint8_t* data, size_t datalen, size_t count)
+{
+	/* hash consecutive chunks into consecutive leaf hashes, full chunks across the SIMD lanes */
+	size_t i;
+
+	i = 0;
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	while ((i + 8) * QSC_MERKLE_CHUNK_SIZE <= datalen)
+	{
+		const uint8_t* pd = data + (i * QSC_MERKLE_CHUNK_SIZE);
+		uint8_t* po = output + (i * QSC_MERKLE_HASH_SIZE);
+
+		sha3_256x8(po, po + QSC_MERKLE_HASH_SIZE, po + (2 * QSC_MERKLE_HASH_SIZE), po + (3 * QSC_MERKLE_HASH_SIZE),
+			po + (4 * QSC_MERKLE_HASH_SIZE), po + (5 * QSC_MERKLE_HASH_SIZE), po + (6 * QSC_MERKLE_HASH_SIZE), po + (7 * QSC_MERKLE_HASH_SIZE),
+			pd, pd + QSC_MERKLE_CHUNK_SIZE, pd + (2 * QSC_MERKLE_CHUNK_SIZE), pd + (3 * QSC_MERKLE_CHUNK_SIZE),
+			pd + (4 * QSC_MERKLE_CHUNK_SIZE), pd + (5 * QSC_MERKLE_CHUNK_SIZE), pd + (6 * QSC_MERKLE_CHUNK_SIZE), pd + (7 * QSC_MERKLE_CHUNK_SIZE),
+			QSC_MERKLE_CHUNK_SIZE);
+		i += 8;
+	}
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	while ((i + 4) * QSC_MERKLE_CHUNK_SIZE <= datalen)
+	{
+		const uint8_t* pd = data + (i * QSC_MERKLE_CHUNK_SIZE);
+		uint8_t* po = output + (i * QSC_MERKLE_HASH_SIZE);
+
+		sha3_256x4(po, po + QSC_MERKLE_HASH_SIZE, po + (2 * QSC_MERKLE_HASH_SIZE), po + (3 * QSC_MERKLE_HASH_SIZE),
+			pd, pd + QSC_MERKLE_CHUNK_SIZE, pd + (2 * QSC_MERKLE_CHUNK_SIZE), pd + (3 * QSC_MERKLE_CHUNK_SIZE),
+			QSC_MERKLE_CHUNK_SIZE);
+		i += 4;
+	}
+#endif
+
+	while (i < count)
+	{
+		qsc_sha3_compute256(output + (i * QSC_MERKLE_HASH_SIZE), data + (i * QSC_MERKLE_CHUNK_SIZE),
+			qsc_intutils_min(QSC_MERKLE_CHUNK_SIZE, datalen - (i * QSC_MERKLE_CHUNK_SIZE)));
+		++i;
+	}
+}
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+static void merkle_nodex4(uint8_t* output, const uint8_t* input)
+{
+	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint64_t lanes[4];
+	size_t i;
+
+	qsc_keccakx4_absorb(state, qsc_keccak_rate_256, input, input + (2 * QSC_MERKLE_HASH_SIZE), input + (4 * QSC_MERKLE_HASH_SIZE),
+		input + (6 * QSC_MERKLE_HASH_SIZE), 2 * QSC_MERKLE_HASH_SIZE, QSC_MERKLE_NODE_DOMAIN_ID);
+	qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+	for (i = 0; i < QSC_MERKLE_HASH_SIZE / sizeof(uint64_t); ++i)
+	{
+		_mm256_storeu_si256((__m256i*)lanes, state[i]);
+
+		for (size_t j = 0; j < 4; ++j)
+		{
+			qsc_intutils_le64to8(output + (j * QSC_MERKLE_HASH_SIZE) + (i * sizeof(uint64_t)), lanes[j]);
+		}
+	}
+}
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static void merkle_nodex8(uint8_t* output, const uint8_t* input)
+{
+	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint64_t lanes[8];
+	size_t i;
+
+	qsc_keccakx8_absorb(state, qsc_keccak_rate_256, input, input + (2 * QSC_MERKLE_HASH_SIZE), input + (4 * QSC_MERKLE_HASH_SIZE),
+		input + (6 * QSC_MERKLE_HASH_SIZE), input + (8 * QSC_MERKLE_HASH_SIZE), input + (10 * QSC_MERKLE_HASH_SIZE),
+		input + (12 * QSC_MERKLE_HASH_SIZE), input + (14 * QSC_MERKLE_HASH_SIZE), 2 * QSC_MERKLE_HASH_SIZE, QSC_MERKLE_NODE_DOMAIN_ID);
+	qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+	for (i = 0; i < QSC_MERKLE_HASH_SIZE / sizeof(uint64_t); ++i)
+	{
+		_mm512_storeu_si512((void*)lanes, state[i]);
+
+		for (size_t j = 0; j < 8; ++j)
+		{
+			qsc_intutils_le64to8(output + (j * QSC_MERKLE_HASH_SIZE) + (i * sizeof(uint64_t)), lanes[j]);
+		}
+	}
+}
+#endif
+
+static void merkle_hash_nodes(uint8_t* output, const uint8_t* input, size_t count)
+{
+	/* hash count adjacent pairs of child hashes into count parent hashes;
+	   each batch reads its inputs before writing, so the output may overlap the input from below */
+	size_t i;
+
+	i = 0;
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	while (i + 8 <= count)
+	{
+		merkle_nodex8(output + (i * QSC_MERKLE_HASH_SIZE), input + (2 * i * QSC_MERKLE_HASH_SIZE));
+		i += 8;
+	}
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	while (i + 4 <= count)
+	{
+		merkle_nodex4(output + (i * QSC_MERKLE_HASH_SIZE), input + (2 * i * QSC_MERKLE_HASH_SIZE));
+		i += 4;
+	}
+#endif
+
+	while (i < count)
+	{
+		keccak_compute_short(output + (i * QSC_MERKLE_HASH_SIZE), QSC_MERKLE_HASH_SIZE, input + (2 * i * QSC_MERKLE_HASH_SIZE),
+			2 * QSC_MERKLE_HASH_SIZE, qsc_keccak_rate_256, QSC_MERKLE_NODE_DOMAIN_ID);
+		++i;
+	}
+}
+
+static size_t merkle_proof_walk(uint8_t* proof, const uint8_t* tree, size_t leaves, size_t first, size_t count)
+{
+	/* the left sibling of an odd range start and the right sibling of an even range end, per level */
+	size_t hi;
+	size_t lo;
+	size_t n;
+	size_t plen;
+
+	lo = first;
+	hi = first + count - 1;
+	n = leaves;
+	plen = 0;
+
+	while (n > 1)
+	{
+		if ((lo & 1) != 0)
+		{
+			if (proof != NULL)
+			{
+				qsc_memutils_copy(proof + plen, tree + ((lo - 1) * QSC_MERKLE_HASH_SIZE), QSC_MERKLE_HASH_SIZE);
+			}
+
+			plen += QSC_MERKLE_HASH_SIZE;
+		}
+
+		if ((hi & 1) == 0 && hi + 1 < n)
+		{
+			if (proof != NULL)
+			{
+				qsc_memutils_copy(proof + plen, tree + ((hi + 1) * QSC_MERKLE_HASH_SIZE), QSC_MERKLE_HASH_SIZE);
+			}
+
+			plen += QSC_MERKLE_HASH_SIZE;
+		}
+
+		if (tree != NULL)
+		{
+			tree += n * QSC_MERKLE_HASH_SIZE;
+		}
+
+		lo >>= 1;
+		hi >>= 1;
+		n = (n + 1) / 2;
+	}
+
+	return plen;
+}
+
+size_t qsc_merkle_leaf_count(size_t msglen)
+{
+	size_t n;
+
+	n = (msglen + QSC_MERKLE_CHUNK_SIZE - 1) / QSC_MERKLE_CHUNK_SIZE;
+
+	return (n != 0) ? n : 1;
+}
+
+size_t qsc_merkle_tree_size(size_t msglen)
+{
+	size_t n;
+	size_t tlen;
+
+	n = qsc_merkle_leaf_count(msglen);
+	tlen = n;
+
+	while (n > 1)
+	{
+		n = (n + 1) / 2;
+		tlen += n;
+	}
+
+	return tlen * QSC_MERKLE_HASH_SIZE;
+}
+
+void qsc_merkle_tree_compute(uint8_t* tree, const uint8_t* message, size_t msglen)
+{
+	assert(tree != NULL);
+	assert(message != NULL);
+
+	size_t n;
+
+	n = qsc_merkle_leaf_count(msglen);
+	merkle_hash_leaves(tree, message, msglen, n);
+
+	/* each level is written directly after the one below it */
+	while (n > 1)
+	{
+		merkle_hash_nodes(tree + (n * QSC_MERKLE_HASH_SIZE), tree, n / 2);
+
+		if ((n & 1) != 0)
+		{
+			qsc_memutils_copy(tree + ((n + (n / 2)) * QSC_MERKLE_HASH_SIZE), tree + ((n - 1) * QSC_MERKLE_HASH_SIZE), QSC_MERKLE_HASH_SIZE);
+		}
+
+		tree += n * QSC_MERKLE_HASH_SIZE;
+		n = (n + 1) / 2;
+	}
+}
+
+bool qsc_merkle_root_compute(uint8_t* root, const uint8_t* message, size_t msglen)
+{
+	assert(root != NULL);
+	assert(message != NULL);
+
+	uint8_t* nodes;
+	size_t n;
+	bool res;
+
+	res = false;
+	n = qsc_merkle_leaf_count(msglen);
+	nodes = (uint8_t*)qsc_memutils_malloc(n * QSC_MERKLE_HASH_SIZE);
+
+	if (nodes != NULL)
+	{
+		merkle_hash_leaves(nodes, message, msglen, n);
+
+		/* the levels are reduced in place */
+		while (n > 1)
+		{
+			merkle_hash_nodes(nodes, nodes, n / 2);
+
+			if ((n & 1) != 0)
+			{
+				qsc_memutils_copy(nodes + ((n / 2) * QSC_MERKLE_HASH_SIZE), nodes + ((n - 1) * QSC_MERKLE_HASH_SIZE), QSC_MERKLE_HASH_SIZE);
+			}
+
+			n = (n + 1) / 2;
+		}
+
+		qsc_memutils_copy(root, nodes, QSC_MERKLE_HASH_SIZE);
+		qsc_memutils_alloc_free(nodes);
+		res = true;
+	}
+
+	return res;
+}
+
+size_t qsc_merkle_proof_size(size_t msglen, size_t first, size_t count)
+{
+	size_t leaves;
+	size_t plen;
+
+	leaves = qsc_merkle_leaf_count(msglen);
+	plen = 0;
+
+	if (first < leaves && count != 0 && count <= leaves - first)
+	{
+		plen = merkle_proof_walk(NULL, NULL, leaves, first, count);
+	}
+
+	return plen;
+}
+
+size_t qsc_merkle_proof_generate(uint8_t* proof, size_t prooflen, const uint8_t* tree, size_t msglen, size_t first, size_t count)
+{
+	assert(tree != NULL);
+
+	size_t leaves;
+	size_t plen;
+
+	leaves = qsc_merkle_leaf_count(msglen);
+	plen = 0;
+
+	if (first < leaves && count != 0 && count <= leaves - first)
+	{
+		plen = merkle_proof_walk(NULL, NULL, leaves, first, count);
+
+		if (plen <= prooflen && (proof != NULL || plen == 0))
+		{
+			merkle_proof_walk(proof, tree, leaves, first, count);
+		}
+		else
+		{
+			plen = 0;
+		}
+	}
+
+	return plen;
+}
+
+bool qsc_merkle_proof_verify(const uint8_t* root, const uint8_t* data, size_t datalen, size_t msglen, size_t first, const uint8_t* proof, size_t prooflen)
+{
+	assert(root != NULL);
+	assert(data != NULL);
+
+	uint8_t pair[2 * QSC_MERKLE_HASH_SIZE] = { 0 };
+	uint8_t* nodes;
+	size_t count;
+	size_t hi;
+	size_t leaves;
+	size_t lo;
+	size_t n;
+	size_t npair;
+	size_t poft;
+	size_t rlen;
+	bool res;
+
+	res = false;
+	leaves = qsc_merkle_leaf_count(msglen);
+	count = qsc_merkle_leaf_count(datalen);
+
+	/* the range must be whole chunks, with only the last chunk of the message partial */
+	if (first < leaves && count <= leaves - first)
+	{
+		rlen = (first + count == leaves) ? msglen - (first * QSC_MERKLE_CHUNK_SIZE) : count * QSC_MERKLE_CHUNK_SIZE;
+
+		if (rlen == datalen && prooflen == merkle_proof_walk(NULL, NULL, leaves, first, count) && (proof != NULL || prooflen == 0))
+		{
+			nodes = (uint8_t*)qsc_memutils_malloc(count * QSC_MERKLE_HASH_SIZE);
+
+			if (nodes != NULL)
+			{
+				merkle_hash_leaves(nodes, data, datalen, count);
+				lo = first;
+				hi = first + count - 1;
+				n = leaves;
+				poft = 0;
+
+				/* rebuild the range's ancestors in place, taking the boundary siblings from the proof */
+				while (n > 1)
+				{
+					npair = 0;
+
+					if ((lo & 1) != 0)
+					{
+						qsc_memutils_copy(pair, proof + poft, QSC_MERKLE_HASH_SIZE);
+						qsc_memutils_copy(pair + QSC_MERKLE_HASH_SIZE, nodes, QSC_MERKLE_HASH_SIZE);
+						keccak_compute_short(nodes, QSC_MERKLE_HASH_SIZE, pair, sizeof(pair), qsc_keccak_rate_256, QSC_MERKLE_NODE_DOMAIN_ID);
+						poft += QSC_MERKLE_HASH_SIZE;
+						npair = 1;
+					}
+
+					if ((hi + 1) / 2 > (lo + 1) / 2)
+					{
+						merkle_hash_nodes(nodes + (npair * QSC_MERKLE_HASH_SIZE), nodes + (npair * QSC_MERKLE_HASH_SIZE), ((hi + 1) / 2) - ((lo + 1) / 2));
+					}
+
+					if ((hi & 1) == 0)
+					{
+						if (hi + 1 < n)
+						{
+							qsc_memutils_copy(pair, nodes + ((hi - lo) * QSC_MERKLE_HASH_SIZE), QSC_MERKLE_HASH_SIZE);
+							qsc_memutils_copy(pair + QSC_MERKLE_HASH_SIZE, proof + poft, QSC_MERKLE_HASH_SIZE);
+							keccak_compute_short(nodes + (((hi / 2) - (lo / 2)) * QSC_MERKLE_HASH_SIZE), QSC_MERKLE_HASH_SIZE, pair, sizeof(pair),
+								qsc_keccak_rate_256, QSC_MERKLE_NODE_DOMAIN_ID);
+							poft += QSC_MERKLE_HASH_SIZE;
+						}
+						else
+						{
+							/* an unpaired last node is carried up */
+							qsc_memutils_copy(nodes + (((hi / 2) - (lo / 2)) * QSC_MERKLE_HASH_SIZE), nodes + ((hi - lo) * QSC_MERKLE_HASH_SIZE), QSC_MERKLE_HASH_SIZE);
+						}
+					}
+
+					lo >>= 1;
+					hi >>= 1;
+					n = (n + 1) / 2;
+				}
+
+				res = (qsc_intutils_verify(root, nodes, QSC_MERKLE_HASH_SIZE) == 0);
+				qsc_memutils_clear(pair, sizeof(pair));
+				qsc_memutils_alloc_free(nodes);
+			}
+		}
+	}
+
+	return res;
+}
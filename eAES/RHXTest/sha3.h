@@ -293,6 +293,17 @@ QSC_EXPORT_API void qsc_keccak_absorb_custom(qsc_keccak_state* ctx, qsc_keccak_r
 */
 QSC_EXPORT_API void qsc_keccak_absorb_key_custom(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen, const uint8_t* name, size_t namelen, size_t rounds);
 
+/**
+* \brief Clone a Keccak state.
+* A KMAC or cSHAKE state is keyed once with the initialize function, and cloned for each message,
+* replacing the key, name, and customization absorption with a copy of the permutation state.
+* The clone must be erased with the dispose function, the source state is unchanged.
+*
+* \param output: [struct] The destination state; receives a copy of the input state
+* \param input: [const][struct] The initialized source state
+*/
+QSC_EXPORT_API void qsc_keccak_clone(qsc_keccak_state* output, const qsc_keccak_state* input);
+
 /**
 * \brief Dispose of the Keccak state.
 *
@@ -370,6 +381,45 @@ QSC_EXPORT_API void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds);
 */
 QSC_EXPORT_API void qsc_keccak_permute_p1600u(uint64_t* state);
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+/**
+* \brief The AVX2 Keccak permute function.
+* Internal function: Permutes a single state array using 256-bit row vectors.
+* Selected at runtime by qsc_keccak_permute when the CPU supports AVX2.
+*
+* \param state: The state array; must be initialized
+* \param rounds: The number of permutation rounds, the default and maximum is 24
+*/
+QSC_EXPORT_API void qsc_keccak_permute_p1600avx2(uint64_t* state, size_t rounds);
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+/**
+* \brief The AVX-512 Keccak permute function.
+* Internal function: Permutes a single state array using 512-bit row vectors, native rotates and ternary logic.
+* Selected at runtime by qsc_keccak_permute when the CPU supports AVX-512.
+*
+* \param state: The state array; must be initialized
+* \param rounds: The number of permutation rounds, the default and maximum is 24
+*/
+QSC_EXPORT_API void qsc_keccak_permute_p1600avx512(uint64_t* state, size_t rounds);
+#endif
+
+/**
+* \brief Stream an arbitrary number of bytes from the Keccak state directly into the output array.
+* The state position tracks the offset within the current block, so successive calls of any length
+* continue the same output stream and never permute more often than a single call would.
+*
+* \warning Do not interleave with the squeezeblocks functions, which ignore the block offset.
+*
+* \param ctx: [struct] A reference to the Keccak state; must be initialized and finalized
+* \param rate: The rate of absorption in bytes
+* \param output: The output byte array
+* \param outlen: The number of output bytes to generate
+* \param rounds: The number of permutation rounds, the default and maximum is 24
+*/
+QSC_EXPORT_API void qsc_keccak_squeeze(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_t* output, size_t outlen, size_t rounds);
+
 /**
 * \brief The Keccak squeeze function.
 *
@@ -548,6 +598,18 @@ QSC_EXPORT_API void qsc_shake_initialize(qsc_keccak_state* ctx, qsc_keccak_rate
 */
 QSC_EXPORT_API void qsc_shake_squeezeblocks(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_t* output, size_t nblocks);
 
+/**
+* \brief The streaming SHAKE squeeze function.
+* Long form api: must be used in conjunction with the initialize function.
+* Extracts any number of bytes, continuing from the previous call.
+*
+* \param ctx: [struct] A reference to the Keccak state; must be initialized
+* \param rate: The rate of absorption in bytes
+* \param output: The output byte array
+* \param outlen: The number of output bytes to generate
+*/
+QSC_EXPORT_API void qsc_shake_squeeze(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_t* output, size_t outlen);
+
 /* cSHAKE */
 
 /**
@@ -629,6 +691,18 @@ QSC_EXPORT_API void qsc_cshake_initialize(qsc_keccak_state* ctx, qsc_keccak_rate
 */
 QSC_EXPORT_API void qsc_cshake_squeezeblocks(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_t* output, size_t nblocks);
 
+/**
+* \brief The streaming cSHAKE squeeze function.
+* Long form api: must be used in conjunction with the initialize function.
+* Extracts any number of bytes, continuing from the previous call.
+*
+* \param ctx: [struct] A reference to the Keccak state; must be initialized
+* \param rate: The rate of absorption in bytes
+* \param output: The output byte array
+* \param outlen: The number of output bytes to generate
+*/
+QSC_EXPORT_API void qsc_cshake_squeeze(qsc_keccak_state* ctx, qsc_keccak_rate rate, uint8_t* output, size_t outlen);
+
 /**
 * \brief The cSHAKE update function.
 * Long form api: must be used in conjunction with the initialize and squeezeblocks functions.
@@ -838,6 +912,44 @@ QSC_EXPORT_API void qsc_kpa_update(qsc_kpa_state* ctx, const uint8_t* message, s
 */
 QSC_EXPORT_API void qsc_kpa_dispose(qsc_kpa_state* ctx);
 
+/* KPA-tree */
+
+/*!
+* \def QSC_KPA_TREE_CHUNK_SIZE
+* \brief The KPA-tree superchunk size in bytes; each superchunk is an independent KPA leaf instance
+*/
+#define QSC_KPA_TREE_CHUNK_SIZE (4ULL * 1024ULL * 1024ULL)
+
+/*!
+* \def QSC_KPA_TREE_VERSION
+* \brief The KPA-tree construction version, encoded in every node name
+*/
+#define QSC_KPA_TREE_VERSION 0x01
+
+/**
+* \brief Compute a KPA-tree MAC, processing the superchunks of a long message on multiple threads.
+* A message no longer than one superchunk produces exactly the KPA MAC.
+* A longer message is split into superchunks of QSC_KPA_TREE_CHUNK_SIZE bytes; chunk j is
+* authenticated by KPA with the customization string extended by the 16-byte node name
+* {'K','P','A','T','R','E','E',QSC_KPA_TREE_VERSION} || be64(j), producing a leaf MAC of the
+* KPA leaf hash size (16, 32 or 64 bytes). The leaf MACs, in order, are the message of a root
+* KPA whose node index is 0xFFFFFFFFFFFFFFFF.
+* The output does not depend on the thread count; threads are used when the library is
+* compiled with OpenMP, otherwise the superchunks are processed sequentially.
+*
+* \param output: The output MAC code array
+* \param outlen: The number of MAC bytes to generate
+* \param message: [const] The message array
+* \param msglen: The message length in bytes
+* \param key: [const] The KPA key; 16, 32 or 64 bytes select KPA-128, KPA-256 or KPA-512
+* \param keylen: The key length in bytes
+* \param custom: [const] The customization string; can be NULL if custlen is zero
+* \param custlen: The customization string length in bytes
+* \param threads: The maximum number of threads; zero selects the OpenMP default
+*/
+QSC_EXPORT_API void qsc_kpa_tree_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen,
+	const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen, size_t threads);
+
 /* parallel Keccak x4 */
 
 #if defined(QSC_SYSTEM_HAS_AVX2)
@@ -926,6 +1038,106 @@ void qsc_keccakx8_squeezeblocks(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak
 
 #endif
 
+/* parallel SHA3 x4 */
+
+/**
+* \brief Process 4 SHA3-256 instances simultaneously using SIMD instructions.
+*
+* \warning The input arrays must be of the same length, the output arrays must be at least QSC_SHA3_256_HASH_SIZE bytes.
+* This function requires the AVX2 instruction set.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param inp0: [const] The 1st input message array
+* \param inp1: [const] The 2nd input message array
+* \param inp2: [const] The 3rd input message array
+* \param inp3: [const] The 4th input message array
+* \param inplen: The length of the input message arrays
+*/
+QSC_EXPORT_API void sha3_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen);
+
+/**
+* \brief Process 4 SHA3-512 instances simultaneously using SIMD instructions.
+*
+* \warning The input arrays must be of the same length, the output arrays must be at least QSC_SHA3_512_HASH_SIZE bytes.
+* This function requires the AVX2 instruction set.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param inp0: [const] The 1st input message array
+* \param inp1: [const] The 2nd input message array
+* \param inp2: [const] The 3rd input message array
+* \param inp3: [const] The 4th input message array
+* \param inplen: The length of the input message arrays
+*/
+QSC_EXPORT_API void sha3_512x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen);
+
+/* parallel SHA3 x8 */
+
+/**
+* \brief Process 8 SHA3-256 instances simultaneously using SIMD instructions.
+*
+* \warning The input arrays must be of the same length, the output arrays must be at least QSC_SHA3_256_HASH_SIZE bytes.
+* This function requires the AVX512 instruction set.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param out4: The 5th output array
+* \param out5: The 6th output array
+* \param out6: The 7th output array
+* \param out7: The 8th output array
+* \param inp0: [const] The 1st input message array
+* \param inp1: [const] The 2nd input message array
+* \param inp2: [const] The 3rd input message array
+* \param inp3: [const] The 4th input message array
+* \param inp4: [const] The 5th input message array
+* \param inp5: [const] The 6th input message array
+* \param inp6: [const] The 7th input message array
+* \param inp7: [const] The 8th input message array
+* \param inplen: The length of the input message arrays
+*/
+QSC_EXPORT_API void sha3_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen);
+
+/**
+* \brief Process 8 SHA3-512 instances simultaneously using SIMD instructions.
+*
+* \warning The input arrays must be of the same length, the output arrays must be at least QSC_SHA3_512_HASH_SIZE bytes.
+* This function requires the AVX512 instruction set.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param out4: The 5th output array
+* \param out5: The 6th output array
+* \param out6: The 7th output array
+* \param out7: The 8th output array
+* \param inp0: [const] The 1st input message array
+* \param inp1: [const] The 2nd input message array
+* \param inp2: [const] The 3rd input message array
+* \param inp3: [const] The 4th input message array
+* \param inp4: [const] The 5th input message array
+* \param inp5: [const] The 6th input message array
+* \param inp6: [const] The 7th input message array
+* \param inp7: [const] The 8th input message array
+* \param inplen: The length of the input message arrays
+*/
+QSC_EXPORT_API void sha3_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen);
+
 /* parallel SHAKE x4 */
 
 /**
@@ -1336,4 +1548,633 @@ QSC_EXPORT_API void kmac512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8
 	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
 	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen);
 
+/* parallel cSHAKE x4 */
+
+/**
+* \brief Process 4 cSHAKE-128 instances simultaneously using SIMD instructions.
+* The name string is shared by all lanes, the key and customization arrays are unique to each lane.
+*
+* \warning The input and output arrays must be of the same length.
+* This function requires the AVX2 instruction set.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param outlen: The length of the output arrays
+* \param key0: [const] The 1st key array
+* \param key1: [const] The 2nd key array
+* \param key2: [const] The 3rd key array
+* \param key3: [const] The 4th key array
+* \param keylen: The length of the input key arrays
+* \param name: [const] The function name string, common to all lanes
+* \param namelen: The byte length of the function name string
+* \param cst0: [const] The 1st custom array
+* \param cst1: [const] The 2nd custom array
+* \param cst2: [const] The 3rd custom array
+* \param cst3: [const] The 4th custom array
+* \param cstlen: The length of the custom arrays
+*/
+QSC_EXPORT_API void cshake128x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen);
+
+/**
+* \brief Process 4 cSHAKE-256 instances simultaneously using SIMD instructions.
+* The name string is shared by all lanes, the key and customization arrays are unique to each lane.
+*
+* \warning The input and output arrays must be of the same length.
+* This function requires the AVX2 instruction set.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param outlen: The length of the output arrays
+* \param key0: [const] The 1st key array
+* \param key1: [const] The 2nd key array
+* \param key2: [const] The 3rd key array
+* \param key3: [const] The 4th key array
+* \param keylen: The length of the input key arrays
+* \param name: [const] The function name string, common to all lanes
+* \param namelen: The byte length of the function name string
+* \param cst0: [const] The 1st custom array
+* \param cst1: [const] The 2nd custom array
+* \param cst2: [const] The 3rd custom array
+* \param cst3: [const] The 4th custom array
+* \param cstlen: The length of the custom arrays
+*/
+QSC_EXPORT_API void cshake256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen);
+
+/**
+* \brief Process 4 cSHAKE-512 instances simultaneously using SIMD instructions.
+* The name string is shared by all lanes, the key and customization arrays are unique to each lane.
+*
+* \warning The input and output arrays must be of the same length.
+* This function requires the AVX2 instruction set.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param outlen: The length of the output arrays
+* \param key0: [const] The 1st key array
+* \param key1: [const] The 2nd key array
+* \param key2: [const] The 3rd key array
+* \param key3: [const] The 4th key array
+* \param keylen: The length of the input key arrays
+* \param name: [const] The function name string, common to all lanes
+* \param namelen: The byte length of the function name string
+* \param cst0: [const] The 1st custom array
+* \param cst1: [const] The 2nd custom array
+* \param cst2: [const] The 3rd custom array
+* \param cst3: [const] The 4th custom array
+* \param cstlen: The length of the custom arrays
+*/
+QSC_EXPORT_API void cshake512x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen);
+
+/* parallel cSHAKE x8 */
+
+/**
+* \brief Process 8 cSHAKE-128 instances simultaneously using SIMD instructions.
+* The name string is shared by all lanes, the key and customization arrays are unique to each lane.
+*
+* \warning The input and output arrays must be of the same length.
+* This function requires the AVX512 instruction set.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param out4: The 5th output array
+* \param out5: The 6th output array
+* \param out6: The 7th output array
+* \param out7: The 8th output array
+* \param outlen: The length of the output arrays
+* \param key0: [const] The 1st key array
+* \param key1: [const] The 2nd key array
+* \param key2: [const] The 3rd key array
+* \param key3: [const] The 4th key array
+* \param key4: [const] The 5th key array
+* \param key5: [const] The 6th key array
+* \param key6: [const] The 7th key array
+* \param key7: [const] The 8th key array
+* \param keylen: The length of the input key arrays
+* \param name: [const] The function name string, common to all lanes
+* \param namelen: The byte length of the function name string
+* \param cst0: [const] The 1st custom array
+* \param cst1: [const] The 2nd custom array
+* \param cst2: [const] The 3rd custom array
+* \param cst3: [const] The 4th custom array
+* \param cst4: [const] The 5th custom array
+* \param cst5: [const] The 6th custom array
+* \param cst6: [const] The 7th custom array
+* \param cst7: [const] The 8th custom array
+* \param cstlen: The length of the custom arrays
+*/
+QSC_EXPORT_API void cshake128x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen);
+
+/**
+* \brief Process 8 cSHAKE-256 instances simultaneously using SIMD instructions.
+* The name string is shared by all lanes, the key and customization arrays are unique to each lane.
+*
+* \warning The input and output arrays must be of the same length.
+* This function requires the AVX512 instruction set.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param out4: The 5th output array
+* \param out5: The 6th output array
+* \param out6: The 7th output array
+* \param out7: The 8th output array
+* \param outlen: The length of the output arrays
+* \param key0: [const] The 1st key array
+* \param key1: [const] The 2nd key array
+* \param key2: [const] The 3rd key array
+* \param key3: [const] The 4th key array
+* \param key4: [const] The 5th key array
+* \param key5: [const] The 6th key array
+* \param key6: [const] The 7th key array
+* \param key7: [const] The 8th key array
+* \param keylen: The length of the input key arrays
+* \param name: [const] The function name string, common to all lanes
+* \param namelen: The byte length of the function name string
+* \param cst0: [const] The 1st custom array
+* \param cst1: [const] The 2nd custom array
+* \param cst2: [const] The 3rd custom array
+* \param cst3: [const] The 4th custom array
+* \param cst4: [const] The 5th custom array
+* \param cst5: [const] The 6th custom array
+* \param cst6: [const] The 7th custom array
+* \param cst7: [const] The 8th custom array
+* \param cstlen: The length of the custom arrays
+*/
+QSC_EXPORT_API void cshake256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen);
+
+/**
+* \brief Process 8 cSHAKE-512 instances simultaneously using SIMD instructions.
+* The name string is shared by all lanes, the key and customization arrays are unique to each lane.
+*
+* \warning The input and output arrays must be of the same length.
+* This function requires the AVX512 instruction set.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param out4: The 5th output array
+* \param out5: The 6th output array
+* \param out6: The 7th output array
+* \param out7: The 8th output array
+* \param outlen: The length of the output arrays
+* \param key0: [const] The 1st key array
+* \param key1: [const] The 2nd key array
+* \param key2: [const] The 3rd key array
+* \param key3: [const] The 4th key array
+* \param key4: [const] The 5th key array
+* \param key5: [const] The 6th key array
+* \param key6: [const] The 7th key array
+* \param key7: [const] The 8th key array
+* \param keylen: The length of the input key arrays
+* \param name: [const] The function name string, common to all lanes
+* \param namelen: The byte length of the function name string
+* \param cst0: [const] The 1st custom array
+* \param cst1: [const] The 2nd custom array
+* \param cst2: [const] The 3rd custom array
+* \param cst3: [const] The 4th custom array
+* \param cst4: [const] The 5th custom array
+* \param cst5: [const] The 6th custom array
+* \param cst6: [const] The 7th custom array
+* \param cst7: [const] The 8th custom array
+* \param cstlen: The length of the custom arrays
+*/
+QSC_EXPORT_API void cshake512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* name, size_t namelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen);
+
+/* multi-lane jobs */
+
+/*!
+* \def QSC_KECCAK_JOB_LANES
+* \brief The number of Keccak instances processed simultaneously by the job scheduler
+*/
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define QSC_KECCAK_JOB_LANES 8
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define QSC_KECCAK_JOB_LANES 4
+#else
+#	define QSC_KECCAK_JOB_LANES 1
+#endif
+
+/*!
+* \enum qsc_keccak_job_mode
+* \brief The Keccak function applied to every job in a queue
+*/
+typedef enum
+{
+	qsc_keccak_job_sha3 = 0x01,						/*!< SHA3; the job output length is the digest size  */
+	qsc_keccak_job_shake = 0x02,					/*!< SHAKE; the message is the input key  */
+	qsc_keccak_job_cshake = 0x03,					/*!< cSHAKE; the message is the input key  */
+	qsc_keccak_job_kmac = 0x04,						/*!< KMAC  */
+} qsc_keccak_job_mode;
+
+/*!
+* \struct qsc_keccak_job
+* \brief A single hash, XOF or MAC request; lengths are independent of the other jobs in the queue
+*/
+QSC_EXPORT_API typedef struct
+{
+	const uint8_t* message;							/*!< The message or input key  */
+	size_t msglen;									/*!< The message length in bytes  */
+	const uint8_t* key;								/*!< The KMAC key; unused by the other modes  */
+	size_t keylen;									/*!< The key length in bytes  */
+	const uint8_t* name;							/*!< The cSHAKE function name; unused by the other modes  */
+	size_t namelen;									/*!< The function name length in bytes  */
+	const uint8_t* custom;							/*!< The cSHAKE or KMAC customization string  */
+	size_t custlen;									/*!< The customization string length in bytes  */
+	uint8_t* output;								/*!< The output array  */
+	size_t outlen;									/*!< The number of output bytes to generate  */
+} qsc_keccak_job;
+
+/**
+* \brief Process a queue of independent Keccak jobs across the SIMD lanes.
+* Each lane absorbs its own job with an independent padding position; when a lane has
+* generated its output, the next pending job is loaded into it, and lanes left without
+* a job are masked out until the queue drains.
+* Processes 8 lanes with AVX-512, 4 lanes with AVX2, or the jobs sequentially.
+*
+* \param jobs: [const] The array of jobs
+* \param jobcount: The number of jobs in the array
+* \param rate: The Keccak rate; 256 for SHA3-256, 512 for SHA3-512
+* \param mode: The Keccak function applied to all jobs
+*/
+QSC_EXPORT_API void qsc_keccak_jobs_compute(const qsc_keccak_job* jobs, size_t jobcount, qsc_keccak_rate rate, qsc_keccak_job_mode mode);
+
+/* incremental multi-lane Keccak */
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+/*!
+* \struct qsc_keccakx4_state
+* \brief The 4-lane incremental Keccak state; the lanes remain interleaved in __m256i registers between calls
+*/
+QSC_EXPORT_API typedef struct
+{
+	__m256i state[QSC_KECCAK_STATE_SIZE];					/*!< The interleaved state array  */
+	uint8_t buffer[4][QSC_KECCAK_STATE_BYTE_SIZE];		/*!< The per-lane message buffers  */
+	size_t position[4];								/*!< The per-lane buffer positions  */
+	qsc_keccak_rate rate;								/*!< The absorption rate  */
+} qsc_keccakx4_state;
+
+/**
+* \brief Dispose of the 4-lane incremental state.
+*
+* \param ctx: [struct] The state to dispose
+*/
+QSC_EXPORT_API void qsc_keccakx4_dispose(qsc_keccakx4_state* ctx);
+
+/**
+* \brief Initialize the 4-lane incremental state for SHA3, SHAKE or an un-customized cSHAKE.
+*
+* \param ctx: [struct] The state to initialize
+* \param rate: The Keccak rate
+*/
+QSC_EXPORT_API void qsc_keccakx4_initialize(qsc_keccakx4_state* ctx, qsc_keccak_rate rate);
+
+/**
+* \brief Initialize the 4-lane incremental state for KMAC.
+* Key and customization lengths are common to all lanes.
+*
+* \param ctx: [struct] The state to initialize
+* \param rate: The Keccak rate
+* \param key0..key3: [const] The per-lane keys
+* \param keylen: The length of each key in bytes
+* \param cst0..cst3: [const] The per-lane customization strings
+* \param cstlen: The length of each customization string in bytes
+*/
+QSC_EXPORT_API void qsc_keccakx4_kmac_initialize(qsc_keccakx4_state* ctx, qsc_keccak_rate rate,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen);
+
+/**
+* \brief Absorb message fragments of independent lengths into the 4 lanes.
+* Each lane buffers its own partial block; the lanes holding a full block are permuted
+* together, and the lanes that did not advance are restored after the permutation.
+* A lane with a zero length is left untouched.
+*
+* \param ctx: [struct] The incremental state
+* \param messages: [const] The per-lane message fragments
+* \param msglens: [const] The per-lane fragment lengths in bytes
+*/
+QSC_EXPORT_API void qsc_keccakx4_update(qsc_keccakx4_state* ctx, const uint8_t* messages[4], const size_t msglens[4]);
+
+/**
+* \brief Pad and absorb the final block of every lane with the domain identifier.
+* Must be followed by one or more calls to the squeeze function.
+*
+* \param ctx: [struct] The incremental state
+* \param domain: The Keccak domain identifier, e.g. QSC_KECCAK_SHAKE_DOMAIN_ID
+*/
+QSC_EXPORT_API void qsc_keccakx4_finalize(qsc_keccakx4_state* ctx, uint8_t domain);
+
+/**
+* \brief Finalize the KMAC lanes and generate the MAC codes.
+*
+* \param ctx: [struct] The incremental state
+* \param outputs: The per-lane output arrays
+* \param outlen: The MAC code length in bytes
+*/
+QSC_EXPORT_API void qsc_keccakx4_kmac_finalize(qsc_keccakx4_state* ctx, uint8_t* outputs[4], size_t outlen);
+
+/**
+* \brief Squeeze output bytes from every lane of a finalized state.
+* Successive calls continue the output stream at any byte offset.
+*
+* \param ctx: [struct] The incremental state
+* \param outputs: The per-lane output arrays
+* \param outlen: The number of bytes to write to each lane output
+*/
+QSC_EXPORT_API void qsc_keccakx4_squeeze(qsc_keccakx4_state* ctx, uint8_t* outputs[4], size_t outlen);
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+/*!
+* \struct qsc_keccakx8_state
+* \brief The 8-lane incremental Keccak state; the lanes remain interleaved in __m512i registers between calls
+*/
+QSC_EXPORT_API typedef struct
+{
+	__m512i state[QSC_KECCAK_STATE_SIZE];					/*!< The interleaved state array  */
+	uint8_t buffer[8][QSC_KECCAK_STATE_BYTE_SIZE];		/*!< The per-lane message buffers  */
+	size_t position[8];								/*!< The per-lane buffer positions  */
+	qsc_keccak_rate rate;								/*!< The absorption rate  */
+} qsc_keccakx8_state;
+
+/**
+* \brief Dispose of the 8-lane incremental state.
+*
+* \param ctx: [struct] The state to dispose
+*/
+QSC_EXPORT_API void qsc_keccakx8_dispose(qsc_keccakx8_state* ctx);
+
+/**
+* \brief Initialize the 8-lane incremental state for SHA3, SHAKE or an un-customized cSHAKE.
+*
+* \param ctx: [struct] The state to initialize
+* \param rate: The Keccak rate
+*/
+QSC_EXPORT_API void qsc_keccakx8_initialize(qsc_keccakx8_state* ctx, qsc_keccak_rate rate);
+
+/**
+* \brief Initialize the 8-lane incremental state for KMAC.
+* Key and customization lengths are common to all lanes.
+*
+* \param ctx: [struct] The state to initialize
+* \param rate: The Keccak rate
+* \param key0..key7: [const] The per-lane keys
+* \param keylen: The length of each key in bytes
+* \param cst0..cst7: [const] The per-lane customization strings
+* \param cstlen: The length of each customization string in bytes
+*/
+QSC_EXPORT_API void qsc_keccakx8_kmac_initialize(qsc_keccakx8_state* ctx, qsc_keccak_rate rate,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen);
+
+/**
+* \brief Absorb message fragments of independent lengths into the 8 lanes.
+* Each lane buffers its own partial block; the lanes holding a full block are permuted
+* together, and the lanes that did not advance are restored after the permutation.
+* A lane with a zero length is left untouched.
+*
+* \param ctx: [struct] The incremental state
+* \param messages: [const] The per-lane message fragments
+* \param msglens: [const] The per-lane fragment lengths in bytes
+*/
+QSC_EXPORT_API void qsc_keccakx8_update(qsc_keccakx8_state* ctx, const uint8_t* messages[8], const size_t msglens[8]);
+
+/**
+* \brief Pad and absorb the final block of every lane with the domain identifier.
+* Must be followed by one or more calls to the squeeze function.
+*
+* \param ctx: [struct] The incremental state
+* \param domain: The Keccak domain identifier, e.g. QSC_KECCAK_SHAKE_DOMAIN_ID
+*/
+QSC_EXPORT_API void qsc_keccakx8_finalize(qsc_keccakx8_state* ctx, uint8_t domain);
+
+/**
+* \brief Finalize the KMAC lanes and generate the MAC codes.
+*
+* \param ctx: [struct] The incremental state
+* \param outputs: The per-lane output arrays
+* \param outlen: The MAC code length in bytes
+*/
+QSC_EXPORT_API void qsc_keccakx8_kmac_finalize(qsc_keccakx8_state* ctx, uint8_t* outputs[8], size_t outlen);
+
+/**
+* \brief Squeeze output bytes from every lane of a finalized state.
+* Successive calls continue the output stream at any byte offset.
+*
+* \param ctx: [struct] The incremental state
+* \param outputs: The per-lane output arrays
+* \param outlen: The number of bytes to write to each lane output
+*/
+QSC_EXPORT_API void qsc_keccakx8_squeeze(qsc_keccakx8_state* ctx, uint8_t* outputs[8], size_t outlen);
+#endif
+
+/* TurboSHAKE */
+
+/*!
+* \def QSC_TURBOSHAKE_DOMAIN_ID
+* \brief The default TurboSHAKE domain id
+*/
+#define QSC_TURBOSHAKE_DOMAIN_ID 0x1F
+
+/*!
+* \def QSC_TURBOSHAKE_ROUNDS
+* \brief The number of permutation rounds used by TurboSHAKE and KangarooTwelve
+*/
+#define QSC_TURBOSHAKE_ROUNDS 12
+
+/**
+* \brief Process a message with TurboSHAKE-128 and return the output array.
+* TurboSHAKE is SHAKE with the Keccak permutation reduced to 12 rounds (RFC 9861).
+*
+* \param output: The output array
+* \param outlen: The number of bytes to generate
+* \param message: [const] The message array; may be empty but not NULL
+* \param msglen: The message length in bytes
+* \param domain: The domain separation byte, in the range 0x01-0x7F
+*/
+QSC_EXPORT_API void qsc_turboshake128_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, uint8_t domain);
+
+/**
+* \brief Process a message with TurboSHAKE-256 and return the output array.
+*
+* \param output: The output array
+* \param outlen: The number of bytes to generate
+* \param message: [const] The message array; may be empty but not NULL
+* \param msglen: The message length in bytes
+* \param domain: The domain separation byte, in the range 0x01-0x7F
+*/
+QSC_EXPORT_API void qsc_turboshake256_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, uint8_t domain);
+
+/* KangarooTwelve */
+
+/*!
+* \def QSC_KT_CHUNK_SIZE
+* \brief The KangarooTwelve tree chunk size in bytes
+*/
+#define QSC_KT_CHUNK_SIZE 8192
+
+/**
+* \brief Process a message with KangarooTwelve (KT128) and return the output array.
+* Messages longer than one chunk are hashed as a tree; the leaf chunks are processed
+* 8 at a time with AVX-512, 4 at a time with AVX2, or sequentially.
+*
+* \param output: The output array
+* \param outlen: The number of bytes to generate
+* \param message: [const] The message array; may be empty but not NULL
+* \param msglen: The message length in bytes
+* \param custom: [const] The customization string; can be NULL if custlen is zero
+* \param custlen: The customization string length in bytes
+*/
+QSC_EXPORT_API void qsc_kt128_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen);
+
+/**
+* \brief Process a message with KangarooTwelve (KT256) and return the output array.
+* KT256 uses TurboSHAKE-256 and 64-byte chaining values.
+*
+* \param output: The output array
+* \param outlen: The number of bytes to generate
+* \param message: [const] The message array; may be empty but not NULL
+* \param msglen: The message length in bytes
+* \param custom: [const] The customization string; can be NULL if custlen is zero
+* \param custlen: The customization string length in bytes
+*/
+QSC_EXPORT_API void qsc_kt256_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen);
+
+/* Merkle tree */
+
+/*!
+* \def QSC_MERKLE_CHUNK_SIZE
+* \brief The Merkle tree leaf chunk size in bytes
+*/
+#define QSC_MERKLE_CHUNK_SIZE 4096
+
+/*!
+* \def QSC_MERKLE_HASH_SIZE
+* \brief The size in bytes of a Merkle tree node hash
+*/
+#define QSC_MERKLE_HASH_SIZE 32
+
+/*!
+* \def QSC_MERKLE_NODE_DOMAIN_ID
+* \brief The Keccak domain byte of an internal node; leaves are plain SHA3-256 (domain 0x06) of their chunk
+*/
+#define QSC_MERKLE_NODE_DOMAIN_ID 0x05
+
+/**
+* \brief Returns the number of leaf chunks in a message; an empty message has one empty leaf.
+*
+* \param msglen: The message length in bytes
+* \return Returns the number of leaves
+*/
+QSC_EXPORT_API size_t qsc_merkle_leaf_count(size_t msglen);
+
+/**
+* \brief Returns the size in bytes of the stored tree for a message.
+* The tree is stored level by level, leaves first, and the last 32 bytes are the root.
+*
+* \param msglen: The message length in bytes
+* \return Returns the tree size in bytes
+*/
+QSC_EXPORT_API size_t qsc_merkle_tree_size(size_t msglen);
+
+/**
+* \brief Compute the Merkle tree of a message.
+* Leaves are the SHA3-256 hashes of each chunk, and each internal node hashes the concatenated
+* pair of child hashes under the node domain; an unpaired last node is carried to the next level.
+* Leaves and nodes are hashed 8 at a time with AVX-512, 4 at a time with AVX2, or sequentially.
+*
+* \param tree: The output tree array, of qsc_merkle_tree_size(msglen) bytes
+* \param message: [const] The message array; may be empty but not NULL
+* \param msglen: The message length in bytes
+*/
+QSC_EXPORT_API void qsc_merkle_tree_compute(uint8_t* tree, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Compute only the Merkle root of a message.
+*
+* \param root: The output root hash of QSC_MERKLE_HASH_SIZE bytes
+* \param message: [const] The message array; may be empty but not NULL
+* \param msglen: The message length in bytes
+* \return Returns false if the working memory could not be allocated
+*/
+QSC_EXPORT_API bool qsc_merkle_root_compute(uint8_t* root, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Returns the size in bytes of the inclusion proof for a range of leaves.
+*
+* \param msglen: The message length in bytes
+* \param first: The index of the first leaf in the range
+* \param count: The number of leaves in the range
+* \return Returns the proof size in bytes, or zero if the range is invalid
+*/
+QSC_EXPORT_API size_t qsc_merkle_proof_size(size_t msglen, size_t first, size_t count);
+
+/**
+* \brief Generate the inclusion proof for a range of leaves from a stored tree.
+* The proof holds the sibling hashes at the range boundaries of each level, at most two per level.
+*
+* \param proof: The output proof array
+* \param prooflen: The proof array length, at least qsc_merkle_proof_size(msglen, first, count)
+* \param tree: [const] The tree computed by qsc_merkle_tree_compute
+* \param msglen: The message length in bytes
+* \param first: The index of the first leaf in the range
+* \param count: The number of leaves in the range
+* \return Returns the number of proof bytes written, or zero on failure
+*/
+QSC_EXPORT_API size_t qsc_merkle_proof_generate(uint8_t* proof, size_t prooflen, const uint8_t* tree, size_t msglen, size_t first, size_t count);
+
+/**
+* \brief Verify a range of message chunks against the Merkle root.
+* Only the range's own chunks and the proof hashes are processed.
+*
+* \param root: [const] The trusted root hash
+* \param data: [const] The chunks of the range, starting at leaf first; the last chunk of the message may be partial
+* \param datalen: The length of the range data in bytes
+* \param msglen: The length of the complete message in bytes
+* \param first: The index of the first leaf in the range
+* \param proof: [const] The inclusion proof
+* \param prooflen: The inclusion proof length in bytes
+* \return Returns true if the range is authentic
+*/
+QSC_EXPORT_API bool qsc_merkle_proof_verify(const uint8_t* root, const uint8_t* data, size_t datalen, size_t msglen, size_t first, const uint8_t* proof, size_t prooflen);
+
 #endif
@@ -1,8 +1,19 @@
 #include "sha3_test.h"
 #include "testutils.h"
 #include "intutils.h"
+#include "memutils.h"
 #include "sha3.h"
 
+#define KECCAK_JOB_TEST_COUNT 11
+#define KECCAK_JOB_TEST_MSGLEN 600
+#define KECCAK_JOB_TEST_OUTLEN 400
+#define KT_TEST_MSGLEN 83521
+#define KPA_TREE_TEST_CUSTLEN 21
+#define KECCAK_ABSORB_TEST_MSGLEN 1531
+#define KECCAK_ABSORB_TEST_OUTLEN 333
+#define KECCAK_SQUEEZE_TEST_OUTLEN 2113
+#define MERKLE_TEST_LEAVES 38
+
 bool qsctest_sha3_256_kat()
 {
 	uint8_t exp0[QSC_SHA3_256_HASH_SIZE] = { 0 };
@@ -1098,347 +1109,1307 @@ bool qsctest_kpa_512_kat()
 	return status;
 }
 
-#if defined(QSC_SYSTEM_HAS_AVX2)
-bool qsctest_kmac128x4_equality()
+bool qsctest_kpa_tree_equality()
 {
-	uint8_t cst[4][16] = { 0 };
-	uint8_t key[4][18] = { 0 };
-	uint8_t msg[4][256] = { 0 };
-	uint8_t otp[4][16] = { 0 };
-	uint8_t exp[4][16] = { 0 };
+	uint8_t cust[KPA_TREE_TEST_CUSTLEN + 16] = { 0 };
+	uint8_t exp[32] = { 0 };
+	uint8_t key[QSC_KPA_256_KEY_SIZE] = { 0 };
+	uint8_t leaves[3 * 32] = { 0 };
+	uint8_t otp[32] = { 0 };
+	const uint8_t node[8] = { 0x4B, 0x50, 0x41, 0x54, 0x52, 0x45, 0x45, QSC_KPA_TREE_VERSION };
+	qsc_kpa_state ctx;
+	uint8_t* msg;
 	size_t i;
+	size_t mlen;
 	bool status;
 
 	status = true;
-
-	for (i = 0; i < 16; ++i)
+	mlen = (size_t)(2 * QSC_KPA_TREE_CHUNK_SIZE) + 1234;
+	msg = (uint8_t*)qsc_memutils_malloc(mlen);
+
+	if (msg != NULL)
+	{
+		for (i = 0; i < mlen; ++i)
+		{
+			msg[i] = (uint8_t)((i * 7) + 1);
+		}
+
+		for (i = 0; i < sizeof(key); ++i)
+		{
+			key[i] = (uint8_t)(i + 0x40);
+		}
+
+		for (i = 0; i < KPA_TREE_TEST_CUSTLEN; ++i)
+		{
+			cust[i] = (uint8_t)(0xA0 - i);
+		}
+
+		/* a single superchunk is plain KPA */
+		qsc_kpa_initialize(&ctx, key, sizeof(key), cust, KPA_TREE_TEST_CUSTLEN);
+		qsc_kpa_update(&ctx, msg, 1000);
+		qsc_kpa_finalize(&ctx, exp, sizeof(exp));
+		qsc_kpa_tree_compute(otp, sizeof(otp), msg, 1000, key, sizeof(key), cust, KPA_TREE_TEST_CUSTLEN, 4);
+
+		if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_kpa_tree_equality: output does not match the known answer -KT1 \n");
+			status = false;
+		}
+
+		/* three superchunks: leaf codes under the node-extended customization, then the root */
+		qsc_memutils_copy(cust + KPA_TREE_TEST_CUSTLEN, node, sizeof(node));
+
+		for (i = 0; i < 3; ++i)
+		{
+			qsc_intutils_be64to8(cust + KPA_TREE_TEST_CUSTLEN + sizeof(node), (uint64_t)i);
+			qsc_kpa_initialize(&ctx, key, sizeof(key), cust, sizeof(cust));
+			qsc_kpa_update(&ctx, msg + (i * (size_t)QSC_KPA_TREE_CHUNK_SIZE), (i == 2) ? 1234 : (size_t)QSC_KPA_TREE_CHUNK_SIZE);
+			qsc_kpa_finalize(&ctx, leaves + (i * 32), 32);
+		}
+
+		qsc_intutils_be64to8(cust + KPA_TREE_TEST_CUSTLEN + sizeof(node), 0xFFFFFFFFFFFFFFFFULL);
+		qsc_kpa_initialize(&ctx, key, sizeof(key), cust, sizeof(cust));
+		qsc_kpa_update(&ctx, leaves, sizeof(leaves));
+		qsc_kpa_finalize(&ctx, exp, sizeof(exp));
+		qsc_kpa_dispose(&ctx);
+
+		qsc_kpa_tree_compute(otp, sizeof(otp), msg, mlen, key, sizeof(key), cust, KPA_TREE_TEST_CUSTLEN, 1);
+
+		if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_kpa_tree_equality: output does not match the known answer -KT2 \n");
+			status = false;
+		}
+
+		/* the thread count does not change the output */
+		qsc_intutils_clear8(otp, sizeof(otp));
+		qsc_kpa_tree_compute(otp, sizeof(otp), msg, mlen, key, sizeof(key), cust, KPA_TREE_TEST_CUSTLEN, 4);
+
+		if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_kpa_tree_equality: output does not match the known answer -KT3 \n");
+			status = false;
+		}
+
+		qsc_memutils_alloc_free(msg);
+	}
+	else
 	{
-		cst[0][i] = (uint8_t)i;
-		cst[1][i] = (uint8_t)i;
-		cst[2][i] = (uint8_t)i;
-		cst[3][i] = (uint8_t)i;
-		key[0][i] = (uint8_t)i;
-		key[1][i] = (uint8_t)i;
-		key[2][i] = (uint8_t)i;
-		key[3][i] = (uint8_t)i;
+		status = false;
 	}
 
-	key[0][16] = (uint8_t)1;
-	key[1][16] = (uint8_t)2;
-	key[2][16] = (uint8_t)3;
-	key[3][16] = (uint8_t)4;
+	return status;
+}
 
-	for (i = 0; i < 256; ++i)
+bool qsctest_turboshake_kat()
+{
+	uint8_t exp128a[32] = { 0 };
+	uint8_t exp128b[32] = { 0 };
+	uint8_t exp128c[32] = { 0 };
+	uint8_t exp256a[64] = { 0 };
+	uint8_t exp256b[64] = { 0 };
+	uint8_t msg0[1] = { 0 };
+	uint8_t msg3[3] = { 0xFF, 0xFF, 0xFF };
+	uint8_t msg289[289] = { 0 };
+	uint8_t output[64] = { 0 };
+	size_t i;
+	bool status;
+
+	qsctest_hex_to_bin("1E415F1C5983AFF2169217277D17BB538CD945A397DDEC541F1CE41AF2C1B74C", exp128a, sizeof(exp128a));
+	qsctest_hex_to_bin("96C77C279E0126F7FC07C9B07F5CDAE1E0BE60BDBE10620040E75D7223A624D2", exp128b, sizeof(exp128b));
+	qsctest_hex_to_bin("3D03988BB59E681851A192F429AE03988E8F444BC06036A3F1A7D2CCD758D174", exp128c, sizeof(exp128c));
+	qsctest_hex_to_bin("367A329DAFEA871C7802EC67F905AE13C57695DC2C6663C61035F59A18F8E7DB"
+		"11EDC0E12E91EA60EB6B32DF06DD7F002FBAFABB6E13EC1CC20D995547600DB0", exp256a, sizeof(exp256a));
+	qsctest_hex_to_bin("66B810DB8E90780424C0847372FDC95710882FDE31C6DF75BEB9D4CD9305CFCA"
+		"E35E7B83E8B7E6EB4B78605880116316FE2C078A09B94AD7B8213C0A738B65C0", exp256b, sizeof(exp256b));
+
+	/* the RFC 9861 ptn pattern: 0x00 to 0xFA repeated */
+	for (i = 0; i < sizeof(msg289); ++i)
 	{
-		msg[0][i] = (uint8_t)i;
-		msg[1][i] = (uint8_t)i;
-		msg[2][i] = (uint8_t)i;
-		msg[3][i] = (uint8_t)i;
+		msg289[i] = (uint8_t)(i % 251);
 	}
 
-	qsc_kmac128_compute(exp[0], 16, msg[0], 256, key[0], 18, cst[0], 16);
+	status = true;
 
-	kmac128x4(otp[0], otp[1], otp[2], otp[3], 16, key[0], key[1], key[2], key[3], 18,
-		cst[0], cst[1], cst[2], cst[3], 16, msg[0], msg[1], msg[2], msg[3], 256);
+	qsc_turboshake128_compute(output, sizeof(exp128a), msg0, 0, QSC_TURBOSHAKE_DOMAIN_ID);
 
-	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	if (qsc_intutils_are_equal8(output, exp128a, sizeof(exp128a)) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac128x4_equality: output does not match the known answer -KP1 \n");
+		qsctest_print_safe("Failure! turboshake_kat: output does not match the known answer -TS1 \n");
 		status = false;
 	}
 
-	qsc_kmac128_compute(exp[1], 16, msg[1], 256, key[1], 18, cst[1], 16);
+	qsc_turboshake128_compute(output, sizeof(exp128b), msg289, sizeof(msg289), QSC_TURBOSHAKE_DOMAIN_ID);
 
-	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	if (qsc_intutils_are_equal8(output, exp128b, sizeof(exp128b)) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac128x4_equality: output does not match the known answer -KP2 \n");
+		qsctest_print_safe("Failure! turboshake_kat: output does not match the known answer -TS2 \n");
 		status = false;
 	}
 
-	qsc_kmac128_compute(exp[2], 16, msg[2], 256, key[2], 18, cst[2], 16);
+	qsc_turboshake128_compute(output, sizeof(exp128c), msg3, sizeof(msg3), 0x06);
 
-	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	if (qsc_intutils_are_equal8(output, exp128c, sizeof(exp128c)) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac128x4_equality: output does not match the known answer -KP3 \n");
+		qsctest_print_safe("Failure! turboshake_kat: output does not match the known answer -TS3 \n");
 		status = false;
 	}
 
-	qsc_kmac128_compute(exp[3], 16, msg[3], 256, key[3], 18, cst[3], 16);
+	qsc_turboshake256_compute(output, sizeof(exp256a), msg0, 0, QSC_TURBOSHAKE_DOMAIN_ID);
 
-	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	if (qsc_intutils_are_equal8(output, exp256a, sizeof(exp256a)) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac128x4_equality: output does not match the known answer -KP4 \n");
+		qsctest_print_safe("Failure! turboshake_kat: output does not match the known answer -TS4 \n");
+		status = false;
+	}
+
+	qsc_turboshake256_compute(output, sizeof(exp256b), msg289, sizeof(msg289), QSC_TURBOSHAKE_DOMAIN_ID);
+
+	if (qsc_intutils_are_equal8(output, exp256b, sizeof(exp256b)) == false)
+	{
+		qsctest_print_safe("Failure! turboshake_kat: output does not match the known answer -TS5 \n");
 		status = false;
 	}
 
 	return status;
 }
 
-bool qsctest_kmac256x4_equality()
+bool qsctest_kangarootwelve_kat()
 {
-	uint8_t cst[4][32] = { 0 };
-	uint8_t key[4][34] = { 0 };
-	uint8_t msg[4][256] = { 0 };
-	uint8_t otp[4][32] = { 0 };
-	uint8_t exp[4][32] = { 0 };
+	uint8_t exp128a[32] = { 0 };
+	uint8_t exp128b[32] = { 0 };
+	uint8_t exp128c[32] = { 0 };
+	uint8_t exp128d[32] = { 0 };
+	uint8_t exp256a[64] = { 0 };
+	uint8_t exp256b[64] = { 0 };
+	uint8_t msg0[1] = { 0 };
+	uint8_t msg1[1] = { 0xFF };
+	uint8_t output[64] = { 0 };
+	uint8_t* msg;
 	size_t i;
 	bool status;
 
+	qsctest_hex_to_bin("1AC2D450FC3B4205D19DA7BFCA1B37513C0803577AC7167F06FE2CE1F0EF39E5", exp128a, sizeof(exp128a));
+	qsctest_hex_to_bin("8701045E22205345FF4DDA05555CBB5C3AF1A771C2B89BAEF37DB43D9998B9FE", exp128b, sizeof(exp128b));
+	qsctest_hex_to_bin("D848C5068CED736F4462159B9867FD4C20B808ACC3D5BC48E0B06BA0A3762EC4", exp128c, sizeof(exp128c));
+	qsctest_hex_to_bin("6057430F613258F3A047936C8170843A9AF005C09931031BF5333B128F4B9AA8", exp128d, sizeof(exp128d));
+	qsctest_hex_to_bin("B23D2E9CEA9F4904E02BEC06817FC10CE38CE8E93EF4C89E6537076AF8646404"
+		"E3E8B68107B8833A5D30490AA33482353FD4ADC7148ECB782855003AAEBDE4A9", exp256a, sizeof(exp256a));
+	qsctest_hex_to_bin("B06275D284CD1CF205BCBE57DCCD3EC1FF6686E3ED15776383E1F2FA3C6AC8F0"
+		"8BF8A162829DB1A44B2A43FF83DD89C3CF1CEB61EDE659766D5CCF817A62BA8D", exp256b, sizeof(exp256b));
+
 	status = true;
 
-	for (i = 0; i < 32; ++i)
+	/* ptn(17^4): ten leaf chunks, enough to fill the 4 and 8 lane batches */
+	msg = (uint8_t*)qsc_memutils_malloc(KT_TEST_MSGLEN);
+
+	if (msg != NULL)
 	{
-		cst[0][i] = (uint8_t)i;
-		cst[1][i] = (uint8_t)i;
-		cst[2][i] = (uint8_t)i;
-		cst[3][i] = (uint8_t)i;
-		key[0][i] = (uint8_t)i;
-		key[1][i] = (uint8_t)i;
-		key[2][i] = (uint8_t)i;
-		key[3][i] = (uint8_t)i;
-	}
+		for (i = 0; i < KT_TEST_MSGLEN; ++i)
+		{
+			msg[i] = (uint8_t)(i % 251);
+		}
 
-	key[0][32] = (uint8_t)1;
-	key[1][32] = (uint8_t)2;
-	key[2][32] = (uint8_t)3;
-	key[3][32] = (uint8_t)4;
+		qsc_kt128_compute(output, sizeof(exp128a), msg0, 0, NULL, 0);
 
-	for (i = 0; i < 256; ++i)
-	{
-		msg[0][i] = (uint8_t)i;
-		msg[1][i] = (uint8_t)i;
-		msg[2][i] = (uint8_t)i;
-		msg[3][i] = (uint8_t)i;
-	}
+		if (qsc_intutils_are_equal8(output, exp128a, sizeof(exp128a)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KT1 \n");
+			status = false;
+		}
 
-	kmac256x4(otp[0], otp[1], otp[2], otp[3], 32, key[0], key[1], key[2], key[3], 34,
-		cst[0], cst[1], cst[2], cst[3], 16, msg[0], msg[1], msg[2], msg[3], 256);
+		qsc_kt128_compute(output, sizeof(exp128b), msg, KT_TEST_MSGLEN, NULL, 0);
 
-	qsc_kmac256_compute(exp[0], 32, msg[0], 256, key[0], 34, cst[0], 16);
+		if (qsc_intutils_are_equal8(output, exp128b, sizeof(exp128b)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KT2 \n");
+			status = false;
+		}
 
-	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
-	{
-		qsctest_print_safe("Failure! qsctest_kmac256x4_equality: output does not match the known answer -KP1 \n");
-		status = false;
-	}
+		qsc_kt128_compute(output, sizeof(exp128c), msg1, sizeof(msg1), msg, 41);
 
-	qsc_kmac256_compute(exp[1], 32, msg[1], 256, key[1], 34, cst[1], 16);
+		if (qsc_intutils_are_equal8(output, exp128c, sizeof(exp128c)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KT3 \n");
+			status = false;
+		}
 
-	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
-	{
-		qsctest_print_safe("Failure! qsctest_kmac256x4_equality: output does not match the known answer -KP2 \n");
-		status = false;
-	}
+		/* the second leaf is made of customization string bytes */
+		qsc_kt128_compute(output, sizeof(exp128d), msg, 8191, msg, 8190);
 
-	qsc_kmac256_compute(exp[2], 32, msg[2], 256, key[2], 34, cst[2], 16);
+		if (qsc_intutils_are_equal8(output, exp128d, sizeof(exp128d)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KT4 \n");
+			status = false;
+		}
 
-	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
-	{
-		qsctest_print_safe("Failure! qsctest_kmac256x4_equality: output does not match the known answer -KP3 \n");
-		status = false;
-	}
+		qsc_kt256_compute(output, sizeof(exp256a), msg0, 0, NULL, 0);
 
-	qsc_kmac256_compute(exp[3], 32, msg[3], 256, key[3], 34, cst[3], 16);
+		if (qsc_intutils_are_equal8(output, exp256a, sizeof(exp256a)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KT5 \n");
+			status = false;
+		}
 
-	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+		qsc_kt256_compute(output, sizeof(exp256b), msg, KT_TEST_MSGLEN, NULL, 0);
+
+		if (qsc_intutils_are_equal8(output, exp256b, sizeof(exp256b)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KT6 \n");
+			status = false;
+		}
+
+		qsc_memutils_alloc_free(msg);
+	}
+	else
 	{
-		qsctest_print_safe("Failure! qsctest_kmac256x4_equality: output does not match the known answer -KP4 \n");
 		status = false;
 	}
 
 	return status;
 }
 
-bool qsctest_kmac512x4_equality()
+bool qsctest_keccak_absorb_equality()
 {
-	uint8_t cst[4][64] = { 0 };
-	uint8_t key[4][66] = { 0 };
-	uint8_t msg[4][256] = { 0 };
-	uint8_t otp[4][64] = { 0 };
-	uint8_t exp[4][64] = { 0 };
+	uint8_t exp[KECCAK_ABSORB_TEST_OUTLEN] = { 0 };
+	uint8_t key[32] = { 0 };
+	uint8_t msg[KECCAK_ABSORB_TEST_MSGLEN] = { 0 };
+	uint8_t otp[KECCAK_ABSORB_TEST_OUTLEN] = { 0 };
+	qsc_keccak_state ctx;
 	size_t i;
+	size_t flen;
+	size_t pos;
 	bool status;
 
 	status = true;
 
-	for (i = 0; i < 64; ++i)
+	for (i = 0; i < sizeof(msg); ++i)
 	{
-		cst[0][i] = (uint8_t)i;
-		cst[1][i] = (uint8_t)i;
-		cst[2][i] = (uint8_t)i;
-		cst[3][i] = (uint8_t)i;
-		key[0][i] = (uint8_t)i;
-		key[1][i] = (uint8_t)i;
-		key[2][i] = (uint8_t)i;
-		key[3][i] = (uint8_t)i;
+		msg[i] = (uint8_t)((i * 13) + 5);
 	}
 
-	key[0][64] = (uint8_t)1;
-	key[1][64] = (uint8_t)2;
-	key[2][64] = (uint8_t)3;
-	key[3][64] = (uint8_t)4;
-
-	for (i = 0; i < 256; ++i)
+	for (i = 0; i < sizeof(key); ++i)
 	{
-		msg[0][i] = (uint8_t)i;
-		msg[1][i] = (uint8_t)i;
-		msg[2][i] = (uint8_t)i;
-		msg[3][i] = (uint8_t)i;
+		key[i] = (uint8_t)(0xF0 - i);
 	}
 
-	kmac512x4(otp[0], otp[1], otp[2], otp[3], 64, key[0], key[1], key[2], key[3], 66,
-		cst[0], cst[1], cst[2], cst[3], 16, msg[0], msg[1], msg[2], msg[3], 256);
-
-	qsc_kmac512_compute(exp[0], 64, msg[0], 256, key[0], 66, cst[0], 16);
+	/* sha3-256 with fragments that straddle the rate boundary */
+	qsc_sha3_compute256(exp, msg, sizeof(msg));
+	qsc_sha3_initialize(&ctx);
+	pos = 0;
+	flen = 1;
 
-	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	while (pos < sizeof(msg))
 	{
-		qsctest_print_safe("Failure! qsctest_kmac512x4_equality: output does not match the known answer -KP1 \n");
-		status = false;
+		flen = qsc_intutils_min(flen, sizeof(msg) - pos);
+		qsc_sha3_update(&ctx, qsc_keccak_rate_256, msg + pos, flen);
+		pos += flen;
+		flen = (flen * 7 + 3) % 181;
 	}
 
-	qsc_kmac512_compute(exp[1], 64, msg[1], 256, key[1], 66, cst[1], 16);
+	qsc_sha3_finalize(&ctx, qsc_keccak_rate_256, otp);
 
-	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	if (qsc_intutils_are_equal8(exp, otp, QSC_SHA3_256_HASH_SIZE) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac512x4_equality: output does not match the known answer -KP2 \n");
+		qsctest_print_safe("Failure! qsctest_keccak_absorb_equality: output does not match the known answer -KA1 \n");
 		status = false;
 	}
 
-	qsc_kmac512_compute(exp[2], 64, msg[2], 256, key[2], 66, cst[2], 16);
+	/* incremental shake-256 absorb and squeeze */
+	qsc_shake256_compute(exp, sizeof(exp), msg, sizeof(msg));
+	qsc_intutils_clear8(otp, sizeof(otp));
+	qsc_keccak_initialize_state(&ctx);
+	pos = 0;
+	flen = 1;
 
-	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	while (pos < sizeof(msg))
 	{
-		qsctest_print_safe("Failure! qsctest_kmac512x4_equality: output does not match the known answer -KP3 \n");
-		status = false;
+		flen = qsc_intutils_min(flen, sizeof(msg) - pos);
+		qsc_keccak_incremental_absorb(&ctx, qsc_keccak_rate_256, msg + pos, flen);
+		pos += flen;
+		flen = (flen * 5 + 11) % 157;
 	}
 
-	qsc_kmac512_compute(exp[3], 64, msg[3], 256, key[3], 66, cst[3], 16);
+	qsc_keccak_incremental_finalize(&ctx, qsc_keccak_rate_256, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	qsc_keccak_incremental_squeeze(&ctx, qsc_keccak_rate_256, otp, 100);
+	qsc_keccak_incremental_squeeze(&ctx, qsc_keccak_rate_256, otp + 100, sizeof(otp) - 100);
 
-	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac512x4_equality: output does not match the known answer -KP4 \n");
+		qsctest_print_safe("Failure! qsctest_keccak_absorb_equality: output does not match the known answer -KA2 \n");
 		status = false;
 	}
 
+	/* kmac-256 over the same fragments, including the position and right-encode edge */
+	for (i = 0; i < 3; ++i)
+	{
+		const size_t mlen = sizeof(msg) - (i * 67);
+
+		qsc_kmac256_compute(exp, sizeof(exp), msg, mlen, key, sizeof(key), NULL, 0);
+		qsc_intutils_clear8(otp, sizeof(otp));
+		qsc_kmac_initialize(&ctx, qsc_keccak_rate_256, key, sizeof(key), NULL, 0);
+		pos = 0;
+		flen = 1;
+
+		while (pos < mlen)
+		{
+			flen = qsc_intutils_min(flen, mlen - pos);
+			qsc_kmac_update(&ctx, qsc_keccak_rate_256, msg + pos, flen);
+			pos += flen;
+			flen = (flen * 3 + 17) % 149;
+		}
+
+		qsc_kmac_finalize(&ctx, qsc_keccak_rate_256, otp, sizeof(otp));
+
+		if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_absorb_equality: output does not match the known answer -KA3 \n");
+			status = false;
+			break;
+		}
+	}
+
+	qsc_keccak_dispose(&ctx);
+
 	return status;
 }
 
-bool qsctest_shake128x4_equality()
+bool qsctest_keccak_squeeze_equality()
 {
-	uint8_t key[4][18] = { 0 };
-	uint8_t otp[4][168] = { 0 };
-	uint8_t exp[4][168] = { 0 };
+	uint8_t exp[KECCAK_SQUEEZE_TEST_OUTLEN] = { 0 };
+	uint8_t cust[15] = { 0 };
+	uint8_t key[KECCAK_ABSORB_TEST_MSGLEN] = { 0 };
+	uint8_t otp[KECCAK_SQUEEZE_TEST_OUTLEN] = { 0 };
+	qsc_keccak_state ctx;
 	size_t i;
+	size_t flen;
+	size_t pos;
 	bool status;
 
 	status = true;
 
-	for (i = 0; i < 16; ++i)
+	for (i = 0; i < sizeof(key); ++i)
 	{
-		key[0][i] = (uint8_t)i;
-		key[1][i] = (uint8_t)i;
-		key[2][i] = (uint8_t)i;
-		key[3][i] = (uint8_t)i;
+		key[i] = (uint8_t)((i * 11) + 3);
 	}
 
-	key[0][16] = (uint8_t)1;
-	key[1][16] = (uint8_t)2;
-	key[2][16] = (uint8_t)3;
-	key[3][16] = (uint8_t)4;
+	for (i = 0; i < sizeof(cust); ++i)
+	{
+		cust[i] = (uint8_t)(0x30 + i);
+	}
 
-	shake128x4(otp[0], otp[1], otp[2], otp[3], 168, key[0], key[1], key[2], key[3], 18);
+	/* shake-256 streamed in fragments that straddle the block boundary */
+	qsc_shake256_compute(exp, sizeof(exp), key, sizeof(key));
+	qsc_shake_initialize(&ctx, qsc_keccak_rate_256, key, sizeof(key));
+	pos = 0;
+	flen = 1;
 
-	qsc_shake128_compute(exp[0], 168, key[0], 18);
+	while (pos < sizeof(otp))
+	{
+		flen = qsc_intutils_min(flen, sizeof(otp) - pos);
+		qsc_shake_squeeze(&ctx, qsc_keccak_rate_256, otp + pos, flen);
+		pos += flen;
+		flen = (flen * 7 + 5) % 311;
+	}
 
-	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake128x4_equality: output does not match the known answer -KP1 \n");
+		qsctest_print_safe("Failure! qsctest_keccak_squeeze_equality: output does not match the known answer -KS1 \n");
 		status = false;
 	}
 
-	qsc_shake128_compute(exp[1], 168, key[1], 18);
+	/* cshake-512 streamed, the first read a whole block */
+	qsc_cshake512_compute(exp, sizeof(exp), key, 64, cust, sizeof(cust), cust, 7);
+	qsc_intutils_clear8(otp, sizeof(otp));
+	qsc_cshake_initialize(&ctx, qsc_keccak_rate_512, key, 64, cust, sizeof(cust), cust, 7);
+	pos = 0;
+	flen = QSC_KECCAK_512_RATE;
 
-	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	while (pos < sizeof(otp))
 	{
-		qsctest_print_safe("Failure! qsctest_shake128x4_equality: output does not match the known answer -KP2 \n");
-		status = false;
+		flen = qsc_intutils_min(flen, sizeof(otp) - pos);
+		qsc_cshake_squeeze(&ctx, qsc_keccak_rate_512, otp + pos, flen);
+		pos += flen;
+		flen = (flen * 3 + 1) % 97;
 	}
 
-	qsc_shake128_compute(exp[2], 168, key[2], 18);
-
-	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake128x4_equality: output does not match the known answer -KP3 \n");
+		qsctest_print_safe("Failure! qsctest_keccak_squeeze_equality: output does not match the known answer -KS2 \n");
 		status = false;
 	}
 
-	qsc_shake128_compute(exp[3], 168, key[3], 18);
+	/* the short form matches the block function for whole blocks */
+	qsc_shake_initialize(&ctx, qsc_keccak_rate_128, key, 32);
+	qsc_shake_squeezeblocks(&ctx, qsc_keccak_rate_128, exp, 3);
+	qsc_shake128_compute(otp, 3 * QSC_KECCAK_128_RATE, key, 32);
 
-	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	if (qsc_intutils_are_equal8(exp, otp, 3 * QSC_KECCAK_128_RATE) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake128x4_equality: output does not match the known answer -KP4 \n");
+		qsctest_print_safe("Failure! qsctest_keccak_squeeze_equality: output does not match the known answer -KS3 \n");
 		status = false;
 	}
 
+	qsc_keccak_dispose(&ctx);
+
 	return status;
 }
 
-bool qsctest_shake256x4_equality()
+bool qsctest_keccak_short_equality()
 {
-	uint8_t key[4][34] = { 0 };
-	uint8_t otp[4][136] = { 0 };
-	uint8_t exp[4][136] = { 0 };
+	uint8_t exp[QSC_KECCAK_128_RATE] = { 0 };
+	uint8_t key[QSC_KECCAK_128_RATE] = { 0 };
+	uint8_t msg[QSC_KECCAK_128_RATE + 8] = { 0 };
+	uint8_t otp[QSC_KECCAK_128_RATE] = { 0 };
+	const qsc_keccak_rate rates[3] = { qsc_keccak_rate_128, qsc_keccak_rate_256, qsc_keccak_rate_512 };
+	qsc_keccak_state ctx;
 	size_t i;
+	size_t j;
+	size_t mlen;
+	size_t olen;
 	bool status;
 
 	status = true;
 
-	for (i = 0; i < 32; ++i)
+	for (i = 0; i < sizeof(msg); ++i)
 	{
-		key[0][i] = (uint8_t)i;
-		key[1][i] = (uint8_t)i;
-		key[2][i] = (uint8_t)i;
-		key[3][i] = (uint8_t)i;
+		msg[i] = (uint8_t)((i * 29) + 7);
 	}
 
-	key[0][32] = (uint8_t)1;
-	key[1][32] = (uint8_t)2;
-	key[2][32] = (uint8_t)3;
-	key[3][32] = (uint8_t)4;
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)(0x80 + i);
+	}
 
-	shake256x4(otp[0], otp[1], otp[2], otp[3], 136, key[0], key[1], key[2], key[3], 34);
+	/* every message length around the single-block boundary, against the long form */
+	for (mlen = 0; mlen <= QSC_KECCAK_256_RATE + 1 && status == true; ++mlen)
+	{
+		qsc_sha3_compute256(otp, msg, mlen);
+		qsc_sha3_initialize(&ctx);
+		qsc_sha3_update(&ctx, qsc_keccak_rate_256, msg, mlen);
+		qsc_sha3_finalize(&ctx, qsc_keccak_rate_256, exp);
 
-	qsc_shake256_compute(exp[0], 136, key[0], 34);
+		if (qsc_intutils_are_equal8(exp, otp, QSC_SHA3_256_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_short_equality: output does not match the known answer -KH1 \n");
+			status = false;
+		}
 
-	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
-	{
-		qsctest_print_safe("Failure! qsctest_shake256x4_equality: output does not match the known answer -KP1 \n");
-		status = false;
-	}
+		olen = (mlen % QSC_KECCAK_128_RATE) + 1;
+		qsc_shake128_compute(otp, olen, msg, mlen);
+		qsc_keccak_initialize_state(&ctx);
+		qsc_keccak_incremental_absorb(&ctx, qsc_keccak_rate_128, msg, mlen);
+		qsc_keccak_incremental_finalize(&ctx, qsc_keccak_rate_128, QSC_KECCAK_SHAKE_DOMAIN_ID);
+		qsc_keccak_incremental_squeeze(&ctx, qsc_keccak_rate_128, exp, olen);
 
-	qsc_shake256_compute(exp[1], 136, key[1], 34);
+		if (qsc_intutils_are_equal8(exp, otp, olen) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_short_equality: output does not match the known answer -KH2 \n");
+			status = false;
+		}
+	}
 
-	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	/* kmac over each rate with short keys and messages, against the streaming api */
+	for (j = 0; j < 3 && status == true; ++j)
 	{
-		qsctest_print_safe("Failure! qsctest_shake256x4_equality: output does not match the known answer -KP2 \n");
-		status = false;
-	}
+		for (mlen = 0; mlen <= (size_t)rates[j] && status == true; mlen += 7)
+		{
+			olen = ((mlen * 3) % (size_t)rates[j]) + 1;
+			qsc_kmac_initialize(&ctx, rates[j], key, (mlen % 64) + 1, NULL, 0);
+			qsc_kmac_update(&ctx, rates[j], msg, mlen);
+			qsc_kmac_finalize(&ctx, rates[j], exp, olen);
 
-	qsc_shake256_compute(exp[2], 136, key[2], 34);
+			if (rates[j] == qsc_keccak_rate_128)
+			{
+				qsc_kmac128_compute(otp, olen, msg, mlen, key, (mlen % 64) + 1, NULL, 0);
+			}
+			else if (rates[j] == qsc_keccak_rate_256)
+			{
+				qsc_kmac256_compute(otp, olen, msg, mlen, key, (mlen % 64) + 1, NULL, 0);
+			}
+			else
+			{
+				qsc_kmac512_compute(otp, olen, msg, mlen, key, (mlen % 64) + 1, NULL, 0);
+			}
 
-	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
-	{
-		qsctest_print_safe("Failure! qsctest_shake256x4_equality: output does not match the known answer -KP3 \n");
-		status = false;
+			if (qsc_intutils_are_equal8(exp, otp, olen) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_keccak_short_equality: output does not match the known answer -KH3 \n");
+				status = false;
+			}
+		}
 	}
 
-	qsc_shake256_compute(exp[3], 136, key[3], 34);
-
-	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	/* the multi-lane kmac starts from the same precomputed name state */
+	if (status == true)
 	{
-		qsctest_print_safe("Failure! qsctest_shake256x4_equality: output does not match the known answer -KP4 \n");
-		status = false;
+		uint8_t lanes[8][QSC_SHA3_256_HASH_SIZE] = { 0 };
+
+		qsc_kmac256_compute(exp, QSC_SHA3_256_HASH_SIZE, msg, 100, key, 32, NULL, 0);
+		kmac256x4(lanes[0], lanes[1], lanes[2], lanes[3], QSC_SHA3_256_HASH_SIZE, key, key, key, key, 32,
+			NULL, NULL, NULL, NULL, 0, msg, msg, msg, msg, 100);
+		kmac256x8(lanes[4], lanes[5], lanes[6], lanes[7], lanes[0], lanes[1], lanes[2], lanes[3], QSC_SHA3_256_HASH_SIZE,
+			key, key, key, key, key, key, key, key, 32, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0,
+			msg, msg, msg, msg, msg, msg, msg, msg, 100);
+
+		for (i = 0; i < 8; ++i)
+		{
+			if (qsc_intutils_are_equal8(exp, lanes[i], QSC_SHA3_256_HASH_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_keccak_short_equality: output does not match the known answer -KH4 \n");
+				status = false;
+				break;
+			}
+		}
+	}
+
+	qsc_keccak_dispose(&ctx);
+
+	return status;
+}
+
+bool qsctest_merkle_tree_equality()
+{
+	uint8_t exp[QSC_MERKLE_HASH_SIZE] = { 0 };
+	uint8_t leaf[3][QSC_MERKLE_HASH_SIZE] = { 0 };
+	uint8_t otp[QSC_MERKLE_HASH_SIZE] = { 0 };
+	uint8_t pair[2 * QSC_MERKLE_HASH_SIZE] = { 0 };
+	const size_t ranges[7][2] = { { 0, 1 }, { 5, 1 }, { 36, 2 }, { 37, 1 }, { 3, 16 }, { 8, 16 }, { 0, MERKLE_TEST_LEAVES } };
+	qsc_keccak_state ctx;
+	uint8_t* msg;
+	uint8_t* proof;
+	uint8_t* tree;
+	size_t i;
+	size_t mlen;
+	size_t plen;
+	size_t dlen;
+	bool status;
+
+	status = true;
+	mlen = ((MERKLE_TEST_LEAVES - 1) * QSC_MERKLE_CHUNK_SIZE) + 1000;
+	msg = (uint8_t*)qsc_memutils_malloc(mlen);
+	tree = (uint8_t*)qsc_memutils_malloc(qsc_merkle_tree_size(mlen));
+	proof = (uint8_t*)qsc_memutils_malloc(2 * 8 * QSC_MERKLE_HASH_SIZE);
+
+	if (msg != NULL && tree != NULL && proof != NULL)
+	{
+		for (i = 0; i < mlen; ++i)
+		{
+			msg[i] = (uint8_t)((i * 17) + (i >> 12));
+		}
+
+		/* a three leaf tree against sha3-256 leaves and keccak node hashes with the node domain */
+		for (i = 0; i < 3; ++i)
+		{
+			qsc_sha3_compute256(leaf[i], msg + (i * QSC_MERKLE_CHUNK_SIZE), (i == 2) ? 10 : QSC_MERKLE_CHUNK_SIZE);
+		}
+
+		qsc_memutils_copy(pair, leaf[0], QSC_MERKLE_HASH_SIZE);
+		qsc_memutils_copy(pair + QSC_MERKLE_HASH_SIZE, leaf[1], QSC_MERKLE_HASH_SIZE);
+		qsc_keccak_initialize_state(&ctx);
+		qsc_keccak_absorb(&ctx, qsc_keccak_rate_256, pair, sizeof(pair), QSC_MERKLE_NODE_DOMAIN_ID, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_squeeze(&ctx, qsc_keccak_rate_256, pair, QSC_MERKLE_HASH_SIZE, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_memutils_copy(pair + QSC_MERKLE_HASH_SIZE, leaf[2], QSC_MERKLE_HASH_SIZE);
+		qsc_keccak_initialize_state(&ctx);
+		qsc_keccak_absorb(&ctx, qsc_keccak_rate_256, pair, sizeof(pair), QSC_MERKLE_NODE_DOMAIN_ID, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_squeeze(&ctx, qsc_keccak_rate_256, exp, sizeof(exp), QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_dispose(&ctx);
+
+		if (qsc_merkle_root_compute(otp, msg, (2 * QSC_MERKLE_CHUNK_SIZE) + 10) == false ||
+			qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_merkle_tree_equality: output does not match the known answer -MT1 \n");
+			status = false;
+		}
+
+		/* the empty message is a single empty leaf */
+		qsc_sha3_compute256(exp, msg, 0);
+		qsc_merkle_root_compute(otp, msg, 0);
+
+		if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_merkle_tree_equality: output does not match the known answer -MT2 \n");
+			status = false;
+		}
+
+		/* the stored tree root matches the root-only computation */
+		qsc_merkle_tree_compute(tree, msg, mlen);
+		qsc_merkle_root_compute(exp, msg, mlen);
+
+		if (qsc_intutils_are_equal8(exp, tree + qsc_merkle_tree_size(mlen) - QSC_MERKLE_HASH_SIZE, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_merkle_tree_equality: output does not match the known answer -MT3 \n");
+			status = false;
+		}
+
+		/* range proofs verify, and fail when the data or the proof is altered */
+		for (i = 0; i < 7; ++i)
+		{
+			plen = qsc_merkle_proof_generate(proof, 2 * 8 * QSC_MERKLE_HASH_SIZE, tree, mlen, ranges[i][0], ranges[i][1]);
+			dlen = qsc_intutils_min(ranges[i][1] * QSC_MERKLE_CHUNK_SIZE, mlen - (ranges[i][0] * QSC_MERKLE_CHUNK_SIZE));
+
+			if (plen != qsc_merkle_proof_size(mlen, ranges[i][0], ranges[i][1]) ||
+				qsc_merkle_proof_verify(exp, msg + (ranges[i][0] * QSC_MERKLE_CHUNK_SIZE), dlen, mlen, ranges[i][0], proof, plen) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_merkle_tree_equality: a valid range was rejected -MT4 \n");
+				status = false;
+				break;
+			}
+
+			msg[(ranges[i][0] * QSC_MERKLE_CHUNK_SIZE) + (dlen / 2)] ^= 0x01;
+
+			if (qsc_merkle_proof_verify(exp, msg + (ranges[i][0] * QSC_MERKLE_CHUNK_SIZE), dlen, mlen, ranges[i][0], proof, plen) == true)
+			{
+				qsctest_print_safe("Failure! qsctest_merkle_tree_equality: altered data was accepted -MT5 \n");
+				status = false;
+				break;
+			}
+
+			msg[(ranges[i][0] * QSC_MERKLE_CHUNK_SIZE) + (dlen / 2)] ^= 0x01;
+
+			if (plen != 0)
+			{
+				proof[plen - 1] ^= 0x80;
+
+				if (qsc_merkle_proof_verify(exp, msg + (ranges[i][0] * QSC_MERKLE_CHUNK_SIZE), dlen, mlen, ranges[i][0], proof, plen) == true)
+				{
+					qsctest_print_safe("Failure! qsctest_merkle_tree_equality: an altered proof was accepted -MT6 \n");
+					status = false;
+					break;
+				}
+			}
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	if (tree != NULL)
+	{
+		qsc_memutils_alloc_free(tree);
+	}
+
+	if (proof != NULL)
+	{
+		qsc_memutils_alloc_free(proof);
+	}
+
+	return status;
+}
+
+bool qsctest_keccak_clone_equality()
+{
+	uint8_t cust[21] = { 0 };
+	uint8_t exp[QSC_KECCAK_256_RATE] = { 0 };
+	uint8_t key[32] = { 0 };
+	uint8_t msg[200] = { 0 };
+	uint8_t name[4] = { 0x54, 0x45, 0x53, 0x54 };
+	uint8_t otp[QSC_KECCAK_256_RATE] = { 0 };
+	uint8_t zero[QSC_KECCAK_STATE_SIZE * sizeof(uint64_t)] = { 0 };
+	qsc_keccak_state clone;
+	qsc_keccak_state tmpl;
+	size_t i;
+	bool status;
+
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)(i + 0x40);
+	}
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)i;
+	}
+
+	qsctest_hex_to_bin("4D7920546167676564204170706C69636174696F6E", cust, sizeof(cust));
+	status = true;
+
+	/* key the KMAC template once, and clone it for each message length */
+	qsc_intutils_clear64(tmpl.state, QSC_KECCAK_STATE_SIZE);
+	qsc_kmac_initialize(&tmpl, qsc_keccak_rate_256, key, sizeof(key), cust, sizeof(cust));
+
+	for (i = 0; i <= sizeof(msg); i += 25)
+	{
+		qsc_kmac256_compute(exp, 32, msg, i, key, sizeof(key), cust, sizeof(cust));
+
+		qsc_keccak_clone(&clone, &tmpl);
+		qsc_kmac_update(&clone, qsc_keccak_rate_256, msg, i);
+		qsc_kmac_finalize(&clone, qsc_keccak_rate_256, otp, 32);
+		qsc_keccak_dispose(&clone);
+
+		if (qsc_intutils_are_equal8(exp, otp, 32) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_clone_equality: KMAC clone output does not match -KC1 \n");
+			status = false;
+		}
+	}
+
+	qsc_keccak_dispose(&tmpl);
+
+	/* key the cSHAKE template once, and clone it */
+	qsc_intutils_clear64(tmpl.state, QSC_KECCAK_STATE_SIZE);
+	qsc_cshake_initialize(&tmpl, qsc_keccak_rate_256, key, sizeof(key), name, sizeof(name), cust, sizeof(cust));
+	qsc_cshake256_compute(exp, sizeof(exp), key, sizeof(key), name, sizeof(name), cust, sizeof(cust));
+
+	for (i = 0; i < 2; ++i)
+	{
+		qsc_keccak_clone(&clone, &tmpl);
+		qsc_cshake_squeezeblocks(&clone, qsc_keccak_rate_256, otp, 1);
+
+		if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_clone_equality: cSHAKE clone output does not match -KC2 \n");
+			status = false;
+		}
+
+		/* the clone is erased on dispose */
+		qsc_keccak_dispose(&clone);
+
+		if (qsc_intutils_are_equal8((uint8_t*)clone.state, zero, sizeof(zero)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_clone_equality: the clone was not erased -KC3 \n");
+			status = false;
+		}
+	}
+
+	qsc_keccak_dispose(&tmpl);
+
+	return status;
+}
+
+bool qsctest_keccak_jobs_equality()
+{
+	uint8_t exp[KECCAK_JOB_TEST_COUNT][KECCAK_JOB_TEST_OUTLEN] = { 0 };
+	uint8_t otp[KECCAK_JOB_TEST_COUNT][KECCAK_JOB_TEST_OUTLEN] = { 0 };
+	uint8_t cust[KECCAK_JOB_TEST_COUNT] = { 0 };
+	uint8_t key[KECCAK_JOB_TEST_COUNT + 32] = { 0 };
+	uint8_t msg[KECCAK_JOB_TEST_MSGLEN] = { 0 };
+	const uint8_t name[4] = { 0x54, 0x45, 0x53, 0x54 };
+	qsc_keccak_job jobs[KECCAK_JOB_TEST_COUNT];
+	size_t i;
+	bool status;
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)((i * 7) + 1);
+	}
+
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)(i + 0x40);
+	}
+
+	for (i = 0; i < sizeof(cust); ++i)
+	{
+		cust[i] = (uint8_t)(0xA0 - i);
+	}
+
+	/* every job has its own message, key, customization and output lengths;
+	   the count is not a multiple of the lane count so lanes are refilled and masked */
+	for (i = 0; i < KECCAK_JOB_TEST_COUNT; ++i)
+	{
+		jobs[i].message = msg;
+		jobs[i].msglen = (i * 73) % KECCAK_JOB_TEST_MSGLEN;
+		jobs[i].key = key;
+		jobs[i].keylen = 16 + i;
+		jobs[i].name = name;
+		jobs[i].namelen = (i % 3 == 0) ? 0 : sizeof(name);
+		jobs[i].custom = cust;
+		jobs[i].custlen = (i * 5) % KECCAK_JOB_TEST_COUNT;
+		jobs[i].output = otp[i];
+		jobs[i].outlen = 1 + ((i * 37) % KECCAK_JOB_TEST_OUTLEN);
+	}
+
+	/* a message that ends one byte short of the rate boundary */
+	jobs[1].msglen = QSC_KECCAK_256_RATE - 1;
+	jobs[2].msglen = (2 * QSC_KECCAK_256_RATE) - 2;
+	status = true;
+
+	/* SHA3-256 and SHA3-512 */
+	for (i = 0; i < KECCAK_JOB_TEST_COUNT; ++i)
+	{
+		jobs[i].outlen = QSC_SHA3_256_HASH_SIZE;
+		qsc_sha3_compute256(exp[i], msg, jobs[i].msglen);
+	}
+
+	qsc_keccak_jobs_compute(jobs, KECCAK_JOB_TEST_COUNT, qsc_keccak_rate_256, qsc_keccak_job_sha3);
+
+	for (i = 0; i < KECCAK_JOB_TEST_COUNT; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], QSC_SHA3_256_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_jobs_equality: SHA3-256 output does not match -KJ1 \n");
+			status = false;
+			break;
+		}
+
+		jobs[i].outlen = QSC_SHA3_512_HASH_SIZE;
+		qsc_sha3_compute512(exp[i], msg, jobs[i].msglen);
+	}
+
+	qsc_keccak_jobs_compute(jobs, KECCAK_JOB_TEST_COUNT, qsc_keccak_rate_512, qsc_keccak_job_sha3);
+
+	for (i = 0; i < KECCAK_JOB_TEST_COUNT; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], QSC_SHA3_512_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_jobs_equality: SHA3-512 output does not match -KJ2 \n");
+			status = false;
+			break;
+		}
+	}
+
+	/* SHAKE-256 */
+	for (i = 0; i < KECCAK_JOB_TEST_COUNT; ++i)
+	{
+		jobs[i].outlen = 1 + ((i * 37) % KECCAK_JOB_TEST_OUTLEN);
+		qsc_shake256_compute(exp[i], jobs[i].outlen, msg, jobs[i].msglen);
+	}
+
+	qsc_keccak_jobs_compute(jobs, KECCAK_JOB_TEST_COUNT, qsc_keccak_rate_256, qsc_keccak_job_shake);
+
+	for (i = 0; i < KECCAK_JOB_TEST_COUNT; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], jobs[i].outlen) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_jobs_equality: SHAKE-256 output does not match -KJ3 \n");
+			status = false;
+			break;
+		}
+	}
+
+	/* cSHAKE-128 */
+	for (i = 0; i < KECCAK_JOB_TEST_COUNT; ++i)
+	{
+		qsc_cshake128_compute(exp[i], jobs[i].outlen, msg, jobs[i].msglen, name, jobs[i].namelen, cust, jobs[i].custlen);
+	}
+
+	qsc_keccak_jobs_compute(jobs, KECCAK_JOB_TEST_COUNT, qsc_keccak_rate_128, qsc_keccak_job_cshake);
+
+	for (i = 0; i < KECCAK_JOB_TEST_COUNT; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], jobs[i].outlen) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_jobs_equality: cSHAKE-128 output does not match -KJ4 \n");
+			status = false;
+			break;
+		}
+	}
+
+	/* KMAC-256 */
+	for (i = 0; i < KECCAK_JOB_TEST_COUNT; ++i)
+	{
+		qsc_kmac256_compute(exp[i], jobs[i].outlen, msg, jobs[i].msglen, key, jobs[i].keylen, cust, jobs[i].custlen);
+	}
+
+	qsc_keccak_jobs_compute(jobs, KECCAK_JOB_TEST_COUNT, qsc_keccak_rate_256, qsc_keccak_job_kmac);
+
+	for (i = 0; i < KECCAK_JOB_TEST_COUNT; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], jobs[i].outlen) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_jobs_equality: KMAC-256 output does not match -KJ5 \n");
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+bool qsctest_keccak_permute_avx2_equality()
+{
+	uint64_t exp[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint64_t otp[QSC_KECCAK_STATE_SIZE] = { 0 };
+	size_t i;
+	size_t j;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		exp[i] = 0x9E3779B97F4A7C15ULL * (i + 1);
+		otp[i] = exp[i];
+	}
+
+	/* chain the permutations so every lane is exercised at both round counts */
+	for (i = 0; i < 16; ++i)
+	{
+		qsc_keccak_permute_p1600c(exp, QSC_KPA_ROUNDS);
+		qsc_keccak_permute_p1600avx2(otp, QSC_KPA_ROUNDS);
+
+		if (qsc_intutils_are_equal8((uint8_t*)exp, (uint8_t*)otp, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_permute_avx2_equality: 12 round output does not match -KP1 \n");
+			status = false;
+			break;
+		}
+
+		for (j = 0; j < 2; ++j)
+		{
+			qsc_keccak_permute_p1600c(exp, QSC_KECCAK_PERMUTATION_ROUNDS);
+			qsc_keccak_permute_p1600avx2(otp, QSC_KECCAK_PERMUTATION_ROUNDS);
+		}
+
+		if (qsc_intutils_are_equal8((uint8_t*)exp, (uint8_t*)otp, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_permute_avx2_equality: 24 round output does not match -KP2 \n");
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_kmac128x4_equality()
+{
+	uint8_t cst[4][16] = { 0 };
+	uint8_t key[4][18] = { 0 };
+	uint8_t msg[4][256] = { 0 };
+	uint8_t otp[4][16] = { 0 };
+	uint8_t exp[4][16] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 16; ++i)
+	{
+		cst[0][i] = (uint8_t)i;
+		cst[1][i] = (uint8_t)i;
+		cst[2][i] = (uint8_t)i;
+		cst[3][i] = (uint8_t)i;
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+	}
+
+	key[0][16] = (uint8_t)1;
+	key[1][16] = (uint8_t)2;
+	key[2][16] = (uint8_t)3;
+	key[3][16] = (uint8_t)4;
+
+	for (i = 0; i < 256; ++i)
+	{
+		msg[0][i] = (uint8_t)i;
+		msg[1][i] = (uint8_t)i;
+		msg[2][i] = (uint8_t)i;
+		msg[3][i] = (uint8_t)i;
+	}
+
+	qsc_kmac128_compute(exp[0], 16, msg[0], 256, key[0], 18, cst[0], 16);
+
+	kmac128x4(otp[0], otp[1], otp[2], otp[3], 16, key[0], key[1], key[2], key[3], 18,
+		cst[0], cst[1], cst[2], cst[3], 16, msg[0], msg[1], msg[2], msg[3], 256);
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac128x4_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_kmac128_compute(exp[1], 16, msg[1], 256, key[1], 18, cst[1], 16);
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac128x4_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_kmac128_compute(exp[2], 16, msg[2], 256, key[2], 18, cst[2], 16);
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac128x4_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_kmac128_compute(exp[3], 16, msg[3], 256, key[3], 18, cst[3], 16);
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac128x4_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_kmac256x4_equality()
+{
+	uint8_t cst[4][32] = { 0 };
+	uint8_t key[4][34] = { 0 };
+	uint8_t msg[4][256] = { 0 };
+	uint8_t otp[4][32] = { 0 };
+	uint8_t exp[4][32] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 32; ++i)
+	{
+		cst[0][i] = (uint8_t)i;
+		cst[1][i] = (uint8_t)i;
+		cst[2][i] = (uint8_t)i;
+		cst[3][i] = (uint8_t)i;
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+	}
+
+	key[0][32] = (uint8_t)1;
+	key[1][32] = (uint8_t)2;
+	key[2][32] = (uint8_t)3;
+	key[3][32] = (uint8_t)4;
+
+	for (i = 0; i < 256; ++i)
+	{
+		msg[0][i] = (uint8_t)i;
+		msg[1][i] = (uint8_t)i;
+		msg[2][i] = (uint8_t)i;
+		msg[3][i] = (uint8_t)i;
+	}
+
+	kmac256x4(otp[0], otp[1], otp[2], otp[3], 32, key[0], key[1], key[2], key[3], 34,
+		cst[0], cst[1], cst[2], cst[3], 16, msg[0], msg[1], msg[2], msg[3], 256);
+
+	qsc_kmac256_compute(exp[0], 32, msg[0], 256, key[0], 34, cst[0], 16);
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac256x4_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_kmac256_compute(exp[1], 32, msg[1], 256, key[1], 34, cst[1], 16);
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac256x4_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_kmac256_compute(exp[2], 32, msg[2], 256, key[2], 34, cst[2], 16);
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac256x4_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_kmac256_compute(exp[3], 32, msg[3], 256, key[3], 34, cst[3], 16);
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac256x4_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_kmac512x4_equality()
+{
+	uint8_t cst[4][64] = { 0 };
+	uint8_t key[4][66] = { 0 };
+	uint8_t msg[4][256] = { 0 };
+	uint8_t otp[4][64] = { 0 };
+	uint8_t exp[4][64] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 64; ++i)
+	{
+		cst[0][i] = (uint8_t)i;
+		cst[1][i] = (uint8_t)i;
+		cst[2][i] = (uint8_t)i;
+		cst[3][i] = (uint8_t)i;
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+	}
+
+	key[0][64] = (uint8_t)1;
+	key[1][64] = (uint8_t)2;
+	key[2][64] = (uint8_t)3;
+	key[3][64] = (uint8_t)4;
+
+	for (i = 0; i < 256; ++i)
+	{
+		msg[0][i] = (uint8_t)i;
+		msg[1][i] = (uint8_t)i;
+		msg[2][i] = (uint8_t)i;
+		msg[3][i] = (uint8_t)i;
+	}
+
+	kmac512x4(otp[0], otp[1], otp[2], otp[3], 64, key[0], key[1], key[2], key[3], 66,
+		cst[0], cst[1], cst[2], cst[3], 16, msg[0], msg[1], msg[2], msg[3], 256);
+
+	qsc_kmac512_compute(exp[0], 64, msg[0], 256, key[0], 66, cst[0], 16);
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac512x4_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_kmac512_compute(exp[1], 64, msg[1], 256, key[1], 66, cst[1], 16);
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac512x4_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_kmac512_compute(exp[2], 64, msg[2], 256, key[2], 66, cst[2], 16);
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac512x4_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_kmac512_compute(exp[3], 64, msg[3], 256, key[3], 66, cst[3], 16);
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac512x4_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_shake128x4_equality()
+{
+	uint8_t key[4][18] = { 0 };
+	uint8_t otp[4][168] = { 0 };
+	uint8_t exp[4][168] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 16; ++i)
+	{
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+	}
+
+	key[0][16] = (uint8_t)1;
+	key[1][16] = (uint8_t)2;
+	key[2][16] = (uint8_t)3;
+	key[3][16] = (uint8_t)4;
+
+	shake128x4(otp[0], otp[1], otp[2], otp[3], 168, key[0], key[1], key[2], key[3], 18);
+
+	qsc_shake128_compute(exp[0], 168, key[0], 18);
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake128x4_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_shake128_compute(exp[1], 168, key[1], 18);
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake128x4_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_shake128_compute(exp[2], 168, key[2], 18);
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake128x4_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_shake128_compute(exp[3], 168, key[3], 18);
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake128x4_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_shake256x4_equality()
+{
+	uint8_t key[4][34] = { 0 };
+	uint8_t otp[4][136] = { 0 };
+	uint8_t exp[4][136] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 32; ++i)
+	{
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+	}
+
+	key[0][32] = (uint8_t)1;
+	key[1][32] = (uint8_t)2;
+	key[2][32] = (uint8_t)3;
+	key[3][32] = (uint8_t)4;
+
+	shake256x4(otp[0], otp[1], otp[2], otp[3], 136, key[0], key[1], key[2], key[3], 34);
+
+	qsc_shake256_compute(exp[0], 136, key[0], 34);
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake256x4_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_shake256_compute(exp[1], 136, key[1], 34);
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake256x4_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_shake256_compute(exp[2], 136, key[2], 34);
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake256x4_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_shake256_compute(exp[3], 136, key[3], 34);
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake256x4_equality: output does not match the known answer -KP4 \n");
+		status = false;
 	}
 
 	return status;
@@ -1446,9 +2417,1166 @@ bool qsctest_shake256x4_equality()
 
 bool qsctest_shake512x4_equality()
 {
-	uint8_t key[4][66] = { 0 };
-	uint8_t otp[4][72] = { 0 };
-	uint8_t exp[4][72] = { 0 };
+	uint8_t key[4][66] = { 0 };
+	uint8_t otp[4][72] = { 0 };
+	uint8_t exp[4][72] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 64; ++i)
+	{
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+	}
+
+	key[0][64] = (uint8_t)1;
+	key[1][64] = (uint8_t)2;
+	key[2][64] = (uint8_t)3;
+	key[3][64] = (uint8_t)4;
+
+	shake512x4(otp[0], otp[1], otp[2], otp[3], 72, key[0], key[1], key[2], key[3], 66);
+
+	qsc_shake512_compute(exp[0], 72, key[0], 66);
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake512x4_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_shake512_compute(exp[1], 72, key[1], 66);
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake512x4_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_shake512_compute(exp[2], 72, key[2], 66);
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake512x4_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_shake512_compute(exp[3], 72, key[3], 66);
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake512x4_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_sha3_256x4_equality()
+{
+	uint8_t msg[4][200] = { 0 };
+	uint8_t otp[4][QSC_SHA3_256_HASH_SIZE] = { 0 };
+	uint8_t exp[4][QSC_SHA3_256_HASH_SIZE] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 199; ++i)
+	{
+		msg[0][i] = (uint8_t)i;
+		msg[1][i] = (uint8_t)i;
+		msg[2][i] = (uint8_t)i;
+		msg[3][i] = (uint8_t)i;
+	}
+
+	msg[0][199] = (uint8_t)1;
+	msg[1][199] = (uint8_t)2;
+	msg[2][199] = (uint8_t)3;
+	msg[3][199] = (uint8_t)4;
+
+	sha3_256x4(otp[0], otp[1], otp[2], otp[3], msg[0], msg[1], msg[2], msg[3], sizeof(msg[0]));
+
+	qsc_sha3_compute256(exp[0], msg[0], sizeof(msg[0]));
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_sha3_256x4_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_sha3_compute256(exp[1], msg[1], sizeof(msg[1]));
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_sha3_256x4_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_sha3_compute256(exp[2], msg[2], sizeof(msg[2]));
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_sha3_256x4_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_sha3_compute256(exp[3], msg[3], sizeof(msg[3]));
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_sha3_256x4_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_sha3_512x4_equality()
+{
+	uint8_t msg[4][200] = { 0 };
+	uint8_t otp[4][QSC_SHA3_512_HASH_SIZE] = { 0 };
+	uint8_t exp[4][QSC_SHA3_512_HASH_SIZE] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 199; ++i)
+	{
+		msg[0][i] = (uint8_t)i;
+		msg[1][i] = (uint8_t)i;
+		msg[2][i] = (uint8_t)i;
+		msg[3][i] = (uint8_t)i;
+	}
+
+	msg[0][199] = (uint8_t)1;
+	msg[1][199] = (uint8_t)2;
+	msg[2][199] = (uint8_t)3;
+	msg[3][199] = (uint8_t)4;
+
+	sha3_512x4(otp[0], otp[1], otp[2], otp[3], msg[0], msg[1], msg[2], msg[3], sizeof(msg[0]));
+
+	qsc_sha3_compute512(exp[0], msg[0], sizeof(msg[0]));
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_sha3_512x4_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_sha3_compute512(exp[1], msg[1], sizeof(msg[1]));
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_sha3_512x4_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_sha3_compute512(exp[2], msg[2], sizeof(msg[2]));
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_sha3_512x4_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_sha3_compute512(exp[3], msg[3], sizeof(msg[3]));
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_sha3_512x4_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_cshake128x4_equality()
+{
+	uint8_t cst[4][21] = { 0 };
+	uint8_t key[4][34] = { 0 };
+	const uint8_t name[4] = { 0x54, 0x45, 0x53, 0x54 };
+	uint8_t otp[4][203] = { 0 };
+	uint8_t exp[4][203] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 32; ++i)
+	{
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+	}
+
+	for (i = 0; i < 20; ++i)
+	{
+		cst[0][i] = (uint8_t)(0xA0 + i);
+		cst[1][i] = (uint8_t)(0xA0 + i);
+		cst[2][i] = (uint8_t)(0xA0 + i);
+		cst[3][i] = (uint8_t)(0xA0 + i);
+	}
+
+	key[0][32] = (uint8_t)1;
+	key[1][32] = (uint8_t)2;
+	key[2][32] = (uint8_t)3;
+	key[3][32] = (uint8_t)4;
+	cst[0][20] = (uint8_t)1;
+	cst[1][20] = (uint8_t)2;
+	cst[2][20] = (uint8_t)3;
+	cst[3][20] = (uint8_t)4;
+
+	cshake128x4(otp[0], otp[1], otp[2], otp[3], sizeof(otp[0]), key[0], key[1], key[2], key[3], sizeof(key[0]),
+		name, sizeof(name), cst[0], cst[1], cst[2], cst[3], sizeof(cst[0]));
+
+	qsc_cshake128_compute(exp[0], sizeof(exp[0]), key[0], sizeof(key[0]), name, sizeof(name), cst[0], sizeof(cst[0]));
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_cshake128x4_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_cshake128_compute(exp[1], sizeof(exp[1]), key[1], sizeof(key[1]), name, sizeof(name), cst[1], sizeof(cst[1]));
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_cshake128x4_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_cshake128_compute(exp[2], sizeof(exp[2]), key[2], sizeof(key[2]), name, sizeof(name), cst[2], sizeof(cst[2]));
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_cshake128x4_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_cshake128_compute(exp[3], sizeof(exp[3]), key[3], sizeof(key[3]), name, sizeof(name), cst[3], sizeof(cst[3]));
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_cshake128x4_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_cshake256x4_equality()
+{
+	uint8_t cst[4][21] = { 0 };
+	uint8_t key[4][34] = { 0 };
+	const uint8_t name[4] = { 0x54, 0x45, 0x53, 0x54 };
+	uint8_t otp[4][171] = { 0 };
+	uint8_t exp[4][171] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 32; ++i)
+	{
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+	}
+
+	for (i = 0; i < 20; ++i)
+	{
+		cst[0][i] = (uint8_t)(0xA0 + i);
+		cst[1][i] = (uint8_t)(0xA0 + i);
+		cst[2][i] = (uint8_t)(0xA0 + i);
+		cst[3][i] = (uint8_t)(0xA0 + i);
+	}
+
+	key[0][32] = (uint8_t)1;
+	key[1][32] = (uint8_t)2;
+	key[2][32] = (uint8_t)3;
+	key[3][32] = (uint8_t)4;
+	cst[0][20] = (uint8_t)1;
+	cst[1][20] = (uint8_t)2;
+	cst[2][20] = (uint8_t)3;
+	cst[3][20] = (uint8_t)4;
+
+	cshake256x4(otp[0], otp[1], otp[2], otp[3], sizeof(otp[0]), key[0], key[1], key[2], key[3], sizeof(key[0]),
+		name, sizeof(name), cst[0], cst[1], cst[2], cst[3], sizeof(cst[0]));
+
+	qsc_cshake256_compute(exp[0], sizeof(exp[0]), key[0], sizeof(key[0]), name, sizeof(name), cst[0], sizeof(cst[0]));
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_cshake256x4_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_cshake256_compute(exp[1], sizeof(exp[1]), key[1], sizeof(key[1]), name, sizeof(name), cst[1], sizeof(cst[1]));
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_cshake256x4_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_cshake256_compute(exp[2], sizeof(exp[2]), key[2], sizeof(key[2]), name, sizeof(name), cst[2], sizeof(cst[2]));
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_cshake256x4_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_cshake256_compute(exp[3], sizeof(exp[3]), key[3], sizeof(key[3]), name, sizeof(name), cst[3], sizeof(cst[3]));
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_cshake256x4_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_cshake512x4_equality()
+{
+	uint8_t cst[4][21] = { 0 };
+	uint8_t key[4][34] = { 0 };
+	const uint8_t name[4] = { 0x54, 0x45, 0x53, 0x54 };
+	uint8_t otp[4][107] = { 0 };
+	uint8_t exp[4][107] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 32; ++i)
+	{
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+	}
+
+	for (i = 0; i < 20; ++i)
+	{
+		cst[0][i] = (uint8_t)(0xA0 + i);
+		cst[1][i] = (uint8_t)(0xA0 + i);
+		cst[2][i] = (uint8_t)(0xA0 + i);
+		cst[3][i] = (uint8_t)(0xA0 + i);
+	}
+
+	key[0][32] = (uint8_t)1;
+	key[1][32] = (uint8_t)2;
+	key[2][32] = (uint8_t)3;
+	key[3][32] = (uint8_t)4;
+	cst[0][20] = (uint8_t)1;
+	cst[1][20] = (uint8_t)2;
+	cst[2][20] = (uint8_t)3;
+	cst[3][20] = (uint8_t)4;
+
+	cshake512x4(otp[0], otp[1], otp[2], otp[3], sizeof(otp[0]), key[0], key[1], key[2], key[3], sizeof(key[0]),
+		name, sizeof(name), cst[0], cst[1], cst[2], cst[3], sizeof(cst[0]));
+
+	qsc_cshake512_compute(exp[0], sizeof(exp[0]), key[0], sizeof(key[0]), name, sizeof(name), cst[0], sizeof(cst[0]));
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_cshake512x4_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_cshake512_compute(exp[1], sizeof(exp[1]), key[1], sizeof(key[1]), name, sizeof(name), cst[1], sizeof(cst[1]));
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_cshake512x4_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_cshake512_compute(exp[2], sizeof(exp[2]), key[2], sizeof(key[2]), name, sizeof(name), cst[2], sizeof(cst[2]));
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_cshake512x4_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_cshake512_compute(exp[3], sizeof(exp[3]), key[3], sizeof(key[3]), name, sizeof(name), cst[3], sizeof(cst[3]));
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_cshake512x4_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	return status;
+}
+bool qsctest_keccakx4_incremental_equality()
+{
+	uint8_t exp[4][KECCAK_JOB_TEST_OUTLEN] = { 0 };
+	uint8_t otp[4][KECCAK_JOB_TEST_OUTLEN] = { 0 };
+	uint8_t cust[KECCAK_JOB_TEST_COUNT + 4] = { 0 };
+	uint8_t key[QSC_KMAC_256_KEY_SIZE + 4] = { 0 };
+	uint8_t msg[KECCAK_JOB_TEST_MSGLEN] = { 0 };
+	const uint8_t* frag[4];
+	uint8_t* out[4];
+	size_t fraglen[4];
+	size_t msglen[4];
+	size_t oft[4];
+	qsc_keccakx4_state ctx;
+	size_t i;
+	size_t j;
+	size_t rnd;
+	bool pending;
+	bool status;
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)((i * 7) + 1);
+	}
+
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)(i + 0x40);
+	}
+
+	for (i = 0; i < sizeof(cust); ++i)
+	{
+		cust[i] = (uint8_t)(0xA0 - i);
+	}
+
+	/* lane 1 ends where the kmac length encoding no longer fits the block */
+	for (j = 0; j < 4; ++j)
+	{
+		msglen[j] = (j * 149) % KECCAK_JOB_TEST_MSGLEN;
+		out[j] = otp[j];
+	}
+
+	msglen[1] = QSC_KECCAK_256_RATE - 3;
+	status = true;
+
+	/* KMAC-256, each lane receives fragments of its own size in every round */
+	qsc_keccakx4_kmac_initialize(&ctx, qsc_keccak_rate_256, key + 0, key + 1, key + 2, key + 3, QSC_KMAC_256_KEY_SIZE,
+		cust + 0, cust + 1, cust + 2, cust + 3, KECCAK_JOB_TEST_COUNT);
+	qsc_memutils_clear(oft, sizeof(oft));
+	rnd = 0;
+
+	do
+	{
+		pending = false;
+
+		for (j = 0; j < 4; ++j)
+		{
+			fraglen[j] = qsc_intutils_min(((rnd * 13) + (j * 7)) % 50, msglen[j] - oft[j]);
+			frag[j] = msg + oft[j];
+			oft[j] += fraglen[j];
+			pending = (pending || oft[j] != msglen[j]);
+		}
+
+		qsc_keccakx4_update(&ctx, frag, fraglen);
+		++rnd;
+	}
+	while (pending == true);
+
+	qsc_keccakx4_kmac_finalize(&ctx, out, QSC_SHA3_256_HASH_SIZE);
+
+	for (j = 0; j < 4; ++j)
+	{
+		qsc_kmac256_compute(exp[j], QSC_SHA3_256_HASH_SIZE, msg, msglen[j], key + j, QSC_KMAC_256_KEY_SIZE, cust + j, KECCAK_JOB_TEST_COUNT);
+
+		if (qsc_intutils_are_equal8(exp[j], otp[j], QSC_SHA3_256_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccakx4_incremental_equality: output does not match the known answer -KI1 \n");
+			status = false;
+		}
+	}
+
+	/* SHAKE-128, absorbed in uneven fragments and squeezed across a block boundary */
+	qsc_keccakx4_initialize(&ctx, qsc_keccak_rate_128);
+	qsc_memutils_clear(oft, sizeof(oft));
+	rnd = 0;
+
+	do
+	{
+		pending = false;
+
+		for (j = 0; j < 4; ++j)
+		{
+			fraglen[j] = qsc_intutils_min(((rnd * 31) + (j * 11)) % 200, msglen[j] - oft[j]);
+			frag[j] = msg + oft[j];
+			oft[j] += fraglen[j];
+			pending = (pending || oft[j] != msglen[j]);
+		}
+
+		qsc_keccakx4_update(&ctx, frag, fraglen);
+		++rnd;
+	}
+	while (pending == true);
+
+	qsc_keccakx4_finalize(&ctx, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	qsc_keccakx4_squeeze(&ctx, out, 100);
+
+	for (j = 0; j < 4; ++j)
+	{
+		out[j] = otp[j] + 100;
+	}
+
+	qsc_keccakx4_squeeze(&ctx, out, KECCAK_JOB_TEST_OUTLEN - 100);
+	qsc_keccakx4_dispose(&ctx);
+
+	for (j = 0; j < 4; ++j)
+	{
+		qsc_shake128_compute(exp[j], KECCAK_JOB_TEST_OUTLEN, msg, msglen[j]);
+
+		if (qsc_intutils_are_equal8(exp[j], otp[j], KECCAK_JOB_TEST_OUTLEN) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccakx4_incremental_equality: output does not match the known answer -KI2 \n");
+			status = false;
+		}
+	}
+
+	return status;
+}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+bool qsctest_keccak_permute_avx512_equality()
+{
+	uint64_t exp[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint64_t otp[QSC_KECCAK_STATE_SIZE] = { 0 };
+	size_t i;
+	size_t j;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		exp[i] = 0x9E3779B97F4A7C15ULL * (i + 1);
+		otp[i] = exp[i];
+	}
+
+	/* chain the permutations so every lane is exercised at both round counts */
+	for (i = 0; i < 16; ++i)
+	{
+		qsc_keccak_permute_p1600c(exp, QSC_KPA_ROUNDS);
+		qsc_keccak_permute_p1600avx512(otp, QSC_KPA_ROUNDS);
+
+		if (qsc_intutils_are_equal8((uint8_t*)exp, (uint8_t*)otp, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_permute_avx512_equality: 12 round output does not match -KP3 \n");
+			status = false;
+			break;
+		}
+
+		for (j = 0; j < 2; ++j)
+		{
+			qsc_keccak_permute_p1600c(exp, QSC_KECCAK_PERMUTATION_ROUNDS);
+			qsc_keccak_permute_p1600avx512(otp, QSC_KECCAK_PERMUTATION_ROUNDS);
+		}
+
+		if (qsc_intutils_are_equal8((uint8_t*)exp, (uint8_t*)otp, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_permute_avx512_equality: 24 round output does not match -KP4 \n");
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_kmac128x8_equality()
+{
+	uint8_t cst[8][16] = { 0 };
+	uint8_t key[8][18] = { 0 };
+	uint8_t msg[8][256] = { 0 };
+	uint8_t otp[8][16] = { 0 };
+	uint8_t exp[8][16] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 16; ++i)
+	{
+		cst[0][i] = (uint8_t)i;
+		cst[1][i] = (uint8_t)i;
+		cst[2][i] = (uint8_t)i;
+		cst[3][i] = (uint8_t)i;
+		cst[4][i] = (uint8_t)i;
+		cst[5][i] = (uint8_t)i;
+		cst[6][i] = (uint8_t)i;
+		cst[7][i] = (uint8_t)i;
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+		key[4][i] = (uint8_t)i;
+		key[5][i] = (uint8_t)i;
+		key[6][i] = (uint8_t)i;
+		key[7][i] = (uint8_t)i;
+	}
+
+	key[0][16] = (uint8_t)1;
+	key[1][16] = (uint8_t)2;
+	key[2][16] = (uint8_t)3;
+	key[3][16] = (uint8_t)4;
+	key[4][16] = (uint8_t)1;
+	key[5][16] = (uint8_t)2;
+	key[6][16] = (uint8_t)3;
+	key[7][16] = (uint8_t)4;
+
+	for (i = 0; i < 256; ++i)
+	{
+		msg[0][i] = (uint8_t)i;
+		msg[1][i] = (uint8_t)i;
+		msg[2][i] = (uint8_t)i;
+		msg[3][i] = (uint8_t)i;
+		msg[4][i] = (uint8_t)i;
+		msg[5][i] = (uint8_t)i;
+		msg[6][i] = (uint8_t)i;
+		msg[7][i] = (uint8_t)i;
+	}
+
+	kmac128x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], 16, 
+		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], 18,
+		cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], 16, 
+		msg[0], msg[1], msg[2], msg[3], msg[4], msg[5], msg[6], msg[7], 256);
+
+	qsc_kmac128_compute(exp[0], 16, msg[0], 256, key[0], 18, cst[0], 16);
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_kmac128_compute(exp[1], 16, msg[1], 256, key[1], 18, cst[1], 16);
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_kmac128_compute(exp[2], 16, msg[2], 256, key[2], 18, cst[2], 16);
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_kmac128_compute(exp[3], 16, msg[3], 256, key[3], 18, cst[3], 16);
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	qsc_kmac128_compute(exp[4], 16, msg[4], 256, key[4], 18, cst[4], 16);
+
+	if (qsc_intutils_are_equal8(exp[4], otp[4], sizeof(exp[4])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP5 \n");
+		status = false;
+	}
+
+	qsc_kmac128_compute(exp[5], 16, msg[5], 256, key[5], 18, cst[5], 16);
+
+	if (qsc_intutils_are_equal8(exp[5], otp[5], sizeof(exp[5])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP6 \n");
+		status = false;
+	}
+
+	qsc_kmac128_compute(exp[6], 16, msg[6], 256, key[6], 18, cst[6], 16);
+
+	if (qsc_intutils_are_equal8(exp[6], otp[6], sizeof(exp[6])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP7 \n");
+		status = false;
+	}
+
+	qsc_kmac128_compute(exp[7], 16, msg[7], 256, key[7], 18, cst[7], 16);
+
+	if (qsc_intutils_are_equal8(exp[7], otp[7], sizeof(exp[7])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP8 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_kmac256x8_equality()
+{
+	uint8_t cst[8][32] = { 0 };
+	uint8_t key[8][34] = { 0 };
+	uint8_t msg[8][256] = { 0 };
+	uint8_t otp[8][32] = { 0 };
+	uint8_t exp[8][32] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 32; ++i)
+	{
+		cst[0][i] = (uint8_t)i;
+		cst[1][i] = (uint8_t)i;
+		cst[2][i] = (uint8_t)i;
+		cst[3][i] = (uint8_t)i;
+		cst[4][i] = (uint8_t)i;
+		cst[5][i] = (uint8_t)i;
+		cst[6][i] = (uint8_t)i;
+		cst[7][i] = (uint8_t)i;
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+		key[4][i] = (uint8_t)i;
+		key[5][i] = (uint8_t)i;
+		key[6][i] = (uint8_t)i;
+		key[7][i] = (uint8_t)i;
+	}
+
+	key[0][32] = (uint8_t)1;
+	key[1][32] = (uint8_t)2;
+	key[2][32] = (uint8_t)3;
+	key[3][32] = (uint8_t)4;
+	key[4][32] = (uint8_t)4;
+	key[5][32] = (uint8_t)5;
+	key[6][32] = (uint8_t)6;
+	key[7][32] = (uint8_t)7;
+
+	for (i = 0; i < 256; ++i)
+	{
+		msg[0][i] = (uint8_t)i;
+		msg[1][i] = (uint8_t)i;
+		msg[2][i] = (uint8_t)i;
+		msg[3][i] = (uint8_t)i;
+		msg[4][i] = (uint8_t)i;
+		msg[5][i] = (uint8_t)i;
+		msg[6][i] = (uint8_t)i;
+		msg[7][i] = (uint8_t)i;
+	}
+
+	kmac256x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], 32, 
+		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], 34,
+		cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], 16, 
+		msg[0], msg[1], msg[2], msg[3], msg[4], msg[5], msg[6], msg[7], 256);
+
+	qsc_kmac256_compute(exp[0], 32, msg[0], 256, key[0], 34, cst[0], 16);
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_kmac256_compute(exp[1], 32, msg[1], 256, key[1], 34, cst[1], 16);
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_kmac256_compute(exp[2], 32, msg[2], 256, key[2], 34, cst[2], 16);
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_kmac256_compute(exp[3], 32, msg[3], 256, key[3], 34, cst[3], 16);
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	qsc_kmac256_compute(exp[4], 32, msg[4], 256, key[4], 34, cst[4], 16);
+
+	if (qsc_intutils_are_equal8(exp[4], otp[4], sizeof(exp[4])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP5 \n");
+		status = false;
+	}
+
+	qsc_kmac256_compute(exp[5], 32, msg[5], 256, key[5], 34, cst[5], 16);
+
+	if (qsc_intutils_are_equal8(exp[5], otp[5], sizeof(exp[5])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP6 \n");
+		status = false;
+	}
+
+	qsc_kmac256_compute(exp[6], 32, msg[6], 256, key[6], 34, cst[6], 16);
+
+	if (qsc_intutils_are_equal8(exp[6], otp[6], sizeof(exp[6])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP7 \n");
+		status = false;
+	}
+
+	qsc_kmac256_compute(exp[7], 32, msg[7], 256, key[7], 34, cst[7], 16);
+
+	if (qsc_intutils_are_equal8(exp[7], otp[7], sizeof(exp[7])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP8 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_kmac512x8_equality()
+{
+	uint8_t cst[8][64] = { 0 };
+	uint8_t key[8][66] = { 0 };
+	uint8_t msg[8][256] = { 0 };
+	uint8_t otp[8][64] = { 0 };
+	uint8_t exp[8][64] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 64; ++i)
+	{
+		cst[0][i] = (uint8_t)i;
+		cst[1][i] = (uint8_t)i;
+		cst[2][i] = (uint8_t)i;
+		cst[3][i] = (uint8_t)i;
+		cst[4][i] = (uint8_t)i;
+		cst[5][i] = (uint8_t)i;
+		cst[6][i] = (uint8_t)i;
+		cst[7][i] = (uint8_t)i;
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+		key[4][i] = (uint8_t)i;
+		key[5][i] = (uint8_t)i;
+		key[6][i] = (uint8_t)i;
+		key[7][i] = (uint8_t)i;
+	}
+
+	key[0][64] = (uint8_t)1;
+	key[1][64] = (uint8_t)2;
+	key[2][64] = (uint8_t)3;
+	key[3][64] = (uint8_t)4;
+	key[4][64] = (uint8_t)5;
+	key[5][64] = (uint8_t)6;
+	key[6][64] = (uint8_t)7;
+	key[7][64] = (uint8_t)8;
+
+	for (i = 0; i < 256; ++i)
+	{
+		msg[0][i] = (uint8_t)i;
+		msg[1][i] = (uint8_t)i;
+		msg[2][i] = (uint8_t)i;
+		msg[3][i] = (uint8_t)i;
+		msg[4][i] = (uint8_t)i;
+		msg[5][i] = (uint8_t)i;
+		msg[6][i] = (uint8_t)i;
+		msg[7][i] = (uint8_t)i;
+	}
+
+	kmac512x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], 64, 
+		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], 66,
+		cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], 16, 
+		msg[0], msg[1], msg[2], msg[3], msg[4], msg[5], msg[6], msg[7], 256);
+
+	qsc_kmac512_compute(exp[0], 64, msg[0], 256, key[0], 66, cst[0], 16);
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_kmac512_compute(exp[1], 64, msg[1], 256, key[1], 66, cst[1], 16);
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_kmac512_compute(exp[2], 64, msg[2], 256, key[2], 66, cst[2], 16);
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_kmac512_compute(exp[3], 64, msg[3], 256, key[3], 66, cst[3], 16);
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	qsc_kmac512_compute(exp[4], 64, msg[4], 256, key[4], 66, cst[4], 16);
+
+	if (qsc_intutils_are_equal8(exp[4], otp[4], sizeof(exp[4])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP5 \n");
+		status = false;
+	}
+
+	qsc_kmac512_compute(exp[5], 64, msg[5], 256, key[5], 66, cst[5], 16);
+
+	if (qsc_intutils_are_equal8(exp[5], otp[5], sizeof(exp[5])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP6 \n");
+		status = false;
+	}
+
+	qsc_kmac512_compute(exp[6], 64, msg[6], 256, key[6], 66, cst[6], 16);
+
+	if (qsc_intutils_are_equal8(exp[6], otp[6], sizeof(exp[6])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP7 \n");
+		status = false;
+	}
+
+	qsc_kmac512_compute(exp[7], 64, msg[7], 256, key[7], 66, cst[7], 16);
+
+	if (qsc_intutils_are_equal8(exp[7], otp[7], sizeof(exp[7])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP8 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_shake128x8_equality()
+{
+	uint8_t key[8][18] = { 0 };
+	uint8_t otp[8][168] = { 0 };
+	uint8_t exp[8][168] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 16; ++i)
+	{
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+		key[4][i] = (uint8_t)i;
+		key[5][i] = (uint8_t)i;
+		key[6][i] = (uint8_t)i;
+		key[7][i] = (uint8_t)i;
+	}
+
+	key[0][16] = (uint8_t)1;
+	key[1][16] = (uint8_t)2;
+	key[2][16] = (uint8_t)3;
+	key[3][16] = (uint8_t)4;
+	key[4][16] = (uint8_t)1;
+	key[5][16] = (uint8_t)2;
+	key[6][16] = (uint8_t)3;
+	key[7][16] = (uint8_t)4;
+
+	shake128x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], 168,
+		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], 18);
+
+	qsc_shake128_compute(exp[0], 168, key[0], 18);
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_shake128_compute(exp[1], 168, key[1], 18);
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_shake128_compute(exp[2], 168, key[2], 18);
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_shake128_compute(exp[3], 168, key[3], 18);
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	qsc_shake128_compute(exp[4], 168, key[4], 18);
+
+	if (qsc_intutils_are_equal8(exp[4], otp[4], sizeof(exp[4])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP5 \n");
+		status = false;
+	}
+
+	qsc_shake128_compute(exp[5], 168, key[5], 18);
+
+	if (qsc_intutils_are_equal8(exp[5], otp[5], sizeof(exp[5])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP6 \n");
+		status = false;
+	}
+
+	qsc_shake128_compute(exp[6], 168, key[6], 18);
+
+	if (qsc_intutils_are_equal8(exp[6], otp[6], sizeof(exp[6])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP7 \n");
+		status = false;
+	}
+
+	qsc_shake128_compute(exp[7], 168, key[7], 18);
+
+	if (qsc_intutils_are_equal8(exp[7], otp[7], sizeof(exp[7])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP8 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_shake256x8_equality()
+{
+	uint8_t key[8][34] = { 0 };
+	uint8_t otp[8][136] = { 0 };
+	uint8_t exp[8][136] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < 32; ++i)
+	{
+		key[0][i] = (uint8_t)i;
+		key[1][i] = (uint8_t)i;
+		key[2][i] = (uint8_t)i;
+		key[3][i] = (uint8_t)i;
+		key[4][i] = (uint8_t)i;
+		key[5][i] = (uint8_t)i;
+		key[6][i] = (uint8_t)i;
+		key[7][i] = (uint8_t)i;
+	}
+
+	key[0][32] = (uint8_t)1;
+	key[1][32] = (uint8_t)2;
+	key[2][32] = (uint8_t)3;
+	key[3][32] = (uint8_t)4;
+	key[4][32] = (uint8_t)1;
+	key[5][32] = (uint8_t)2;
+	key[6][32] = (uint8_t)3;
+	key[7][32] = (uint8_t)4;
+
+	shake256x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], 136, 
+		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], 34);
+
+	qsc_shake256_compute(exp[0], 136, key[0], 34);
+
+	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP1 \n");
+		status = false;
+	}
+
+	qsc_shake256_compute(exp[1], 136, key[1], 34);
+
+	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP2 \n");
+		status = false;
+	}
+
+	qsc_shake256_compute(exp[2], 136, key[2], 34);
+
+	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP3 \n");
+		status = false;
+	}
+
+	qsc_shake256_compute(exp[3], 136, key[3], 34);
+
+	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	qsc_shake256_compute(exp[4], 136, key[4], 34);
+
+	if (qsc_intutils_are_equal8(exp[4], otp[4], sizeof(exp[4])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP5 \n");
+		status = false;
+	}
+
+	qsc_shake256_compute(exp[5], 136, key[5], 34);
+
+	if (qsc_intutils_are_equal8(exp[5], otp[5], sizeof(exp[5])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP6 \n");
+		status = false;
+	}
+
+	qsc_shake256_compute(exp[6], 136, key[6], 34);
+
+	if (qsc_intutils_are_equal8(exp[6], otp[6], sizeof(exp[6])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP7 \n");
+		status = false;
+	}
+
+	qsc_shake256_compute(exp[7], 136, key[7], 34);
+
+	if (qsc_intutils_are_equal8(exp[7], otp[7], sizeof(exp[7])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP8 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_shake512x8_equality()
+{
+	uint8_t key[8][66] = { 0 };
+	uint8_t otp[8][72] = { 0 };
+	uint8_t exp[8][72] = { 0 };
 	size_t i;
 	bool status;
 
@@ -1460,20 +3588,29 @@ bool qsctest_shake512x4_equality()
 		key[1][i] = (uint8_t)i;
 		key[2][i] = (uint8_t)i;
 		key[3][i] = (uint8_t)i;
+		key[4][i] = (uint8_t)i;
+		key[5][i] = (uint8_t)i;
+		key[6][i] = (uint8_t)i;
+		key[7][i] = (uint8_t)i;
 	}
 
 	key[0][64] = (uint8_t)1;
 	key[1][64] = (uint8_t)2;
 	key[2][64] = (uint8_t)3;
 	key[3][64] = (uint8_t)4;
+	key[4][64] = (uint8_t)1;
+	key[5][64] = (uint8_t)2;
+	key[6][64] = (uint8_t)3;
+	key[7][64] = (uint8_t)4;
 
-	shake512x4(otp[0], otp[1], otp[2], otp[3], 72, key[0], key[1], key[2], key[3], 66);
+	shake512x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], 72,
+		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], 66);
 
 	qsc_shake512_compute(exp[0], 72, key[0], 66);
 
 	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake512x4_equality: output does not match the known answer -KP1 \n");
+		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP1 \n");
 		status = false;
 	}
 
@@ -1481,7 +3618,7 @@ bool qsctest_shake512x4_equality()
 
 	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake512x4_equality: output does not match the known answer -KP2 \n");
+		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP2 \n");
 		status = false;
 	}
 
@@ -1489,7 +3626,7 @@ bool qsctest_shake512x4_equality()
 
 	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake512x4_equality: output does not match the known answer -KP3 \n");
+		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP3 \n");
 		status = false;
 	}
 
@@ -1497,57 +3634,56 @@ bool qsctest_shake512x4_equality()
 
 	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake512x4_equality: output does not match the known answer -KP4 \n");
+		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP4 \n");
+		status = false;
+	}
+
+	qsc_shake512_compute(exp[4], 72, key[4], 66);
+
+	if (qsc_intutils_are_equal8(exp[4], otp[4], sizeof(exp[4])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP5 \n");
+		status = false;
+	}
+
+	qsc_shake512_compute(exp[5], 72, key[5], 66);
+
+	if (qsc_intutils_are_equal8(exp[5], otp[5], sizeof(exp[5])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP6 \n");
+		status = false;
+	}
+
+	qsc_shake512_compute(exp[6], 72, key[6], 66);
+
+	if (qsc_intutils_are_equal8(exp[6], otp[6], sizeof(exp[6])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP7 \n");
+		status = false;
+	}
+
+	qsc_shake512_compute(exp[7], 72, key[7], 66);
+
+	if (qsc_intutils_are_equal8(exp[7], otp[7], sizeof(exp[7])) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP8 \n");
 		status = false;
 	}
 
 	return status;
 }
-#endif
 
-#if defined(QSC_SYSTEM_HAS_AVX512)
-bool qsctest_kmac128x8_equality()
+bool qsctest_sha3_256x8_equality()
 {
-	uint8_t cst[8][16] = { 0 };
-	uint8_t key[8][18] = { 0 };
-	uint8_t msg[8][256] = { 0 };
-	uint8_t otp[8][16] = { 0 };
-	uint8_t exp[8][16] = { 0 };
+	uint8_t msg[8][200] = { 0 };
+	uint8_t otp[8][QSC_SHA3_256_HASH_SIZE] = { 0 };
+	uint8_t exp[8][QSC_SHA3_256_HASH_SIZE] = { 0 };
 	size_t i;
 	bool status;
 
 	status = true;
 
-	for (i = 0; i < 16; ++i)
-	{
-		cst[0][i] = (uint8_t)i;
-		cst[1][i] = (uint8_t)i;
-		cst[2][i] = (uint8_t)i;
-		cst[3][i] = (uint8_t)i;
-		cst[4][i] = (uint8_t)i;
-		cst[5][i] = (uint8_t)i;
-		cst[6][i] = (uint8_t)i;
-		cst[7][i] = (uint8_t)i;
-		key[0][i] = (uint8_t)i;
-		key[1][i] = (uint8_t)i;
-		key[2][i] = (uint8_t)i;
-		key[3][i] = (uint8_t)i;
-		key[4][i] = (uint8_t)i;
-		key[5][i] = (uint8_t)i;
-		key[6][i] = (uint8_t)i;
-		key[7][i] = (uint8_t)i;
-	}
-
-	key[0][16] = (uint8_t)1;
-	key[1][16] = (uint8_t)2;
-	key[2][16] = (uint8_t)3;
-	key[3][16] = (uint8_t)4;
-	key[4][16] = (uint8_t)1;
-	key[5][16] = (uint8_t)2;
-	key[6][16] = (uint8_t)3;
-	key[7][16] = (uint8_t)4;
-
-	for (i = 0; i < 256; ++i)
+	for (i = 0; i < 199; ++i)
 	{
 		msg[0][i] = (uint8_t)i;
 		msg[1][i] = (uint8_t)i;
@@ -1559,120 +3695,96 @@ bool qsctest_kmac128x8_equality()
 		msg[7][i] = (uint8_t)i;
 	}
 
-	kmac128x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], 16, 
-		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], 18,
-		cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], 16, 
-		msg[0], msg[1], msg[2], msg[3], msg[4], msg[5], msg[6], msg[7], 256);
+	msg[0][199] = (uint8_t)1;
+	msg[1][199] = (uint8_t)2;
+	msg[2][199] = (uint8_t)3;
+	msg[3][199] = (uint8_t)4;
+	msg[4][199] = (uint8_t)1;
+	msg[5][199] = (uint8_t)2;
+	msg[6][199] = (uint8_t)3;
+	msg[7][199] = (uint8_t)4;
 
-	qsc_kmac128_compute(exp[0], 16, msg[0], 256, key[0], 18, cst[0], 16);
+	sha3_256x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7],
+		msg[0], msg[1], msg[2], msg[3], msg[4], msg[5], msg[6], msg[7], sizeof(msg[0]));
+
+	qsc_sha3_compute256(exp[0], msg[0], sizeof(msg[0]));
 
 	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP1 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_256x8_equality: output does not match the known answer -KP1 \n");
 		status = false;
 	}
 
-	qsc_kmac128_compute(exp[1], 16, msg[1], 256, key[1], 18, cst[1], 16);
+	qsc_sha3_compute256(exp[1], msg[1], sizeof(msg[1]));
 
 	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP2 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_256x8_equality: output does not match the known answer -KP2 \n");
 		status = false;
 	}
 
-	qsc_kmac128_compute(exp[2], 16, msg[2], 256, key[2], 18, cst[2], 16);
+	qsc_sha3_compute256(exp[2], msg[2], sizeof(msg[2]));
 
 	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP3 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_256x8_equality: output does not match the known answer -KP3 \n");
 		status = false;
 	}
 
-	qsc_kmac128_compute(exp[3], 16, msg[3], 256, key[3], 18, cst[3], 16);
+	qsc_sha3_compute256(exp[3], msg[3], sizeof(msg[3]));
 
 	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP4 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_256x8_equality: output does not match the known answer -KP4 \n");
 		status = false;
 	}
 
-	qsc_kmac128_compute(exp[4], 16, msg[4], 256, key[4], 18, cst[4], 16);
+	qsc_sha3_compute256(exp[4], msg[4], sizeof(msg[4]));
 
 	if (qsc_intutils_are_equal8(exp[4], otp[4], sizeof(exp[4])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP5 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_256x8_equality: output does not match the known answer -KP5 \n");
 		status = false;
 	}
 
-	qsc_kmac128_compute(exp[5], 16, msg[5], 256, key[5], 18, cst[5], 16);
+	qsc_sha3_compute256(exp[5], msg[5], sizeof(msg[5]));
 
 	if (qsc_intutils_are_equal8(exp[5], otp[5], sizeof(exp[5])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP6 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_256x8_equality: output does not match the known answer -KP6 \n");
 		status = false;
 	}
 
-	qsc_kmac128_compute(exp[6], 16, msg[6], 256, key[6], 18, cst[6], 16);
+	qsc_sha3_compute256(exp[6], msg[6], sizeof(msg[6]));
 
 	if (qsc_intutils_are_equal8(exp[6], otp[6], sizeof(exp[6])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP7 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_256x8_equality: output does not match the known answer -KP7 \n");
 		status = false;
 	}
 
-	qsc_kmac128_compute(exp[7], 16, msg[7], 256, key[7], 18, cst[7], 16);
+	qsc_sha3_compute256(exp[7], msg[7], sizeof(msg[7]));
 
 	if (qsc_intutils_are_equal8(exp[7], otp[7], sizeof(exp[7])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac128x8_equality: output does not match the known answer -KP8 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_256x8_equality: output does not match the known answer -KP8 \n");
 		status = false;
 	}
 
 	return status;
 }
 
-bool qsctest_kmac256x8_equality()
+bool qsctest_sha3_512x8_equality()
 {
-	uint8_t cst[8][32] = { 0 };
-	uint8_t key[8][34] = { 0 };
-	uint8_t msg[8][256] = { 0 };
-	uint8_t otp[8][32] = { 0 };
-	uint8_t exp[8][32] = { 0 };
+	uint8_t msg[8][200] = { 0 };
+	uint8_t otp[8][QSC_SHA3_512_HASH_SIZE] = { 0 };
+	uint8_t exp[8][QSC_SHA3_512_HASH_SIZE] = { 0 };
 	size_t i;
 	bool status;
 
 	status = true;
 
-	for (i = 0; i < 32; ++i)
-	{
-		cst[0][i] = (uint8_t)i;
-		cst[1][i] = (uint8_t)i;
-		cst[2][i] = (uint8_t)i;
-		cst[3][i] = (uint8_t)i;
-		cst[4][i] = (uint8_t)i;
-		cst[5][i] = (uint8_t)i;
-		cst[6][i] = (uint8_t)i;
-		cst[7][i] = (uint8_t)i;
-		key[0][i] = (uint8_t)i;
-		key[1][i] = (uint8_t)i;
-		key[2][i] = (uint8_t)i;
-		key[3][i] = (uint8_t)i;
-		key[4][i] = (uint8_t)i;
-		key[5][i] = (uint8_t)i;
-		key[6][i] = (uint8_t)i;
-		key[7][i] = (uint8_t)i;
-	}
-
-	key[0][32] = (uint8_t)1;
-	key[1][32] = (uint8_t)2;
-	key[2][32] = (uint8_t)3;
-	key[3][32] = (uint8_t)4;
-	key[4][32] = (uint8_t)4;
-	key[5][32] = (uint8_t)5;
-	key[6][32] = (uint8_t)6;
-	key[7][32] = (uint8_t)7;
-
-	for (i = 0; i < 256; ++i)
+	for (i = 0; i < 199; ++i)
 	{
 		msg[0][i] = (uint8_t)i;
 		msg[1][i] = (uint8_t)i;
@@ -1684,100 +3796,99 @@ bool qsctest_kmac256x8_equality()
 		msg[7][i] = (uint8_t)i;
 	}
 
-	kmac256x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], 32, 
-		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], 34,
-		cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], 16, 
-		msg[0], msg[1], msg[2], msg[3], msg[4], msg[5], msg[6], msg[7], 256);
+	msg[0][199] = (uint8_t)1;
+	msg[1][199] = (uint8_t)2;
+	msg[2][199] = (uint8_t)3;
+	msg[3][199] = (uint8_t)4;
+	msg[4][199] = (uint8_t)1;
+	msg[5][199] = (uint8_t)2;
+	msg[6][199] = (uint8_t)3;
+	msg[7][199] = (uint8_t)4;
 
-	qsc_kmac256_compute(exp[0], 32, msg[0], 256, key[0], 34, cst[0], 16);
+	sha3_512x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7],
+		msg[0], msg[1], msg[2], msg[3], msg[4], msg[5], msg[6], msg[7], sizeof(msg[0]));
+
+	qsc_sha3_compute512(exp[0], msg[0], sizeof(msg[0]));
 
 	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP1 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_512x8_equality: output does not match the known answer -KP1 \n");
 		status = false;
 	}
 
-	qsc_kmac256_compute(exp[1], 32, msg[1], 256, key[1], 34, cst[1], 16);
+	qsc_sha3_compute512(exp[1], msg[1], sizeof(msg[1]));
 
 	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP2 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_512x8_equality: output does not match the known answer -KP2 \n");
 		status = false;
 	}
 
-	qsc_kmac256_compute(exp[2], 32, msg[2], 256, key[2], 34, cst[2], 16);
+	qsc_sha3_compute512(exp[2], msg[2], sizeof(msg[2]));
 
 	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP3 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_512x8_equality: output does not match the known answer -KP3 \n");
 		status = false;
 	}
 
-	qsc_kmac256_compute(exp[3], 32, msg[3], 256, key[3], 34, cst[3], 16);
+	qsc_sha3_compute512(exp[3], msg[3], sizeof(msg[3]));
 
 	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP4 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_512x8_equality: output does not match the known answer -KP4 \n");
 		status = false;
 	}
 
-	qsc_kmac256_compute(exp[4], 32, msg[4], 256, key[4], 34, cst[4], 16);
+	qsc_sha3_compute512(exp[4], msg[4], sizeof(msg[4]));
 
 	if (qsc_intutils_are_equal8(exp[4], otp[4], sizeof(exp[4])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP5 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_512x8_equality: output does not match the known answer -KP5 \n");
 		status = false;
 	}
 
-	qsc_kmac256_compute(exp[5], 32, msg[5], 256, key[5], 34, cst[5], 16);
+	qsc_sha3_compute512(exp[5], msg[5], sizeof(msg[5]));
 
 	if (qsc_intutils_are_equal8(exp[5], otp[5], sizeof(exp[5])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP6 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_512x8_equality: output does not match the known answer -KP6 \n");
 		status = false;
 	}
 
-	qsc_kmac256_compute(exp[6], 32, msg[6], 256, key[6], 34, cst[6], 16);
+	qsc_sha3_compute512(exp[6], msg[6], sizeof(msg[6]));
 
 	if (qsc_intutils_are_equal8(exp[6], otp[6], sizeof(exp[6])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP7 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_512x8_equality: output does not match the known answer -KP7 \n");
 		status = false;
 	}
 
-	qsc_kmac256_compute(exp[7], 32, msg[7], 256, key[7], 34, cst[7], 16);
+	qsc_sha3_compute512(exp[7], msg[7], sizeof(msg[7]));
 
 	if (qsc_intutils_are_equal8(exp[7], otp[7], sizeof(exp[7])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac256x8_equality: output does not match the known answer -KP8 \n");
+		qsctest_print_safe("Failure! qsctest_sha3_512x8_equality: output does not match the known answer -KP8 \n");
 		status = false;
 	}
 
 	return status;
 }
 
-bool qsctest_kmac512x8_equality()
+bool qsctest_cshake128x8_equality()
 {
-	uint8_t cst[8][64] = { 0 };
-	uint8_t key[8][66] = { 0 };
-	uint8_t msg[8][256] = { 0 };
-	uint8_t otp[8][64] = { 0 };
-	uint8_t exp[8][64] = { 0 };
+	uint8_t cst[8][21] = { 0 };
+	uint8_t key[8][34] = { 0 };
+	const uint8_t name[4] = { 0x54, 0x45, 0x53, 0x54 };
+	uint8_t otp[8][203] = { 0 };
+	uint8_t exp[8][203] = { 0 };
 	size_t i;
 	bool status;
 
 	status = true;
 
-	for (i = 0; i < 64; ++i)
+	for (i = 0; i < 32; ++i)
 	{
-		cst[0][i] = (uint8_t)i;
-		cst[1][i] = (uint8_t)i;
-		cst[2][i] = (uint8_t)i;
-		cst[3][i] = (uint8_t)i;
-		cst[4][i] = (uint8_t)i;
-		cst[5][i] = (uint8_t)i;
-		cst[6][i] = (uint8_t)i;
-		cst[7][i] = (uint8_t)i;
 		key[0][i] = (uint8_t)i;
 		key[1][i] = (uint8_t)i;
 		key[2][i] = (uint8_t)i;
@@ -1788,110 +3899,119 @@ bool qsctest_kmac512x8_equality()
 		key[7][i] = (uint8_t)i;
 	}
 
-	key[0][64] = (uint8_t)1;
-	key[1][64] = (uint8_t)2;
-	key[2][64] = (uint8_t)3;
-	key[3][64] = (uint8_t)4;
-	key[4][64] = (uint8_t)5;
-	key[5][64] = (uint8_t)6;
-	key[6][64] = (uint8_t)7;
-	key[7][64] = (uint8_t)8;
-
-	for (i = 0; i < 256; ++i)
+	for (i = 0; i < 20; ++i)
 	{
-		msg[0][i] = (uint8_t)i;
-		msg[1][i] = (uint8_t)i;
-		msg[2][i] = (uint8_t)i;
-		msg[3][i] = (uint8_t)i;
-		msg[4][i] = (uint8_t)i;
-		msg[5][i] = (uint8_t)i;
-		msg[6][i] = (uint8_t)i;
-		msg[7][i] = (uint8_t)i;
+		cst[0][i] = (uint8_t)(0xA0 + i);
+		cst[1][i] = (uint8_t)(0xA0 + i);
+		cst[2][i] = (uint8_t)(0xA0 + i);
+		cst[3][i] = (uint8_t)(0xA0 + i);
+		cst[4][i] = (uint8_t)(0xA0 + i);
+		cst[5][i] = (uint8_t)(0xA0 + i);
+		cst[6][i] = (uint8_t)(0xA0 + i);
+		cst[7][i] = (uint8_t)(0xA0 + i);
 	}
 
-	kmac512x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], 64, 
-		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], 66,
-		cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], 16, 
-		msg[0], msg[1], msg[2], msg[3], msg[4], msg[5], msg[6], msg[7], 256);
-
-	qsc_kmac512_compute(exp[0], 64, msg[0], 256, key[0], 66, cst[0], 16);
+	key[0][32] = (uint8_t)1;
+	key[1][32] = (uint8_t)2;
+	key[2][32] = (uint8_t)3;
+	key[3][32] = (uint8_t)4;
+	key[4][32] = (uint8_t)5;
+	key[5][32] = (uint8_t)6;
+	key[6][32] = (uint8_t)7;
+	key[7][32] = (uint8_t)8;
+	cst[0][20] = (uint8_t)1;
+	cst[1][20] = (uint8_t)2;
+	cst[2][20] = (uint8_t)3;
+	cst[3][20] = (uint8_t)4;
+	cst[4][20] = (uint8_t)5;
+	cst[5][20] = (uint8_t)6;
+	cst[6][20] = (uint8_t)7;
+	cst[7][20] = (uint8_t)8;
+
+	cshake128x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], sizeof(otp[0]),
+		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], sizeof(key[0]), name, sizeof(name),
+		cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], sizeof(cst[0]));
+
+	qsc_cshake128_compute(exp[0], sizeof(exp[0]), key[0], sizeof(key[0]), name, sizeof(name), cst[0], sizeof(cst[0]));
 
 	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP1 \n");
+		qsctest_print_safe("Failure! qsctest_cshake128x8_equality: output does not match the known answer -KP1 \n");
 		status = false;
 	}
 
-	qsc_kmac512_compute(exp[1], 64, msg[1], 256, key[1], 66, cst[1], 16);
+	qsc_cshake128_compute(exp[1], sizeof(exp[1]), key[1], sizeof(key[1]), name, sizeof(name), cst[1], sizeof(cst[1]));
 
 	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP2 \n");
+		qsctest_print_safe("Failure! qsctest_cshake128x8_equality: output does not match the known answer -KP2 \n");
 		status = false;
 	}
 
-	qsc_kmac512_compute(exp[2], 64, msg[2], 256, key[2], 66, cst[2], 16);
+	qsc_cshake128_compute(exp[2], sizeof(exp[2]), key[2], sizeof(key[2]), name, sizeof(name), cst[2], sizeof(cst[2]));
 
 	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP3 \n");
+		qsctest_print_safe("Failure! qsctest_cshake128x8_equality: output does not match the known answer -KP3 \n");
 		status = false;
 	}
 
-	qsc_kmac512_compute(exp[3], 64, msg[3], 256, key[3], 66, cst[3], 16);
+	qsc_cshake128_compute(exp[3], sizeof(exp[3]), key[3], sizeof(key[3]), name, sizeof(name), cst[3], sizeof(cst[3]));
 
 	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP4 \n");
+		qsctest_print_safe("Failure! qsctest_cshake128x8_equality: output does not match the known answer -KP4 \n");
 		status = false;
 	}
 
-	qsc_kmac512_compute(exp[4], 64, msg[4], 256, key[4], 66, cst[4], 16);
+	qsc_cshake128_compute(exp[4], sizeof(exp[4]), key[4], sizeof(key[4]), name, sizeof(name), cst[4], sizeof(cst[4]));
 
 	if (qsc_intutils_are_equal8(exp[4], otp[4], sizeof(exp[4])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP5 \n");
+		qsctest_print_safe("Failure! qsctest_cshake128x8_equality: output does not match the known answer -KP5 \n");
 		status = false;
 	}
 
-	qsc_kmac512_compute(exp[5], 64, msg[5], 256, key[5], 66, cst[5], 16);
+	qsc_cshake128_compute(exp[5], sizeof(exp[5]), key[5], sizeof(key[5]), name, sizeof(name), cst[5], sizeof(cst[5]));
 
 	if (qsc_intutils_are_equal8(exp[5], otp[5], sizeof(exp[5])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP6 \n");
+		qsctest_print_safe("Failure! qsctest_cshake128x8_equality: output does not match the known answer -KP6 \n");
 		status = false;
 	}
 
-	qsc_kmac512_compute(exp[6], 64, msg[6], 256, key[6], 66, cst[6], 16);
+	qsc_cshake128_compute(exp[6], sizeof(exp[6]), key[6], sizeof(key[6]), name, sizeof(name), cst[6], sizeof(cst[6]));
 
 	if (qsc_intutils_are_equal8(exp[6], otp[6], sizeof(exp[6])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP7 \n");
+		qsctest_print_safe("Failure! qsctest_cshake128x8_equality: output does not match the known answer -KP7 \n");
 		status = false;
 	}
 
-	qsc_kmac512_compute(exp[7], 64, msg[7], 256, key[7], 66, cst[7], 16);
+	qsc_cshake128_compute(exp[7], sizeof(exp[7]), key[7], sizeof(key[7]), name, sizeof(name), cst[7], sizeof(cst[7]));
 
 	if (qsc_intutils_are_equal8(exp[7], otp[7], sizeof(exp[7])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_kmac512x8_equality: output does not match the known answer -KP8 \n");
+		qsctest_print_safe("Failure! qsctest_cshake128x8_equality: output does not match the known answer -KP8 \n");
 		status = false;
 	}
 
 	return status;
 }
 
-bool qsctest_shake128x8_equality()
+bool qsctest_cshake256x8_equality()
 {
-	uint8_t key[8][18] = { 0 };
-	uint8_t otp[8][168] = { 0 };
-	uint8_t exp[8][168] = { 0 };
+	uint8_t cst[8][21] = { 0 };
+	uint8_t key[8][34] = { 0 };
+	const uint8_t name[4] = { 0x54, 0x45, 0x53, 0x54 };
+	uint8_t otp[8][171] = { 0 };
+	uint8_t exp[8][171] = { 0 };
 	size_t i;
 	bool status;
 
 	status = true;
 
-	for (i = 0; i < 16; ++i)
+	for (i = 0; i < 32; ++i)
 	{
 		key[0][i] = (uint8_t)i;
 		key[1][i] = (uint8_t)i;
@@ -1903,90 +4023,113 @@ bool qsctest_shake128x8_equality()
 		key[7][i] = (uint8_t)i;
 	}
 
-	key[0][16] = (uint8_t)1;
-	key[1][16] = (uint8_t)2;
-	key[2][16] = (uint8_t)3;
-	key[3][16] = (uint8_t)4;
-	key[4][16] = (uint8_t)1;
-	key[5][16] = (uint8_t)2;
-	key[6][16] = (uint8_t)3;
-	key[7][16] = (uint8_t)4;
-
-	shake128x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], 168,
-		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], 18);
+	for (i = 0; i < 20; ++i)
+	{
+		cst[0][i] = (uint8_t)(0xA0 + i);
+		cst[1][i] = (uint8_t)(0xA0 + i);
+		cst[2][i] = (uint8_t)(0xA0 + i);
+		cst[3][i] = (uint8_t)(0xA0 + i);
+		cst[4][i] = (uint8_t)(0xA0 + i);
+		cst[5][i] = (uint8_t)(0xA0 + i);
+		cst[6][i] = (uint8_t)(0xA0 + i);
+		cst[7][i] = (uint8_t)(0xA0 + i);
+	}
 
-	qsc_shake128_compute(exp[0], 168, key[0], 18);
+	key[0][32] = (uint8_t)1;
+	key[1][32] = (uint8_t)2;
+	key[2][32] = (uint8_t)3;
+	key[3][32] = (uint8_t)4;
+	key[4][32] = (uint8_t)5;
+	key[5][32] = (uint8_t)6;
+	key[6][32] = (uint8_t)7;
+	key[7][32] = (uint8_t)8;
+	cst[0][20] = (uint8_t)1;
+	cst[1][20] = (uint8_t)2;
+	cst[2][20] = (uint8_t)3;
+	cst[3][20] = (uint8_t)4;
+	cst[4][20] = (uint8_t)5;
+	cst[5][20] = (uint8_t)6;
+	cst[6][20] = (uint8_t)7;
+	cst[7][20] = (uint8_t)8;
+
+	cshake256x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], sizeof(otp[0]),
+		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], sizeof(key[0]), name, sizeof(name),
+		cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], sizeof(cst[0]));
+
+	qsc_cshake256_compute(exp[0], sizeof(exp[0]), key[0], sizeof(key[0]), name, sizeof(name), cst[0], sizeof(cst[0]));
 
 	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP1 \n");
+		qsctest_print_safe("Failure! qsctest_cshake256x8_equality: output does not match the known answer -KP1 \n");
 		status = false;
 	}
 
-	qsc_shake128_compute(exp[1], 168, key[1], 18);
+	qsc_cshake256_compute(exp[1], sizeof(exp[1]), key[1], sizeof(key[1]), name, sizeof(name), cst[1], sizeof(cst[1]));
 
 	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP2 \n");
+		qsctest_print_safe("Failure! qsctest_cshake256x8_equality: output does not match the known answer -KP2 \n");
 		status = false;
 	}
 
-	qsc_shake128_compute(exp[2], 168, key[2], 18);
+	qsc_cshake256_compute(exp[2], sizeof(exp[2]), key[2], sizeof(key[2]), name, sizeof(name), cst[2], sizeof(cst[2]));
 
 	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP3 \n");
+		qsctest_print_safe("Failure! qsctest_cshake256x8_equality: output does not match the known answer -KP3 \n");
 		status = false;
 	}
 
-	qsc_shake128_compute(exp[3], 168, key[3], 18);
+	qsc_cshake256_compute(exp[3], sizeof(exp[3]), key[3], sizeof(key[3]), name, sizeof(name), cst[3], sizeof(cst[3]));
 
 	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP4 \n");
+		qsctest_print_safe("Failure! qsctest_cshake256x8_equality: output does not match the known answer -KP4 \n");
 		status = false;
 	}
 
-	qsc_shake128_compute(exp[4], 168, key[4], 18);
+	qsc_cshake256_compute(exp[4], sizeof(exp[4]), key[4], sizeof(key[4]), name, sizeof(name), cst[4], sizeof(cst[4]));
 
 	if (qsc_intutils_are_equal8(exp[4], otp[4], sizeof(exp[4])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP5 \n");
+		qsctest_print_safe("Failure! qsctest_cshake256x8_equality: output does not match the known answer -KP5 \n");
 		status = false;
 	}
 
-	qsc_shake128_compute(exp[5], 168, key[5], 18);
+	qsc_cshake256_compute(exp[5], sizeof(exp[5]), key[5], sizeof(key[5]), name, sizeof(name), cst[5], sizeof(cst[5]));
 
 	if (qsc_intutils_are_equal8(exp[5], otp[5], sizeof(exp[5])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP6 \n");
+		qsctest_print_safe("Failure! qsctest_cshake256x8_equality: output does not match the known answer -KP6 \n");
 		status = false;
 	}
 
-	qsc_shake128_compute(exp[6], 168, key[6], 18);
+	qsc_cshake256_compute(exp[6], sizeof(exp[6]), key[6], sizeof(key[6]), name, sizeof(name), cst[6], sizeof(cst[6]));
 
 	if (qsc_intutils_are_equal8(exp[6], otp[6], sizeof(exp[6])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP7 \n");
+		qsctest_print_safe("Failure! qsctest_cshake256x8_equality: output does not match the known answer -KP7 \n");
 		status = false;
 	}
 
-	qsc_shake128_compute(exp[7], 168, key[7], 18);
+	qsc_cshake256_compute(exp[7], sizeof(exp[7]), key[7], sizeof(key[7]), name, sizeof(name), cst[7], sizeof(cst[7]));
 
 	if (qsc_intutils_are_equal8(exp[7], otp[7], sizeof(exp[7])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake128x8_equality: output does not match the known answer -KP8 \n");
+		qsctest_print_safe("Failure! qsctest_cshake256x8_equality: output does not match the known answer -KP8 \n");
 		status = false;
 	}
 
 	return status;
 }
 
-bool qsctest_shake256x8_equality()
+bool qsctest_cshake512x8_equality()
 {
+	uint8_t cst[8][21] = { 0 };
 	uint8_t key[8][34] = { 0 };
-	uint8_t otp[8][136] = { 0 };
-	uint8_t exp[8][136] = { 0 };
+	const uint8_t name[4] = { 0x54, 0x45, 0x53, 0x54 };
+	uint8_t otp[8][107] = { 0 };
+	uint8_t exp[8][107] = { 0 };
 	size_t i;
 	bool status;
 
@@ -2004,181 +4147,228 @@ bool qsctest_shake256x8_equality()
 		key[7][i] = (uint8_t)i;
 	}
 
+	for (i = 0; i < 20; ++i)
+	{
+		cst[0][i] = (uint8_t)(0xA0 + i);
+		cst[1][i] = (uint8_t)(0xA0 + i);
+		cst[2][i] = (uint8_t)(0xA0 + i);
+		cst[3][i] = (uint8_t)(0xA0 + i);
+		cst[4][i] = (uint8_t)(0xA0 + i);
+		cst[5][i] = (uint8_t)(0xA0 + i);
+		cst[6][i] = (uint8_t)(0xA0 + i);
+		cst[7][i] = (uint8_t)(0xA0 + i);
+	}
+
 	key[0][32] = (uint8_t)1;
 	key[1][32] = (uint8_t)2;
 	key[2][32] = (uint8_t)3;
 	key[3][32] = (uint8_t)4;
-	key[4][32] = (uint8_t)1;
-	key[5][32] = (uint8_t)2;
-	key[6][32] = (uint8_t)3;
-	key[7][32] = (uint8_t)4;
-
-	shake256x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], 136, 
-		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], 34);
-
-	qsc_shake256_compute(exp[0], 136, key[0], 34);
+	key[4][32] = (uint8_t)5;
+	key[5][32] = (uint8_t)6;
+	key[6][32] = (uint8_t)7;
+	key[7][32] = (uint8_t)8;
+	cst[0][20] = (uint8_t)1;
+	cst[1][20] = (uint8_t)2;
+	cst[2][20] = (uint8_t)3;
+	cst[3][20] = (uint8_t)4;
+	cst[4][20] = (uint8_t)5;
+	cst[5][20] = (uint8_t)6;
+	cst[6][20] = (uint8_t)7;
+	cst[7][20] = (uint8_t)8;
+
+	cshake512x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], sizeof(otp[0]),
+		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], sizeof(key[0]), name, sizeof(name),
+		cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], sizeof(cst[0]));
+
+	qsc_cshake512_compute(exp[0], sizeof(exp[0]), key[0], sizeof(key[0]), name, sizeof(name), cst[0], sizeof(cst[0]));
 
 	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP1 \n");
+		qsctest_print_safe("Failure! qsctest_cshake512x8_equality: output does not match the known answer -KP1 \n");
 		status = false;
 	}
 
-	qsc_shake256_compute(exp[1], 136, key[1], 34);
+	qsc_cshake512_compute(exp[1], sizeof(exp[1]), key[1], sizeof(key[1]), name, sizeof(name), cst[1], sizeof(cst[1]));
 
 	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP2 \n");
+		qsctest_print_safe("Failure! qsctest_cshake512x8_equality: output does not match the known answer -KP2 \n");
 		status = false;
 	}
 
-	qsc_shake256_compute(exp[2], 136, key[2], 34);
+	qsc_cshake512_compute(exp[2], sizeof(exp[2]), key[2], sizeof(key[2]), name, sizeof(name), cst[2], sizeof(cst[2]));
 
 	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP3 \n");
+		qsctest_print_safe("Failure! qsctest_cshake512x8_equality: output does not match the known answer -KP3 \n");
 		status = false;
 	}
 
-	qsc_shake256_compute(exp[3], 136, key[3], 34);
+	qsc_cshake512_compute(exp[3], sizeof(exp[3]), key[3], sizeof(key[3]), name, sizeof(name), cst[3], sizeof(cst[3]));
 
 	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP4 \n");
+		qsctest_print_safe("Failure! qsctest_cshake512x8_equality: output does not match the known answer -KP4 \n");
 		status = false;
 	}
 
-	qsc_shake256_compute(exp[4], 136, key[4], 34);
+	qsc_cshake512_compute(exp[4], sizeof(exp[4]), key[4], sizeof(key[4]), name, sizeof(name), cst[4], sizeof(cst[4]));
 
 	if (qsc_intutils_are_equal8(exp[4], otp[4], sizeof(exp[4])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP5 \n");
+		qsctest_print_safe("Failure! qsctest_cshake512x8_equality: output does not match the known answer -KP5 \n");
 		status = false;
 	}
 
-	qsc_shake256_compute(exp[5], 136, key[5], 34);
+	qsc_cshake512_compute(exp[5], sizeof(exp[5]), key[5], sizeof(key[5]), name, sizeof(name), cst[5], sizeof(cst[5]));
 
 	if (qsc_intutils_are_equal8(exp[5], otp[5], sizeof(exp[5])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP6 \n");
+		qsctest_print_safe("Failure! qsctest_cshake512x8_equality: output does not match the known answer -KP6 \n");
 		status = false;
 	}
 
-	qsc_shake256_compute(exp[6], 136, key[6], 34);
+	qsc_cshake512_compute(exp[6], sizeof(exp[6]), key[6], sizeof(key[6]), name, sizeof(name), cst[6], sizeof(cst[6]));
 
 	if (qsc_intutils_are_equal8(exp[6], otp[6], sizeof(exp[6])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP7 \n");
+		qsctest_print_safe("Failure! qsctest_cshake512x8_equality: output does not match the known answer -KP7 \n");
 		status = false;
 	}
 
-	qsc_shake256_compute(exp[7], 136, key[7], 34);
+	qsc_cshake512_compute(exp[7], sizeof(exp[7]), key[7], sizeof(key[7]), name, sizeof(name), cst[7], sizeof(cst[7]));
 
 	if (qsc_intutils_are_equal8(exp[7], otp[7], sizeof(exp[7])) == false)
 	{
-		qsctest_print_safe("Failure! qsctest_shake256x8_equality: output does not match the known answer -KP8 \n");
+		qsctest_print_safe("Failure! qsctest_cshake512x8_equality: output does not match the known answer -KP8 \n");
 		status = false;
 	}
 
 	return status;
 }
 
-bool qsctest_shake512x8_equality()
+bool qsctest_keccakx8_incremental_equality()
 {
-	uint8_t key[8][66] = { 0 };
-	uint8_t otp[8][72] = { 0 };
-	uint8_t exp[8][72] = { 0 };
+	uint8_t exp[8][KECCAK_JOB_TEST_OUTLEN] = { 0 };
+	uint8_t otp[8][KECCAK_JOB_TEST_OUTLEN] = { 0 };
+	uint8_t cust[KECCAK_JOB_TEST_COUNT + 8] = { 0 };
+	uint8_t key[QSC_KMAC_256_KEY_SIZE + 8] = { 0 };
+	uint8_t msg[KECCAK_JOB_TEST_MSGLEN] = { 0 };
+	const uint8_t* frag[8];
+	uint8_t* out[8];
+	size_t fraglen[8];
+	size_t msglen[8];
+	size_t oft[8];
+	qsc_keccakx8_state ctx;
 	size_t i;
+	size_t j;
+	size_t rnd;
+	bool pending;
 	bool status;
 
-	status = true;
-
-	for (i = 0; i < 64; ++i)
+	for (i = 0; i < sizeof(msg); ++i)
 	{
-		key[0][i] = (uint8_t)i;
-		key[1][i] = (uint8_t)i;
-		key[2][i] = (uint8_t)i;
-		key[3][i] = (uint8_t)i;
-		key[4][i] = (uint8_t)i;
-		key[5][i] = (uint8_t)i;
-		key[6][i] = (uint8_t)i;
-		key[7][i] = (uint8_t)i;
+		msg[i] = (uint8_t)((i * 7) + 1);
 	}
 
-	key[0][64] = (uint8_t)1;
-	key[1][64] = (uint8_t)2;
-	key[2][64] = (uint8_t)3;
-	key[3][64] = (uint8_t)4;
-	key[4][64] = (uint8_t)1;
-	key[5][64] = (uint8_t)2;
-	key[6][64] = (uint8_t)3;
-	key[7][64] = (uint8_t)4;
-
-	shake512x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], 72,
-		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], 66);
-
-	qsc_shake512_compute(exp[0], 72, key[0], 66);
-
-	if (qsc_intutils_are_equal8(exp[0], otp[0], sizeof(exp[0])) == false)
+	for (i = 0; i < sizeof(key); ++i)
 	{
-		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP1 \n");
-		status = false;
+		key[i] = (uint8_t)(i + 0x40);
 	}
 
-	qsc_shake512_compute(exp[1], 72, key[1], 66);
-
-	if (qsc_intutils_are_equal8(exp[1], otp[1], sizeof(exp[1])) == false)
+	for (i = 0; i < sizeof(cust); ++i)
 	{
-		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP2 \n");
-		status = false;
+		cust[i] = (uint8_t)(0xA0 - i);
 	}
 
-	qsc_shake512_compute(exp[2], 72, key[2], 66);
-
-	if (qsc_intutils_are_equal8(exp[2], otp[2], sizeof(exp[2])) == false)
+	/* lane 1 ends where the kmac length encoding no longer fits the block */
+	for (j = 0; j < 8; ++j)
 	{
-		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP3 \n");
-		status = false;
+		msglen[j] = (j * 149) % KECCAK_JOB_TEST_MSGLEN;
+		out[j] = otp[j];
 	}
 
-	qsc_shake512_compute(exp[3], 72, key[3], 66);
+	msglen[1] = QSC_KECCAK_256_RATE - 3;
+	status = true;
 
-	if (qsc_intutils_are_equal8(exp[3], otp[3], sizeof(exp[3])) == false)
+	/* KMAC-256, each lane receives fragments of its own size in every round */
+	qsc_keccakx8_kmac_initialize(&ctx, qsc_keccak_rate_256, key + 0, key + 1, key + 2, key + 3, key + 4, key + 5, key + 6, key + 7, QSC_KMAC_256_KEY_SIZE,
+		cust + 0, cust + 1, cust + 2, cust + 3, cust + 4, cust + 5, cust + 6, cust + 7, KECCAK_JOB_TEST_COUNT);
+	qsc_memutils_clear(oft, sizeof(oft));
+	rnd = 0;
+
+	do
 	{
-		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP4 \n");
-		status = false;
+		pending = false;
+
+		for (j = 0; j < 8; ++j)
+		{
+			fraglen[j] = qsc_intutils_min(((rnd * 13) + (j * 7)) % 50, msglen[j] - oft[j]);
+			frag[j] = msg + oft[j];
+			oft[j] += fraglen[j];
+			pending = (pending || oft[j] != msglen[j]);
+		}
+
+		qsc_keccakx8_update(&ctx, frag, fraglen);
+		++rnd;
 	}
+	while (pending == true);
 
-	qsc_shake512_compute(exp[4], 72, key[4], 66);
+	qsc_keccakx8_kmac_finalize(&ctx, out, QSC_SHA3_256_HASH_SIZE);
 
-	if (qsc_intutils_are_equal8(exp[4], otp[4], sizeof(exp[4])) == false)
+	for (j = 0; j < 8; ++j)
 	{
-		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP5 \n");
-		status = false;
+		qsc_kmac256_compute(exp[j], QSC_SHA3_256_HASH_SIZE, msg, msglen[j], key + j, QSC_KMAC_256_KEY_SIZE, cust + j, KECCAK_JOB_TEST_COUNT);
+
+		if (qsc_intutils_are_equal8(exp[j], otp[j], QSC_SHA3_256_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccakx8_incremental_equality: output does not match the known answer -KI3 \n");
+			status = false;
+		}
 	}
 
-	qsc_shake512_compute(exp[5], 72, key[5], 66);
+	/* SHAKE-128, absorbed in uneven fragments and squeezed across a block boundary */
+	qsc_keccakx8_initialize(&ctx, qsc_keccak_rate_128);
+	qsc_memutils_clear(oft, sizeof(oft));
+	rnd = 0;
 
-	if (qsc_intutils_are_equal8(exp[5], otp[5], sizeof(exp[5])) == false)
+	do
 	{
-		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP6 \n");
-		status = false;
+		pending = false;
+
+		for (j = 0; j < 8; ++j)
+		{
+			fraglen[j] = qsc_intutils_min(((rnd * 31) + (j * 11)) % 200, msglen[j] - oft[j]);
+			frag[j] = msg + oft[j];
+			oft[j] += fraglen[j];
+			pending = (pending || oft[j] != msglen[j]);
+		}
+
+		qsc_keccakx8_update(&ctx, frag, fraglen);
+		++rnd;
 	}
+	while (pending == true);
 
-	qsc_shake512_compute(exp[6], 72, key[6], 66);
+	qsc_keccakx8_finalize(&ctx, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	qsc_keccakx8_squeeze(&ctx, out, 100);
 
-	if (qsc_intutils_are_equal8(exp[6], otp[6], sizeof(exp[6])) == false)
+	for (j = 0; j < 8; ++j)
 	{
-		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP7 \n");
-		status = false;
+		out[j] = otp[j] + 100;
 	}
 
-	qsc_shake512_compute(exp[7], 72, key[7], 66);
+	qsc_keccakx8_squeeze(&ctx, out, KECCAK_JOB_TEST_OUTLEN - 100);
+	qsc_keccakx8_dispose(&ctx);
 
-	if (qsc_intutils_are_equal8(exp[7], otp[7], sizeof(exp[7])) == false)
+	for (j = 0; j < 8; ++j)
 	{
-		qsctest_print_safe("Failure! qsctest_shake512x8_equality: output does not match the known answer -KP8 \n");
-		status = false;
+		qsc_shake128_compute(exp[j], KECCAK_JOB_TEST_OUTLEN, msg, msglen[j]);
+
+		if (qsc_intutils_are_equal8(exp[j], otp[j], KECCAK_JOB_TEST_OUTLEN) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccakx8_incremental_equality: output does not match the known answer -KI4 \n");
+			status = false;
+		}
 	}
 
 	return status;
@@ -2322,8 +4512,98 @@ void qsctest_sha3_run()
 		qsctest_print_safe("Failure! Failed the KPA-512 KAT test. \n");
 	}
 
+	if (qsctest_kpa_tree_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the KPA-tree equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the KPA-tree equality test. \n");
+	}
+
+	if (qsctest_turboshake_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the TurboSHAKE KAT test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the TurboSHAKE KAT test. \n");
+	}
+
+	if (qsctest_kangarootwelve_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the KangarooTwelve KAT test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the KangarooTwelve KAT test. \n");
+	}
+
+	if (qsctest_keccak_absorb_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the Keccak absorb equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Keccak absorb equality test. \n");
+	}
+
+	if (qsctest_keccak_squeeze_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the Keccak squeeze equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Keccak squeeze equality test. \n");
+	}
+
+	if (qsctest_keccak_short_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the Keccak short message equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Keccak short message equality test. \n");
+	}
+
+	if (qsctest_merkle_tree_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the Merkle tree proof test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Merkle tree proof test. \n");
+	}
+
+	if (qsctest_keccak_clone_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the KMAC and cSHAKE keyed state clone test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the KMAC and cSHAKE keyed state clone test. \n");
+	}
+
+	if (qsctest_keccak_jobs_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the variable-length multi-lane job equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the variable-length multi-lane job equality test. \n");
+	}
+
 #if defined(QSC_SYSTEM_HAS_AVX2)
 
+	if (qsctest_keccak_permute_avx2_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the AVX2 Keccak permutation equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the AVX2 Keccak permutation equality test. \n");
+	}
+
 	if (qsctest_kmac128x4_equality() == true)
 	{
 		qsctest_print_safe("Success! Passed the KMAC-128 4x SIMD equality test. \n");
@@ -2378,10 +4658,73 @@ void qsctest_sha3_run()
 		qsctest_print_safe("Failure! Failed the SHAKE-512 4x SIMD equality test. \n");
 	}
 
+	if (qsctest_sha3_256x4_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the SHA3-256 4x SIMD equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the SHA3-256 4x SIMD equality test. \n");
+	}
+
+	if (qsctest_sha3_512x4_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the SHA3-512 4x SIMD equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the SHA3-512 4x SIMD equality test. \n");
+	}
+
+	if (qsctest_cshake128x4_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the cSHAKE-128 4x SIMD equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the cSHAKE-128 4x SIMD equality test. \n");
+	}
+
+	if (qsctest_cshake256x4_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the cSHAKE-256 4x SIMD equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the cSHAKE-256 4x SIMD equality test. \n");
+	}
+
+	if (qsctest_cshake512x4_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the cSHAKE-512 4x SIMD equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the cSHAKE-512 4x SIMD equality test. \n");
+	}
+
+	if (qsctest_keccakx4_incremental_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the 4x SIMD incremental KMAC and SHAKE equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the 4x SIMD incremental KMAC and SHAKE equality test. \n");
+	}
+
 #endif
 
 #if defined(QSC_SYSTEM_HAS_AVX512)
 
+	if (qsctest_keccak_permute_avx512_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the AVX-512 Keccak permutation equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the AVX-512 Keccak permutation equality test. \n");
+	}
+
 	if (qsctest_kmac128x8_equality() == true)
 	{
 		qsctest_print_safe("Success! Passed the KMAC-128 8x SIMD equality test. \n");
@@ -2436,5 +4779,59 @@ void qsctest_sha3_run()
 		qsctest_print_safe("Failure! Failed the SHAKE-512 8x SIMD equality test. \n");
 	}
 
+	if (qsctest_sha3_256x8_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the SHA3-256 8x SIMD equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the SHA3-256 8x SIMD equality test. \n");
+	}
+
+	if (qsctest_sha3_512x8_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the SHA3-512 8x SIMD equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the SHA3-512 8x SIMD equality test. \n");
+	}
+
+	if (qsctest_cshake128x8_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the cSHAKE-128 8x SIMD equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the cSHAKE-128 8x SIMD equality test. \n");
+	}
+
+	if (qsctest_cshake256x8_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the cSHAKE-256 8x SIMD equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the cSHAKE-256 8x SIMD equality test. \n");
+	}
+
+	if (qsctest_cshake512x8_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the cSHAKE-512 8x SIMD equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the cSHAKE-512 8x SIMD equality test. \n");
+	}
+
+	if (qsctest_keccakx8_incremental_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the 8x SIMD incremental KMAC and SHAKE equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the 8x SIMD incremental KMAC and SHAKE equality test. \n");
+	}
+
 #endif
 }
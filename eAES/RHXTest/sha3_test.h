@@ -163,7 +163,79 @@ bool qsctest_kpa_256_kat(void);
 */
 bool qsctest_kpa_512_kat(void);
 
+/**
+* \brief Tests the multi-threaded KPA-tree against KPA and a sequential reconstruction of the tree
+*
+* \return Returns true for success
+*/
+bool qsctest_kpa_tree_equality(void);
+
+/**
+* \brief Tests TurboSHAKE-128 and TurboSHAKE-256 for correct operation, using the RFC 9861 test patterns.
+*
+* \return Returns true for success
+*/
+bool qsctest_turboshake_kat(void);
+
+/**
+* \brief Tests KangarooTwelve (KT128 and KT256) for correct operation, using the RFC 9861 test patterns,
+* including multi-chunk messages hashed across the SIMD lanes.
+*
+* \return Returns true for success
+*/
+bool qsctest_kangarootwelve_kat(void);
+
+/**
+* \brief Tests fragmented SHA3, incremental SHAKE and KMAC updates for equality with the single-call api
+*
+* \return Returns true for success
+*/
+bool qsctest_keccak_absorb_equality(void);
+
+/**
+* \brief Tests the streaming SHAKE and cSHAKE squeeze functions for equality with the single-call api
+*
+* \return Returns true for success
+*/
+bool qsctest_keccak_squeeze_equality(void);
+
+/**
+* \brief Tests the single-block SHA3, SHAKE and KMAC paths against the long form api at every length around the block boundary
+*
+* \return Returns true for success
+*/
+bool qsctest_keccak_short_equality(void);
+
+/**
+* \brief Tests the Merkle tree root against a sequential reconstruction, and range proof generation and verification
+*
+* \return Returns true for success
+*/
+bool qsctest_merkle_tree_equality(void);
+
+/**
+* \brief Tests cloned keyed KMAC and cSHAKE states for equality with the short form api, and that clones are erased on dispose.
+*
+* \return Returns true for success
+*/
+bool qsctest_keccak_clone_equality(void);
+
+/**
+* \brief Tests the multi-lane job scheduler with unequal message, key, customization and output lengths,
+* for equality with the sequential SHA3, SHAKE, cSHAKE and KMAC implementations.
+*
+* \return Returns true for success
+*/
+bool qsctest_keccak_jobs_equality(void);
+
 #if defined(QSC_SYSTEM_HAS_AVX2)
+/**
+* \brief Tests the single-state AVX2 Keccak permutation for equality with the compact permutation, at 12 and 24 rounds.
+*
+* \return Returns true for success
+*/
+bool qsctest_keccak_permute_avx2_equality(void);
+
 /**
 * \brief Tests the KMAC-128 AVX2 intrinsics implementation for equality with the sequential implementation.
 *
@@ -205,9 +277,58 @@ bool qsctest_shake256x4_equality(void);
 * \return Returns true for success
 */
 bool qsctest_shake512x4_equality(void);
+
+/**
+* \brief Tests the SHA3-256 AVX2 intrinsics implementation for equality with the sequential implementation.
+*
+* \return Returns true for success
+*/
+bool qsctest_sha3_256x4_equality(void);
+
+/**
+* \brief Tests the SHA3-512 AVX2 intrinsics implementation for equality with the sequential implementation.
+*
+* \return Returns true for success
+*/
+bool qsctest_sha3_512x4_equality(void);
+
+/**
+* \brief Tests the cSHAKE-128 AVX2 intrinsics implementation for equality with the sequential implementation.
+*
+* \return Returns true for success
+*/
+bool qsctest_cshake128x4_equality(void);
+
+/**
+* \brief Tests the cSHAKE-256 AVX2 intrinsics implementation for equality with the sequential implementation.
+*
+* \return Returns true for success
+*/
+bool qsctest_cshake256x4_equality(void);
+
+/**
+* \brief Tests the cSHAKE-512 AVX2 intrinsics implementation for equality with the sequential implementation.
+*
+* \return Returns true for success
+*/
+bool qsctest_cshake512x4_equality(void);
+/**
+* \brief Tests the 4-lane incremental KMAC and SHAKE against the sequential functions using fragmented updates
+*
+* \return Returns true for success
+*/
+bool qsctest_keccakx4_incremental_equality(void);
+
 #endif
 
 #if defined(QSC_SYSTEM_HAS_AVX512)
+/**
+* \brief Tests the single-state AVX-512 Keccak permutation for equality with the compact permutation, at 12 and 24 rounds.
+*
+* \return Returns true for success
+*/
+bool qsctest_keccak_permute_avx512_equality(void);
+
 /**
 * \brief Tests the KMAC-128 AVX512 intrinsics implementation for equality with the sequential implementation.
 *
@@ -249,6 +370,48 @@ bool qsctest_shake256x8_equality(void);
 * \return Returns true for success
 */
 bool qsctest_shake512x8_equality(void);
+
+/**
+* \brief Tests the SHA3-256 AVX512 intrinsics implementation for equality with the sequential implementation.
+*
+* \return Returns true for success
+*/
+bool qsctest_sha3_256x8_equality(void);
+
+/**
+* \brief Tests the SHA3-512 AVX512 intrinsics implementation for equality with the sequential implementation.
+*
+* \return Returns true for success
+*/
+bool qsctest_sha3_512x8_equality(void);
+
+/**
+* \brief Tests the cSHAKE-128 AVX512 intrinsics implementation for equality with the sequential implementation.
+*
+* \return Returns true for success
+*/
+bool qsctest_cshake128x8_equality(void);
+
+/**
+* \brief Tests the cSHAKE-256 AVX512 intrinsics implementation for equality with the sequential implementation.
+*
+* \return Returns true for success
+*/
+bool qsctest_cshake256x8_equality(void);
+
+/**
+* \brief Tests the cSHAKE-512 AVX512 intrinsics implementation for equality with the sequential implementation.
+*
+* \return Returns true for success
+*/
+bool qsctest_cshake512x8_equality(void);
+/**
+* \brief Tests the 8-lane incremental KMAC and SHAKE against the sequential functions using fragmented updates
+*
+* \return Returns true for success
+*/
+bool qsctest_keccakx8_incremental_equality(void);
+
 #endif
 
 /**